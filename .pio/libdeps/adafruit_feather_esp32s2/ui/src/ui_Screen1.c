@@ -21,6 +21,10 @@ lv_obj_t * ui_Button5 = NULL;
 lv_obj_t * ui_Image1 = NULL;
 lv_obj_t * ui_Image32 = NULL;
 lv_obj_t * ui_Image28 = NULL;
+lv_obj_t * ui_LabelCocheBateria = NULL;
+lv_obj_t * ui_LabelCocheCorriente = NULL;
+lv_obj_t * ui_LabelEnlaceRssi = NULL;
+lv_obj_t * ui_LabelEnlaceRtt = NULL;
 // event funtions
 void ui_event_Button5(lv_event_t * e)
 {
@@ -381,6 +385,42 @@ void ui_Screen1_screen_init(void)
     lv_img_set_angle(ui_Image28, -1300);
     lv_img_set_zoom(ui_Image28, 240);
 
+    ui_LabelCocheBateria = lv_label_create(ui_Screen1);
+    lv_obj_set_width(ui_LabelCocheBateria, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_LabelCocheBateria, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_LabelCocheBateria, -70);
+    lv_obj_set_y(ui_LabelCocheBateria, -106);
+    lv_obj_set_align(ui_LabelCocheBateria, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_LabelCocheBateria, "-- mV");
+    lv_obj_set_style_text_font(ui_LabelCocheBateria, &lv_font_montserrat_12, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_LabelCocheCorriente = lv_label_create(ui_Screen1);
+    lv_obj_set_width(ui_LabelCocheCorriente, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_LabelCocheCorriente, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_LabelCocheCorriente, -15);
+    lv_obj_set_y(ui_LabelCocheCorriente, -106);
+    lv_obj_set_align(ui_LabelCocheCorriente, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_LabelCocheCorriente, "-- mA");
+    lv_obj_set_style_text_font(ui_LabelCocheCorriente, &lv_font_montserrat_12, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_LabelEnlaceRssi = lv_label_create(ui_Screen1);
+    lv_obj_set_width(ui_LabelEnlaceRssi, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_LabelEnlaceRssi, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_LabelEnlaceRssi, 38);
+    lv_obj_set_y(ui_LabelEnlaceRssi, -106);
+    lv_obj_set_align(ui_LabelEnlaceRssi, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_LabelEnlaceRssi, "RSSI --");
+    lv_obj_set_style_text_font(ui_LabelEnlaceRssi, &lv_font_montserrat_12, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_LabelEnlaceRtt = lv_label_create(ui_Screen1);
+    lv_obj_set_width(ui_LabelEnlaceRtt, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_LabelEnlaceRtt, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_LabelEnlaceRtt, 90);
+    lv_obj_set_y(ui_LabelEnlaceRtt, -106);
+    lv_obj_set_align(ui_LabelEnlaceRtt, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_LabelEnlaceRtt, "-- ms");
+    lv_obj_set_style_text_font(ui_LabelEnlaceRtt, &lv_font_montserrat_12, LV_PART_MAIN | LV_STATE_DEFAULT);
+
     lv_obj_add_event_cb(ui_Button5, ui_event_Button5, LV_EVENT_ALL, NULL);
 
 }
@@ -406,5 +446,9 @@ void ui_Screen1_screen_destroy(void)
     ui_Image1 = NULL;
     ui_Image32 = NULL;
     ui_Image28 = NULL;
+    ui_LabelCocheBateria = NULL;
+    ui_LabelCocheCorriente = NULL;
+    ui_LabelEnlaceRssi = NULL;
+    ui_LabelEnlaceRtt = NULL;
 
 }
@@ -30,6 +30,10 @@ extern lv_obj_t * ui_Button5;
 extern lv_obj_t * ui_Image1;
 extern lv_obj_t * ui_Image32;
 extern lv_obj_t * ui_Image28;
+extern lv_obj_t * ui_LabelCocheBateria;
+extern lv_obj_t * ui_LabelCocheCorriente;
+extern lv_obj_t * ui_LabelEnlaceRssi;
+extern lv_obj_t * ui_LabelEnlaceRtt;
 // CUSTOM VARIABLES
 
 #ifdef __cplusplus
@@ -26,6 +26,8 @@ lv_obj_t * ui_Image14 = NULL;
 lv_obj_t * ui_Image15 = NULL;
 lv_obj_t * ui_Image22 = NULL;
 lv_obj_t * ui_Image23 = NULL;
+lv_obj_t * ui_ButtonCurva = NULL;
+lv_obj_t * ui_LabelCurva = NULL;
 // event funtions
 void ui_event_Screen3(lv_event_t * e)
 {
@@ -126,6 +128,16 @@ void ui_event_ButtonJoystick8(lv_event_t * e)
     }
 }
 
+void ui_event_ButtonCurva(lv_event_t * e)
+{
+    lv_event_code_t event_code = lv_event_get_code(e);
+
+    if(event_code == LV_EVENT_RELEASED) {
+        calibrar_curva(e);
+        _ui_screen_change(&ui_Screen6, LV_SCR_LOAD_ANIM_FADE_ON, 50, 0, &ui_Screen6_screen_init);
+    }
+}
+
 // build funtions
 
 void ui_Screen3_screen_init(void)
@@ -380,6 +392,29 @@ void ui_Screen3_screen_init(void)
     lv_obj_add_flag(ui_Image23, LV_OBJ_FLAG_ADV_HITTEST);     /// Flags
     lv_obj_clear_flag(ui_Image23, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
 
+    ui_ButtonCurva = lv_btn_create(ui_Screen3);
+    lv_obj_set_width(ui_ButtonCurva, 52);
+    lv_obj_set_height(ui_ButtonCurva, 30);
+    lv_obj_set_x(ui_ButtonCurva, 124);
+    lv_obj_set_y(ui_ButtonCurva, -60);
+    lv_obj_set_align(ui_ButtonCurva, LV_ALIGN_CENTER);
+    lv_obj_add_flag(ui_ButtonCurva, LV_OBJ_FLAG_SCROLL_ON_FOCUS);     /// Flags
+    lv_obj_clear_flag(ui_ButtonCurva, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
+    lv_obj_set_style_bg_color(ui_ButtonCurva, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_bg_opa(ui_ButtonCurva, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_border_width(ui_ButtonCurva, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_shadow_color(ui_ButtonCurva, lv_color_hex(0x585757), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_shadow_opa(ui_ButtonCurva, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_LabelCurva = lv_label_create(ui_ButtonCurva);
+    lv_obj_set_width(ui_LabelCurva, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_LabelCurva, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_align(ui_LabelCurva, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_LabelCurva, "Curvas");
+    lv_obj_set_style_text_color(ui_LabelCurva, lv_color_hex(0x15B9A8), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_opa(ui_LabelCurva, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(ui_LabelCurva, &lv_font_montserrat_12, LV_PART_MAIN | LV_STATE_DEFAULT);
+
     lv_obj_add_event_cb(ui_ButtonJoystick3, ui_event_ButtonJoystick3, LV_EVENT_ALL, NULL);
     lv_obj_add_event_cb(ui_Button7, ui_event_Button7, LV_EVENT_ALL, NULL);
     lv_obj_add_event_cb(ui_ButtonJoystick1, ui_event_ButtonJoystick1, LV_EVENT_ALL, NULL);
@@ -389,6 +424,7 @@ void ui_Screen3_screen_init(void)
     lv_obj_add_event_cb(ui_ButtonJoystick6, ui_event_ButtonJoystick6, LV_EVENT_ALL, NULL);
     lv_obj_add_event_cb(ui_ButtonJoystick7, ui_event_ButtonJoystick7, LV_EVENT_ALL, NULL);
     lv_obj_add_event_cb(ui_ButtonJoystick8, ui_event_ButtonJoystick8, LV_EVENT_ALL, NULL);
+    lv_obj_add_event_cb(ui_ButtonCurva, ui_event_ButtonCurva, LV_EVENT_ALL, NULL);
     lv_obj_add_event_cb(ui_Screen3, ui_event_Screen3, LV_EVENT_ALL, NULL);
 
 }
@@ -419,5 +455,7 @@ void ui_Screen3_screen_destroy(void)
     ui_Image15 = NULL;
     ui_Image22 = NULL;
     ui_Image23 = NULL;
+    ui_ButtonCurva = NULL;
+    ui_LabelCurva = NULL;
 
 }
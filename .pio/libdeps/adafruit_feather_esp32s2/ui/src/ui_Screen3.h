@@ -44,6 +44,9 @@ extern lv_obj_t * ui_Image14;
 extern lv_obj_t * ui_Image15;
 extern lv_obj_t * ui_Image22;
 extern lv_obj_t * ui_Image23;
+extern void ui_event_ButtonCurva(lv_event_t * e);
+extern lv_obj_t * ui_ButtonCurva;
+extern lv_obj_t * ui_LabelCurva;
 // CUSTOM VARIABLES
 
 #ifdef __cplusplus
@@ -23,6 +23,9 @@ lv_obj_t * ui_Image19 = NULL;
 lv_obj_t * ui_Image20 = NULL;
 lv_obj_t * ui_Image21 = NULL;
 lv_obj_t * ui_Label23 = NULL;
+lv_obj_t * ui_DropdownModelo = NULL;
+lv_obj_t * ui_ButtonModeloNuevo = NULL;
+lv_obj_t * ui_LabelModeloNuevo = NULL;
 // event funtions
 void ui_event_Button10(lv_event_t * e)
 {
@@ -81,6 +84,30 @@ void ui_event_ButtonJoystick15(lv_event_t * e)
     }
 }
 
+void ui_event_DropdownModelo(lv_event_t * e)
+{
+    lv_event_code_t event_code = lv_event_get_code(e);
+
+    if(event_code == LV_EVENT_VALUE_CHANGED) {
+        seleccionar_modelo(e);
+        _ui_screen_change(&ui_Screen3, LV_SCR_LOAD_ANIM_FADE_ON, 50, 0, &ui_Screen3_screen_init);
+        guardarCambios(e);
+        salir_configuracion(e);
+    }
+}
+
+void ui_event_ButtonModeloNuevo(lv_event_t * e)
+{
+    lv_event_code_t event_code = lv_event_get_code(e);
+
+    if(event_code == LV_EVENT_RELEASED) {
+        crear_modelo(e);
+        _ui_screen_change(&ui_Screen3, LV_SCR_LOAD_ANIM_FADE_ON, 50, 0, &ui_Screen3_screen_init);
+        guardarCambios(e);
+        salir_configuracion(e);
+    }
+}
+
 // build funtions
 
 void ui_Screen7_screen_init(void)
@@ -279,11 +306,49 @@ void ui_Screen7_screen_init(void)
     lv_obj_set_align(ui_Label23, LV_ALIGN_CENTER);
     lv_label_set_text(ui_Label23, "Perfil Actual: 1");
 
+    ui_DropdownModelo = lv_dropdown_create(ui_Screen7);
+    lv_dropdown_set_options(ui_DropdownModelo, "Perfil 1");
+    lv_dropdown_set_dir(ui_DropdownModelo, LV_DIR_TOP);
+    lv_dropdown_set_symbol(ui_DropdownModelo, LV_SYMBOL_UP);
+    lv_obj_set_width(ui_DropdownModelo, 190);
+    lv_obj_set_height(ui_DropdownModelo, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_DropdownModelo, -40);
+    lv_obj_set_y(ui_DropdownModelo, 97);
+    lv_obj_set_align(ui_DropdownModelo, LV_ALIGN_CENTER);
+    lv_obj_add_flag(ui_DropdownModelo, LV_OBJ_FLAG_SCROLL_ON_FOCUS);     /// Flags
+    lv_obj_set_style_text_font(ui_DropdownModelo, &lv_font_montserrat_12, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_pad_ver(ui_DropdownModelo, 6, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_ButtonModeloNuevo = lv_btn_create(ui_Screen7);
+    lv_obj_set_width(ui_ButtonModeloNuevo, 65);
+    lv_obj_set_height(ui_ButtonModeloNuevo, 28);
+    lv_obj_set_x(ui_ButtonModeloNuevo, 111);
+    lv_obj_set_y(ui_ButtonModeloNuevo, 97);
+    lv_obj_set_align(ui_ButtonModeloNuevo, LV_ALIGN_CENTER);
+    lv_obj_add_flag(ui_ButtonModeloNuevo, LV_OBJ_FLAG_SCROLL_ON_FOCUS);     /// Flags
+    lv_obj_clear_flag(ui_ButtonModeloNuevo, LV_OBJ_FLAG_SCROLLABLE);      /// Flags
+    lv_obj_set_style_bg_color(ui_ButtonModeloNuevo, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_bg_opa(ui_ButtonModeloNuevo, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_border_width(ui_ButtonModeloNuevo, 1, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_shadow_color(ui_ButtonModeloNuevo, lv_color_hex(0x585757), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_shadow_opa(ui_ButtonModeloNuevo, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_LabelModeloNuevo = lv_label_create(ui_ButtonModeloNuevo);
+    lv_obj_set_width(ui_LabelModeloNuevo, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_LabelModeloNuevo, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_align(ui_LabelModeloNuevo, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_LabelModeloNuevo, "Nuevo");
+    lv_obj_set_style_text_color(ui_LabelModeloNuevo, lv_color_hex(0x15B9A8), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_opa(ui_LabelModeloNuevo, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(ui_LabelModeloNuevo, &lv_font_montserrat_12, LV_PART_MAIN | LV_STATE_DEFAULT);
+
     lv_obj_add_event_cb(ui_Button10, ui_event_Button10, LV_EVENT_ALL, NULL);
     lv_obj_add_event_cb(ui_ButtonJoystick13, ui_event_ButtonJoystick13, LV_EVENT_ALL, NULL);
     lv_obj_add_event_cb(ui_ButtonJoystick12, ui_event_ButtonJoystick12, LV_EVENT_ALL, NULL);
     lv_obj_add_event_cb(ui_ButtonJoystick14, ui_event_ButtonJoystick14, LV_EVENT_ALL, NULL);
     lv_obj_add_event_cb(ui_ButtonJoystick15, ui_event_ButtonJoystick15, LV_EVENT_ALL, NULL);
+    lv_obj_add_event_cb(ui_DropdownModelo, ui_event_DropdownModelo, LV_EVENT_ALL, NULL);
+    lv_obj_add_event_cb(ui_ButtonModeloNuevo, ui_event_ButtonModeloNuevo, LV_EVENT_ALL, NULL);
 
 }
 
@@ -310,5 +375,8 @@ void ui_Screen7_screen_destroy(void)
     ui_Image20 = NULL;
     ui_Image21 = NULL;
     ui_Label23 = NULL;
+    ui_DropdownModelo = NULL;
+    ui_ButtonModeloNuevo = NULL;
+    ui_LabelModeloNuevo = NULL;
 
 }
@@ -36,6 +36,11 @@ extern lv_obj_t * ui_Image19;
 extern lv_obj_t * ui_Image20;
 extern lv_obj_t * ui_Image21;
 extern lv_obj_t * ui_Label23;
+extern void ui_event_DropdownModelo(lv_event_t * e);
+extern lv_obj_t * ui_DropdownModelo;
+extern void ui_event_ButtonModeloNuevo(lv_event_t * e);
+extern lv_obj_t * ui_ButtonModeloNuevo;
+extern lv_obj_t * ui_LabelModeloNuevo;
 // CUSTOM VARIABLES
 
 #ifdef __cplusplus
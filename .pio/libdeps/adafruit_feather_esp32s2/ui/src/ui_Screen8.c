@@ -23,6 +23,10 @@ lv_obj_t * ui_Image25 = NULL;
 lv_obj_t * ui_Image26 = NULL;
 lv_obj_t * ui_Image27 = NULL;
 lv_obj_t * ui_Label24 = NULL;
+lv_obj_t * ui_LabelEnlaceCalidad = NULL;
+lv_obj_t * ui_LabelEnlacePerdida = NULL;
+lv_obj_t * ui_LabelEnlaceReenvios = NULL;
+lv_obj_t * ui_LabelEnlaceLatencia = NULL;
 // event funtions
 void ui_event_Button11(lv_event_t * e)
 {
@@ -280,6 +284,42 @@ void ui_Screen8_screen_init(void)
     lv_obj_set_align(ui_Label24, LV_ALIGN_CENTER);
     lv_label_set_text(ui_Label24, "Alcance actual: Momno");
 
+    ui_LabelEnlaceCalidad = lv_label_create(ui_Screen8);
+    lv_obj_set_width(ui_LabelEnlaceCalidad, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_LabelEnlaceCalidad, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_LabelEnlaceCalidad, -80);
+    lv_obj_set_y(ui_LabelEnlaceCalidad, 92);
+    lv_obj_set_align(ui_LabelEnlaceCalidad, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_LabelEnlaceCalidad, "Calidad --");
+    lv_obj_set_style_text_font(ui_LabelEnlaceCalidad, &lv_font_montserrat_12, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_LabelEnlacePerdida = lv_label_create(ui_Screen8);
+    lv_obj_set_width(ui_LabelEnlacePerdida, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_LabelEnlacePerdida, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_LabelEnlacePerdida, 80);
+    lv_obj_set_y(ui_LabelEnlacePerdida, 92);
+    lv_obj_set_align(ui_LabelEnlacePerdida, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_LabelEnlacePerdida, "Perdida --");
+    lv_obj_set_style_text_font(ui_LabelEnlacePerdida, &lv_font_montserrat_12, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_LabelEnlaceReenvios = lv_label_create(ui_Screen8);
+    lv_obj_set_width(ui_LabelEnlaceReenvios, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_LabelEnlaceReenvios, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_LabelEnlaceReenvios, -80);
+    lv_obj_set_y(ui_LabelEnlaceReenvios, 108);
+    lv_obj_set_align(ui_LabelEnlaceReenvios, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_LabelEnlaceReenvios, "Reenvios --");
+    lv_obj_set_style_text_font(ui_LabelEnlaceReenvios, &lv_font_montserrat_12, LV_PART_MAIN | LV_STATE_DEFAULT);
+
+    ui_LabelEnlaceLatencia = lv_label_create(ui_Screen8);
+    lv_obj_set_width(ui_LabelEnlaceLatencia, LV_SIZE_CONTENT);   /// 1
+    lv_obj_set_height(ui_LabelEnlaceLatencia, LV_SIZE_CONTENT);    /// 1
+    lv_obj_set_x(ui_LabelEnlaceLatencia, 80);
+    lv_obj_set_y(ui_LabelEnlaceLatencia, 108);
+    lv_obj_set_align(ui_LabelEnlaceLatencia, LV_ALIGN_CENTER);
+    lv_label_set_text(ui_LabelEnlaceLatencia, "p90 -- us");
+    lv_obj_set_style_text_font(ui_LabelEnlaceLatencia, &lv_font_montserrat_12, LV_PART_MAIN | LV_STATE_DEFAULT);
+
     lv_obj_add_event_cb(ui_Button11, ui_event_Button11, LV_EVENT_ALL, NULL);
     lv_obj_add_event_cb(ui_ButtonJoystick16, ui_event_ButtonJoystick16, LV_EVENT_ALL, NULL);
     lv_obj_add_event_cb(ui_ButtonJoystick17, ui_event_ButtonJoystick17, LV_EVENT_ALL, NULL);
@@ -311,5 +351,9 @@ void ui_Screen8_screen_destroy(void)
     ui_Image26 = NULL;
     ui_Image27 = NULL;
     ui_Label24 = NULL;
+    ui_LabelEnlaceCalidad = NULL;
+    ui_LabelEnlacePerdida = NULL;
+    ui_LabelEnlaceReenvios = NULL;
+    ui_LabelEnlaceLatencia = NULL;
 
 }
@@ -36,6 +36,10 @@ extern lv_obj_t * ui_Image25;
 extern lv_obj_t * ui_Image26;
 extern lv_obj_t * ui_Image27;
 extern lv_obj_t * ui_Label24;
+extern lv_obj_t * ui_LabelEnlaceCalidad;
+extern lv_obj_t * ui_LabelEnlacePerdida;
+extern lv_obj_t * ui_LabelEnlaceReenvios;
+extern lv_obj_t * ui_LabelEnlaceLatencia;
 // CUSTOM VARIABLES
 
 #ifdef __cplusplus
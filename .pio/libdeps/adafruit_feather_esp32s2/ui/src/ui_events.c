@@ -12,6 +12,7 @@ extern bool palanca4_calibration_mode;
 extern bool settings_calibration_mode;
 extern bool intensidad_calibration_mode;
 extern bool canal_calibration_mode; // << añadido
+extern bool curva_calibration_mode;
 
 extern void applyBrightness(int brightness_value);
 extern uint8_t getBrightnessLimit(void);
@@ -27,7 +28,7 @@ extern void getBoostLimits(uint8_t* pos1, uint8_t* pos2, uint8_t* pos3);
 extern void setBoostLimits(uint8_t pos1, uint8_t pos2, uint8_t pos3);
 extern void getExtraLimits(uint8_t* pos1, uint8_t* pos2, uint8_t* pos3);
 extern void setExtraLimits(uint8_t pos1, uint8_t pos2, uint8_t pos3);
-extern void setActiveProfile(uint8_t profile);
+extern bool setActiveProfile(uint8_t profile);
 extern uint8_t getActiveProfile(void);
 extern void setIntensity(uint8_t intensity);
 extern uint8_t getIntensityLimit(void);
@@ -37,11 +38,21 @@ extern void updatePalanca1Vector(void);
 extern void updatePalanca2Vector(void);
 extern void updatePalanca3Vector(void);
 extern void updatePalanca4Vector(void);
+// Modelos (directorio de ConfigStorage): más recientes primero, nombre y alta
+extern uint8_t getRecentModels(uint8_t* profiles, uint8_t max);
+extern void getModelName(uint8_t profile, char* name, uint8_t size);
+extern bool createModel(uint8_t* profile);
 
 // getters/setters para índice 13 (extra config / canal)
 extern void setExtraConfig(uint8_t value);
 extern uint8_t getExtraConfig(void);
 
+// Curvas de respuesta de ch1-ch4 (main.cpp)
+extern void getCurve(uint8_t canal, uint8_t* tipo, uint8_t* cantidad, uint8_t* puntos);
+extern void setCurve(uint8_t canal, uint8_t tipo, uint8_t cantidad, const uint8_t* puntos);
+extern void previewCurve(uint8_t canal, uint8_t tipo, uint8_t cantidad, const uint8_t* puntos);
+extern void updateCurves(void);
+
 extern uint8_t palanca1[3];
 extern uint8_t palanca2[3];
 extern uint8_t palanca3[3];
@@ -63,11 +74,57 @@ static uint8_t original_extra_limits[3] = {0, 0, 0};
 static uint8_t current_extra_limits[3] = {0, 0, 0};
 static uint8_t current_extra_position = 0;
 static uint8_t original_active_profile = 0;
+
+// Selector de modelos: mismos límites que ConfigProfile.h (MAX_PROFILES, CONFIG_NAME_SIZE)
+#define MODELOS_MAX 32
+#define MODELO_NOMBRE_SIZE 12
+static uint8_t modelos[MODELOS_MAX];   // Opción del selector -> perfil
+static uint8_t modelos_count = 0;
 static uint8_t original_intensity = 1;
 
 static uint8_t original_canal = 0;   // << añadido
 static uint8_t current_canal = 0;    // << añadido
 
+// Edición de curvas: mismos valores que ResponseCurve.h (tipos y puntos)
+#define CURVA_CANALES 4
+#define CURVA_TIPOS 4
+#define CURVA_TIPO_PUNTOS 3
+#define CURVA_PUNTOS 5
+static const char* const curva_nombres[CURVA_TIPOS] = {"Lineal", "Expo", "Curva S", "Puntos"};
+static uint8_t current_curva_canal = 0;
+static uint8_t current_curva_tipo = 0;
+static uint8_t current_curva_cantidad = 0;
+static uint8_t current_curva_puntos[CURVA_PUNTOS] = {0, 64, 128, 191, 255};
+static uint8_t current_curva_punto = 0;
+
+// Título y valor de la curva en edición; la tabla del lazo de control se
+// recalcula en vivo (sin guardar)
+static void mostrar_curva(void)
+{
+    char label_str[40];
+    char value_str[12];
+    
+    if (current_curva_tipo == CURVA_TIPO_PUNTOS) {
+        sprintf(label_str, "Curva ch%d: Punto %d%%", current_curva_canal + 1, current_curva_punto * 25);
+        sprintf(value_str, "%d", current_curva_puntos[current_curva_punto]);
+    } else {
+        sprintf(label_str, "Curva ch%d: %s", current_curva_canal + 1, curva_nombres[current_curva_tipo]);
+        sprintf(value_str, "%d%%", current_curva_cantidad);
+    }
+    lv_label_set_text(ui_Label4, label_str);
+    lv_textarea_set_text(ui_TextArea3, value_str);
+    
+    previewCurve(current_curva_canal, current_curva_tipo, current_curva_cantidad, current_curva_puntos);
+}
+
+static void cargar_curva(uint8_t canal)
+{
+    current_curva_canal = canal;
+    current_curva_punto = 0;
+    getCurve(canal, &current_curva_tipo, &current_curva_cantidad, current_curva_puntos);
+    if (current_curva_tipo >= CURVA_TIPOS) current_curva_tipo = 0;
+}
+
 void Button1_event_cb(lv_event_t * e)
 {
     if (brightness_calibration_mode) {
@@ -138,6 +195,15 @@ void Button1_event_cb(lv_event_t * e)
             lv_textarea_set_text(ui_TextArea3, canal_str);
         }
     }
+
+    if (curva_calibration_mode) {
+        if (current_curva_tipo == CURVA_TIPO_PUNTOS) {
+            if (current_curva_puntos[current_curva_punto] > 0) current_curva_puntos[current_curva_punto]--;
+        } else if (current_curva_cantidad > 0) {
+            current_curva_cantidad--;
+        }
+        mostrar_curva();
+    }
 }
 
 void Button2_event_cb(lv_event_t * e)
@@ -209,6 +275,15 @@ void Button2_event_cb(lv_event_t * e)
             lv_textarea_set_text(ui_TextArea3, canal_str);
         }
     }
+
+    if (curva_calibration_mode) {
+        if (current_curva_tipo == CURVA_TIPO_PUNTOS) {
+            if (current_curva_puntos[current_curva_punto] < 255) current_curva_puntos[current_curva_punto]++;
+        } else if (current_curva_cantidad < 100) {
+            current_curva_cantidad++;
+        }
+        mostrar_curva();
+    }
 }
 
 void calibrar_brillo(lv_event_t * e)
@@ -305,11 +380,38 @@ void calibrate_canal(lv_event_t * e)
     lv_textarea_set_text(ui_TextArea3, canal_str);
 }
 
+// Posición 1: canal (ch1-ch4), posición 2: tipo de curva, posición 3: punto (tipo Puntos)
+void calibrar_curva(lv_event_t * e)
+{
+    curva_calibration_mode = true;
+    
+    cargar_curva(0);
+    mostrar_curva();
+}
+
+// Selector de modelos: los guardados, del más reciente al más antiguo
+static void cargar_modelos(void)
+{
+    char opciones[MODELOS_MAX * MODELO_NOMBRE_SIZE];
+    char nombre[MODELO_NOMBRE_SIZE];
+    
+    modelos_count = getRecentModels(modelos, MODELOS_MAX);
+    opciones[0] = '\0';
+    for (uint8_t i = 0; i < modelos_count; i++) {
+        getModelName(modelos[i], nombre, sizeof(nombre));
+        if (i > 0) strcat(opciones, "\n");
+        strcat(opciones, nombre);
+    }
+    lv_dropdown_set_options(ui_DropdownModelo, opciones);
+    lv_dropdown_set_selected(ui_DropdownModelo, 0);
+}
+
 void calibrar_settings(lv_event_t * e)
 {
     settings_calibration_mode = true;
     
     original_active_profile = getActiveProfile();
+    cargar_modelos();
     
     lv_label_set_text(ui_Label23, "Seleccionar Perfil");
     char label_str[32];
@@ -317,18 +419,28 @@ void calibrar_settings(lv_event_t * e)
     lv_label_set_text(ui_Label23, label_str);
 }
 
-void calibrate_settings1(lv_event_t * e)
+// Cambia al perfil y recarga las palancas; false si no se pudo (sigue el actual)
+static bool activar_perfil(uint8_t profile)
 {
-    if (settings_calibration_mode) {
-        setActiveProfile(0);
-        
-        updatePalanca1Vector();
-        updatePalanca2Vector();
-        updatePalanca3Vector();
-        updatePalanca4Vector();
-        
+    if (!setActiveProfile(profile)) {
+        // Caché llena de perfiles sin escribir: sigue el perfil actual
         settings_calibration_mode = false;
-        
+        lv_label_set_text(ui_Label23, "Error al cambiar perfil");
+        return false;
+    }
+    
+    updatePalanca1Vector();
+    updatePalanca2Vector();
+    updatePalanca3Vector();
+    updatePalanca4Vector();
+    
+    settings_calibration_mode = false;
+    return true;
+}
+
+void calibrate_settings1(lv_event_t * e)
+{
+    if (settings_calibration_mode && activar_perfil(0)) {
         lv_label_set_text(ui_Label23, "Perfil 1 Activado");
         lv_textarea_set_text(ui_TextArea3, "1");
     }
@@ -336,16 +448,7 @@ void calibrate_settings1(lv_event_t * e)
 
 void calibrate_settings2(lv_event_t * e)
 {
-    if (settings_calibration_mode) {
-        setActiveProfile(1);
-        
-        updatePalanca1Vector();
-        updatePalanca2Vector();
-        updatePalanca3Vector();
-        updatePalanca4Vector();
-        
-        settings_calibration_mode = false;
-        
+    if (settings_calibration_mode && activar_perfil(1)) {
         lv_label_set_text(ui_Label23, "Perfil 2 Activado");
         lv_textarea_set_text(ui_TextArea3, "2");
     }
@@ -353,16 +456,7 @@ void calibrate_settings2(lv_event_t * e)
 
 void calibrate_settings3(lv_event_t * e)
 {
-    if (settings_calibration_mode) {
-        setActiveProfile(2);
-        
-        updatePalanca1Vector();
-        updatePalanca2Vector();
-        updatePalanca3Vector();
-        updatePalanca4Vector();
-        
-        settings_calibration_mode = false;
-        
+    if (settings_calibration_mode && activar_perfil(2)) {
         lv_label_set_text(ui_Label23, "Perfil 3 Activado");
         lv_textarea_set_text(ui_TextArea3, "3");
     }
@@ -370,21 +464,56 @@ void calibrate_settings3(lv_event_t * e)
 
 void calibrate_settings4(lv_event_t * e)
 {
-    if (settings_calibration_mode) {
-        setActiveProfile(3);
-        
-        updatePalanca1Vector();
-        updatePalanca2Vector();
-        updatePalanca3Vector();
-        updatePalanca4Vector();
-        
-        settings_calibration_mode = false;
-        
+    if (settings_calibration_mode && activar_perfil(3)) {
         lv_label_set_text(ui_Label23, "Perfil 4 Activado");
         lv_textarea_set_text(ui_TextArea3, "4");
     }
 }
 
+static void mostrar_modelo_activo(uint8_t profile)
+{
+    char nombre[MODELO_NOMBRE_SIZE];
+    char label_str[32];
+    getModelName(profile, nombre, sizeof(nombre));
+    sprintf(label_str, "%s activo", nombre);
+    lv_label_set_text(ui_Label23, label_str);
+    
+    char profile_str[4];
+    sprintf(profile_str, "%d", profile + 1);
+    lv_textarea_set_text(ui_TextArea3, profile_str);
+}
+
+void seleccionar_modelo(lv_event_t * e)
+{
+    uint16_t opcion = lv_dropdown_get_selected(ui_DropdownModelo);
+    if (!settings_calibration_mode || opcion >= modelos_count) {
+        return;
+    }
+    
+    if (activar_perfil(modelos[opcion])) {
+        mostrar_modelo_activo(modelos[opcion]);
+    }
+}
+
+// Modelo nuevo con valores por defecto y nombre "Modelo N"; pasa a ser el activo
+void crear_modelo(lv_event_t * e)
+{
+    if (!settings_calibration_mode) {
+        return;
+    }
+    
+    uint8_t profile;
+    if (!createModel(&profile)) {
+        settings_calibration_mode = false;
+        lv_label_set_text(ui_Label23, "No quedan modelos libres");
+        return;
+    }
+    
+    if (activar_perfil(profile)) {
+        mostrar_modelo_activo(profile);
+    }
+}
+
 void calibrate_posicion1(lv_event_t * e)
 {
     if (palanca1_calibration_mode) {
@@ -428,6 +557,13 @@ void calibrate_posicion1(lv_event_t * e)
         sprintf(extra_str, "%d", current_extra_limits[0]);
         lv_textarea_set_text(ui_TextArea3, extra_str);
     }
+
+    if (curva_calibration_mode) {
+        // Siguiente canal: se descartan los cambios sin guardar del anterior
+        updateCurves();
+        cargar_curva((current_curva_canal + 1) % CURVA_CANALES);
+        mostrar_curva();
+    }
 }
 
 void calibrate_posicion2(lv_event_t * e)
@@ -473,6 +609,12 @@ void calibrate_posicion2(lv_event_t * e)
         sprintf(extra_str, "%d", current_extra_limits[1]);
         lv_textarea_set_text(ui_TextArea3, extra_str);
     }
+
+    if (curva_calibration_mode) {
+        current_curva_tipo = (current_curva_tipo + 1) % CURVA_TIPOS;
+        current_curva_punto = 0;
+        mostrar_curva();
+    }
 }
 
 void calibrate_posicion3(lv_event_t * e)
@@ -518,6 +660,11 @@ void calibrate_posicion3(lv_event_t * e)
         sprintf(extra_str, "%d", current_extra_limits[2]);
         lv_textarea_set_text(ui_TextArea3, extra_str);
     }
+
+    if (curva_calibration_mode && current_curva_tipo == CURVA_TIPO_PUNTOS) {
+        current_curva_punto = (current_curva_punto + 1) % CURVA_PUNTOS;
+        mostrar_curva();
+    }
 }
 
 void touch_calibrate(lv_event_t * e)
@@ -680,8 +827,20 @@ void cancelar_cambios(lv_event_t * e)
         canal_calibration_mode = false;
     }
 
+    if (curva_calibration_mode) {
+        // Volver a la curva guardada
+        updateCurves();
+        cargar_curva(current_curva_canal);
+        mostrar_curva();
+        curva_calibration_mode = false;
+    }
+
     if (settings_calibration_mode) {
-        setActiveProfile(original_active_profile);
+        if (!setActiveProfile(original_active_profile)) {
+            // No se pudo volver al perfil original: sigue el modo para reintentar
+            lv_label_set_text(ui_Label23, "Error al cambiar perfil");
+            return;
+        }
         
         char profile_str[4];
         sprintf(profile_str, "%d", original_active_profile);
@@ -772,6 +931,13 @@ void guardarCambios(lv_event_t * e)
         canal_calibration_mode = false;
     }
 
+    if (curva_calibration_mode) {
+        setCurve(current_curva_canal, current_curva_tipo, current_curva_cantidad, current_curva_puntos);
+        saveCurrentConfig();
+        updateCurves();
+        curva_calibration_mode = false;
+    }
+
     if (settings_calibration_mode) {
         saveCurrentConfig();
         
@@ -873,6 +1039,12 @@ void salir_configuracion(lv_event_t * e)
     intensidad_calibration_mode = false;
     canal_calibration_mode = false; // << añadido
     
+    // Una curva editada sin guardar vuelve a la guardada
+    if (curva_calibration_mode) {
+        updateCurves();
+        curva_calibration_mode = false;
+    }
+    
     // Aquí puedes agregar código para cambiar de pantalla o cerrar la configuración
     // Por ejemplo, si tienes una función para ir a la pantalla principal:
     // lv_scr_load(ui_Screen1);
@@ -35,6 +35,9 @@ void calibrate_intensidad2(lv_event_t * e);
 void calibrate_intensidad3(lv_event_t * e);
 void calibrate_intensidad4(lv_event_t * e);
 void calibrate_canal(lv_event_t * e);
+void calibrar_curva(lv_event_t * e);
+void seleccionar_modelo(lv_event_t * e);
+void crear_modelo(lv_event_t * e);
 
 #ifdef __cplusplus
 } /*extern "C"*/
@@ -0,0 +1,245 @@
+/**
+ * AnalogAcquisition Library Implementation
+ *
+ * Date: 2025
+ */
+
+#include "AnalogAcquisition.h"
+
+// Constructor
+AnalogAcquisition::AnalogAcquisition() {
+    _source = nullptr;
+    _sampleRateHz = ANALOG_ACQ_DEFAULT_RATE_HZ;
+    _running = false;
+
+    _channelCount = 0;
+    memset(_pins, 0, sizeof(_pins));
+    memset(_pinToChannel, ANALOG_ACQ_NO_CHANNEL, sizeof(_pinToChannel));
+
+    memset(_ring, 0, sizeof(_ring));
+    memset(_ringHead, 0, sizeof(_ringHead));
+    memset(_ringFill, 0, sizeof(_ringFill));
+    memset(_channelDirty, 0, sizeof(_channelDirty));
+    for (uint8_t i = 0; i < ANALOG_ACQ_MAX_CHANNELS; i++) {
+        _filtered[i] = 0;
+        _latest[i] = 0;
+    }
+
+    _outputBits = ANALOG_ACQ_OUTPUT_BITS;
+    _tolerance = 150; // Same outlier window the Joystick library uses
+    _statsMux = portMUX_INITIALIZER_UNLOCKED;
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+// Configuration
+bool AnalogAcquisition::addChannel(uint8_t pin) {
+    if (_running || pin >= ANALOG_ACQ_MAX_PIN || _channelCount >= ANALOG_ACQ_MAX_CHANNELS) {
+        return false;
+    }
+    if (_pinToChannel[pin] != ANALOG_ACQ_NO_CHANNEL) {
+        return true; // Already registered
+    }
+
+    _pins[_channelCount] = pin;
+    _pinToChannel[pin] = _channelCount;
+    _channelCount++;
+    return true;
+}
+
+void AnalogAcquisition::setOutputResolution(uint8_t bits) {
+    _outputBits = constrain(bits, 8, 16);
+}
+
+void AnalogAcquisition::setOutlierTolerance(int tolerance) {
+    _tolerance = tolerance;
+}
+
+// Control
+bool AnalogAcquisition::begin(AnalogSampleSource* source, uint32_t sampleRateHz) {
+    if (source == nullptr || _channelCount == 0) {
+        return false;
+    }
+
+    _source = source;
+    _sampleRateHz = sampleRateHz;
+
+    if (!_source->begin(_pins, _channelCount, _sampleRateHz)) {
+        Serial.println("AnalogAcquisition: Failed to start sample source");
+        _source = nullptr;
+        return false;
+    }
+
+    _running = true;
+
+    // Prime the buffers so read() returns real values right away
+    for (uint8_t attempt = 0; attempt < 10; attempt++) {
+        poll();
+        bool allFilled = true;
+        for (uint8_t i = 0; i < _channelCount; i++) {
+            if (_ringFill[i] == 0) allFilled = false;
+        }
+        if (allFilled) break;
+        delay(1);
+    }
+
+    return true;
+}
+
+void AnalogAcquisition::end() {
+    if (_source != nullptr) {
+        _source->end();
+    }
+    _running = false;
+}
+
+// Drain everything the source has buffered
+uint16_t AnalogAcquisition::poll() {
+    if (!_running) return 0;
+
+    uint32_t startUs = micros();
+    AnalogSample chunk[ANALOG_ACQ_READ_CHUNK];
+    uint16_t total = 0;
+    uint32_t unknownPins = 0;
+    uint8_t sourceBits = _source->getResolution();
+
+    for (;;) {
+        uint16_t count = _source->read(chunk, ANALOG_ACQ_READ_CHUNK);
+
+        for (uint16_t i = 0; i < count; i++) {
+            uint8_t pin = chunk[i].pin;
+            uint8_t channel = (pin < ANALOG_ACQ_MAX_PIN) ? _pinToChannel[pin] : ANALOG_ACQ_NO_CHANNEL;
+            if (channel == ANALOG_ACQ_NO_CHANNEL) {
+                unknownPins++;
+                continue;
+            }
+
+            uint16_t value = _scale(chunk[i].value, sourceBits);
+            _ring[channel][_ringHead[channel]] = value;
+            _ringHead[channel] = (_ringHead[channel] + 1) % ANALOG_ACQ_RING_SIZE;
+            if (_ringFill[channel] < ANALOG_ACQ_RING_SIZE) _ringFill[channel]++;
+            _channelDirty[channel] = true;
+            _latest[channel] = value;
+        }
+
+        total += count;
+        if (count < ANALOG_ACQ_READ_CHUNK) break; // Source drained
+    }
+
+    // Filter once per channel, not once per sample
+    for (uint8_t i = 0; i < _channelCount; i++) {
+        if (_channelDirty[i]) {
+            _updateFilter(i);
+            _channelDirty[i] = false;
+        }
+    }
+
+    uint32_t overflows = _source->getOverflowCount();
+    uint32_t elapsedUs = micros() - startUs;
+    portENTER_CRITICAL(&_statsMux);
+    _stats.samples += total;
+    _stats.polls++;
+    _stats.unknownPins += unknownPins;
+    _stats.overflows = overflows;
+    if (elapsedUs > _stats.maxPollUs) _stats.maxPollUs = elapsedUs;
+    portEXIT_CRITICAL(&_statsMux);
+
+    return total;
+}
+
+uint16_t AnalogAcquisition::_scale(uint16_t value, uint8_t sourceBits) {
+    if (sourceBits == _outputBits) return value;
+    if (sourceBits < _outputBits) return value << (_outputBits - sourceBits);
+    return value >> (sourceBits - _outputBits);
+}
+
+// Average of the ring, discarding samples far from the median.
+// The median (not the mean) is the reference so a single spike cannot
+// drag the window away from the real value.
+void AnalogAcquisition::_updateFilter(uint8_t channel) {
+    uint8_t fill = _ringFill[channel];
+    if (fill == 0) return;
+
+    uint16_t sorted[ANALOG_ACQ_RING_SIZE];
+    memcpy(sorted, _ring[channel], fill * sizeof(uint16_t));
+
+    // Insertion sort, the ring is tiny
+    for (uint8_t i = 1; i < fill; i++) {
+        uint16_t value = sorted[i];
+        int8_t j = i - 1;
+        while (j >= 0 && sorted[j] > value) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = value;
+    }
+    int median = sorted[fill / 2];
+
+    uint32_t validSum = 0;
+    uint8_t validCount = 0;
+    for (uint8_t i = 0; i < fill; i++) {
+        if (abs((int)sorted[i] - median) < _tolerance) {
+            validSum += sorted[i];
+            validCount++;
+        }
+    }
+
+    _filtered[channel] = (validCount == 0) ? median : validSum / validCount;
+}
+
+// Reading
+int AnalogAcquisition::read(uint8_t pin) {
+    uint8_t channel = getChannel(pin);
+    if (channel == ANALOG_ACQ_NO_CHANNEL) return -1;
+    return _filtered[channel];
+}
+
+int AnalogAcquisition::readLatest(uint8_t pin) {
+    uint8_t channel = getChannel(pin);
+    if (channel == ANALOG_ACQ_NO_CHANNEL) return -1;
+    return _latest[channel];
+}
+
+uint8_t AnalogAcquisition::getChannel(uint8_t pin) {
+    if (pin >= ANALOG_ACQ_MAX_PIN) return ANALOG_ACQ_NO_CHANNEL;
+    return _pinToChannel[pin];
+}
+
+int AnalogAcquisition::readPin(uint8_t pin, void* context) {
+    AnalogAcquisition* self = static_cast<AnalogAcquisition*>(context);
+    int value = self->isRunning() ? self->read(pin) : -1;
+    // Pins that are not part of the engine (or a stopped engine) fall back to a direct conversion
+    return (value >= 0) ? value : analogRead(pin);
+}
+
+// Statistics
+AnalogAcquisitionStats AnalogAcquisition::getStats() {
+    AnalogAcquisitionStats stats;
+    portENTER_CRITICAL(&_statsMux);
+    stats = _stats;
+    portEXIT_CRITICAL(&_statsMux);
+    return stats;
+}
+
+void AnalogAcquisition::resetStats() {
+    portENTER_CRITICAL(&_statsMux);
+    memset(&_stats, 0, sizeof(_stats));
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+void AnalogAcquisition::printStats() {
+    AnalogAcquisitionStats stats = getStats();
+
+    Serial.println("=== AnalogAcquisition ===");
+    Serial.print("Channels: "); Serial.print(_channelCount);
+    Serial.print("  Rate: "); Serial.print(_sampleRateHz); Serial.println(" Hz");
+    Serial.print("Samples: "); Serial.print(stats.samples);
+    Serial.print("  Polls: "); Serial.print(stats.polls);
+    Serial.print("  Overflows: "); Serial.print(stats.overflows);
+    Serial.print("  Unknown: "); Serial.print(stats.unknownPins);
+    Serial.print("  Max poll: "); Serial.print(stats.maxPollUs); Serial.println(" us");
+    for (uint8_t i = 0; i < _channelCount; i++) {
+        Serial.print("  Pin "); Serial.print(_pins[i]);
+        Serial.print(": "); Serial.print(_filtered[i]);
+        Serial.print(" (last "); Serial.print(_latest[i]); Serial.println(")");
+    }
+}
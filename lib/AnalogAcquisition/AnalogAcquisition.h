@@ -0,0 +1,139 @@
+/**
+ * AnalogAcquisition Library - Non-blocking analog input engine
+ *
+ * Collects samples for a fixed list of analog pins (joysticks, analog levers,
+ * battery) from a sample source, keeps a small ring buffer per channel and
+ * exposes the latest filtered value per pin without blocking the caller.
+ *
+ * Features:
+ * - Hardware abstraction (AnalogSampleSource): ESP32 continuous ADC/DMA,
+ *   polling analogRead() fallback, or a synthetic source for host builds
+ * - Ring buffer per channel with median-anchored outlier rejection
+ * - O(1) lookup by pin number
+ * - Lock-free reads: one writer (poll) and any number of readers
+ * - Plugs into Joystick/Lever through an AnalogReadFn callback
+ * - Throughput statistics (samples, polls, overflows, poll time)
+ *
+ * Date: 2025
+ */
+
+#ifndef ANALOG_ACQUISITION_H
+#define ANALOG_ACQUISITION_H
+
+#include <Arduino.h>
+
+#define ANALOG_ACQ_MAX_CHANNELS 8
+#define ANALOG_ACQ_RING_SIZE 16       // Samples kept per channel
+#define ANALOG_ACQ_READ_CHUNK 64      // Samples pulled from the source per read() call
+#define ANALOG_ACQ_MAX_PIN 64
+#define ANALOG_ACQ_NO_CHANNEL 0xFF
+#define ANALOG_ACQ_DEFAULT_RATE_HZ 20000
+
+// Resolution reported by read(), matches analogRead() on the target
+#if defined(CONFIG_IDF_TARGET_ESP32S2)
+#define ANALOG_ACQ_OUTPUT_BITS 13
+#else
+#define ANALOG_ACQ_OUTPUT_BITS 12
+#endif
+
+// One conversion result
+struct AnalogSample {
+    uint8_t pin;
+    uint16_t value;
+};
+
+// Hardware abstraction for anything that produces analog samples
+class AnalogSampleSource {
+public:
+    virtual ~AnalogSampleSource() {}
+
+    // Start converting the given pins at (approximately) the total sample rate
+    virtual bool begin(const uint8_t* pins, uint8_t count, uint32_t sampleRateHz) = 0;
+    virtual void end() = 0;
+
+    // Copy up to maxSamples pending conversions. Must never block.
+    virtual uint16_t read(AnalogSample* samples, uint16_t maxSamples) = 0;
+
+    // Native resolution of the values returned by read()
+    virtual uint8_t getResolution() = 0;
+
+    // Conversions lost by the source itself (e.g. DMA buffer overflow)
+    virtual uint32_t getOverflowCount() { return 0; }
+};
+
+// Signature used by Joystick/Lever to read a pin through the engine
+typedef int (*AnalogReadFn)(uint8_t pin, void* context);
+
+struct AnalogAcquisitionStats {
+    uint32_t samples;       // Samples consumed
+    uint32_t polls;         // poll() calls
+    uint32_t unknownPins;   // Samples for pins that are not registered
+    uint32_t overflows;     // Reported by the source
+    uint32_t maxPollUs;     // Longest poll() duration
+};
+
+class AnalogAcquisition {
+private:
+    AnalogSampleSource* _source;
+    uint32_t _sampleRateHz;
+    bool _running;
+
+    // Channel table
+    uint8_t _pins[ANALOG_ACQ_MAX_CHANNELS];
+    uint8_t _channelCount;
+    uint8_t _pinToChannel[ANALOG_ACQ_MAX_PIN];
+
+    // Per-channel ring buffers (written by poll() only)
+    uint16_t _ring[ANALOG_ACQ_MAX_CHANNELS][ANALOG_ACQ_RING_SIZE];
+    uint8_t _ringHead[ANALOG_ACQ_MAX_CHANNELS];
+    uint8_t _ringFill[ANALOG_ACQ_MAX_CHANNELS];
+    bool _channelDirty[ANALOG_ACQ_MAX_CHANNELS];
+
+    // Published values (16-bit stores are atomic, safe to read from any task)
+    volatile uint16_t _filtered[ANALOG_ACQ_MAX_CHANNELS];
+    volatile uint16_t _latest[ANALOG_ACQ_MAX_CHANNELS];
+
+    // Processing
+    uint8_t _outputBits;
+    int _tolerance;
+
+    // Statistics (written by poll() in the control task, read and reset from loop())
+    portMUX_TYPE _statsMux;
+    AnalogAcquisitionStats _stats;
+
+    uint16_t _scale(uint16_t value, uint8_t sourceBits);
+    void _updateFilter(uint8_t channel);
+
+public:
+    AnalogAcquisition();
+
+    // Configuration (before begin)
+    bool addChannel(uint8_t pin);
+    void setOutputResolution(uint8_t bits);
+    void setOutlierTolerance(int tolerance);
+
+    // Control
+    bool begin(AnalogSampleSource* source, uint32_t sampleRateHz = ANALOG_ACQ_DEFAULT_RATE_HZ);
+    void end();
+    bool isRunning() { return _running; }
+
+    // Drain the source and refresh the filtered values. Never blocks.
+    uint16_t poll();
+
+    // Reading (lock-free)
+    int read(uint8_t pin);          // Filtered value, -1 if the pin is not registered
+    int readLatest(uint8_t pin);    // Most recent raw conversion
+    uint8_t getChannel(uint8_t pin);
+    uint8_t getChannelCount() { return _channelCount; }
+    uint8_t getOutputResolution() { return _outputBits; }
+
+    // Adapter for Joystick::setAnalogReader / Lever::setAnalogReader
+    static int readPin(uint8_t pin, void* context);
+
+    // Statistics
+    AnalogAcquisitionStats getStats();
+    void resetStats();
+    void printStats();
+};
+
+#endif // ANALOG_ACQUISITION_H
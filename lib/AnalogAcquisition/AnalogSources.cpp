@@ -0,0 +1,242 @@
+/**
+ * AnalogSources Implementation
+ *
+ * Date: 2025
+ */
+
+#include "AnalogSources.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+#include <driver/adc.h>
+
+// Output layout of the digital controller differs per target
+#if defined(CONFIG_IDF_TARGET_ESP32)
+#define ANALOG_DMA_CONV_LIMIT_EN 1
+#define ANALOG_DMA_OUTPUT_FORMAT ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ANALOG_DMA_CHANNEL(p) ((p)->type1.channel)
+#define ANALOG_DMA_DATA(p) ((p)->type1.data)
+#else
+#define ANALOG_DMA_CONV_LIMIT_EN 0
+#define ANALOG_DMA_OUTPUT_FORMAT ADC_DIGI_OUTPUT_FORMAT_TYPE2
+#define ANALOG_DMA_CHANNEL(p) ((p)->type2.channel)
+#define ANALOG_DMA_DATA(p) ((p)->type2.data)
+#endif
+
+// DMA source
+DmaAnalogSource::DmaAnalogSource() {
+    memset(_channelToPin, ANALOG_ACQ_NO_CHANNEL, sizeof(_channelToPin));
+    _overflows = 0;
+    _started = false;
+}
+
+bool DmaAnalogSource::begin(const uint8_t* pins, uint8_t count, uint32_t sampleRateHz) {
+    if (count == 0 || count > SOC_ADC_PATT_LEN_MAX) {
+        return false;
+    }
+
+    adc_digi_pattern_config_t pattern[SOC_ADC_PATT_LEN_MAX] = {};
+    uint16_t channelMask = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        int8_t channel = digitalPinToAnalogChannel(pins[i]);
+        // Only ADC1 can run in continuous mode alongside WiFi/ADC2 users
+        if (channel < 0 || channel >= ANALOG_DMA_MAX_ADC_CHANNELS) {
+            Serial.print("DmaAnalogSource: Pin ");
+            Serial.print(pins[i]);
+            Serial.println(" is not an ADC1 pin");
+            return false;
+        }
+
+        _channelToPin[channel] = pins[i];
+        channelMask |= (1 << channel);
+
+        pattern[i].atten = ADC_ATTEN_DB_11; // Same attenuation analogRead() uses
+        pattern[i].channel = channel;
+        pattern[i].unit = 0;                // ADC1
+        pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    }
+
+    adc_digi_init_config_t initConfig = {};
+    initConfig.max_store_buf_size = ANALOG_DMA_BUFFER_BYTES;
+    initConfig.conv_num_each_intr = ANALOG_DMA_FRAME_BYTES;
+    initConfig.adc1_chan_mask = channelMask;
+    initConfig.adc2_chan_mask = 0;
+
+    if (adc_digi_initialize(&initConfig) != ESP_OK) {
+        Serial.println("DmaAnalogSource: adc_digi_initialize failed");
+        return false;
+    }
+
+    adc_digi_configuration_t digiConfig = {};
+    digiConfig.conv_limit_en = ANALOG_DMA_CONV_LIMIT_EN;
+    digiConfig.conv_limit_num = 250;
+    digiConfig.pattern_num = count;
+    digiConfig.adc_pattern = pattern;
+    digiConfig.sample_freq_hz = constrain(sampleRateHz,
+                                          (uint32_t)SOC_ADC_SAMPLE_FREQ_THRES_LOW,
+                                          (uint32_t)SOC_ADC_SAMPLE_FREQ_THRES_HIGH);
+    digiConfig.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    digiConfig.format = ANALOG_DMA_OUTPUT_FORMAT;
+
+    if (adc_digi_controller_configure(&digiConfig) != ESP_OK ||
+        adc_digi_start() != ESP_OK) {
+        Serial.println("DmaAnalogSource: Failed to start continuous conversion");
+        adc_digi_deinitialize();
+        return false;
+    }
+
+    _started = true;
+    return true;
+}
+
+void DmaAnalogSource::end() {
+    if (_started) {
+        adc_digi_stop();
+        adc_digi_deinitialize();
+        _started = false;
+    }
+}
+
+uint16_t DmaAnalogSource::read(AnalogSample* samples, uint16_t maxSamples) {
+    if (!_started || maxSamples == 0) return 0;
+
+    uint8_t buffer[ANALOG_ACQ_READ_CHUNK * SOC_ADC_DIGI_RESULT_BYTES];
+    uint32_t maxBytes = (uint32_t)maxSamples * SOC_ADC_DIGI_RESULT_BYTES;
+    if (maxBytes > sizeof(buffer)) maxBytes = sizeof(buffer);
+
+    uint32_t length = 0;
+    // Timeout 0: only take what the DMA has already converted
+    esp_err_t result = adc_digi_read_bytes(buffer, maxBytes, &length, 0);
+    if (result == ESP_ERR_INVALID_STATE) {
+        _overflows++; // Data is still valid, the driver just dropped older frames
+    } else if (result != ESP_OK) {
+        return 0;
+    }
+
+    uint16_t count = 0;
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= length; i += SOC_ADC_DIGI_RESULT_BYTES) {
+        adc_digi_output_data_t* data = (adc_digi_output_data_t*)&buffer[i];
+        uint8_t channel = ANALOG_DMA_CHANNEL(data);
+        if (channel >= ANALOG_DMA_MAX_ADC_CHANNELS) continue;
+
+        uint8_t pin = _channelToPin[channel];
+        if (pin == ANALOG_ACQ_NO_CHANNEL) continue;
+
+        samples[count].pin = pin;
+        samples[count].value = ANALOG_DMA_DATA(data);
+        count++;
+    }
+
+    return count;
+}
+
+uint8_t DmaAnalogSource::getResolution() {
+    return SOC_ADC_DIGI_MAX_BITWIDTH;
+}
+
+#endif // ARDUINO_ARCH_ESP32
+
+// Polling source
+PollingAnalogSource::PollingAnalogSource() {
+    memset(_pins, 0, sizeof(_pins));
+    _count = 0;
+}
+
+bool PollingAnalogSource::begin(const uint8_t* pins, uint8_t count, uint32_t sampleRateHz) {
+    (void)sampleRateHz; // One conversion per channel on every read(), paced by the caller
+    if (count == 0 || count > ANALOG_ACQ_MAX_CHANNELS) {
+        return false;
+    }
+    memcpy(_pins, pins, count);
+    _count = count;
+    return true;
+}
+
+uint16_t PollingAnalogSource::read(AnalogSample* samples, uint16_t maxSamples) {
+    uint16_t count = 0;
+    for (uint8_t i = 0; i < _count && count < maxSamples; i++) {
+        samples[count].pin = _pins[i];
+        samples[count].value = analogRead(_pins[i]);
+        count++;
+    }
+    return count;
+}
+
+// Synthetic source
+SyntheticAnalogSource::SyntheticAnalogSource(uint8_t resolution) {
+    memset(_pins, 0, sizeof(_pins));
+    memset(_values, 0, sizeof(_values));
+    _count = 0;
+    _resolution = resolution;
+    _sampleRateHz = 0;
+    _lastAccrueUs = 0;
+    _pending = 0;
+    _overflows = 0;
+    _sampleIndex = 0;
+    _generator = nullptr;
+    _context = nullptr;
+}
+
+bool SyntheticAnalogSource::begin(const uint8_t* pins, uint8_t count, uint32_t sampleRateHz) {
+    if (count == 0 || count > ANALOG_ACQ_MAX_CHANNELS) {
+        return false;
+    }
+    memcpy(_pins, pins, count);
+    _count = count;
+    _sampleRateHz = sampleRateHz;
+    _lastAccrueUs = micros();
+    _pending = count; // One full frame available immediately
+    _overflows = 0;
+    _sampleIndex = 0;
+    return true;
+}
+
+void SyntheticAnalogSource::setValue(uint8_t pin, uint16_t value) {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_pins[i] == pin) {
+            _values[i] = value;
+            return;
+        }
+    }
+}
+
+void SyntheticAnalogSource::setGenerator(Generator generator, void* context) {
+    _generator = generator;
+    _context = context;
+}
+
+void SyntheticAnalogSource::queueSamples(uint32_t count) {
+    _pending += count;
+}
+
+uint16_t SyntheticAnalogSource::read(AnalogSample* samples, uint16_t maxSamples) {
+    if (_count == 0) return 0;
+
+    // Accrue the conversions the hardware would have produced since last call
+    uint32_t nowUs = micros();
+    uint32_t elapsedUs = nowUs - _lastAccrueUs;
+    uint32_t produced = (uint64_t)elapsedUs * _sampleRateHz / 1000000UL;
+    if (produced > 0) {
+        _pending += produced;
+        _lastAccrueUs += (uint64_t)produced * 1000000UL / _sampleRateHz;
+    }
+    if (_pending > ANALOG_SYNTHETIC_MAX_PENDING) {
+        _overflows += _pending - ANALOG_SYNTHETIC_MAX_PENDING;
+        _sampleIndex += _pending - ANALOG_SYNTHETIC_MAX_PENDING;
+        _pending = ANALOG_SYNTHETIC_MAX_PENDING;
+    }
+
+    uint16_t count = 0;
+    while (count < maxSamples && _pending > 0) {
+        uint8_t index = _sampleIndex % _count;
+        uint8_t pin = _pins[index];
+
+        samples[count].pin = pin;
+        samples[count].value = _generator ? _generator(pin, _sampleIndex, _context) : _values[index];
+        count++;
+        _sampleIndex++;
+        _pending--;
+    }
+    return count;
+}
@@ -0,0 +1,99 @@
+/**
+ * AnalogSources - Sample source backends for AnalogAcquisition
+ *
+ * Features:
+ * - DmaAnalogSource: ESP32 ADC1 continuous mode, conversions land in a DMA
+ *   buffer and read() only copies what is already there (ESP32 builds only)
+ * - PollingAnalogSource: one analogRead() per pin per read() call, used when
+ *   the continuous driver is not available
+ * - SyntheticAnalogSource: generated values for host builds, replays and
+ *   throughput measurements
+ *
+ * Date: 2025
+ */
+
+#ifndef ANALOG_SOURCES_H
+#define ANALOG_SOURCES_H
+
+#include <Arduino.h>
+#include "AnalogAcquisition.h"
+
+#define ANALOG_DMA_FRAME_BYTES 256     // Bytes converted per DMA interrupt
+#define ANALOG_DMA_BUFFER_BYTES 1024   // Driver-side ring buffer
+#define ANALOG_DMA_MAX_ADC_CHANNELS 10
+#define ANALOG_SYNTHETIC_MAX_PENDING (ANALOG_DMA_BUFFER_BYTES / 2)  // Mirrors the DMA buffer depth
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+// Continuous ADC1 conversion through the ESP-IDF digital controller (DMA)
+class DmaAnalogSource : public AnalogSampleSource {
+private:
+    uint8_t _channelToPin[ANALOG_DMA_MAX_ADC_CHANNELS];
+    uint32_t _overflows;
+    bool _started;
+
+public:
+    DmaAnalogSource();
+
+    bool begin(const uint8_t* pins, uint8_t count, uint32_t sampleRateHz) override;
+    void end() override;
+    uint16_t read(AnalogSample* samples, uint16_t maxSamples) override;
+    uint8_t getResolution() override;
+    uint32_t getOverflowCount() override { return _overflows; }
+};
+
+#endif // ARDUINO_ARCH_ESP32
+
+// Fallback: synchronous conversions, one sample per pin per call
+class PollingAnalogSource : public AnalogSampleSource {
+private:
+    uint8_t _pins[ANALOG_ACQ_MAX_CHANNELS];
+    uint8_t _count;
+
+public:
+    PollingAnalogSource();
+
+    bool begin(const uint8_t* pins, uint8_t count, uint32_t sampleRateHz) override;
+    void end() override {}
+    uint16_t read(AnalogSample* samples, uint16_t maxSamples) override;
+    uint8_t getResolution() override { return ANALOG_ACQ_OUTPUT_BITS; }
+};
+
+// Generated samples. Without a generator each pin returns its fixed value.
+class SyntheticAnalogSource : public AnalogSampleSource {
+public:
+    typedef uint16_t (*Generator)(uint8_t pin, uint32_t sampleIndex, void* context);
+
+private:
+    uint8_t _pins[ANALOG_ACQ_MAX_CHANNELS];
+    uint16_t _values[ANALOG_ACQ_MAX_CHANNELS];
+    uint8_t _count;
+    uint8_t _resolution;
+    uint32_t _sampleRateHz;
+    uint32_t _lastAccrueUs;
+    uint32_t _pending;
+    uint32_t _overflows;
+    uint32_t _sampleIndex;
+    Generator _generator;
+    void* _context;
+
+public:
+    SyntheticAnalogSource(uint8_t resolution = ANALOG_ACQ_OUTPUT_BITS);
+
+    bool begin(const uint8_t* pins, uint8_t count, uint32_t sampleRateHz) override;
+    void end() override {}
+    uint16_t read(AnalogSample* samples, uint16_t maxSamples) override;
+    uint8_t getResolution() override { return _resolution; }
+    uint32_t getOverflowCount() override { return _overflows; }
+
+    // Configuration
+    void setValue(uint8_t pin, uint16_t value);
+    void setGenerator(Generator generator, void* context = nullptr);
+
+    // Samples accrue with micros() at the configured rate, like the DMA buffer.
+    // queueSamples() adds extra ones on top, e.g. for throughput measurements.
+    void queueSamples(uint32_t count);
+    uint32_t getSampleIndex() { return _sampleIndex; }
+};
+
+#endif // ANALOG_SOURCES_H
@@ -0,0 +1,261 @@
+/**
+ * ConfigCodec Implementation
+ *
+ * Fecha: 2025
+ */
+
+#include "ConfigCodec.h"
+
+#define CONFIG_BLOB_MAGIC0 'C'
+#define CONFIG_BLOB_MAGIC1 'P'
+#define CONFIG_DIRECTORY_MAGIC1 'D'
+#define CONFIG_BLOB_CRC_OFFSET 5
+#define CONFIG_ADDRESS_SIZE 8
+#define CONFIG_DEFAULT_ADDRESS 0xE8E8F0F0E1LL
+
+// Campos guardados en values[]: etiqueta, primer índice, cuántos y valor por defecto
+struct ConfigField {
+    uint8_t tag;
+    uint8_t index;
+    uint8_t count;
+    uint8_t fallback;
+};
+
+static const ConfigField VALUE_FIELDS[] = {
+    {CONFIG_TAG_SPEED, 0, 3, 128},
+    {CONFIG_TAG_TURN, 3, 3, 128},
+    {CONFIG_TAG_BOOST, 6, 3, 128},
+    {CONFIG_TAG_EXTRA, 9, 3, 128},
+    {CONFIG_TAG_BRIGHTNESS, 12, 1, 128},
+    {CONFIG_TAG_EXTRA_CONFIG, 13, 1, 128},
+    {CONFIG_TAG_INTENSITY, 14, 1, 1},       // Los perfiles de 14 valores no la tenían
+};
+static const uint8_t VALUE_FIELD_COUNT = sizeof(VALUE_FIELDS) / sizeof(VALUE_FIELDS[0]);
+
+static_assert(CONFIG_VALUES_COUNT == 15, "Cada valor de values[] pertenece a un campo de VALUE_FIELDS");
+static_assert(sizeof(ResponseCurveConfig) <= 255, "Una curva cabe en un campo TLV");
+
+// ========== MIGRACIONES ==========
+
+// 0 -> 1: la intensidad de las claves sueltas se guardaba sin validar (0 = sin configurar)
+static void migrateLegacy(ConfigProfile& config) {
+    uint8_t& intensity = config.values[14];
+    if (intensity < 1) intensity = 1;
+    if (intensity > 4) intensity = 4;
+}
+
+// MIGRATIONS[v] lleva un perfil de la versión v a la v + 1
+typedef void (*ConfigMigration)(ConfigProfile& config);
+static const ConfigMigration MIGRATIONS[CONFIG_BLOB_VERSION] = {
+    migrateLegacy,
+};
+
+// ========== CODIFICACIÓN ==========
+
+static void putField(uint8_t* blob, uint16_t& length, uint8_t tag, const void* value, uint8_t size) {
+    blob[length++] = tag;
+    blob[length++] = size;
+    memcpy(blob + length, value, size);
+    length += size;
+}
+
+static void putLittleEndian(uint8_t* out, uint64_t value, uint8_t size) {
+    for (uint8_t i = 0; i < size; i++) {
+        out[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static uint64_t getLittleEndian(const uint8_t* in, uint8_t size) {
+    uint64_t value = 0;
+    for (uint8_t i = 0; i < size; i++) {
+        value |= (uint64_t)in[i] << (8 * i);
+    }
+    return value;
+}
+
+// Cabecera y CRC de un blob cuyos campos ya están tras CONFIG_BLOB_HEADER_SIZE
+static uint16_t sealBlob(uint8_t* blob, uint16_t length, uint8_t magic, uint8_t version) {
+    uint16_t fields = length - CONFIG_BLOB_HEADER_SIZE;
+    blob[0] = CONFIG_BLOB_MAGIC0;
+    blob[1] = magic;
+    blob[2] = version;
+    blob[3] = fields & 0xFF;
+    blob[4] = fields >> 8;
+
+    uint32_t crc = ConfigCodec::crc32(blob, CONFIG_BLOB_CRC_OFFSET);
+    crc = ConfigCodec::crc32(blob + CONFIG_BLOB_HEADER_SIZE, fields, crc);
+    putLittleEndian(blob + CONFIG_BLOB_CRC_OFFSET, crc, 4);
+    return length;
+}
+
+// Magia, longitud y CRC; devuelve la longitud de los campos (0 si no cuadran)
+static uint16_t checkBlob(const uint8_t* blob, size_t length, uint8_t magic) {
+    if (blob == nullptr || length <= CONFIG_BLOB_HEADER_SIZE ||
+        blob[0] != CONFIG_BLOB_MAGIC0 || blob[1] != magic) {
+        return 0;
+    }
+
+    uint16_t fields = blob[3] | (blob[4] << 8);
+    if (length != (size_t)CONFIG_BLOB_HEADER_SIZE + fields) {
+        return 0;
+    }
+
+    uint32_t crc = ConfigCodec::crc32(blob, CONFIG_BLOB_CRC_OFFSET);
+    if (ConfigCodec::crc32(blob + CONFIG_BLOB_HEADER_SIZE, fields, crc) !=
+        getLittleEndian(blob + CONFIG_BLOB_CRC_OFFSET, 4)) {
+        return 0;
+    }
+    return fields;
+}
+
+void ConfigCodec::defaults(ConfigProfile& config) {
+    memset(&config, 0, sizeof(config));
+    for (uint8_t f = 0; f < VALUE_FIELD_COUNT; f++) {
+        memset(config.values + VALUE_FIELDS[f].index, VALUE_FIELDS[f].fallback, VALUE_FIELDS[f].count);
+    }
+    config.address = CONFIG_DEFAULT_ADDRESS;
+    for (uint8_t i = 0; i < CONFIG_CURVES_COUNT; i++) {
+        ResponseCurve::defaultConfig(config.curves[i]);
+    }
+}
+
+uint16_t ConfigCodec::encode(const ConfigProfile& config, uint8_t blob[CONFIG_BLOB_MAX]) {
+    uint16_t length = CONFIG_BLOB_HEADER_SIZE;
+
+    for (uint8_t f = 0; f < VALUE_FIELD_COUNT; f++) {
+        putField(blob, length, VALUE_FIELDS[f].tag, config.values + VALUE_FIELDS[f].index, VALUE_FIELDS[f].count);
+    }
+
+    uint8_t address[CONFIG_ADDRESS_SIZE];
+    putLittleEndian(address, config.address, CONFIG_ADDRESS_SIZE);
+    putField(blob, length, CONFIG_TAG_ADDRESS, address, CONFIG_ADDRESS_SIZE);
+
+    for (uint8_t i = 0; i < CONFIG_CURVES_COUNT; i++) {
+        putField(blob, length, CONFIG_TAG_CURVE + i, &config.curves[i], sizeof(ResponseCurveConfig));
+    }
+    return sealBlob(blob, length, CONFIG_BLOB_MAGIC1, CONFIG_BLOB_VERSION);
+}
+
+bool ConfigCodec::decode(const uint8_t* blob, size_t length, ConfigProfile& config, uint8_t& version) {
+    uint16_t fields = checkBlob(blob, length, CONFIG_BLOB_MAGIC1);
+    if (fields == 0) {
+        return false;
+    }
+
+    // Los campos que falten se quedan con su valor por defecto
+    defaults(config);
+    version = blob[2];
+
+    const uint8_t* field = blob + CONFIG_BLOB_HEADER_SIZE;
+    const uint8_t* end = field + fields;
+    while (field + 2 <= end) {
+        uint8_t tag = field[0];
+        uint8_t size = field[1];
+        const uint8_t* value = field + 2;
+        if (value + size > end) {
+            return false;
+        }
+        field = value + size;
+
+        // Un campo más corto de lo esperado solo rellena su principio (más largo: se ignora el resto)
+        bool known = false;
+        for (uint8_t f = 0; f < VALUE_FIELD_COUNT && !known; f++) {
+            if (VALUE_FIELDS[f].tag == tag) {
+                memcpy(config.values + VALUE_FIELDS[f].index, value, min(size, VALUE_FIELDS[f].count));
+                known = true;
+            }
+        }
+        if (known) continue;
+
+        if (tag == CONFIG_TAG_ADDRESS && size == CONFIG_ADDRESS_SIZE) {
+            config.address = getLittleEndian(value, CONFIG_ADDRESS_SIZE);
+        } else if (tag >= CONFIG_TAG_CURVE && tag < CONFIG_TAG_CURVE + CONFIG_CURVES_COUNT &&
+                   size == sizeof(ResponseCurveConfig)) {
+            memcpy(&config.curves[tag - CONFIG_TAG_CURVE], value, size);
+        }
+        // Etiqueta desconocida (de una versión posterior): se salta
+    }
+    return field == end;
+}
+
+void ConfigCodec::decodeLegacy(const uint8_t* values, size_t count, ConfigProfile& config) {
+    defaults(config);
+    memcpy(config.values, values, min(count, (size_t)CONFIG_VALUES_COUNT));
+}
+
+bool ConfigCodec::upgrade(ConfigProfile& config, uint8_t version) {
+    if (version >= CONFIG_BLOB_VERSION) {
+        return false;
+    }
+    for (uint8_t v = version; v < CONFIG_BLOB_VERSION; v++) {
+        MIGRATIONS[v](config);
+    }
+    return true;
+}
+
+// ========== DIRECTORIO ==========
+
+uint16_t ConfigCodec::encodeDirectory(const ConfigDirectoryRecord& record, uint8_t blob[CONFIG_DIRECTORY_MAX]) {
+    uint16_t length = CONFIG_BLOB_HEADER_SIZE;
+    putField(blob, length, CONFIG_DIR_TAG_ACTIVE, &record.active, 1);
+
+    uint8_t model[CONFIG_MODEL_FIELD_SIZE + CONFIG_NAME_SIZE - 1];
+    for (uint8_t i = 0; i < MAX_PROFILES; i++) {
+        if (!(record.used & (1UL << i))) continue;
+        const ConfigModelInfo& info = record.models[i];
+        model[0] = i;
+        putLittleEndian(model + 1, info.lastUsed, 4);
+        putLittleEndian(model + 5, info.address, CONFIG_ADDRESS_SIZE);
+        model[13] = info.channel;
+        uint8_t nameLength = strnlen(info.name, CONFIG_NAME_SIZE - 1);
+        memcpy(model + CONFIG_MODEL_FIELD_SIZE, info.name, nameLength);
+        putField(blob, length, CONFIG_DIR_TAG_MODEL, model, CONFIG_MODEL_FIELD_SIZE + nameLength);
+    }
+    return sealBlob(blob, length, CONFIG_DIRECTORY_MAGIC1, CONFIG_DIRECTORY_VERSION);
+}
+
+bool ConfigCodec::decodeDirectory(const uint8_t* blob, size_t length, ConfigDirectoryRecord& record) {
+    uint16_t fields = checkBlob(blob, length, CONFIG_DIRECTORY_MAGIC1);
+    if (fields == 0) {
+        return false;
+    }
+
+    memset(&record, 0, sizeof(record));
+    const uint8_t* field = blob + CONFIG_BLOB_HEADER_SIZE;
+    const uint8_t* end = field + fields;
+    while (field + 2 <= end) {
+        uint8_t tag = field[0];
+        uint8_t size = field[1];
+        const uint8_t* value = field + 2;
+        if (value + size > end) {
+            return false;
+        }
+        field = value + size;
+
+        if (tag == CONFIG_DIR_TAG_ACTIVE && size >= 1) {
+            record.active = value[0];
+        } else if (tag == CONFIG_DIR_TAG_MODEL && size >= CONFIG_MODEL_FIELD_SIZE && value[0] < MAX_PROFILES) {
+            ConfigModelInfo& info = record.models[value[0]];
+            info.lastUsed = getLittleEndian(value + 1, 4);
+            info.address = getLittleEndian(value + 5, CONFIG_ADDRESS_SIZE);
+            info.channel = value[13];
+            memcpy(info.name, value + CONFIG_MODEL_FIELD_SIZE,
+                   min(size - CONFIG_MODEL_FIELD_SIZE, CONFIG_NAME_SIZE - 1));
+            record.used |= 1UL << value[0];
+        }
+        // Etiqueta desconocida (de una versión posterior): se salta
+    }
+    return field == end;
+}
+
+// CRC-32 (IEEE 802.3, reflejado), sin tabla: un perfil se codifica pocas veces
+uint32_t ConfigCodec::crc32(const uint8_t* data, size_t length, uint32_t crc) {
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+    }
+    return ~crc;
+}
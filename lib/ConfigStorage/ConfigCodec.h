@@ -0,0 +1,93 @@
+/**
+ * ConfigCodec - Formato en flash de un perfil y del directorio de modelos
+ *
+ * Cada perfil se guarda en una sola entrada de NVS ("p<n>"), legible en una
+ * lectura y protegida por CRC32. El directorio ("dir") usa la misma cabecera
+ * con otra magia.
+ *
+ * Formato (little endian):
+ *   0-1   Magia 'C' 'P' (perfil) o 'C' 'D' (directorio)
+ *   2     Versión del formato (CONFIG_BLOB_VERSION, CONFIG_DIRECTORY_VERSION)
+ *   3-4   Longitud de los campos
+ *   5-8   CRC32 (0xEDB88320) de la cabecera sin el CRC y de los campos
+ *   9...  Campos TLV: etiqueta (1 byte), longitud (1 byte), valor
+ *
+ * Los campos se describen en una tabla (etiqueta, posición en values[] y
+ * valor por defecto): un campo que no está en el blob toma su valor por
+ * defecto y una etiqueta desconocida se salta. Añadir un campo es añadir
+ * una fila; los perfiles guardados antes lo cargan con su valor por defecto.
+ * Los cambios de significado de un campo van en la tabla de migraciones,
+ * que lleva un perfil de cualquier versión anterior a la actual.
+ *
+ * Versiones del perfil:
+ *   0  Claves sueltas "p<n>v" (14 o 15 bytes), "p<n>a" y "p<n>c"
+ *   1  Blob TLV
+ *
+ * Directorio (versión 1): un campo con el perfil activo y uno por modelo
+ * guardado (perfil, último uso, dirección, canal y nombre sin terminador).
+ *
+ * Fecha: 2025
+ */
+
+#ifndef CONFIG_CODEC_H
+#define CONFIG_CODEC_H
+
+#include <Arduino.h>
+#include "ConfigProfile.h"
+
+#define CONFIG_BLOB_VERSION 1
+#define CONFIG_BLOB_HEADER_SIZE 9
+#define CONFIG_BLOB_MAX 128         // Todos los campos actuales ocupan 84 bytes
+
+#define CONFIG_DIRECTORY_VERSION 1
+#define CONFIG_MODEL_FIELD_SIZE 14  // Campo de un modelo sin el nombre
+#define CONFIG_DIRECTORY_MAX (CONFIG_BLOB_HEADER_SIZE + 3 + \
+                              MAX_PROFILES * (2 + CONFIG_MODEL_FIELD_SIZE + CONFIG_NAME_SIZE - 1))
+
+// Etiquetas de los campos (nunca se reutiliza una retirada)
+enum ConfigTag {
+    CONFIG_TAG_SPEED = 0x01,        // Límites de velocidad (values 0-2)
+    CONFIG_TAG_TURN = 0x02,         // Límites de giro (values 3-5)
+    CONFIG_TAG_BOOST = 0x03,        // Límites de boost (values 6-8)
+    CONFIG_TAG_EXTRA = 0x04,        // Límites adicionales (values 9-11)
+    CONFIG_TAG_BRIGHTNESS = 0x05,   // Brillo (values 12)
+    CONFIG_TAG_EXTRA_CONFIG = 0x06, // Configuración adicional (values 13)
+    CONFIG_TAG_INTENSITY = 0x07,    // Intensidad 1-4 (values 14)
+    CONFIG_TAG_ADDRESS = 0x08,      // Dirección NRF24L01 (8 bytes)
+    CONFIG_TAG_CURVE = 0x10         // Curva de ch1-ch4: 0x10 + canal
+};
+
+// Etiquetas de los campos del directorio
+enum ConfigDirectoryTag {
+    CONFIG_DIR_TAG_ACTIVE = 0x01,   // Perfil activo (1 byte)
+    CONFIG_DIR_TAG_MODEL = 0x02     // Perfil, último uso (4), dirección (8), canal y nombre
+};
+
+class ConfigCodec {
+public:
+    // Perfil con el valor por defecto de cada campo (el de un campo que falta en el blob)
+    static void defaults(ConfigProfile& config);
+
+    // Blob de la versión actual; devuelve su longitud
+    static uint16_t encode(const ConfigProfile& config, uint8_t blob[CONFIG_BLOB_MAX]);
+
+    // Campos del blob sobre los valores por defecto. Devuelve false si la
+    // cabecera o el CRC no cuadran; version recibe la versión del blob.
+    static bool decode(const uint8_t* blob, size_t length, ConfigProfile& config, uint8_t& version);
+
+    // Perfil en el formato de claves sueltas (versión 0): values por posición
+    static void decodeLegacy(const uint8_t* values, size_t count, ConfigProfile& config);
+
+    // Aplica las migraciones desde version hasta CONFIG_BLOB_VERSION.
+    // Devuelve true si el perfil cambió de versión (hay que reescribirlo).
+    static bool upgrade(ConfigProfile& config, uint8_t version);
+
+    // Directorio de modelos: solo los perfiles con su bit en used
+    static uint16_t encodeDirectory(const ConfigDirectoryRecord& record, uint8_t blob[CONFIG_DIRECTORY_MAX]);
+    // False si la cabecera o el CRC no cuadran (hay que reconstruirlo desde los perfiles)
+    static bool decodeDirectory(const uint8_t* blob, size_t length, ConfigDirectoryRecord& record);
+
+    static uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc = 0);
+};
+
+#endif // CONFIG_CODEC_H
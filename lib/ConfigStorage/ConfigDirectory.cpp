@@ -0,0 +1,191 @@
+/**
+ * ConfigDirectory Implementation
+ *
+ * Fecha: 2025
+ */
+
+#include "ConfigDirectory.h"
+
+ConfigDirectory::ConfigDirectory() {
+    clear();
+}
+
+void ConfigDirectory::clear() {
+    memset(&record, 0, sizeof(record));
+    namedCount = 0;
+    count = 0;
+    useCounter = 0;
+}
+
+void ConfigDirectory::load(const ConfigDirectoryRecord& source) {
+    record = source;
+    if (record.active >= MAX_PROFILES) record.active = 0;
+
+    useCounter = 0;
+    for (uint8_t i = 0; i < MAX_PROFILES; i++) {
+        if (!contains(i)) {
+            memset(&record.models[i], 0, sizeof(ConfigModelInfo));
+            continue;
+        }
+        record.models[i].name[CONFIG_NAME_SIZE - 1] = '\0';
+        if (record.models[i].lastUsed > useCounter) useCounter = record.models[i].lastUsed;
+    }
+    rebuildIndex();
+}
+
+const ConfigModelInfo* ConfigDirectory::get(uint8_t profile) const {
+    return contains(profile) ? &record.models[profile] : nullptr;
+}
+
+bool ConfigDirectory::update(uint8_t profile, uint64_t address, uint8_t channel) {
+    if (profile >= MAX_PROFILES) {
+        return false;
+    }
+
+    ConfigModelInfo& info = record.models[profile];
+    if (contains(profile) && info.address == address && info.channel == channel) {
+        return false;
+    }
+    if (!contains(profile)) {
+        memset(&info, 0, sizeof(info));
+        record.used |= 1UL << profile;
+    }
+    info.address = address;
+    info.channel = channel;
+    rebuildIndex();
+    return true;
+}
+
+bool ConfigDirectory::setName(uint8_t profile, const char* name) {
+    if (!contains(profile) || name == nullptr) {
+        return false;
+    }
+
+    char trimmed[CONFIG_NAME_SIZE];
+    strncpy(trimmed, name, CONFIG_NAME_SIZE - 1);
+    trimmed[CONFIG_NAME_SIZE - 1] = '\0';
+
+    uint8_t owner = findByName(trimmed);
+    if (owner != CONFIG_NO_PROFILE && owner != profile) {
+        return false;
+    }
+    memcpy(record.models[profile].name, trimmed, CONFIG_NAME_SIZE);
+    rebuildIndex();
+    return true;
+}
+
+void ConfigDirectory::remove(uint8_t profile) {
+    if (!contains(profile)) {
+        return;
+    }
+    record.used &= ~(1UL << profile);
+    memset(&record.models[profile], 0, sizeof(ConfigModelInfo));
+    rebuildIndex();
+}
+
+void ConfigDirectory::setActive(uint8_t profile) {
+    if (profile >= MAX_PROFILES) {
+        return;
+    }
+    record.active = profile;
+    if (contains(profile)) {
+        record.models[profile].lastUsed = ++useCounter;
+    }
+}
+
+// ========== BÚSQUEDAS ==========
+
+uint8_t ConfigDirectory::findByName(const char* name) const {
+    if (name == nullptr || name[0] == '\0') {
+        return CONFIG_NO_PROFILE;
+    }
+
+    // Primer nombre >= name
+    uint8_t low = 0;
+    uint8_t high = namedCount;
+    while (low < high) {
+        uint8_t middle = (low + high) / 2;
+        if (strncmp(record.models[byName[middle]].name, name, CONFIG_NAME_SIZE) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low < namedCount && strncmp(record.models[byName[low]].name, name, CONFIG_NAME_SIZE) == 0) {
+        return byName[low];
+    }
+    return CONFIG_NO_PROFILE;
+}
+
+// Varios modelos con la misma dirección: el de número más bajo
+uint8_t ConfigDirectory::findByAddress(uint64_t address) const {
+    uint8_t low = 0;
+    uint8_t high = count;
+    while (low < high) {
+        uint8_t middle = (low + high) / 2;
+        if (record.models[byAddress[middle]].address < address) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low < count && record.models[byAddress[low]].address == address) {
+        return byAddress[low];
+    }
+    return CONFIG_NO_PROFILE;
+}
+
+uint8_t ConfigDirectory::findFree() const {
+    for (uint8_t i = 0; i < MAX_PROFILES; i++) {
+        if (!contains(i)) return i;
+    }
+    return CONFIG_NO_PROFILE;
+}
+
+uint8_t ConfigDirectory::getRecent(uint8_t* profiles, uint8_t max) const {
+    if (profiles == nullptr) {
+        return 0;
+    }
+
+    // Inserción ordenada por lastUsed: la lista es corta y se pide desde la UI
+    uint8_t found = 0;
+    for (uint8_t i = 0; i < MAX_PROFILES; i++) {
+        if (!contains(i)) continue;
+        uint32_t lastUsed = record.models[i].lastUsed;
+        uint8_t position = found < max ? found : max;
+        while (position > 0 && record.models[profiles[position - 1]].lastUsed < lastUsed) {
+            if (position < max) profiles[position] = profiles[position - 1];
+            position--;
+        }
+        if (position < max) profiles[position] = i;
+        if (found < max) found++;
+    }
+    return found;
+}
+
+// ========== ÍNDICES ==========
+
+// Inserción: como mucho MAX_PROFILES entradas y solo al dar de alta o renombrar
+void ConfigDirectory::rebuildIndex() {
+    namedCount = 0;
+    count = 0;
+    for (uint8_t i = 0; i < MAX_PROFILES; i++) {
+        if (!contains(i)) continue;
+        const ConfigModelInfo& info = record.models[i];
+
+        uint8_t position = count++;
+        while (position > 0 && record.models[byAddress[position - 1]].address > info.address) {
+            byAddress[position] = byAddress[position - 1];
+            position--;
+        }
+        byAddress[position] = i;
+
+        if (info.name[0] == '\0') continue;
+        position = namedCount++;
+        while (position > 0 && strncmp(record.models[byName[position - 1]].name, info.name, CONFIG_NAME_SIZE) > 0) {
+            byName[position] = byName[position - 1];
+            position--;
+        }
+        byName[position] = i;
+    }
+}
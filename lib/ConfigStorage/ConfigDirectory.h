@@ -0,0 +1,69 @@
+/**
+ * ConfigDirectory - Directorio de modelos de ConfigStorage
+ *
+ * Una entrada pequeña por modelo guardado (nombre, dirección NRF24, canal y
+ * último uso) que se lee entera en begin() con una sola lectura de flash;
+ * los perfiles completos se leen solo al seleccionarlos. Arrancar no cuesta
+ * más con más modelos guardados.
+ *
+ * Características:
+ * - Búsqueda por nombre y por dirección en O(log n): índices ordenados que
+ *   se rehacen solo al dar de alta, renombrar o cambiar la dirección
+ * - Nombres únicos (los modelos sin nombre no entran en el índice)
+ * - Lista de los modelos usados más recientemente (contador de usos)
+ * - El registro (ConfigDirectoryRecord) es lo que ConfigCodec guarda en "dir"
+ *
+ * Fecha: 2025
+ */
+
+#ifndef CONFIG_DIRECTORY_H
+#define CONFIG_DIRECTORY_H
+
+#include <Arduino.h>
+#include "ConfigProfile.h"
+
+class ConfigDirectory {
+private:
+    ConfigDirectoryRecord record;
+    uint8_t byName[MAX_PROFILES];           // Modelos con nombre, ordenados por nombre
+    uint8_t byAddress[MAX_PROFILES];        // Todos los modelos, ordenados por dirección
+    uint8_t namedCount;
+    uint8_t count;
+    uint32_t useCounter;                    // Último lastUsed dado
+
+    void rebuildIndex();
+
+public:
+    ConfigDirectory();
+
+    void clear();
+    // Registro leído de flash (o reconstruido): rehace los índices
+    void load(const ConfigDirectoryRecord& source);
+    const ConfigDirectoryRecord& getRecord() const { return record; }
+
+    bool contains(uint8_t profile) const {
+        return profile < MAX_PROFILES && (record.used & (1UL << profile));
+    }
+    uint8_t getCount() const { return count; }
+    // nullptr si el perfil no está guardado
+    const ConfigModelInfo* get(uint8_t profile) const;
+
+    // Alta o cambio de dirección/canal; true si el registro cambió
+    bool update(uint8_t profile, uint64_t address, uint8_t channel);
+    // Nombre único (recortado a CONFIG_NAME_SIZE - 1); false si otro modelo ya lo usa
+    bool setName(uint8_t profile, const char* name);
+    // Baja (perfil ilegible en flash: se trata como vacío)
+    void remove(uint8_t profile);
+    // Perfil activo y marca de uso
+    void setActive(uint8_t profile);
+    uint8_t getActive() const { return record.active; }
+
+    // Búsquedas: CONFIG_NO_PROFILE si no hay ninguno
+    uint8_t findByName(const char* name) const;
+    uint8_t findByAddress(uint64_t address) const;
+    uint8_t findFree() const;
+    // Hasta max perfiles, del usado más recientemente al menos; devuelve cuántos
+    uint8_t getRecent(uint8_t* profiles, uint8_t max) const;
+};
+
+#endif // CONFIG_DIRECTORY_H
@@ -0,0 +1,50 @@
+/**
+ * ConfigProfile - Perfil de configuración guardado por ConfigStorage
+ *
+ * Compartido por ConfigStorage (caché en RAM), ConfigDirectory (índice de
+ * modelos) y ConfigWriter (escritura en flash en segundo plano).
+ *
+ * Fecha: 2025
+ */
+
+#ifndef CONFIG_PROFILE_H
+#define CONFIG_PROFILE_H
+
+#include <Arduino.h>
+#include <ResponseCurve.h>
+
+// Configuración de la librería
+#define MAX_PROFILES 32         // Modelos guardados (0-31), uno por vehículo
+#define CONFIG_CACHE_SIZE 4     // Perfiles completos en RAM (los usados más recientemente)
+#define CONFIG_VALUES_COUNT 15  // Número de valores uint8_t por perfil (ahora 15 para incluir intensidad)
+#define CONFIG_CURVES_COUNT 4   // Curvas de respuesta por perfil (ch1-ch4)
+#define CONFIG_COMMIT_DELAY_MS 2000 // Sin cambios durante este tiempo: se escribe en flash
+#define CONFIG_KEY_SIZE 8       // "p<n>v" + terminador
+#define CONFIG_NAME_SIZE 12     // Nombre del modelo: 11 caracteres + terminador
+#define CONFIG_NO_PROFILE 0xFF  // Búsqueda sin resultado
+
+static_assert(MAX_PROFILES <= 32, "Un bit por perfil en las máscaras de uint32_t");
+
+// Estructura para un perfil de configuración
+struct ConfigProfile {
+    uint8_t values[CONFIG_VALUES_COUNT];  // 14 valores de 0-255
+    uint64_t address;                     // 1 valor tipo dirección NRF24L01
+    ResponseCurveConfig curves[CONFIG_CURVES_COUNT];  // Curvas de respuesta de ch1-ch4
+};
+
+// Entrada del directorio: lo necesario para listar y buscar un modelo sin leer su perfil
+struct ConfigModelInfo {
+    uint64_t address;                     // Copia de ConfigProfile::address
+    uint32_t lastUsed;                    // Contador de usos: mayor = usado más recientemente
+    char name[CONFIG_NAME_SIZE];          // "" = sin nombre
+    uint8_t channel;                      // Canal de radio (values[13])
+};
+
+// Directorio de modelos: lo único que se lee de todos los modelos en begin()
+struct ConfigDirectoryRecord {
+    uint32_t used;                        // Un bit por perfil guardado
+    uint8_t active;                       // Perfil activo
+    ConfigModelInfo models[MAX_PROFILES];
+};
+
+#endif // CONFIG_PROFILE_H
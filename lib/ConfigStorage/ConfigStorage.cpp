@@ -8,7 +8,23 @@
 
 // Constructor
 ConfigStorage::ConfigStorage() {
+    started = false;
     activeProfile = 0;
+    directoryDirty = false;
+    cacheTick = 0;
+    lastChangeMs = 0;
+    commitDelayMs = CONFIG_COMMIT_DELAY_MS;
+    writeCallback = nullptr;
+    writeContext = nullptr;
+    
+    for (uint8_t i = 0; i < CONFIG_CACHE_SIZE; i++) {
+        cache[i].profile = CONFIG_NO_PROFILE;
+        cache[i].dirty = false;
+        cache[i].lastUse = 0;
+        defaultConfig(cache[i].config);
+    }
+    memset(inFlight, 0, sizeof(inFlight));
+    resetStats();
     
     // Inicializar configuración por defecto
     resetCurrentConfig();
@@ -19,18 +35,22 @@ ConfigStorage::ConfigStorage() {
 bool ConfigStorage::begin() {
     // Inicializar Preferences
     bool success = preferences.begin("config", false);
+    started = success;
     
     if (success) {
-        // Cargar perfil activo guardado (si existe)
-        activeProfile = preferences.getUChar("active", 0);
+        writer.begin(&preferences);
         
-        // Asegurar que el perfil activo esté en rango válido
-        if (activeProfile >= MAX_PROFILES) {
-            activeProfile = 0;
-            preferences.putUChar("active", activeProfile);
+        // Directorio: una sola lectura, haya los modelos que haya
+        if (readDirectory()) {
+            for (uint8_t i = 0; i < MAX_PROFILES; i++) {
+                if (directory.contains(i)) writer.setStored(i, true, false);
+            }
+        } else {
+            rebuildDirectory();
         }
+        activeProfile = directory.getActive();
         
-        // Cargar configuración del perfil activo
+        // Solo el perfil activo pasa a RAM; los demás, al seleccionarlos
         bool configLoaded = loadCurrentConfig();
         
         // Si no se pudo cargar, usar valores por defecto
@@ -38,16 +58,145 @@ bool ConfigStorage::begin() {
             resetCurrentConfig();
             saveCurrentConfig(); // Guardar los valores por defecto
         }
+        
+        // Directorio reconstruido, valores por defecto o migraciones: a flash ya
+        if (isDirty()) {
+            flush();
+        }
     }
     
     return success;
 }
 
 void ConfigStorage::end() {
+    flush();
+    writer.end();
     preferences.end();
+    started = false;
     Serial.println("ConfigStorage cerrado");
 }
 
+// ========== ESCRITURA EN FLASH ==========
+
+bool ConfigStorage::startWriter(UBaseType_t priority, uint32_t stackSize) {
+    if (!started) {
+        return false;
+    }
+    return writer.startTask(priority, stackSize);
+}
+
+bool ConfigStorage::poll(uint32_t nowMs) {
+    uint32_t startUs = micros();
+    bool queued = false;
+    
+    if (isDirty() && nowMs - lastChangeMs >= commitDelayMs) {
+        queueWrites();
+        // Sin tarea de escritura se escribe aquí mismo
+        if (!writer.hasTask()) writer.process();
+        queued = true;
+    }
+    collectWrites();
+    
+    uint32_t elapsedUs = micros() - startUs;
+    if (elapsedUs > stats.maxPollUs) stats.maxPollUs = elapsedUs;
+    return queued;
+}
+
+bool ConfigStorage::flush(uint32_t timeoutMs) {
+    if (!started) {
+        return false;
+    }
+    
+    uint32_t startUs = micros();
+    if (isDirty()) {
+        queueWrites();
+    }
+    if (!writer.hasTask()) {
+        writer.process();
+    } else {
+        // Con la cola llena queda algo sin encolar: se encola al ir vaciándose
+        uint32_t startMs = millis();
+        while ((!writer.isIdle() || isDirty()) && millis() - startMs < timeoutMs) {
+            delay(1);
+            collectWrites();
+            if (isDirty()) queueWrites();
+        }
+    }
+    collectWrites();
+    
+    uint32_t elapsedUs = micros() - startUs;
+    if (elapsedUs > stats.maxPollUs) stats.maxPollUs = elapsedUs;
+    return !hasPendingWrites();
+}
+
+void ConfigStorage::queueWrites() {
+    ConfigWriteRequest request;
+    
+    request.kind = CONFIG_WRITE_PROFILE;
+    for (uint8_t i = 0; i < CONFIG_CACHE_SIZE; i++) {
+        CacheSlot& slot = cache[i];
+        if (!slot.dirty) continue;
+        request.profile = slot.profile;
+        request.config = slot.config;
+        if (!writer.submit(request)) {
+            stats.queueFull++;
+            return;
+        }
+        slot.dirty = false;
+        inFlight[slot.profile]++;
+    }
+    
+    // El directorio, después de los perfiles: nunca lista uno sin escribir
+    if (directoryDirty) {
+        writer.publishDirectory(directory.getRecord());
+        request.kind = CONFIG_WRITE_DIRECTORY;
+        request.profile = activeProfile;
+        if (!writer.submit(request)) {
+            stats.queueFull++;
+            return;
+        }
+        directoryDirty = false;
+    }
+    stats.commits++;
+}
+
+void ConfigStorage::collectWrites() {
+    writer.collect(onWriteResult, this);
+}
+
+void ConfigStorage::onWriteResult(const ConfigWriteResult& result, void* context) {
+    ConfigStorage* self = static_cast<ConfigStorage*>(context);
+    uint32_t latencyUs = micros() - result.queuedUs;
+    
+    self->stats.keysWritten += result.keys;
+    self->stats.bytesWritten += result.bytes;
+    if (result.writeUs > self->stats.maxWriteUs) self->stats.maxWriteUs = result.writeUs;
+    if (latencyUs > self->stats.maxLatencyUs) self->stats.maxLatencyUs = latencyUs;
+    
+    if (result.kind == CONFIG_WRITE_PROFILE && self->inFlight[result.profile] > 0) {
+        self->inFlight[result.profile]--;
+    }
+    
+    if (!result.success) {
+        self->stats.writeErrors++;
+        // Se reintenta tras otro periodo sin cambios. El perfil sigue en la caché (en
+        // escritura no sale de ella); el directorio, por si se escribió sin él.
+        if (result.kind == CONFIG_WRITE_PROFILE) {
+            CacheSlot* slot = self->findSlot(result.profile);
+            if (slot != nullptr) self->markDirty(*slot);
+        }
+        if (result.kind != CONFIG_WRITE_CLEAR) {
+            self->markDirectoryDirty();
+        }
+        Serial.print("❌ ConfigStorage: error escribiendo en flash (perfil ");
+        Serial.print(result.profile); Serial.println(")");
+    }
+    
+    if (self->writeCallback != nullptr) {
+        self->writeCallback(result, self->writeContext);
+    }
+}
+
 // ========== GESTIÓN DE PERFILES ==========
 
 bool ConfigStorage::setActiveProfile(uint8_t profile) {
@@ -57,29 +206,47 @@ bool ConfigStorage::setActiveProfile(uint8_t profile) {
     
     // Solo guardar configuración actual si estamos cambiando de perfil
     if (activeProfile != profile) {
-        // Guardar configuración del perfil actual
-        saveCurrentConfig();
+        uint32_t startUs = micros();
         
-        // Cambiar perfil activo
-        activeProfile = profile;
-        
-        // Guardar INMEDIATAMENTE el nuevo perfil activo en flash
-        bool activeSaved = preferences.putUChar("active", activeProfile);
+        // Guardar configuración del perfil actual (en RAM)
+        saveCurrentConfig();
         
-        if (!activeSaved) {
-            // Si no se pudo guardar, revertir el cambio
-            activeProfile = (activeProfile == 0) ? profile : activeProfile;
+        // Sitio en la caché para el nuevo perfil (de flash si no está) antes de cambiar:
+        // si la caché no se pudo vaciar (escritura fallida o flash ocupada) se queda el
+        // actual, nunca valores por defecto en lugar de un modelo guardado
+        CacheSlot* slot = nullptr;
+        ConfigLoadStatus status = directory.contains(profile) ? loadSlot(profile, slot) : CONFIG_LOAD_MISSING;
+        if (status == CONFIG_LOAD_MISSING) {
+            slot = allocSlot(profile);
+            if (slot == nullptr) status = CONFIG_LOAD_BUSY;
+        }
+        if (status == CONFIG_LOAD_BUSY) {
+            stats.failedSwitches++;
+            Serial.print("❌ ConfigStorage: no se puede cambiar al perfil "); Serial.println(profile);
             return false;
         }
         
-        // Cargar configuración del nuevo perfil
-        bool configLoaded = loadCurrentConfig();
+        // Cambiar perfil activo
+        activeProfile = profile;
         
-        if (!configLoaded) {
+        if (status == CONFIG_LOAD_OK) {
+            currentConfig = slot->config;
+        } else {
             // Si no existe configuración para este perfil, crear una por defecto
             resetCurrentConfig();
-            saveCurrentConfig();
+            slot->config = currentConfig;
+            markDirty(*slot);
+            directory.update(profile, currentConfig.address, currentConfig.values[13]);
+            markDirectoryDirty();
         }
+        
+        // Perfil activo y último uso en el directorio; llegan a flash con el próximo commit
+        directory.setActive(profile);
+        markDirectoryDirty();
+        
+        uint32_t elapsedUs = micros() - startUs;
+        stats.switches++;
+        if (elapsedUs > stats.maxSwitchUs) stats.maxSwitchUs = elapsedUs;
     }
     
     return true;
@@ -99,77 +266,51 @@ bool ConfigStorage::loadCurrentConfig() {
     return loadConfigFromProfile(activeProfile);
 }
 
+// Solo RAM: la flash se escribe en poll()/flush()
 bool ConfigStorage::saveConfigToProfile(uint8_t profile) {
     if (profile >= MAX_PROFILES) {
         return false;
     }
     
-    // Generar claves para este perfil
-    String valuesKey = getProfileKey(profile);
-    String addressKey = getAddressKey(profile);
-    
-    // Guardar los 15 valores uint8_t como array
-    size_t written = preferences.putBytes(valuesKey.c_str(), currentConfig.values, CONFIG_VALUES_COUNT);
-    
-    // Guardar la dirección uint64_t
-    bool addressSaved = preferences.putULong64(addressKey.c_str(), currentConfig.address);
-    
-    bool success = (written == CONFIG_VALUES_COUNT) && addressSaved;
-    
-    if (success) {
-        Serial.print("✅ Configuración guardada en perfil ");
-        Serial.print(profile);
-        Serial.print(" ("); Serial.print(written); Serial.println(" bytes)");
-        
-        // Mostrar algunos valores guardados para debug
-        Serial.print("🔍 Valores guardados: [");
-        Serial.print(currentConfig.values[0]); Serial.print(",");
-        Serial.print(currentConfig.values[12]); Serial.print(",");
-        Serial.print(currentConfig.values[14]); Serial.println("]");
-    } else {
-        Serial.print("❌ Error guardando en perfil ");
-        Serial.print(profile);
-        Serial.print(" - Escritos: "); Serial.print(written);
-        Serial.print("/"); Serial.print(CONFIG_VALUES_COUNT);
-        Serial.print(" Addr: "); Serial.println(addressSaved ? "OK" : "FAIL");
+    stats.saves++;
+    CacheSlot* slot = nullptr;
+    if (directory.contains(profile) && loadSlot(profile, slot) == CONFIG_LOAD_BUSY) {
+        return false;
+    }
+    if (slot != nullptr && sameProfile(slot->config, currentConfig)) {
+        // Varios guardados seguidos en un mismo toque de la UI: nada nuevo
+        stats.unchangedSaves++;
+        return true;
     }
     
-    return success;
+    // Perfil nuevo: alta en la caché y en el directorio
+    if (slot == nullptr) {
+        slot = allocSlot(profile);
+        if (slot == nullptr) {
+            return false;
+        }
+    }
+    slot->config = currentConfig;
+    markDirty(*slot);
+    if (directory.update(profile, currentConfig.address, currentConfig.values[13])) {
+        markDirectoryDirty();
+    }
+    return true;
 }
 
 bool ConfigStorage::loadConfigFromProfile(uint8_t profile) {
-    if (profile >= MAX_PROFILES) {
+    if (profile >= MAX_PROFILES || !directory.contains(profile)) {
+        // Si no existe configuración, retornar false
+        // El caller debe usar resetCurrentConfig() y saveCurrentConfig()
         return false;
     }
     
-    // Generar claves para este perfil
-    String valuesKey = getProfileKey(profile);
-    String addressKey = getAddressKey(profile);
-    
-    // Intentar cargar los 15 valores uint8_t
-    size_t bytesRead = preferences.getBytes(valuesKey.c_str(), currentConfig.values, CONFIG_VALUES_COUNT);
-    
-    // Cargar la dirección uint64_t (valor por defecto si no existe)
-    currentConfig.address = preferences.getULong64(addressKey.c_str(), 0xE8E8F0F0E1LL);
-    
-    bool success = (bytesRead == CONFIG_VALUES_COUNT);
-    
-    // Si no se leyeron 15 valores, puede ser un perfil con 14 valores (versión anterior)
-    if (!success && bytesRead == 14) {
-        // Migración automática: establecer valor por defecto para intensidad (índice 14)
-        currentConfig.values[14] = 1;  // Intensidad por defecto = 1
-        
-        // Guardar el perfil migrado inmediatamente
-        saveConfigToProfile(profile);
-        success = true;
-    }
-    else if (!success || bytesRead == 0) {
-        // Si no existe configuración o está vacía, retornar false
-        // El caller debe usar resetCurrentConfig() y saveCurrentConfig()
+    CacheSlot* slot = nullptr;
+    if (loadSlot(profile, slot) != CONFIG_LOAD_OK) {
         return false;
     }
-    
-    return success;
+    currentConfig = slot->config;
+    return true;
 }
 
 // ========== ACCESO A DATOS ==========
@@ -220,22 +361,9 @@ void ConfigStorage::resetProfile(uint8_t profile) {
         return;
     }
     
-    // Crear configuración por defecto
-    ConfigProfile defaultConfig;
-    
-    // Valores por defecto para los 14 uint8_t
-    for (uint8_t i = 0; i < CONFIG_VALUES_COUNT; i++) {
-        defaultConfig.values[i] = 128; // Valor medio (50%)
-    }
-    
-    // Dirección por defecto
-    defaultConfig.address = 0xE8E8F0F0E1LL;
-    
-    // Guardar temporalmente la config actual
+    // Configuración por defecto: valores medios (50%), dirección por defecto y curvas lineales
     ConfigProfile temp = currentConfig;
-    
-    // Aplicar config por defecto y guardar
-    currentConfig = defaultConfig;
+    defaultConfig(currentConfig);
     saveConfigToProfile(profile);
     
     // Restaurar config actual
@@ -282,6 +410,9 @@ void ConfigStorage::resetCurrentConfig() {
     // Dirección por defecto NRF24L01
     currentConfig.address = 0xE8E8F0F0E1LL;
     
+    // Curvas de respuesta lineales (mismo mapeo que sin curvas)
+    resetCurves(currentConfig.curves);
+    
     Serial.println("✅ Configuración reseteada con valores por defecto");
 }
 
@@ -292,10 +423,8 @@ bool ConfigStorage::isProfileEmpty(uint8_t profile) {
         return true;
     }
     
-    String valuesKey = getProfileKey(profile);
-    
-    // Verificar si existe la clave de valores
-    return !preferences.isKey(valuesKey.c_str());
+    // Guardado en flash o pendiente de escribir
+    return !directory.contains(profile);
 }
 
 void ConfigStorage::printCurrentConfig() {
@@ -357,8 +486,17 @@ bool ConfigStorage::quickSave(uint8_t profile, uint8_t values[CONFIG_VALUES_COUN
         return false;
     }
     
-    // Crear configuración temporal
+    // Crear configuración temporal: las curvas del perfil no se tocan
     ConfigProfile tempConfig;
+    CacheSlot* slot = nullptr;
+    if (directory.contains(profile) && loadSlot(profile, slot) == CONFIG_LOAD_BUSY) {
+        return false;
+    }
+    if (slot != nullptr) {
+        tempConfig = slot->config;
+    } else {
+        defaultConfig(tempConfig);
+    }
     
     // Copiar valores
     for (uint8_t i = 0; i < CONFIG_VALUES_COUNT; i++) {
@@ -558,6 +696,25 @@ uint8_t ConfigStorage::getExtraConfig() {
     return currentConfig.values[13];
 }
 
+// CURVAS DE RESPUESTA
+void ConfigStorage::setCurve(uint8_t channel, const ResponseCurveConfig& curve) {
+    if (channel < CONFIG_CURVES_COUNT) {
+        currentConfig.curves[channel] = curve;
+        Serial.print("✅ Curva ch"); Serial.print(channel + 1);
+        Serial.print(": "); Serial.print(ResponseCurve::typeName(curve.type));
+        Serial.print(" "); Serial.println(curve.amount);
+    }
+}
+
+ResponseCurveConfig ConfigStorage::getCurve(uint8_t channel) {
+    if (channel < CONFIG_CURVES_COUNT) {
+        return currentConfig.curves[channel];
+    }
+    ResponseCurveConfig linear;
+    ResponseCurve::defaultConfig(linear);
+    return linear;
+}
+
 // DIRECCIÓN NRF24L01
 void ConfigStorage::setNRFAddress(uint64_t address) {
     currentConfig.address = address;
@@ -575,7 +732,88 @@ uint8_t ConfigStorage::getActiveProfileNumber() {
 }
 
 String ConfigStorage::getActiveProfileName() {
-    return "Perfil " + String(activeProfile);
+    return getProfileName(activeProfile);
+}
+
+// ========== MODELOS (DIRECTORIO) ==========
+
+uint8_t ConfigStorage::getProfileCount() {
+    return directory.getCount();
+}
+
+bool ConfigStorage::getProfileInfo(uint8_t profile, ConfigModelInfo& info) {
+    const ConfigModelInfo* entry = directory.get(profile);
+    if (entry == nullptr) {
+        return false;
+    }
+    info = *entry;
+    return true;
+}
+
+String ConfigStorage::getProfileName(uint8_t profile) {
+    const ConfigModelInfo* entry = directory.get(profile);
+    if (entry != nullptr && entry->name[0] != '\0') {
+        return String(entry->name);
+    }
+    return "Perfil " + String(profile);
+}
+
+bool ConfigStorage::setProfileName(uint8_t profile, const char* name) {
+    if (!directory.setName(profile, name)) {
+        Serial.print("❌ ConfigStorage: no se puede renombrar el perfil ");
+        Serial.print(profile); Serial.println(" (vacío o nombre en uso)");
+        return false;
+    }
+    markDirectoryDirty();
+    return true;
+}
+
+uint8_t ConfigStorage::createProfile(const char* name) {
+    // Sin nombre no se crea: no se podría encontrar con findProfileByName()
+    if (name == nullptr || name[0] == '\0') {
+        Serial.println("❌ ConfigStorage: el modelo nuevo necesita nombre");
+        return CONFIG_NO_PROFILE;
+    }
+    
+    // El directorio guarda el nombre recortado: se comprueba ya recortado
+    char trimmed[CONFIG_NAME_SIZE];
+    strncpy(trimmed, name, CONFIG_NAME_SIZE - 1);
+    trimmed[CONFIG_NAME_SIZE - 1] = '\0';
+    
+    uint8_t profile = directory.findFree();
+    if (profile == CONFIG_NO_PROFILE || directory.findByName(trimmed) != CONFIG_NO_PROFILE) {
+        Serial.println("❌ ConfigStorage: sin perfiles libres o nombre en uso");
+        return CONFIG_NO_PROFILE;
+    }
+    
+    // Mismos valores por defecto que un perfil activo nuevo
+    ConfigProfile backup = currentConfig;
+    resetCurrentConfig();
+    bool success = saveConfigToProfile(profile);
+    currentConfig = backup;
+    if (!success) {
+        return CONFIG_NO_PROFILE;
+    }
+    
+    if (!directory.setName(profile, trimmed)) {
+        // Un modelo sin nombre no se da de alta
+        directory.remove(profile);
+        markDirectoryDirty();
+        return CONFIG_NO_PROFILE;
+    }
+    return profile;
+}
+
+uint8_t ConfigStorage::findProfileByName(const char* name) {
+    return directory.findByName(name);
+}
+
+uint8_t ConfigStorage::findProfileByAddress(uint64_t address) {
+    return directory.findByAddress(address);
+}
+
+uint8_t ConfigStorage::getRecentProfiles(uint8_t* profiles, uint8_t max) {
+    return directory.getRecent(profiles, max);
 }
 
 void ConfigStorage::printActiveConfig() {
@@ -629,12 +867,230 @@ void ConfigStorage::reloadActiveConfig() {
 
 // ========== FUNCIONES PRIVADAS ==========
 
-String ConfigStorage::getProfileKey(uint8_t profile) {
-    return "p" + String(profile) + "v"; // "p0v", "p1v", etc.
+bool ConfigStorage::readDirectory() {
+    if (!preferences.isKey("dir")) {
+        return false;
+    }
+    
+    uint8_t blob[CONFIG_DIRECTORY_MAX];
+    size_t length = preferences.getBytes("dir", blob, sizeof(blob));
+    ConfigDirectoryRecord record;
+    if (length == 0 || !ConfigCodec::decodeDirectory(blob, length, record)) {
+        Serial.println("❌ ConfigStorage: directorio dañado, se reconstruye desde los perfiles");
+        return false;
+    }
+    directory.load(record);
+    return true;
 }
 
-String ConfigStorage::getAddressKey(uint8_t profile) {
-    return "p" + String(profile) + "a"; // "p0a", "p1a", etc.
+// Primer arranque con esta versión (claves sueltas o un blob por perfil sin directorio),
+// flash vacía o directorio dañado: se leen todos los perfiles, una sola vez
+void ConfigStorage::rebuildDirectory() {
+    stats.rebuilds++;
+    directory.clear();
+    
+    for (uint8_t i = 0; i < MAX_PROFILES; i++) {
+        ConfigProfile config;
+        bool blob = false;
+        bool legacy = false;
+        bool rewrite = false;
+        if (!readProfile(i, config, blob, legacy, rewrite)) {
+            continue;
+        }
+        writer.setStored(i, blob, legacy);
+        directory.update(i, config.address, config.values[13]);
+        
+        // Los que hay que reescribir se quedan en la caché hasta escribirlos
+        if (rewrite) {
+            CacheSlot* slot = allocSlot(i);
+            if (slot == nullptr) continue;
+            slot->config = config;
+            markDirty(*slot);
+        }
+    }
+    
+    // Perfil activo de antes del directorio (clave "active"; se borra al escribirlo)
+    directory.setActive(preferences.isKey("active") ? preferences.getUChar("active", 0) : 0);
+    markDirectoryDirty();
+}
+
+bool ConfigStorage::readProfile(uint8_t profile, ConfigProfile& config, bool& blob, bool& legacy, bool& rewrite) {
+    char blobKey[CONFIG_KEY_SIZE];
+    char valuesKey[CONFIG_KEY_SIZE];
+    ConfigWriter::makeKey(blobKey, profile, 0);
+    ConfigWriter::makeKey(valuesKey, profile, 'v');
+    legacy = preferences.isKey(valuesKey);
+    
+    // Una sola lectura: el blob entero (getBytes devuelve su longitud)
+    uint8_t data[CONFIG_BLOB_MAX];
+    size_t length = preferences.isKey(blobKey) ? preferences.getBytes(blobKey, data, sizeof(data)) : 0;
+    uint8_t version = 0;
+    bool found = false;
+    
+    if (length > 0) {
+        found = ConfigCodec::decode(data, length, config, version);
+        if (!found) {
+            stats.corruptProfiles++;
+            Serial.print("❌ ConfigStorage: perfil "); Serial.print(profile);
+            Serial.println(legacy ? " dañado, se usan las claves anteriores" : " dañado (CRC)");
+        }
+    }
+    blob = found;
+    if (!found && legacy) {
+        found = readLegacyProfile(profile, config);
+        version = 0;
+    }
+    if (!found) {
+        return false;
+    }
+    
+    // Versión anterior o claves sueltas que quedan: se reescribe en la versión actual
+    bool upgraded = ConfigCodec::upgrade(config, version);
+    rewrite = upgraded || legacy || version != CONFIG_BLOB_VERSION;
+    return true;
+}
+
+// Versión 0: "p<n>v" (14 o 15 valores), "p<n>a" y "p<n>c" (puede faltar: curvas lineales)
+bool ConfigStorage::readLegacyProfile(uint8_t profile, ConfigProfile& config) {
+    char valuesKey[CONFIG_KEY_SIZE];
+    char addressKey[CONFIG_KEY_SIZE];
+    char curvesKey[CONFIG_KEY_SIZE];
+    ConfigWriter::makeKey(valuesKey, profile, 'v');
+    ConfigWriter::makeKey(addressKey, profile, 'a');
+    ConfigWriter::makeKey(curvesKey, profile, 'c');
+    
+    uint8_t values[CONFIG_VALUES_COUNT];
+    size_t count = preferences.getBytes(valuesKey, values, sizeof(values));
+    if (count == 0) {
+        return false;
+    }
+    // Los valores que falten (perfiles de 14) toman el valor por defecto de su campo
+    ConfigCodec::decodeLegacy(values, count, config);
+    config.address = preferences.getULong64(addressKey, config.address);
+    
+    const size_t size = sizeof(config.curves);
+    if (preferences.getBytesLength(curvesKey) != size ||
+        preferences.getBytes(curvesKey, config.curves, size) != size) {
+        resetCurves(config.curves);
+    }
+    return true;
+}
+
+void ConfigStorage::resetCurves(ResponseCurveConfig curves[CONFIG_CURVES_COUNT]) {
+    for (uint8_t i = 0; i < CONFIG_CURVES_COUNT; i++) {
+        ResponseCurve::defaultConfig(curves[i]);
+    }
+}
+
+// Perfil por defecto de resetProfile(): valores medios (50%)
+void ConfigStorage::defaultConfig(ConfigProfile& config) {
+    memset(&config, 0, sizeof(config));
+    for (uint8_t i = 0; i < CONFIG_VALUES_COUNT; i++) {
+        config.values[i] = 128;
+    }
+    config.address = 0xE8E8F0F0E1LL;
+    resetCurves(config.curves);
+}
+
+// Campo a campo: el relleno entre values y address no cuenta
+bool ConfigStorage::sameProfile(const ConfigProfile& a, const ConfigProfile& b) {
+    return memcmp(a.values, b.values, sizeof(a.values)) == 0 && a.address == b.address &&
+           memcmp(a.curves, b.curves, sizeof(a.curves)) == 0;
+}
+
+// ========== CACHÉ DE PERFILES ==========
+
+ConfigStorage::CacheSlot* ConfigStorage::findSlot(uint8_t profile) {
+    for (uint8_t i = 0; i < CONFIG_CACHE_SIZE; i++) {
+        if (cache[i].profile == profile) return &cache[i];
+    }
+    return nullptr;
+}
+
+ConfigStorage::CacheSlot* ConfigStorage::allocSlot(uint8_t profile) {
+    CacheSlot* victim = nullptr;
+    for (uint8_t attempt = 0; attempt < 2 && victim == nullptr; attempt++) {
+        for (uint8_t i = 0; i < CONFIG_CACHE_SIZE; i++) {
+            CacheSlot& slot = cache[i];
+            if (slot.profile == CONFIG_NO_PROFILE) {
+                victim = &slot;
+                break;
+            }
+            // Ni el perfil activo ni uno cuya última versión aún no está en flash
+            if (slot.profile == activeProfile || slot.dirty || inFlight[slot.profile] > 0) continue;
+            if (victim == nullptr || slot.lastUse < victim->lastUse) victim = &slot;
+        }
+        // Todos pendientes de escribir: se escriben ya (solo al recorrer muchos modelos
+        // editándolos en menos de commitDelayMs)
+        if (victim == nullptr && attempt == 0) flush();
+    }
+    if (victim == nullptr) {
+        Serial.println("❌ ConfigStorage: caché llena de perfiles sin escribir");
+        return nullptr;
+    }
+    
+    if (victim->profile != CONFIG_NO_PROFILE) stats.evictions++;
+    victim->profile = profile;
+    victim->dirty = false;
+    victim->lastUse = ++cacheTick;
+    return victim;
+}
+
+ConfigLoadStatus ConfigStorage::loadSlot(uint8_t profile, CacheSlot*& slot) {
+    slot = findSlot(profile);
+    if (slot != nullptr) {
+        stats.cacheHits++;
+        slot->lastUse = ++cacheTick;
+        return CONFIG_LOAD_OK;
+    }
+    
+    slot = allocSlot(profile);
+    if (slot == nullptr) {
+        return CONFIG_LOAD_BUSY;
+    }
+    
+    // Lectura diferida: la primera vez que se selecciona desde begin()
+    uint32_t startUs = micros();
+    bool blob = false;
+    bool legacy = false;
+    bool rewrite = false;
+    bool found = readProfile(profile, slot->config, blob, legacy, rewrite);
+    uint32_t elapsedUs = micros() - startUs;
+    stats.cacheMisses++;
+    if (elapsedUs > stats.maxLoadUs) stats.maxLoadUs = elapsedUs;
+    
+    if (!found) {
+        // En el directorio pero ilegible: se trata como vacío (como en begin())
+        slot->profile = CONFIG_NO_PROFILE;
+        slot = nullptr;
+        directory.remove(profile);
+        markDirectoryDirty();
+        return CONFIG_LOAD_MISSING;
+    }
+    if (rewrite) {
+        markDirty(*slot);
+    }
+    return CONFIG_LOAD_OK;
+}
+
+void ConfigStorage::markDirty(CacheSlot& slot) {
+    slot.dirty = true;
+    lastChangeMs = millis();
+}
+
+void ConfigStorage::markDirectoryDirty() {
+    directoryDirty = true;
+    lastChangeMs = millis();
+}
+
+bool ConfigStorage::isDirty() {
+    if (directoryDirty) {
+        return true;
+    }
+    for (uint8_t i = 0; i < CONFIG_CACHE_SIZE; i++) {
+        if (cache[i].dirty) return true;
+    }
+    return false;
 }
 
 // CONFIGURACIÓN DE INTENSIDAD (índice 14)
@@ -667,22 +1123,27 @@ uint8_t ConfigStorage::getIntensityLimit() {
 void ConfigStorage::clearAllProfiles() {
     Serial.println("🗑️  Limpiando todos los perfiles...");
     
-    for (uint8_t i = 0; i < MAX_PROFILES; i++) {
-        String valuesKey = getProfileKey(i);
-        String addressKey = getAddressKey(i);
-        
-        preferences.remove(valuesKey.c_str());
-        preferences.remove(addressKey.c_str());
-        
-        Serial.print("✅ Perfil ");
-        Serial.print(i);
-        Serial.println(" limpiado");
+    // Detrás de lo ya encolado: nada escrito antes puede reaparecer después
+    ConfigWriteRequest request;
+    request.kind = CONFIG_WRITE_CLEAR;
+    request.profile = 0;
+    if (!writer.submit(request)) {
+        flush();
+        writer.submit(request);
+    }
+    if (!writer.hasTask()) {
+        writer.process();
     }
     
-    // Limpiar perfil activo también
-    preferences.remove("active");
+    // La caché y el directorio también quedan vacíos (nada pendiente de escribir)
+    for (uint8_t i = 0; i < CONFIG_CACHE_SIZE; i++) {
+        cache[i].profile = CONFIG_NO_PROFILE;
+        cache[i].dirty = false;
+    }
+    directory.clear();
+    directoryDirty = false;
     
-    // Resetear configuración actual
+    // Resetear configuración actual (sin directorio se arranca en el perfil 0)
     resetCurrentConfig();
     activeProfile = 0;
     
@@ -719,4 +1180,38 @@ bool ConfigStorage::repairProfile(uint8_t profile) {
     }
     
     return success;
-}
\ No newline at end of file
+}
+
+// ========== ESTADÍSTICAS ==========
+
+void ConfigStorage::resetStats() {
+    memset(&stats, 0, sizeof(stats));
+}
+
+void ConfigStorage::printStats() {
+    Serial.print("ConfigStorage: guardados "); Serial.print(stats.saves);
+    Serial.print(" ("); Serial.print(stats.unchangedSaves); Serial.print(" sin cambios), cambios de perfil ");
+    Serial.print(stats.switches); Serial.print(" (máx "); Serial.print(stats.maxSwitchUs);
+    Serial.print(" us, "); Serial.print(stats.failedSwitches); Serial.println(" rechazados)");
+    
+    Serial.print("ConfigStorage: modelos "); Serial.print(directory.getCount());
+    Serial.print(", caché "); Serial.print(stats.cacheHits);
+    Serial.print(" aciertos, "); Serial.print(stats.cacheMisses);
+    Serial.print(" lecturas (máx "); Serial.print(stats.maxLoadUs);
+    Serial.print(" us), expulsados "); Serial.print(stats.evictions);
+    Serial.print(", dañados "); Serial.print(stats.corruptProfiles);
+    Serial.print(", directorio reconstruido "); Serial.println(stats.rebuilds);
+    
+    Serial.print("ConfigStorage: escrituras en flash "); Serial.print(stats.commits);
+    Serial.print(", claves "); Serial.print(stats.keysWritten);
+    Serial.print(", bytes "); Serial.print(stats.bytesWritten);
+    Serial.print(", errores "); Serial.print(stats.writeErrors);
+    Serial.print(", cola llena "); Serial.print(stats.queueFull);
+    Serial.println(hasPendingWrites() ? " (pendiente)" : "");
+    
+    // Con tarea de escritura el loop() solo espera a encolar (máx poll); sin ella, a la escritura
+    Serial.print("ConfigStorage: "); Serial.print(writer.hasTask() ? "en segundo plano" : "en el loop");
+    Serial.print(", escritura máx "); Serial.print(stats.maxWriteUs);
+    Serial.print(" us, latencia máx "); Serial.print(stats.maxLatencyUs);
+    Serial.print(" us, poll máx "); Serial.print(stats.maxPollUs); Serial.println(" us");
+}
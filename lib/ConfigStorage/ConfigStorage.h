@@ -4,9 +4,25 @@
  * Librería simple para guardar configuraciones con Preferences.h
  * 
  * Características:
- * - 4 perfiles de configuración (0-3)
+ * - MAX_PROFILES modelos (0-31), cada uno con nombre opcional
  * - Cada perfil tiene: 14 valores uint8_t + 1 valor uint64_t
- * - Selector de perfil activo
+ * - Curvas de respuesta de ch1-ch4 por perfil
+ * - Un blob versionado con CRC32 por perfil (ConfigCodec): una lectura por
+ *   perfil; los perfiles de versiones anteriores (también las claves sueltas
+ *   "p<n>v"/"p<n>a"/"p<n>c") se migran y se reescriben
+ * - Directorio de modelos (ConfigDirectory): nombre, dirección, canal y
+ *   último uso de todos; es lo único que begin() lee de todos los modelos,
+ *   con búsqueda por nombre y por dirección en O(log n)
+ * - Selector de perfil activo (guardado en el directorio)
+ * - Caché LRU en RAM de CONFIG_CACHE_SIZE perfiles: un perfil se lee de
+ *   flash la primera vez que se selecciona; cambiar entre los usados
+ *   recientemente y guardar trabajan en RAM
+ * - Escritura diferida: los perfiles modificados se escriben juntos tras
+ *   CONFIG_COMMIT_DELAY_MS sin cambios (poll()) o con flush(), solo los
+ *   que cambiaron y el directorio al final
+ * - Escritura en segundo plano (startWriter()): una tarea de ConfigWriter
+ *   escribe lo encolado y poll() entrega los resultados al callback
+ * - Estadísticas: guardados, caché, escrituras en flash y tiempos (printStats())
  * - Funciones súper simples
  * 
  * Autor: GitHub Copilot
@@ -18,40 +34,146 @@
 
 #include <Arduino.h>
 #include <Preferences.h>
+#include "ConfigProfile.h"
+#include "ConfigCodec.h"
+#include "ConfigDirectory.h"
+#include "ConfigWriter.h"
 
-// Configuración de la librería
-#define MAX_PROFILES 4          // Número de perfiles (0-3)
-#define CONFIG_VALUES_COUNT 15  // Número de valores uint8_t por perfil (ahora 15 para incluir intensidad)
+// Resultado de cargar un perfil en la caché
+enum ConfigLoadStatus {
+    CONFIG_LOAD_OK,
+    CONFIG_LOAD_MISSING,        // No está en el directorio o está dañado en flash
+    CONFIG_LOAD_BUSY            // Caché llena de perfiles sin escribir (error o flash ocupada)
+};
 
-// Estructura para un perfil de configuración
-struct ConfigProfile {
-    uint8_t values[CONFIG_VALUES_COUNT];  // 14 valores de 0-255
-    uint64_t address;                     // 1 valor tipo dirección NRF24L01
+// Estadísticas de la caché y de las escrituras en flash (desde el arranque)
+struct ConfigStorageStats {
+    uint32_t saves;             // saveConfigToProfile() y equivalentes
+    uint32_t unchangedSaves;    // Guardados idénticos a lo que ya había: sin escritura
+    uint32_t switches;          // Cambios de perfil activo
+    uint32_t maxSwitchUs;       // Cambio de perfil más lento
+    uint32_t failedSwitches;    // Cambios rechazados: sin sitio en la caché para el perfil
+    uint32_t cacheHits;         // Perfil ya en RAM al seleccionarlo o leerlo
+    uint32_t cacheMisses;       // Perfil leído de flash
+    uint32_t evictions;         // Perfiles sacados de la caché (el usado hace más tiempo)
+    uint32_t maxLoadUs;         // Lectura de un perfil desde flash más lenta
+    uint32_t commits;           // Escrituras agrupadas encoladas
+    uint32_t queueFull;         // Cola de ConfigWriter llena: se reintenta en el próximo poll()
+    uint32_t keysWritten;       // Claves de Preferences escritas
+    uint32_t bytesWritten;
+    uint32_t writeErrors;
+    uint32_t maxWriteUs;        // Escritura más lenta (en la tarea de escritura si la hay)
+    uint32_t maxLatencyUs;      // De encolar a terminar de escribir
+    uint32_t maxPollUs;         // poll()/flush() más lento: lo que se detiene el loop()
+    uint32_t corruptProfiles;   // Blobs con cabecera o CRC erróneos
+    uint32_t rebuilds;          // Directorio reconstruido desde los perfiles (sin "dir" o dañado)
 };
 
 // Clase principal de almacenamiento
 class ConfigStorage {
 private:
     Preferences preferences;
+    bool started;
     uint8_t activeProfile;
-    ConfigProfile currentConfig;
+    ConfigProfile currentConfig;            // Configuración en edición (perfil activo)
+    
+    // Todos los modelos guardados (en flash o pendientes), en RAM desde begin()
+    ConfigDirectory directory;
+    bool directoryDirty;                    // Pendiente de encolar (también el perfil activo)
+    
+    // Caché LRU de perfiles completos; el activo siempre está en ella
+    struct CacheSlot {
+        uint8_t profile;                    // CONFIG_NO_PROFILE = libre
+        bool dirty;                         // Pendiente de encolar
+        uint32_t lastUse;                   // cacheTick del último acceso
+        ConfigProfile config;
+    };
+    CacheSlot cache[CONFIG_CACHE_SIZE];
+    uint32_t cacheTick;
+    // Escrituras encoladas sin resultado: el perfil no sale de la caché (en flash
+    // todavía está la versión anterior)
+    uint8_t inFlight[MAX_PROFILES];
+    uint32_t lastChangeMs;
+    uint32_t commitDelayMs;
+    ConfigStorageStats stats;
+    
+    // Escritura en flash (en su propia tarea tras startWriter())
+    ConfigWriter writer;
+    ConfigWriteCallback writeCallback;
+    void* writeContext;
+    
+    // Directorio desde flash (una lectura); false si no existe o está dañado
+    bool readDirectory();
+    // Sin directorio: se rehace con los perfiles que haya (y sus migraciones)
+    void rebuildDirectory();
+    // Lectura de un perfil desde flash; false si no existe o está dañado.
+    // blob: la flash tiene su blob (de cualquier versión); legacy: quedan claves
+    // sueltas de la versión 0; rewrite: hay que reescribirlo en la versión actual.
+    bool readProfile(uint8_t profile, ConfigProfile& config, bool& blob, bool& legacy, bool& rewrite);
+    bool readLegacyProfile(uint8_t profile, ConfigProfile& config);
+    static void resetCurves(ResponseCurveConfig curves[CONFIG_CURVES_COUNT]);
+    static void defaultConfig(ConfigProfile& config);
+    static bool sameProfile(const ConfigProfile& a, const ConfigProfile& b);
     
-    // Claves para Preferences (nombres cortos para ahorrar espacio)
-    String getProfileKey(uint8_t profile);
-    String getAddressKey(uint8_t profile);
+    // Caché: posición del perfil (nullptr si no está), una libre para él (saca la
+    // usada hace más tiempo que no esté pendiente de escribir) o el perfil cargado.
+    // loadSlot() distingue un perfil que no existe de una caché que no se pudo vaciar.
+    CacheSlot* findSlot(uint8_t profile);
+    CacheSlot* allocSlot(uint8_t profile);
+    ConfigLoadStatus loadSlot(uint8_t profile, CacheSlot*& slot);
+    
+    // Perfil o directorio modificado en RAM: se escribirá en el próximo commit
+    void markDirty(CacheSlot& slot);
+    void markDirectoryDirty();
+    bool isDirty();
+    // Perfiles pendientes y después el directorio a la cola de writer
+    void queueWrites();
+    // Resultados de writer: estadísticas, reintentos y callback
+    void collectWrites();
+    static void onWriteResult(const ConfigWriteResult& result, void* context);
     
 public:
     // Constructor
     ConfigStorage();
     
     // ========== FUNCIONES BÁSICAS ==========
-    bool begin();                           // Inicializar librería
-    void end();                            // Cerrar librería
+    bool begin();                           // Inicializar librería, directorio y perfil activo
+    void end();                            // Escribir lo pendiente y cerrar librería
+    
+    // ========== ESCRITURA EN FLASH ==========
+    // Tarea de escritura en segundo plano (tras begin()). Sin ella poll() escribe en el loop.
+    bool startWriter(UBaseType_t priority = CONFIG_WRITER_DEFAULT_PRIORITY,
+                     uint32_t stackSize = CONFIG_WRITER_DEFAULT_STACK);
+    // Resultado de cada escritura, llamado desde poll() (en la tarea de UI)
+    void onWriteComplete(ConfigWriteCallback callback, void* context = nullptr) {
+        writeCallback = callback;
+        writeContext = context;
+    }
+    // En cada vuelta del loop: encola lo pendiente tras commitDelayMs sin cambios y
+    // recoge los resultados. Devuelve true si encoló.
+    bool poll(uint32_t nowMs);
+    // Encolar ya lo pendiente y esperar a que se escriba (hasta timeoutMs con tarea)
+    bool flush(uint32_t timeoutMs = 1000);
+    bool hasPendingWrites() { return isDirty() || !writer.isIdle(); }
+    void setCommitDelay(uint32_t delayMs) { commitDelayMs = delayMs; }
+    // Tarea de escritura: en el host, donde las tareas no se ejecutan, la llama el programa
+    uint8_t processWrites() { return writer.process(); }
     
     // ========== GESTIÓN DE PERFILES ==========
-    bool setActiveProfile(uint8_t profile); // Cambiar perfil activo (0-3)
+    bool setActiveProfile(uint8_t profile); // Cambiar perfil activo (0-31); false: se queda el actual
     uint8_t getActiveProfile();             // Obtener perfil activo
     
+    // ========== MODELOS (DIRECTORIO) ==========
+    uint8_t getProfileCount();              // Modelos guardados
+    bool getProfileInfo(uint8_t profile, ConfigModelInfo& info); // Sin leer el perfil
+    String getProfileName(uint8_t profile); // Nombre, o "Perfil n" si no tiene
+    bool setProfileName(uint8_t profile, const char* name); // false si otro modelo ya lo usa
+    uint8_t createProfile(const char* name); // Perfil libre con valores por defecto; CONFIG_NO_PROFILE si no hay,
+                                             // sin nombre o si el nombre recortado ya está en uso
+    uint8_t findProfileByName(const char* name);     // CONFIG_NO_PROFILE si no existe
+    uint8_t findProfileByAddress(uint64_t address);  // CONFIG_NO_PROFILE si no existe
+    uint8_t getRecentProfiles(uint8_t* profiles, uint8_t max); // Del más reciente al más antiguo
+    
     // ========== GUARDAR/CARGAR CONFIGURACIÓN ==========
     bool saveCurrentConfig();               // Guardar config actual al perfil activo
     bool loadCurrentConfig();               // Cargar config desde perfil activo
@@ -122,6 +244,10 @@ public:
     void setIntensity(uint8_t intensity);     // Valores de 1-4
     uint8_t getIntensityLimit();              // Obtener intensidad actual
     
+    // CURVAS DE RESPUESTA (canal 0-3 = ch1-ch4)
+    void setCurve(uint8_t channel, const ResponseCurveConfig& curve);
+    ResponseCurveConfig getCurve(uint8_t channel);
+    
     // DIRECCIÓN NRF24L01
     void setNRFAddress(uint64_t address);
     uint64_t getNRFAddress();
@@ -138,6 +264,11 @@ public:
     // FUNCIONES DE MANTENIMIENTO
     void clearAllProfiles();                     // Limpiar todos los perfiles (usar con cuidado)
     bool repairProfile(uint8_t profile);        // Reparar un perfil corrupto
+    
+    // ESTADÍSTICAS
+    ConfigStorageStats getStats() { return stats; }
+    void resetStats();
+    void printStats();
 };
 
 #endif // CONFIG_STORAGE_H
\ No newline at end of file
@@ -0,0 +1,282 @@
+/**
+ * ConfigWriter Implementation
+ *
+ * Fecha: 2025
+ */
+
+#include "ConfigWriter.h"
+#include "ConfigCodec.h"
+
+ConfigWriter::ConfigWriter() {
+    preferences = nullptr;
+    task = nullptr;
+    mux = portMUX_INITIALIZER_UNLOCKED;
+    head = 0;
+    done = 0;
+    tail = 0;
+    storedProfiles = 0;
+    knownCrc = 0;
+    memset(storedCrc, 0, sizeof(storedCrc));
+    legacyProfiles = 0;
+    failedProfiles = 0;
+    legacyActive = false;
+    directoryKnown = false;
+    directoryCrc = 0;
+}
+
+void ConfigWriter::begin(Preferences* prefs) {
+    preferences = prefs;
+    head = 0;
+    done = 0;
+    tail = 0;
+    storedProfiles = 0;
+    knownCrc = 0;
+    legacyProfiles = 0;
+    failedProfiles = 0;
+    legacyActive = preferences->isKey("active");
+    directoryKnown = false;
+}
+
+void ConfigWriter::setStored(uint8_t profile, bool blob, bool legacy) {
+    if (profile >= MAX_PROFILES) return;
+    uint32_t bit = 1UL << profile;
+    storedProfiles = blob ? storedProfiles | bit : storedProfiles & ~bit;
+    legacyProfiles = legacy ? legacyProfiles | bit : legacyProfiles & ~bit;
+}
+
+bool ConfigWriter::startTask(UBaseType_t priority, uint32_t stackSize) {
+    if (preferences == nullptr || task != nullptr) {
+        return false;
+    }
+    if (xTaskCreate(taskEntry, "config_writer", stackSize, this, priority, &task) != pdPASS) {
+        Serial.println("ConfigWriter: Failed to create task");
+        task = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void ConfigWriter::end() {
+    if (task != nullptr) {
+        vTaskDelete(task);
+        task = nullptr;
+    }
+}
+
+void ConfigWriter::makeKey(char key[CONFIG_KEY_SIZE], uint8_t profile, char kind) {
+    if (kind == 0) {
+        snprintf(key, CONFIG_KEY_SIZE, "p%u", profile);         // Blob: "p0", "p1"...
+    } else {
+        snprintf(key, CONFIG_KEY_SIZE, "p%u%c", profile, kind); // Versión 0: "p0v", "p1a", "p2c"...
+    }
+}
+
+// Claves sueltas de la versión 0 de un perfil
+static const char LEGACY_KINDS[] = {'v', 'a', 'c'};
+
+// ========== TAREA DE UI ==========
+
+bool ConfigWriter::submit(const ConfigWriteRequest& request) {
+    if (preferences == nullptr) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&mux);
+    bool full = head - tail >= CONFIG_WRITE_QUEUE_SIZE;
+    portEXIT_CRITICAL(&mux);
+    if (full) {
+        return false;
+    }
+
+    // La tarea no mira esta posición hasta que head avanza
+    Slot& slot = slots[head % CONFIG_WRITE_QUEUE_SIZE];
+    slot.request = request;
+    slot.result.queuedUs = micros();
+
+    portENTER_CRITICAL(&mux);
+    head++;
+    portEXIT_CRITICAL(&mux);
+
+    if (task != nullptr) {
+        xTaskNotifyGive(task);
+    }
+    return true;
+}
+
+uint8_t ConfigWriter::getQueued() {
+    portENTER_CRITICAL(&mux);
+    uint8_t queued = head - tail;
+    portEXIT_CRITICAL(&mux);
+    return queued;
+}
+
+uint8_t ConfigWriter::collect(ConfigWriteCallback callback, void* context) {
+    portENTER_CRITICAL(&mux);
+    uint32_t finished = done;
+    portEXIT_CRITICAL(&mux);
+
+    uint8_t count = 0;
+    while (tail != finished) {
+        // Copia: al avanzar tail la posición vuelve a estar libre
+        ConfigWriteResult result = slots[tail % CONFIG_WRITE_QUEUE_SIZE].result;
+        portENTER_CRITICAL(&mux);
+        tail++;
+        portEXIT_CRITICAL(&mux);
+
+        if (callback != nullptr) {
+            callback(result, context);
+        }
+        count++;
+    }
+    return count;
+}
+
+// ========== TAREA DE ESCRITURA ==========
+
+void ConfigWriter::taskEntry(void* arg) {
+    ConfigWriter* self = static_cast<ConfigWriter*>(arg);
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        self->process();
+    }
+}
+
+uint8_t ConfigWriter::process() {
+    uint8_t count = 0;
+    for (;;) {
+        portENTER_CRITICAL(&mux);
+        uint32_t next = done;
+        bool pending = next != head;
+        portEXIT_CRITICAL(&mux);
+        if (!pending) break;
+
+        Slot& slot = slots[next % CONFIG_WRITE_QUEUE_SIZE];
+        write(slot.request, slot.result);
+
+        portENTER_CRITICAL(&mux);
+        done++;
+        portEXIT_CRITICAL(&mux);
+        count++;
+    }
+    return count;
+}
+
+void ConfigWriter::write(const ConfigWriteRequest& request, ConfigWriteResult& result) {
+    uint32_t startUs = micros();
+    result.kind = request.kind;
+    result.profile = request.profile;
+    result.keys = 0;
+    result.bytes = 0;
+
+    switch (request.kind) {
+        case CONFIG_WRITE_PROFILE:
+            result.success = writeProfile(request.profile, request.config, result);
+            break;
+        case CONFIG_WRITE_DIRECTORY:
+            result.success = writeDirectory(result);
+            break;
+        case CONFIG_WRITE_CLEAR:
+            result.success = clear();
+            break;
+        default:
+            result.success = false;
+            break;
+    }
+    result.writeUs = micros() - startUs;
+}
+
+bool ConfigWriter::writeProfile(uint8_t profile, const ConfigProfile& config, ConfigWriteResult& result) {
+    if (profile >= MAX_PROFILES) {
+        return false;
+    }
+
+    // Todo el perfil en una entrada: se escribe entero o no se escribe
+    uint8_t blob[CONFIG_BLOB_MAX];
+    uint16_t length = ConfigCodec::encode(config, blob);
+    uint32_t crc = ConfigCodec::crc32(blob, length);
+    uint32_t bit = 1UL << profile;
+    bool changed = !(knownCrc & bit) || storedCrc[profile] != crc;
+
+    char key[CONFIG_KEY_SIZE];
+    if (changed) {
+        makeKey(key, profile, 0);
+        if (preferences->putBytes(key, blob, length) != length) {
+            failedProfiles |= bit;
+            return false;
+        }
+        storedCrc[profile] = crc;
+        knownCrc |= bit;
+        storedProfiles |= bit;
+        result.keys++;
+        result.bytes += length;
+    }
+    failedProfiles &= ~bit;
+
+    // Con el blob ya en flash, las claves de la versión 0 sobran
+    if (legacyProfiles & bit) {
+        for (uint8_t k = 0; k < sizeof(LEGACY_KINDS); k++) {
+            makeKey(key, profile, LEGACY_KINDS[k]);
+            preferences->remove(key);
+        }
+        legacyProfiles &= ~bit;
+    }
+    return true;
+}
+
+// Solo modelos con el blob entero en flash, y solo si el perfil activo lo está:
+// tras un corte se arranca con un perfil entero
+bool ConfigWriter::writeDirectory(ConfigWriteResult& result) {
+    if (!directory.read(pending)) {
+        return false;
+    }
+    uint32_t activeBit = 1UL << pending.active;
+    if (pending.active >= MAX_PROFILES || !(storedProfiles & activeBit) || (failedProfiles & activeBit)) {
+        return false;
+    }
+
+    // Publicado después de encolar un perfil nuevo que aún no está en flash: fuera hasta
+    // el directorio que se encola tras él
+    pending.used &= storedProfiles;
+    uint16_t length = ConfigCodec::encodeDirectory(pending, buffer);
+    uint32_t crc = ConfigCodec::crc32(buffer, length);
+    if (!directoryKnown || directoryCrc != crc) {
+        if (preferences->putBytes("dir", buffer, length) != length) {
+            return false;
+        }
+        directoryCrc = crc;
+        directoryKnown = true;
+        result.keys = 1;
+        result.bytes = length;
+    }
+
+    // Perfil activo de antes del directorio: ya está en él
+    if (legacyActive) {
+        preferences->remove("active");
+        legacyActive = false;
+    }
+    return true;
+}
+
+bool ConfigWriter::clear() {
+    char key[CONFIG_KEY_SIZE];
+
+    // Primero el directorio: tras un corte a medias nunca lista un perfil ya borrado
+    // (begin() lo reconstruye con los que queden)
+    preferences->remove("dir");
+    for (uint8_t i = 0; i < MAX_PROFILES; i++) {
+        makeKey(key, i, 0);
+        preferences->remove(key);
+        for (uint8_t k = 0; k < sizeof(LEGACY_KINDS); k++) {
+            makeKey(key, i, LEGACY_KINDS[k]);
+            preferences->remove(key);
+        }
+    }
+    preferences->remove("active");
+    storedProfiles = 0;
+    knownCrc = 0;
+    legacyProfiles = 0;
+    failedProfiles = 0;
+    legacyActive = false;
+    directoryKnown = false;
+    return true;
+}
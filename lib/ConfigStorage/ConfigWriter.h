@@ -0,0 +1,137 @@
+/**
+ * ConfigWriter - Escritura en flash de ConfigStorage en segundo plano
+ *
+ * Las escrituras de Preferences/NVS tardan milisegundos (borrado de página
+ * incluido). ConfigStorage encola aquí copias de los perfiles y una tarea
+ * de FreeRTOS con la prioridad de loop() las escribe, así el loop() de la UI
+ * no se detiene durante toda la escritura.
+ *
+ * Características:
+ * - Cola acotada de CONFIG_WRITE_QUEUE_SIZE peticiones: submit() no espera;
+ *   si está llena devuelve false y el llamador lo reintenta más tarde
+ * - Orden de llegada: el directorio encolado tras un perfil se escribe
+ *   después de él. Solo lista modelos cuyo blob está entero en flash y
+ *   solo se escribe si el perfil activo lo está (un corte de alimentación
+ *   nunca deja el directorio apuntando a un perfil a medias)
+ * - Un perfil es un blob de ConfigCodec en una sola entrada, escrito solo si
+ *   difiere de lo último escrito (CRC); al escribirlo se borran las claves
+ *   sueltas de la versión 0 que queden
+ * - El directorio no viaja en la cola (ocupa 1 KB): ConfigStorage lo publica
+ *   en un SeqLock y la tarea lee la última versión al escribirlo
+ * - Resultados recogidos con collect() en la tarea de UI: el callback puede
+ *   tocar LVGL
+ * - Sin tarea (startTask() sin llamar, o en el host) process() escribe en el
+ *   llamador
+ *
+ * Fecha: 2025
+ */
+
+#ifndef CONFIG_WRITER_H
+#define CONFIG_WRITER_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <SeqLock.h>
+#include "ConfigProfile.h"
+#include "ConfigCodec.h"
+
+#define CONFIG_WRITE_QUEUE_SIZE 8           // Peticiones en cola (perfiles de la caché + directorio)
+#define CONFIG_WRITER_DEFAULT_PRIORITY 1    // La de loop(): se reparten el procesador por ticks
+#define CONFIG_WRITER_DEFAULT_STACK 4096    // NVS necesita ~3 KB
+
+enum ConfigWriteKind {
+    CONFIG_WRITE_PROFILE,   // Blob "p<n>" de un perfil
+    CONFIG_WRITE_DIRECTORY, // Blob "dir": modelos guardados y perfil activo
+    CONFIG_WRITE_CLEAR      // Borrar todos los perfiles y el directorio
+};
+
+// Petición encolada: copia del perfil en el momento de encolar
+struct ConfigWriteRequest {
+    uint8_t kind;           // ConfigWriteKind
+    uint8_t profile;        // Perfil escrito o perfil activo del directorio
+    ConfigProfile config;   // CONFIG_WRITE_PROFILE
+};
+
+struct ConfigWriteResult {
+    uint8_t kind;           // ConfigWriteKind
+    uint8_t profile;
+    bool success;
+    uint8_t keys;           // Claves escritas (0 si ya estaba todo en flash)
+    uint16_t bytes;
+    uint32_t queuedUs;      // micros() al encolar
+    uint32_t writeUs;       // Duración de la escritura en la tarea
+};
+
+typedef void (*ConfigWriteCallback)(const ConfigWriteResult& result, void* context);
+
+class ConfigWriter {
+private:
+    struct Slot {
+        ConfigWriteRequest request;
+        ConfigWriteResult result;
+    };
+
+    Preferences* preferences;
+    TaskHandle_t task;
+    portMUX_TYPE mux;
+
+    // Cola circular: submit() avanza head, process() done, collect() tail
+    Slot slots[CONFIG_WRITE_QUEUE_SIZE];
+    uint32_t head;
+    uint32_t done;
+    uint32_t tail;
+
+    // Lo que hay en flash (solo lo toca process() una vez arrancada la tarea)
+    uint32_t storedProfiles;                // Blob entero en flash
+    uint32_t knownCrc;                      // storedCrc válido (escrito en esta sesión)
+    uint32_t storedCrc[MAX_PROFILES];
+    uint32_t legacyProfiles;                // Quedan claves sueltas de la versión 0
+    uint32_t failedProfiles;                // Última escritura del perfil con error
+    bool legacyActive;                      // Queda la clave "active" de antes del directorio
+    bool directoryKnown;
+    uint32_t directoryCrc;
+
+    // Directorio publicado por la tarea de UI y su copia en la tarea de escritura
+    SeqLock<ConfigDirectoryRecord> directory;
+    ConfigDirectoryRecord pending;
+    uint8_t buffer[CONFIG_DIRECTORY_MAX];   // Fuera de la pila de la tarea
+
+    static void taskEntry(void* arg);
+    void write(const ConfigWriteRequest& request, ConfigWriteResult& result);
+    bool writeProfile(uint8_t profile, const ConfigProfile& config, ConfigWriteResult& result);
+    bool writeDirectory(ConfigWriteResult& result);
+    bool clear();
+
+public:
+    ConfigWriter();
+
+    // Preferences ya abierto por ConfigStorage
+    void begin(Preferences* prefs);
+    // Lo leído en begin() de ConfigStorage, antes de arrancar la tarea: blob del
+    // perfil en flash y claves sueltas de la versión 0
+    void setStored(uint8_t profile, bool blob, bool legacy);
+
+    // Tarea de escritura. Sin ella process() escribe en el llamador.
+    bool startTask(UBaseType_t priority = CONFIG_WRITER_DEFAULT_PRIORITY,
+                   uint32_t stackSize = CONFIG_WRITER_DEFAULT_STACK);
+    void end();
+    bool hasTask() { return task != nullptr; }
+
+    // Claves para Preferences (nombres cortos para ahorrar espacio): kind 0 para el blob
+    // del perfil ("p0"), 'v'/'a'/'c' para las claves sueltas de la versión 0 ("p0v")
+    static void makeKey(char key[CONFIG_KEY_SIZE], uint8_t profile, char kind);
+
+    // Tarea de UI: encolar sin esperar (false si la cola está llena)
+    bool submit(const ConfigWriteRequest& request);
+    // Tarea de UI: directorio para la próxima CONFIG_WRITE_DIRECTORY
+    void publishDirectory(const ConfigDirectoryRecord& record) { directory.publish(record); }
+    uint8_t getQueued();                    // Encoladas o sin recoger
+    bool isIdle() { return getQueued() == 0; }
+    // Tarea de UI: resultados terminados al callback; devuelve cuántos
+    uint8_t collect(ConfigWriteCallback callback, void* context);
+
+    // Tarea de escritura: escribe todo lo encolado; devuelve cuántas peticiones
+    uint8_t process();
+};
+
+#endif // CONFIG_WRITER_H
@@ -0,0 +1,153 @@
+/**
+ * ControlLoop Library Implementation
+ *
+ * Date: 2025
+ */
+
+#include "ControlLoop.h"
+
+// Constructor
+ControlLoop::ControlLoop() {
+    _callback = nullptr;
+    _context = nullptr;
+    _rateHz = CONTROL_LOOP_DEFAULT_RATE_HZ;
+    _periodUs = 1000000UL / _rateHz;
+
+    _task = nullptr;
+    _timer = nullptr;
+    _statsMux = portMUX_INITIALIZER_UNLOCKED;
+
+    _lastTickUs = 0;
+    _ticks = 0;
+    _overruns = 0;
+    _maxExecUs = 0;
+    _period.setTarget(_periodUs);
+}
+
+bool ControlLoop::begin(TickCallback callback, void* context, uint16_t rateHz,
+                        UBaseType_t priority, uint32_t stackSize) {
+    if (callback == nullptr || rateHz == 0 || _task != nullptr) {
+        return false;
+    }
+
+    _callback = callback;
+    _context = context;
+    _rateHz = rateHz;
+    _periodUs = 1000000UL / rateHz;
+    resetStats();
+
+    if (xTaskCreate(_taskEntry, "control", stackSize, this, priority, &_task) != pdPASS) {
+        Serial.println("ControlLoop: Failed to create task");
+        _task = nullptr;
+        return false;
+    }
+
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = &_timerCallback;
+    timerArgs.arg = this;
+    timerArgs.dispatch_method = ESP_TIMER_TASK;
+    timerArgs.name = "control_tick";
+
+    if (esp_timer_create(&timerArgs, &_timer) != ESP_OK ||
+        esp_timer_start_periodic(_timer, _periodUs) != ESP_OK) {
+        Serial.println("ControlLoop: Failed to start timer");
+        end();
+        return false;
+    }
+
+    return true;
+}
+
+void ControlLoop::end() {
+    if (_timer != nullptr) {
+        esp_timer_stop(_timer);
+        esp_timer_delete(_timer);
+        _timer = nullptr;
+    }
+    if (_task != nullptr) {
+        vTaskDelete(_task);
+        _task = nullptr;
+    }
+}
+
+void ControlLoop::setRate(uint16_t rateHz) {
+    if (rateHz == 0) return;
+
+    _rateHz = rateHz;
+    _periodUs = 1000000UL / rateHz;
+
+    if (_timer != nullptr) {
+        esp_timer_stop(_timer);
+        esp_timer_start_periodic(_timer, _periodUs);
+    }
+    resetStats();
+}
+
+// Runs in the esp_timer task: just wake the control task
+void ControlLoop::_timerCallback(void* arg) {
+    ControlLoop* self = static_cast<ControlLoop*>(arg);
+    if (self->_task != nullptr) {
+        xTaskNotifyGive(self->_task);
+    }
+}
+
+void ControlLoop::_taskEntry(void* arg) {
+    static_cast<ControlLoop*>(arg)->_run();
+}
+
+void ControlLoop::_run() {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        uint32_t startUs = micros();
+        _callback(_context);
+        uint32_t execUs = micros() - startUs;
+
+        portENTER_CRITICAL(&_statsMux);
+        if (_lastTickUs != 0) {
+            uint32_t periodUs = startUs - _lastTickUs;
+            _period.record(periodUs);
+            if (periodUs > _periodUs + _periodUs / 2) {
+                _overruns++;
+            }
+        }
+        _lastTickUs = startUs;
+        if (execUs > _maxExecUs) _maxExecUs = execUs;
+        _ticks++;
+        portEXIT_CRITICAL(&_statsMux);
+    }
+}
+
+ControlLoopStats ControlLoop::getStats() {
+    ControlLoopStats stats;
+
+    portENTER_CRITICAL(&_statsMux);
+    stats.rateHz = _rateHz;
+    stats.ticks = _ticks;
+    stats.overruns = _overruns;
+    stats.maxExecUs = _maxExecUs;
+    stats.period = _period;
+    portEXIT_CRITICAL(&_statsMux);
+
+    return stats;
+}
+
+void ControlLoop::resetStats() {
+    portENTER_CRITICAL(&_statsMux);
+    _lastTickUs = 0;
+    _ticks = 0;
+    _overruns = 0;
+    _maxExecUs = 0;
+    _period.setTarget(_periodUs);
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+void ControlLoop::printStats() {
+    ControlLoopStats stats = getStats();
+
+    Serial.print("ControlLoop: "); Serial.print(stats.rateHz); Serial.print(" Hz");
+    Serial.print("  Ticks: "); Serial.print(stats.ticks);
+    Serial.print("  Overruns: "); Serial.print(stats.overruns);
+    Serial.print("  Max exec: "); Serial.print(stats.maxExecUs); Serial.println(" us");
+    stats.period.print("Control period");
+}
@@ -0,0 +1,84 @@
+/**
+ * ControlLoop Library - Fixed-rate control task for ESP32
+ *
+ * Runs a callback at a fixed rate in its own high-priority FreeRTOS task,
+ * independent of how long the UI (lv_timer_handler) takes in loop().
+ *
+ * Features:
+ * - Hardware timer tick (esp_timer) wakes the task, so the period does not
+ *   drift with the callback duration and is not limited to whole RTOS ticks
+ * - Configurable rate and task priority
+ * - Jitter statistics: min/max/mean/p99 period and a histogram
+ * - Callback execution time and overrun counters
+ * - Serial report of the timing statistics
+ *
+ * Date: 2025
+ */
+
+#ifndef CONTROL_LOOP_H
+#define CONTROL_LOOP_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include "PeriodHistogram.h"
+
+#define CONTROL_LOOP_DEFAULT_RATE_HZ 200
+#define CONTROL_LOOP_DEFAULT_PRIORITY 3      // loop() runs at priority 1
+#define CONTROL_LOOP_DEFAULT_STACK 4096
+
+// Snapshot of the timing statistics (copied atomically from the task)
+struct ControlLoopStats {
+    uint16_t rateHz;
+    uint32_t ticks;            // Callbacks executed
+    uint32_t overruns;         // Periods longer than 1.5x the target
+    uint32_t maxExecUs;        // Longest callback duration
+    PeriodHistogram period;    // Measured wake-up to wake-up periods
+};
+
+class ControlLoop {
+public:
+    typedef void (*TickCallback)(void* context);
+
+private:
+    TickCallback _callback;
+    void* _context;
+    uint16_t _rateHz;
+    uint32_t _periodUs;
+
+    TaskHandle_t _task;
+    esp_timer_handle_t _timer;
+    portMUX_TYPE _statsMux;
+
+    // Statistics (written by the control task only)
+    uint32_t _lastTickUs;
+    uint32_t _ticks;
+    uint32_t _overruns;
+    uint32_t _maxExecUs;
+    PeriodHistogram _period;
+
+    static void _timerCallback(void* arg);
+    static void _taskEntry(void* arg);
+    void _run();
+
+public:
+    ControlLoop();
+
+    // Start the control task. The callback runs once per period.
+    bool begin(TickCallback callback, void* context = nullptr,
+               uint16_t rateHz = CONTROL_LOOP_DEFAULT_RATE_HZ,
+               UBaseType_t priority = CONTROL_LOOP_DEFAULT_PRIORITY,
+               uint32_t stackSize = CONTROL_LOOP_DEFAULT_STACK);
+    void end();
+
+    // Configuration
+    void setRate(uint16_t rateHz);
+    uint16_t getRate() { return _rateHz; }
+    uint32_t getPeriodUs() { return _periodUs; }
+
+    // Statistics
+    ControlLoopStats getStats();
+    void resetStats();
+    void printStats();
+};
+
+#endif // CONTROL_LOOP_H
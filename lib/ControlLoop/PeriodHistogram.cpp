@@ -0,0 +1,97 @@
+/**
+ * PeriodHistogram Implementation
+ *
+ * Date: 2025
+ */
+
+#include "PeriodHistogram.h"
+
+PeriodHistogram::PeriodHistogram() {
+    _targetUs = 0;
+    _binWidthUs = 1;
+    reset();
+}
+
+void PeriodHistogram::setTarget(uint32_t targetUs) {
+    _targetUs = targetUs;
+    _binWidthUs = targetUs / PERIOD_HISTOGRAM_BINS_PER_TARGET;
+    if (_binWidthUs == 0) _binWidthUs = 1;
+    reset();
+}
+
+void PeriodHistogram::reset() {
+    memset(_bins, 0, sizeof(_bins));
+    _count = 0;
+    _minUs = 0xFFFFFFFF;
+    _maxUs = 0;
+    _sumUs = 0;
+}
+
+void PeriodHistogram::record(uint32_t periodUs) {
+    uint32_t bin = periodUs / _binWidthUs;
+    if (bin >= PERIOD_HISTOGRAM_BINS) {
+        bin = PERIOD_HISTOGRAM_BINS - 1; // Last bin collects everything above range
+    }
+    _bins[bin]++;
+
+    if (periodUs < _minUs) _minUs = periodUs;
+    if (periodUs > _maxUs) _maxUs = periodUs;
+    _sumUs += periodUs;
+    _count++;
+}
+
+uint32_t PeriodHistogram::getMean() const {
+    if (_count == 0) return 0;
+    return (uint32_t)(_sumUs / _count);
+}
+
+uint32_t PeriodHistogram::getPercentile(uint8_t percent) const {
+    if (_count == 0) return 0;
+    if (percent > 100) percent = 100;
+
+    // Number of samples that must be at or below the returned value
+    uint32_t threshold = ((uint64_t)_count * percent + 99) / 100;
+    if (threshold == 0) threshold = 1;
+
+    uint32_t accumulated = 0;
+    for (uint8_t i = 0; i < PERIOD_HISTOGRAM_BINS; i++) {
+        accumulated += _bins[i];
+        if (accumulated >= threshold) {
+            // The overflow bin has no upper edge, report the real maximum instead
+            if (i == PERIOD_HISTOGRAM_BINS - 1) return _maxUs;
+            uint32_t upperEdge = (i + 1) * _binWidthUs;
+            return (upperEdge < _maxUs) ? upperEdge : _maxUs;
+        }
+    }
+    return _maxUs;
+}
+
+uint32_t PeriodHistogram::getBin(uint8_t index) const {
+    if (index < PERIOD_HISTOGRAM_BINS) {
+        return _bins[index];
+    }
+    return 0;
+}
+
+void PeriodHistogram::print(const char* name) const {
+    Serial.print("=== "); Serial.print(name); Serial.println(" ===");
+    Serial.print("Samples: "); Serial.print(_count);
+    Serial.print("  Target: "); Serial.print(_targetUs); Serial.println(" us");
+    Serial.print("Min: "); Serial.print(getMin());
+    Serial.print(" us  Mean: "); Serial.print(getMean());
+    Serial.print(" us  p99: "); Serial.print(getPercentile(99));
+    Serial.print(" us  Max: "); Serial.print(_maxUs); Serial.println(" us");
+
+    // Only non-empty bins, to keep the output short
+    for (uint8_t i = 0; i < PERIOD_HISTOGRAM_BINS; i++) {
+        if (_bins[i] == 0) continue;
+        Serial.print("  ");
+        Serial.print(i * _binWidthUs);
+        if (i == PERIOD_HISTOGRAM_BINS - 1) {
+            Serial.print("+ us: ");
+        } else {
+            Serial.print("-"); Serial.print((i + 1) * _binWidthUs); Serial.print(" us: ");
+        }
+        Serial.println(_bins[i]);
+    }
+}
@@ -0,0 +1,57 @@
+/**
+ * PeriodHistogram - Timing statistics for periodic tasks
+ *
+ * Features:
+ * - Min/max/mean of measured periods (microseconds)
+ * - Fixed-size histogram centred on the target period
+ * - Percentile queries (p50, p99, ...) without storing samples
+ * - No dynamic memory, safe to use from a task context
+ *
+ * Date: 2025
+ */
+
+#ifndef PERIOD_HISTOGRAM_H
+#define PERIOD_HISTOGRAM_H
+
+#include <Arduino.h>
+
+// Number of histogram bins. Each bin is (target / PERIOD_HISTOGRAM_BINS_PER_TARGET) wide,
+// so the histogram covers up to BINS / BINS_PER_TARGET times the target period.
+#define PERIOD_HISTOGRAM_BINS 64
+#define PERIOD_HISTOGRAM_BINS_PER_TARGET 16
+
+class PeriodHistogram {
+private:
+    uint32_t _targetUs;
+    uint32_t _binWidthUs;
+    uint32_t _bins[PERIOD_HISTOGRAM_BINS];
+    uint32_t _count;
+    uint32_t _minUs;
+    uint32_t _maxUs;
+    uint64_t _sumUs;
+
+public:
+    PeriodHistogram();
+
+    // Configuration
+    void setTarget(uint32_t targetUs);
+    void reset();
+
+    // Recording
+    void record(uint32_t periodUs);
+
+    // Queries
+    uint32_t getCount() const { return _count; }
+    uint32_t getTarget() const { return _targetUs; }
+    uint32_t getMin() const { return _count ? _minUs : 0; }
+    uint32_t getMax() const { return _maxUs; }
+    uint32_t getMean() const;
+    uint32_t getPercentile(uint8_t percent) const; // Upper edge of the bin holding the percentile
+    uint32_t getBin(uint8_t index) const;
+    uint32_t getBinWidth() const { return _binWidthUs; }
+
+    // Debug
+    void print(const char* name) const;
+};
+
+#endif // PERIOD_HISTOGRAM_H
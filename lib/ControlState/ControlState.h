@@ -0,0 +1,61 @@
+/**
+ * ControlState - Estado compartido entre el lazo de control, la radio y la UI
+ *
+ * Dos publicaciones de un solo escritor cada una (SeqLock):
+ * - ControlLimits: imagen del perfil activo (límites de las palancas, curvas y
+ *   ajustes de radio). La construye entera la tarea de UI (callbacks de
+ *   ui_events, cambio de perfil) y la publica una vez por vuelta de loop():
+ *   el cambio es un solo store de la secuencia, así el lazo de control nunca
+ *   ve un cambio de perfil a medias. ProfileSwitch lleva los ajustes de radio
+ *   al NRF24 entre dos paquetes.
+ * - ControlState: lo que produjo cada ciclo de control (entradas, posiciones
+ *   de las palancas, canales enviados, telemetría del receptor). Lo escribe
+ *   la tarea de control y lo leen la UI y cualquier otro consumidor sin
+ *   bloquearla.
+ *
+ * Características:
+ * - Lecturas sin locks ni copias (beginRead/endRead)
+ * - Versión de cada publicación para detectar cambios
+ * - ControlState indica con qué versión de límites se calculó
+ * - Un paquete sale con los canales y la radio de la misma imagen
+ *
+ * Fecha: 2025
+ */
+
+#ifndef CONTROL_STATE_H
+#define CONTROL_STATE_H
+
+#include <Arduino.h>
+#include <TransmitterLogic.h>
+#include <TelemetryLink.h>
+#include "SeqLock.h"
+
+// Ajustes de radio del perfil (dirección del receptor, canal fijo y potencia)
+struct RadioProfile {
+    uint64_t address;
+    uint8_t channel;           // Sin uso con salto de frecuencia (lo fija la secuencia)
+    uint8_t paLevel;           // RF24_PA_MIN ... RF24_PA_MAX
+};
+
+// Imagen del perfil activo: límites de las palancas (palanca1 ... palanca4) y
+// curvas de los canales (ya precalculadas) tal como los usa computeSentData(),
+// y la radio con la que deben salir los paquetes calculados con ellos
+struct ControlLimits {
+    uint8_t palanca[PALANCAS_COUNT][3];
+    ResponseCurve curves[CURVAS_COUNT];
+    RadioProfile radio;
+    uint8_t profile;
+    uint32_t publishedUs;      // micros() al publicarla (latencia del cambio)
+};
+
+// Resultado de un ciclo de control
+struct ControlState {
+    uint32_t tick;             // Ciclos de control desde el arranque
+    uint32_t timestampUs;      // micros() al calcular los canales
+    uint32_t limitsVersion;    // Versión de ControlLimits usada
+    ControlInputs inputs;      // Joysticks, botón y posiciones de las palancas
+    Data_to_be_sent data;      // Canales transmitidos
+    TelemetryState telemetry;  // Último dato del receptor (modo bidireccional)
+};
+
+#endif // CONTROL_STATE_H
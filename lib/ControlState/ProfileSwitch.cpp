@@ -0,0 +1,125 @@
+/**
+ * ProfileSwitch Implementation
+ *
+ * Fecha: 2025
+ */
+
+#include "ProfileSwitch.h"
+
+ProfileSwitch::ProfileSwitch() {
+    _radio = nullptr;
+    memset(&_applied, 0, sizeof(_applied));
+    _fixedChannel = true;
+    _version = 0;
+
+    _statsMux = portMUX_INITIALIZER_UNLOCKED;
+    resetStats();
+}
+
+bool ProfileSwitch::begin(RF24* radio, const RadioProfile& initial, uint32_t version, bool fixedChannel) {
+    if (radio == nullptr) {
+        Serial.println("ProfileSwitch: Sin radio");
+        return false;
+    }
+
+    _radio = radio;
+    _fixedChannel = fixedChannel;
+    _version = version;
+    _applied = initial;
+    _radio->openWritingPipe(initial.address);
+    if (_fixedChannel) _radio->setChannel(initial.channel);
+    _radio->setPALevel(initial.paLevel);
+    return true;
+}
+
+uint8_t ProfileSwitch::pending(const RadioProfile& radio) const {
+    if (_radio == nullptr) {
+        return 0;
+    }
+
+    uint8_t changes = 0;
+    if (radio.address != _applied.address) changes |= PROFILE_RADIO_ADDRESS;
+    if (_fixedChannel && radio.channel != _applied.channel) changes |= PROFILE_RADIO_CHANNEL;
+    if (radio.paLevel != _applied.paLevel) changes |= PROFILE_RADIO_PA;
+    return changes;
+}
+
+uint8_t ProfileSwitch::apply(const RadioProfile& radio) {
+    uint8_t changes = pending(radio);
+    if (changes == 0) {
+        return 0;
+    }
+
+    // Cada registro del NRF24 es una transacción SPI: solo los que cambian
+    if (changes & PROFILE_RADIO_ADDRESS) _radio->openWritingPipe(radio.address);
+    if (changes & PROFILE_RADIO_CHANNEL) _radio->setChannel(radio.channel);
+    if (changes & PROFILE_RADIO_PA) _radio->setPALevel(radio.paLevel);
+    _applied = radio;
+
+    portENTER_CRITICAL(&_statsMux);
+    _stats.radioChanges++;
+    portEXIT_CRITICAL(&_statsMux);
+    return changes;
+}
+
+uint8_t ProfileSwitch::paLevelFor(uint8_t intensity) {
+    switch (intensity) {
+        case 1: return RF24_PA_MIN;
+        case 2: return RF24_PA_LOW;
+        case 3: return RF24_PA_HIGH;
+        case 4: return RF24_PA_MAX;
+        default: return RF24_PA_LOW;
+    }
+}
+
+void ProfileSwitch::onFrame(uint32_t version, uint32_t publishedUs, uint32_t nowUs) {
+    if (version == _version) {
+        return;
+    }
+    _version = version;
+
+    uint32_t latencyUs = nowUs - publishedUs;
+    portENTER_CRITICAL(&_statsMux);
+    _stats.swaps++;
+    _stats.lastLatencyUs = latencyUs;
+    if (latencyUs > _stats.maxLatencyUs) _stats.maxLatencyUs = latencyUs;
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+void ProfileSwitch::onRecompute() {
+    portENTER_CRITICAL(&_statsMux);
+    _stats.recomputes++;
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+// ========== ESTADÍSTICAS ==========
+
+ProfileSwitchStats ProfileSwitch::getStats() {
+    ProfileSwitchStats stats;
+    portENTER_CRITICAL(&_statsMux);
+    stats = _stats;
+    portEXIT_CRITICAL(&_statsMux);
+    return stats;
+}
+
+void ProfileSwitch::resetStats() {
+    portENTER_CRITICAL(&_statsMux);
+    memset(&_stats, 0, sizeof(_stats));
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+void ProfileSwitch::printStats() {
+    ProfileSwitchStats stats = getStats();
+
+    Serial.print("ProfileSwitch: imágenes "); Serial.print(stats.swaps);
+    Serial.print("  Radio reconfigurada: "); Serial.print(stats.radioChanges);
+    Serial.print("  Recálculos: "); Serial.println(stats.recomputes);
+
+    Serial.print("ProfileSwitch: latencia publicación->paquete ");
+    if (stats.swaps > 0) {
+        Serial.print(stats.lastLatencyUs); Serial.print("/"); Serial.print(stats.maxLatencyUs);
+        Serial.println(" us (última/máx)");
+    } else {
+        Serial.println("-");
+    }
+}
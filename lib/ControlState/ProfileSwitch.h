@@ -0,0 +1,84 @@
+/**
+ * ProfileSwitch - Cambio de perfil en caliente sin mezclar dos perfiles
+ *
+ * Lado del lazo de control de ControlLimits: cada paquete se calcula con una
+ * sola imagen publicada, y antes de cargarlo en la FIFO la radio se pone en
+ * la dirección, canal y potencia de esa misma imagen. La reconfiguración se
+ * hace entre dos paquetes (FIFO de TX vacía), solo con lo que cambió.
+ *
+ * Características:
+ * - pending()/apply(): ajustes de radio de la imagen que aún no tiene el NRF24
+ * - Con salto de frecuencia el canal es de HopTransmitter (no se toca)
+ * - Latencia del cambio: publicación de la imagen -> primer paquete con ella
+ * - Estadísticas: imágenes nuevas, reconfiguraciones, recálculos por una
+ *   publicación durante el cálculo, latencia última/máxima
+ *
+ * Uso (tarea de control):
+ *   if (profile_switch.pending(image.radio)) {
+ *       radio_tx.flush(now);
+ *       profile_switch.apply(image.radio);
+ *   }
+ *   radio_tx.submit(...);
+ *   profile_switch.onFrame(version, image.publishedUs, now);
+ *
+ * Fecha: 2025
+ */
+
+#ifndef PROFILE_SWITCH_H
+#define PROFILE_SWITCH_H
+
+#include <Arduino.h>
+#include <RF24.h>
+#include "ControlState.h"
+
+// Ajustes de radio de pending()/apply()
+#define PROFILE_RADIO_ADDRESS 0x01
+#define PROFILE_RADIO_CHANNEL 0x02
+#define PROFILE_RADIO_PA 0x04
+
+struct ProfileSwitchStats {
+    uint32_t swaps;            // Imágenes nuevas que llegaron al aire
+    uint32_t radioChanges;     // Reconfiguraciones de la radio entre paquetes
+    uint32_t recomputes;       // Paquetes recalculados: la UI publicó durante el cálculo
+    uint32_t lastLatencyUs;    // Publicación -> primer paquete con la imagen
+    uint32_t maxLatencyUs;
+};
+
+class ProfileSwitch {
+private:
+    RF24* _radio;
+    RadioProfile _applied;     // Lo que tiene el NRF24
+    bool _fixedChannel;        // false: el canal lo lleva HopTransmitter
+    uint32_t _version;         // Imagen del último paquete
+
+    // Estadísticas (solo las escribe la tarea de control)
+    portMUX_TYPE _statsMux;
+    ProfileSwitchStats _stats;
+
+public:
+    ProfileSwitch();
+
+    // Radio ya arrancada en TX: aplica todos los ajustes de la imagen inicial
+    bool begin(RF24* radio, const RadioProfile& initial, uint32_t version, bool fixedChannel = true);
+
+    // Ajustes de radio (PROFILE_RADIO_*) que difieren de los aplicados; 0 = ninguno
+    uint8_t pending(const RadioProfile& radio) const;
+    // Solo con la FIFO de TX vacía; devuelve lo que cambió
+    uint8_t apply(const RadioProfile& radio);
+    const RadioProfile& getApplied() const { return _applied; }
+
+    // Potencia del NRF24 según la intensidad guardada en el perfil (1-4; otro valor: baja)
+    static uint8_t paLevelFor(uint8_t intensity);
+
+    // Paquete calculado con la imagen 'version' cargado en la FIFO en nowUs
+    void onFrame(uint32_t version, uint32_t publishedUs, uint32_t nowUs);
+    // El cálculo se repitió porque la imagen cambió mientras tanto
+    void onRecompute();
+
+    // Estadísticas
+    ProfileSwitchStats getStats();
+    void resetStats();
+    void printStats();
+};
+
+#endif // PROFILE_SWITCH_H
@@ -0,0 +1,104 @@
+/**
+ * SeqLock - Single-writer, lock-free double-buffered snapshot
+ *
+ * One task publishes a value, any number of tasks read it without locks,
+ * without disabling interrupts and without copying it. The writer fills
+ * the back buffer while readers keep using the front one; a sequence
+ * counter tells a reader whether the buffer it read was overwritten.
+ *
+ * Features:
+ * - Wait-free writer: beginWrite()/endWrite() in place, or publish(value)
+ * - Zero-copy readers: beginRead()/endRead() around direct field access
+ * - Copying read() with bounded retries for convenience
+ * - Version number of the published value
+ *
+ * Reader pattern:
+ *   uint32_t token;
+ *   const T* value;
+ *   do {
+ *       value = lock.beginRead(token);
+ *       ... use *value ...
+ *   } while (!lock.endRead(token));
+ *
+ * A reader only has to retry if the writer published twice while it was
+ * reading (the buffer it was using became the back buffer again).
+ *
+ * Date: 2025
+ */
+
+#ifndef SEQ_LOCK_H
+#define SEQ_LOCK_H
+
+#include <Arduino.h>
+#include <atomic>
+
+#define SEQ_LOCK_READ_RETRIES 8
+
+template <typename T>
+class SeqLock {
+private:
+    // _sequence = 2 * version while idle, 2 * version + 1 while the next
+    // version is being written. Version v lives in _buffers[v & 1].
+    T _buffers[2];
+    std::atomic<uint32_t> _sequence;
+
+public:
+    SeqLock() : _buffers(), _sequence(0) {}
+
+    // ========== WRITER (one task only) ==========
+
+    // Back buffer for the next version. Its content is two versions old:
+    // overwrite every field, or start from front() if only some change.
+    T& beginWrite() {
+        uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+        _sequence.store(sequence | 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return _buffers[((sequence >> 1) + 1) & 1];
+    }
+
+    void endWrite() {
+        uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+        _sequence.store((sequence | 1) + 1, std::memory_order_release);
+    }
+
+    void publish(const T& value) {
+        beginWrite() = value;
+        endWrite();
+    }
+
+    // Last published value, as seen by the writer itself
+    const T& front() const {
+        return _buffers[(_sequence.load(std::memory_order_relaxed) >> 1) & 1];
+    }
+
+    // ========== READERS (any task) ==========
+
+    const T* beginRead(uint32_t& token) const {
+        token = _sequence.load(std::memory_order_acquire);
+        return &_buffers[(token >> 1) & 1];
+    }
+
+    // True if the buffer returned by beginRead() was not touched meanwhile
+    bool endRead(uint32_t token) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+        // The buffer is rewritten when the writer starts the version after next
+        return sequence - (token & ~1UL) <= 2;
+    }
+
+    // Copy of the last published value. False if the writer kept overwriting it.
+    bool read(T& value) const {
+        for (uint8_t attempt = 0; attempt < SEQ_LOCK_READ_RETRIES; attempt++) {
+            uint32_t token;
+            value = *beginRead(token);
+            if (endRead(token)) return true;
+        }
+        return false;
+    }
+
+    uint32_t getVersion() const {
+        return _sequence.load(std::memory_order_acquire) >> 1;
+    }
+};
+
+#endif // SEQ_LOCK_H
@@ -0,0 +1,188 @@
+/**
+ * DisplayFlush Library Implementation
+ *
+ * Date: 2025
+ */
+
+#include "DisplayFlush.h"
+#include <esp_heap_caps.h>
+
+// Constructor
+DisplayFlush::DisplayFlush() {
+    _tft = nullptr;
+    _buffers[0] = nullptr;
+    _buffers[1] = nullptr;
+    _dmaEnabled = false;
+    _pending = nullptr;
+    _pendingPixels = 0;
+    _transferStartUs = 0;
+    _waitStartUs = 0;
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+bool DisplayFlush::begin(TFT_eSPI* tft, uint16_t width, uint16_t height, uint16_t bufferLines, bool useDma) {
+    if (tft == nullptr || width == 0 || height == 0 || bufferLines == 0 || _tft != nullptr) {
+        return false;
+    }
+    if (bufferLines > height) bufferLines = height;
+    _tft = tft;
+
+    // The SPI DMA engine can only read from internal, DMA-capable RAM
+    uint32_t bufferPixels = (uint32_t)width * bufferLines;
+    _buffers[0] = (lv_color_t*)heap_caps_malloc(bufferPixels * sizeof(lv_color_t), MALLOC_CAP_DMA);
+    if (_buffers[0] == nullptr) {
+        // The blocking flush reads the buffer with the CPU: any RAM will do
+        _buffers[0] = (lv_color_t*)heap_caps_malloc(bufferPixels * sizeof(lv_color_t), MALLOC_CAP_8BIT);
+        useDma = false;
+    }
+    if (_buffers[0] == nullptr) {
+        Serial.println("DisplayFlush: Failed to allocate draw buffer");
+        _tft = nullptr;
+        return false;
+    }
+
+    if (useDma) {
+        _buffers[1] = (lv_color_t*)heap_caps_malloc(bufferPixels * sizeof(lv_color_t), MALLOC_CAP_DMA);
+        _dmaEnabled = _buffers[1] != nullptr && _tft->initDMA();
+        if (!_dmaEnabled) {
+            Serial.println("DisplayFlush: DMA not available, using blocking flush");
+            heap_caps_free(_buffers[1]);
+            _buffers[1] = nullptr;
+        }
+    }
+
+    // LVGL keeps RGB565 in CPU order (LV_COLOR_16_SWAP 0); the panel wants it big-endian
+    _tft->setSwapBytes(true);
+
+    lv_disp_draw_buf_init(&_drawBuf, _buffers[0], _buffers[1], bufferPixels);
+
+    lv_disp_drv_init(&_driver);
+    _driver.hor_res = width;
+    _driver.ver_res = height;
+    _driver.flush_cb = _flushCallback;
+    _driver.wait_cb = _dmaEnabled ? _waitCallback : nullptr;
+    _driver.monitor_cb = _monitorCallback;
+    _driver.draw_buf = &_drawBuf;
+    _driver.user_data = this;
+    lv_disp_drv_register(&_driver);
+
+    resetStats();
+    return true;
+}
+
+// LVGL callbacks
+void DisplayFlush::_flushCallback(lv_disp_drv_t* driver, const lv_area_t* area, lv_color_t* colors) {
+    ((DisplayFlush*)driver->user_data)->_flush(area, colors);
+}
+
+// Called by LVGL while it waits for a buffer that is still being flushed
+void DisplayFlush::_waitCallback(lv_disp_drv_t* driver) {
+    DisplayFlush* self = (DisplayFlush*)driver->user_data;
+    if (self->_pending == nullptr) return;
+
+    if (self->_waitStartUs == 0) self->_waitStartUs = micros() | 1;
+    if (!self->_tft->dmaBusy()) self->_complete();
+}
+
+void DisplayFlush::_monitorCallback(lv_disp_drv_t* driver, uint32_t timeMs, uint32_t pixels) {
+    (void)pixels;
+    DisplayFlush* self = (DisplayFlush*)driver->user_data;
+    self->_stats.frames++;
+    self->_stats.frameTimeMs += timeMs;
+    if (timeMs > self->_stats.maxFrameMs) self->_stats.maxFrameMs = timeMs;
+}
+
+void DisplayFlush::_flush(const lv_area_t* area, lv_color_t* colors) {
+    uint32_t startUs = micros();
+    uint32_t w = (area->x2 - area->x1 + 1);
+    uint32_t h = (area->y2 - area->y1 + 1);
+
+    _stats.flushes++;
+    _stats.pixels += w * h;
+
+    if (!_dmaEnabled) {
+        _tft->startWrite();
+        _tft->setAddrWindow(area->x1, area->y1, w, h);
+        _tft->pushColors((uint16_t*)&colors->full, w * h, true);
+        _tft->endWrite();
+
+        uint32_t elapsedUs = micros() - startUs;
+        _stats.busUs += elapsedUs;
+        _addBlocked(elapsedUs);
+        lv_disp_flush_ready(&_driver);
+        return;
+    }
+
+    // Byte swap happens in place in this buffer; the other one is free for LVGL
+    _tft->startWrite();
+    _tft->pushImageDMA(area->x1, area->y1, w, h, (uint16_t*)&colors->full);
+
+    _pending = &_driver;
+    _pendingPixels = w * h;
+    _transferStartUs = micros();
+    _waitStartUs = 0;
+    _addBlocked(_transferStartUs - startUs);
+}
+
+void DisplayFlush::_complete() {
+    uint32_t nowUs = micros();
+    if (_waitStartUs != 0) {
+        // Someone spun until the end: the elapsed time is the real transfer time
+        _stats.busUs += nowUs - _transferStartUs;
+        _addBlocked(nowUs - _waitStartUs);
+    } else {
+        // Noticed later from service(): use the wire time at the SPI clock instead
+        _stats.busUs += (uint32_t)((uint64_t)_pendingPixels * 16 * 1000000ULL / SPI_FREQUENCY);
+    }
+
+    lv_disp_drv_t* driver = _pending;
+    _pending = nullptr;
+    _tft->endWrite();
+    lv_disp_flush_ready(driver);
+}
+
+void DisplayFlush::_addBlocked(uint32_t us) {
+    _stats.blockedUs += us;
+    if (us > _stats.maxBlockedUs) _stats.maxBlockedUs = us;
+}
+
+void DisplayFlush::service() {
+    if (_pending != nullptr && !_tft->dmaBusy()) {
+        _complete();
+    }
+}
+
+void DisplayFlush::waitIdle() {
+    if (_pending == nullptr) return;
+
+    _waitStartUs = micros() | 1;
+    _tft->dmaWait();
+    _complete();
+}
+
+// Statistics
+void DisplayFlush::resetStats() {
+    memset(&_stats, 0, sizeof(_stats));
+    _stats.dmaEnabled = _dmaEnabled;
+}
+
+void DisplayFlush::printStats() {
+    DisplayFlushStats stats = getStats();
+
+    Serial.print("DisplayFlush: "); Serial.print(stats.dmaEnabled ? "DMA x2" : "blocking");
+    Serial.print("  Frames: "); Serial.print(stats.frames);
+    if (stats.frames > 0) {
+        Serial.print("  Avg frame: "); Serial.print(stats.frameTimeMs / stats.frames);
+        Serial.print(" ms  Max frame: "); Serial.print(stats.maxFrameMs); Serial.print(" ms");
+    }
+    Serial.println();
+
+    // Bus time not spent blocked is time the CPU kept rendering (or running other tasks)
+    uint32_t savedUs = stats.busUs > stats.blockedUs ? stats.busUs - stats.blockedUs : 0;
+    Serial.print("  Flushes: "); Serial.print(stats.flushes);
+    Serial.print("  Pixels: "); Serial.print(stats.pixels);
+    Serial.print("  Bus: "); Serial.print(stats.busUs); Serial.print(" us");
+    Serial.print("  CPU blocked: "); Serial.print(stats.blockedUs); Serial.print(" us");
+    Serial.print(" (max "); Serial.print(stats.maxBlockedUs); Serial.print(" us)");
+    Serial.print("  CPU saved: "); Serial.print(savedUs); Serial.println(" us");
+}
@@ -0,0 +1,93 @@
+/**
+ * DisplayFlush Library - Double-buffered DMA flush for LVGL on TFT_eSPI
+ *
+ * Registers the LVGL display driver with two draw buffers and sends each
+ * rendered stripe to the panel with TFT_eSPI's SPI DMA. The flush callback
+ * only starts the transfer, so LVGL renders the next stripe into the other
+ * buffer while the previous one is still on the bus.
+ *
+ * Features:
+ * - Two DMA-capable draw buffers (internal RAM)
+ * - lv_disp_flush_ready() is signalled when the DMA transfer completes
+ *   (checked from LVGL's wait_cb and from service() in loop())
+ * - Automatic fallback to the blocking pushColors() path if DMA is unavailable
+ * - Performance counters: frame time, bus time, CPU time blocked on the bus
+ *   and CPU time saved by overlapping rendering with the transfer
+ * - Serial report of the statistics
+ *
+ * Date: 2025
+ */
+
+#ifndef DISPLAY_FLUSH_H
+#define DISPLAY_FLUSH_H
+
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <lvgl.h>
+
+#define DISPLAY_FLUSH_DEFAULT_LINES 24       // Stripe height (1/10 of a 240-line screen)
+
+// Snapshot of the flush statistics
+struct DisplayFlushStats {
+    bool dmaEnabled;
+    uint32_t frames;           // LVGL refresh cycles (monitor_cb)
+    uint32_t frameTimeMs;      // Sum of the refresh durations reported by LVGL
+    uint32_t maxFrameMs;       // Longest refresh
+    uint32_t flushes;          // Stripes sent to the panel
+    uint32_t pixels;           // Pixels sent to the panel
+    uint32_t busUs;            // Time the stripes spent on the SPI bus
+    uint32_t blockedUs;        // CPU time spent in the flush path or waiting for the bus
+    uint32_t maxBlockedUs;     // Longest single block of the CPU
+};
+
+class DisplayFlush {
+private:
+    TFT_eSPI* _tft;
+    lv_disp_draw_buf_t _drawBuf;
+    lv_disp_drv_t _driver;
+    lv_color_t* _buffers[2];
+    bool _dmaEnabled;
+
+    // Transfer in flight
+    lv_disp_drv_t* _pending;
+    uint32_t _pendingPixels;
+    uint32_t _transferStartUs;
+    uint32_t _waitStartUs;
+
+    // Statistics
+    DisplayFlushStats _stats;
+
+    static void _flushCallback(lv_disp_drv_t* driver, const lv_area_t* area, lv_color_t* colors);
+    static void _waitCallback(lv_disp_drv_t* driver);
+    static void _monitorCallback(lv_disp_drv_t* driver, uint32_t timeMs, uint32_t pixels);
+
+    void _flush(const lv_area_t* area, lv_color_t* colors);
+    void _complete();
+    void _addBlocked(uint32_t us);
+
+public:
+    DisplayFlush();
+
+    // Allocate the draw buffers and register the LVGL display driver.
+    // Without DMA-capable RAM a single buffer from any RAM is used with the blocking flush;
+    // false only if no buffer could be allocated (no display registered).
+    // lv_init() and tft.init() must have been called before.
+    bool begin(TFT_eSPI* tft, uint16_t width, uint16_t height,
+               uint16_t bufferLines = DISPLAY_FLUSH_DEFAULT_LINES, bool useDma = true);
+
+    // Signal LVGL if the last transfer finished. Call from loop() before lv_timer_handler().
+    void service();
+
+    // Block until the bus is free (e.g. before another SPI device such as the touch controller)
+    void waitIdle();
+
+    bool isDmaEnabled() { return _dmaEnabled; }
+    bool isBusy() { return _pending != nullptr; }
+
+    // Statistics
+    DisplayFlushStats getStats() { return _stats; }
+    void resetStats();
+    void printStats();
+};
+
+#endif // DISPLAY_FLUSH_H
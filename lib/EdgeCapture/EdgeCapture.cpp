@@ -0,0 +1,201 @@
+/**
+ * EdgeCapture Library Implementation
+ *
+ * Date: 2025
+ */
+
+#include "EdgeCapture.h"
+
+// Constructor
+EdgeCapture::EdgeCapture() : _head(0), _tail(0) {
+    memset(_channels, 0, sizeof(_channels));
+    _count = 0;
+    memset(_pinToChannel, EDGE_CAPTURE_NO_CHANNEL, sizeof(_pinToChannel));
+    memset(_queue, 0, sizeof(_queue));
+    _queueEvents = false;
+    memset((void*)&_stats, 0, sizeof(_stats));
+}
+
+EdgeCapture::~EdgeCapture() {
+    end();
+}
+
+int8_t EdgeCapture::addPin(uint8_t pin, uint32_t debounceUs, bool activeLow) {
+    if (pin >= sizeof(_pinToChannel) || _count >= EDGE_CAPTURE_MAX_CHANNELS) {
+        Serial.println("EdgeCapture: Cannot add pin");
+        return EDGE_CAPTURE_NO_CHANNEL;
+    }
+    if (_pinToChannel[pin] != EDGE_CAPTURE_NO_CHANNEL) {
+        return _pinToChannel[pin];
+    }
+
+    pinMode(pin, activeLow ? INPUT_PULLUP : INPUT);
+
+    Channel& channel = _channels[_count];
+    channel.owner = this;
+    channel.pin = pin;
+    channel.activeLow = activeLow;
+    channel.debounceUs = debounceUs;
+    channel.rawActive = _isActiveLevel(channel, digitalRead(pin));
+    channel.active = channel.rawActive;
+    channel.acceptedUs = micros() - debounceUs;
+    channel.activations = 0;
+    channel.deactivations = 0;
+
+    _pinToChannel[pin] = _count;
+    attachInterruptArg(digitalPinToInterrupt(pin), _isr, &channel, CHANGE);
+    return _count++;
+}
+
+int8_t EdgeCapture::getChannel(uint8_t pin) {
+    return pin < sizeof(_pinToChannel) ? _pinToChannel[pin] : EDGE_CAPTURE_NO_CHANNEL;
+}
+
+void EdgeCapture::end() {
+    for (uint8_t i = 0; i < _count; i++) {
+        detachInterrupt(digitalPinToInterrupt(_channels[i].pin));
+        _pinToChannel[_channels[i].pin] = EDGE_CAPTURE_NO_CHANNEL;
+    }
+    _count = 0;
+}
+
+// GPIO interrupt: the pin is read here, so a pulse shorter than the
+// interrupt latency is seen as an edge to the level it already had.
+void IRAM_ATTR EdgeCapture::_isr(void* arg) {
+    Channel& channel = *(Channel*)arg;
+    EdgeCapture* owner = channel.owner;
+    uint32_t now = micros();
+    bool active = owner->_isActiveLevel(channel, digitalRead(channel.pin));
+
+    portENTER_CRITICAL_ISR(&owner->_mux);
+    owner->_onEdge(channel, active, now);
+    portEXIT_CRITICAL_ISR(&owner->_mux);
+}
+
+// Called inside the critical section
+void IRAM_ATTR EdgeCapture::_onEdge(Channel& channel, bool active, uint32_t timestampUs) {
+    _stats.edges++;
+    if (active == channel.rawActive) return;
+    channel.rawActive = active;
+
+    if (active == channel.active) {
+        // Bounced back to the debounced state
+        _stats.bounces++;
+    } else if (timestampUs - channel.acceptedUs >= channel.debounceUs) {
+        // Leading edge: accepted at once
+        _accept(channel, active, timestampUs);
+        _stats.accepted++;
+    } else {
+        // Inside the window: service() decides once it has elapsed
+        _stats.bounces++;
+    }
+}
+
+void IRAM_ATTR EdgeCapture::_accept(Channel& channel, bool active, uint32_t timestampUs) {
+    channel.active = active;
+    channel.acceptedUs = timestampUs;
+    if (active) channel.activations++;
+    else channel.deactivations++;
+
+    if (!_queueEvents) return;
+    uint16_t head = _head.load(std::memory_order_relaxed);
+    uint16_t next = (head + 1) & (EDGE_CAPTURE_QUEUE_SIZE - 1);
+    if (next == _tail.load(std::memory_order_acquire)) {
+        _stats.dropped++;
+        return;
+    }
+    _queue[head].timestampUs = timestampUs;
+    _queue[head].pin = channel.pin;
+    _queue[head].active = active;
+    _head.store(next, std::memory_order_release);
+}
+
+void EdgeCapture::service() {
+    uint32_t now = micros();
+    for (uint8_t i = 0; i < _count; i++) {
+        Channel& channel = _channels[i];
+        if (channel.rawActive == channel.active) continue;
+
+        portENTER_CRITICAL(&_mux);
+        if (channel.rawActive != channel.active && now - channel.acceptedUs >= channel.debounceUs) {
+            _accept(channel, channel.rawActive, now);
+            _stats.settled++;
+        }
+        portEXIT_CRITICAL(&_mux);
+    }
+}
+
+// Channel state
+bool EdgeCapture::isActive(int8_t channel) {
+    if (channel < 0 || channel >= _count) return false;
+    return _channels[channel].active;
+}
+
+uint16_t EdgeCapture::getActivations(int8_t channel) {
+    if (channel < 0 || channel >= _count) return 0;
+    return _channels[channel].activations;
+}
+
+uint16_t EdgeCapture::getDeactivations(int8_t channel) {
+    if (channel < 0 || channel >= _count) return 0;
+    return _channels[channel].deactivations;
+}
+
+uint32_t EdgeCapture::getLastEdgeUs(int8_t channel) {
+    if (channel < 0 || channel >= _count) return 0;
+    return _channels[channel].acceptedUs;
+}
+
+// Event queue
+void EdgeCapture::enableEvents(bool enable) {
+    _queueEvents = enable;
+}
+
+bool EdgeCapture::popEvent(EdgeEvent& event) {
+    uint16_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail == _head.load(std::memory_order_acquire)) return false;
+    event = _queue[tail];
+    _tail.store((tail + 1) & (EDGE_CAPTURE_QUEUE_SIZE - 1), std::memory_order_release);
+    return true;
+}
+
+uint16_t EdgeCapture::getPendingEvents() {
+    uint16_t head = _head.load(std::memory_order_acquire);
+    uint16_t tail = _tail.load(std::memory_order_relaxed);
+    return (head - tail) & (EDGE_CAPTURE_QUEUE_SIZE - 1);
+}
+
+void EdgeCapture::injectEdge(uint8_t pin, int level, uint32_t timestampUs) {
+    int8_t index = getChannel(pin);
+    if (index == EDGE_CAPTURE_NO_CHANNEL) return;
+
+    Channel& channel = _channels[index];
+    portENTER_CRITICAL(&_mux);
+    _onEdge(channel, _isActiveLevel(channel, level), timestampUs);
+    portEXIT_CRITICAL(&_mux);
+}
+
+// Statistics
+EdgeCaptureStats EdgeCapture::getStats() {
+    EdgeCaptureStats stats;
+    portENTER_CRITICAL(&_mux);
+    memcpy(&stats, (const void*)&_stats, sizeof(stats));
+    portEXIT_CRITICAL(&_mux);
+    return stats;
+}
+
+void EdgeCapture::resetStats() {
+    portENTER_CRITICAL(&_mux);
+    memset((void*)&_stats, 0, sizeof(_stats));
+    portEXIT_CRITICAL(&_mux);
+}
+
+void EdgeCapture::printStats() {
+    EdgeCaptureStats stats = getStats();
+    Serial.print("EdgeCapture: "); Serial.print(_count); Serial.print(" pins");
+    Serial.print("  Edges: "); Serial.print(stats.edges);
+    Serial.print("  Accepted: "); Serial.print(stats.accepted);
+    Serial.print("  Bounces: "); Serial.print(stats.bounces);
+    Serial.print("  Settled: "); Serial.print(stats.settled);
+    Serial.print("  Dropped: "); Serial.println(stats.dropped);
+}
@@ -0,0 +1,130 @@
+/**
+ * EdgeCapture Library - Interrupt-driven switch edge capture with debouncing
+ *
+ * Buttons and switches are not polled: a GPIO interrupt on every edge
+ * timestamps it, debounces it and updates the switch state right away, so
+ * a press is seen within the interrupt latency whatever the loop is doing.
+ * Accepted edges can also be queued (lock-free) with their timestamp for
+ * consumers that need the exact order and time of each transition.
+ *
+ * Features:
+ * - One channel per pin, active-low (pull-up) or active-high
+ * - Per-channel debounce state: the first edge is accepted immediately,
+ *   edges within the debounce window after it are bounces. If the pin ends
+ *   the window at a different level, service() accepts it.
+ * - Activation/deactivation counters per channel: consumers keep their own
+ *   "seen" count, so several of them never steal edges from each other
+ * - Optional single-producer/single-consumer queue of accepted edges (EdgeEvent)
+ * - injectEdge() feeds edges with explicit timestamps (host tests/replay)
+ * - Statistics (edges, accepted, bounces, settled by service(), dropped)
+ *
+ * Usage:
+ *   EdgeCapture buttons;
+ *   int8_t fire = buttons.addPin(4);      // INPUT_PULLUP + CHANGE interrupt
+ *   ...
+ *   buttons.service();                    // Periodically (e.g. control tick)
+ *   if (buttons.isActive(fire)) ...
+ *
+ * Date: 2025
+ */
+
+#ifndef EDGE_CAPTURE_H
+#define EDGE_CAPTURE_H
+
+#include <Arduino.h>
+#include <atomic>
+
+#define EDGE_CAPTURE_MAX_CHANNELS 16
+#define EDGE_CAPTURE_QUEUE_SIZE 64          // Power of two
+#define EDGE_CAPTURE_DEBOUNCE_US 5000
+#define EDGE_CAPTURE_NO_CHANNEL -1
+
+// One accepted (debounced) transition
+struct EdgeEvent {
+    uint32_t timestampUs;  // micros() of the edge
+    uint8_t pin;
+    bool active;           // New logical state (pressed / switch closed)
+};
+
+struct EdgeCaptureStats {
+    uint32_t edges;        // Interrupts (or injected edges) processed
+    uint32_t accepted;     // Transitions accepted at the edge
+    uint32_t bounces;      // Edges inside a debounce window
+    uint32_t settled;      // Transitions accepted late by service()
+    uint32_t dropped;      // Accepted edges that did not fit in the queue
+};
+
+class EdgeCapture {
+private:
+    struct Channel {
+        EdgeCapture* owner;
+        uint8_t pin;
+        bool activeLow;
+        uint32_t debounceUs;
+        volatile bool rawActive;         // Last level seen by the interrupt
+        volatile bool active;            // Debounced state
+        volatile uint32_t acceptedUs;    // Time of the last accepted transition
+        volatile uint16_t activations;
+        volatile uint16_t deactivations;
+    };
+
+    Channel _channels[EDGE_CAPTURE_MAX_CHANNELS];
+    uint8_t _count;
+    int8_t _pinToChannel[64];
+
+    // Accepted edges. Pushed inside the capture critical section (interrupt
+    // or service()), popped by one consumer task.
+    EdgeEvent _queue[EDGE_CAPTURE_QUEUE_SIZE];
+    std::atomic<uint16_t> _head;
+    std::atomic<uint16_t> _tail;
+
+    bool _queueEvents;
+
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+    volatile EdgeCaptureStats _stats;
+
+    static void _isr(void* arg);
+    void _onEdge(Channel& channel, bool active, uint32_t timestampUs);
+    void _accept(Channel& channel, bool active, uint32_t timestampUs);
+
+    static bool _isActiveLevel(const Channel& channel, int level) {
+        return channel.activeLow ? level == LOW : level == HIGH;
+    }
+
+public:
+    EdgeCapture();
+    ~EdgeCapture();
+
+    // Configure the pin, read its initial state and attach a CHANGE interrupt.
+    // Returns the channel, or EDGE_CAPTURE_NO_CHANNEL if the table is full.
+    int8_t addPin(uint8_t pin, uint32_t debounceUs = EDGE_CAPTURE_DEBOUNCE_US, bool activeLow = true);
+    int8_t getChannel(uint8_t pin);
+    uint8_t getChannelCount() { return _count; }
+    void end();
+
+    // Accept transitions left pending at the end of a debounce window.
+    // Call periodically from one task (e.g. the control tick).
+    void service();
+
+    // Channel state (lock-free, any task)
+    bool isActive(int8_t channel);
+    uint16_t getActivations(int8_t channel);
+    uint16_t getDeactivations(int8_t channel);
+    uint32_t getLastEdgeUs(int8_t channel);
+
+    // Accepted edges in order (one consumer task). Off by default: nothing
+    // is queued unless a consumer enables it.
+    void enableEvents(bool enable);
+    bool popEvent(EdgeEvent& event);
+    uint16_t getPendingEvents();
+
+    // Process an edge as the interrupt would, with an explicit timestamp
+    void injectEdge(uint8_t pin, int level, uint32_t timestampUs);
+
+    // Statistics
+    EdgeCaptureStats getStats();
+    void resetStats();
+    void printStats();
+};
+
+#endif // EDGE_CAPTURE_H
@@ -0,0 +1,158 @@
+/**
+ * FrequencyHop Library Implementation
+ *
+ * Date: 2025
+ */
+
+#include "FrequencyHop.h"
+
+#define HOP_POOL_SIZE (HOP_CHANNEL_MAX - HOP_CHANNEL_MIN + 1)
+#define HOP_SPACING_TRIES 16
+
+// ========== HopSequence ==========
+
+HopSequence::HopSequence() {
+    for (uint8_t i = 0; i < HOP_SLOTS; i++) {
+        _channels[i] = HOP_CHANNEL_MIN + i * (HOP_POOL_SIZE / HOP_SLOTS);
+    }
+    _blacklist = 0;
+}
+
+// xorshift32 seeded with the address: 32-bit arithmetic only, so an AVR
+// receiver gets the same sequence as the ESP32
+void HopSequence::begin(uint64_t address) {
+    uint32_t state = (uint32_t)address ^ ((uint32_t)(address >> 32) * 0x9E3779B1UL);
+    if (state == 0) state = 0x2545F491UL;
+
+    uint8_t pool[HOP_POOL_SIZE];
+    for (uint8_t i = 0; i < HOP_POOL_SIZE; i++) {
+        pool[i] = HOP_CHANNEL_MIN + i;
+    }
+
+    uint8_t remaining = HOP_POOL_SIZE;
+    for (uint8_t slot = 0; slot < HOP_SLOTS; slot++) {
+        uint8_t index = 0;
+        for (uint8_t tries = 0; tries < HOP_SPACING_TRIES; tries++) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            index = state % remaining;
+            if (slot == 0) break;
+            int16_t spacing = (int16_t)pool[index] - _channels[slot - 1];
+            if (spacing >= HOP_MIN_SPACING || spacing <= -HOP_MIN_SPACING) break;
+        }
+        _channels[slot] = pool[index];
+        pool[index] = pool[--remaining];
+    }
+    _blacklist = 0;
+}
+
+uint8_t HopSequence::getChannel(uint8_t slot) {
+    slot %= HOP_SLOTS;
+    while (slot != HOP_SYNC_SLOT && isBlacklisted(slot)) {
+        slot--;
+    }
+    return _channels[slot];
+}
+
+// ========== HopCodec ==========
+
+uint8_t HopCodec::encode(const HopTrailer& trailer, uint8_t* buffer) {
+    uint32_t offset = trailer.offsetUs / HOP_OFFSET_UNIT_US;
+    buffer[0] = trailer.slot;
+    buffer[1] = offset > 255 ? 255 : offset;
+    buffer[2] = trailer.blacklist & 0xFF;
+    buffer[3] = trailer.blacklist >> 8;
+    return HOP_TRAILER_SIZE;
+}
+
+bool HopCodec::decode(const uint8_t* buffer, HopTrailer& trailer) {
+    if (buffer[0] >= HOP_SLOTS) return false;
+    uint16_t blacklist = buffer[2] | ((uint16_t)buffer[3] << 8);
+    if (blacklist & (1U << HOP_SYNC_SLOT)) return false;
+
+    trailer.slot = buffer[0];
+    trailer.offsetUs = (uint32_t)buffer[1] * HOP_OFFSET_UNIT_US;
+    trailer.blacklist = blacklist;
+    return true;
+}
+
+// ========== HopReceiver ==========
+
+HopReceiver::HopReceiver() {
+    _radio = nullptr;
+    _slotUs = HOP_DEFAULT_SLOT_US;
+    _slot = HOP_SYNC_SLOT;
+    _channel = 0;
+    _slotStartUs = 0;
+    _lastPacketUs = 0;
+    _synced = false;
+    _packets = 0;
+    _syncs = 0;
+    _lostSyncs = 0;
+}
+
+void HopReceiver::begin(RF24* radio, uint64_t address, uint32_t nowUs, uint32_t slotUs) {
+    _radio = radio;
+    _sequence.begin(address);
+    _slotUs = slotUs > HOP_MAX_SLOT_US ? HOP_MAX_SLOT_US : slotUs;
+    _slot = HOP_SYNC_SLOT;
+    _slotStartUs = nowUs;
+    _lastPacketUs = nowUs;
+    _synced = false;
+    _channel = 0xFF;
+    _tune();
+}
+
+void HopReceiver::_tune() {
+    uint8_t channel = _sequence.getChannel(_slot);
+    if (channel != _channel) {
+        _radio->setChannel(channel);
+        _channel = channel;
+    }
+}
+
+void HopReceiver::update(uint32_t nowUs) {
+    if (_radio == nullptr || !_synced) return;
+
+    // Nothing for a while: the clocks may have drifted apart, wait on the sync slot
+    if (nowUs - _lastPacketUs > (uint32_t)HOP_LOST_CYCLES * HOP_SLOTS * _slotUs) {
+        _synced = false;
+        _lostSyncs++;
+        _slot = HOP_SYNC_SLOT;
+        _tune();
+        return;
+    }
+
+    bool hopped = false;
+    while ((int32_t)(nowUs - _slotStartUs) >= (int32_t)_slotUs) {
+        _slotStartUs += _slotUs;
+        _slot = (_slot + 1) % HOP_SLOTS;
+        hopped = true;
+    }
+    if (hopped) _tune();
+}
+
+bool HopReceiver::onPacket(const uint8_t* trailer, uint32_t rxUs) {
+    HopTrailer decoded;
+    if (_radio == nullptr || !HopCodec::decode(trailer, decoded)) return false;
+
+    _sequence.setBlacklist(decoded.blacklist);
+    uint32_t start = rxUs - decoded.offsetUs - HOP_RX_LATENCY_US;
+
+    if (_synced && decoded.slot == _slot) {
+        // Early packets give the best estimate of the transmitter's clock;
+        // late ones may have waited for a retry or for this loop
+        int32_t error = (int32_t)(start - _slotStartUs);
+        _slotStartUs += error < 0 ? error : error / HOP_DRIFT_DIV;
+    } else {
+        if (!_synced) _syncs++;
+        _slot = decoded.slot;
+        _slotStartUs = start;
+        _synced = true;
+    }
+    _lastPacketUs = rxUs;
+    _packets++;
+    _tune();
+    return true;
+}
@@ -0,0 +1,143 @@
+/**
+ * FrequencyHop Library - Pseudo-random frequency hopping for an nRF24 link
+ *
+ * A single channel is only as good as the 2.4 GHz traffic sitting on it.
+ * Both ends derive the same sequence of HOP_SLOTS channels from the pipe
+ * address and move through it in time slots of a fixed length: a WiFi
+ * network or another transmitter on some channels costs the slots on those
+ * channels instead of the whole link. Slots whose channel shows a carrier
+ * are blacklisted by the transmitter and replaced by a clean channel of the
+ * sequence at both ends.
+ *
+ * Every packet ends with a HOP_TRAILER_SIZE trailer: slot number, time into
+ * the slot and blacklist. The receiver hops on its own clock between
+ * packets (the transmit rate may drop to a heartbeat) and re-aligns its
+ * slot boundaries on every packet it gets. After HOP_LOST_CYCLES cycles
+ * without packets it parks on the sync slot channel, where the transmitter
+ * sends at least once per cycle, and locks again on the first packet.
+ *
+ * Slot layout: the transmitter ticks at a fixed rate and the slot
+ * boundaries fall a guard time before its ticks, so the receiver may be
+ * off by up to the guard time without missing a packet.
+ *
+ * Trailer layout (HOP_TRAILER_SIZE bytes, little endian):
+ *   byte 0    slot (0 to HOP_SLOTS - 1)
+ *   byte 1    time into the slot at transmission, HOP_OFFSET_UNIT_US units
+ *   byte 2-3  blacklist, one bit per slot (bit 0, the sync slot, is never set)
+ *
+ * Features:
+ * - HopSequence: channels from the address (HOP_CHANNEL_MIN-HOP_CHANNEL_MAX,
+ *   all different, at least HOP_MIN_SPACING apart between consecutive slots)
+ *   and blacklist substitution
+ * - HopCodec: trailer encode/decode
+ * - HopReceiver (receiver): slot clock, re-alignment, loss of sync and
+ *   parking on the sync slot
+ * - HopTransmitter (transmitter, HopTransmitter.h): slot clock, carrier
+ *   survey and blacklist
+ * - FrequencyHop.h/.cpp do not depend on the ESP32 core, so the receiver
+ *   (e.g. an Arduino Nano) can build them as they are
+ *
+ * Usage (receiver):
+ *   hop.begin(&radio, address, micros());         // After startListening()
+ *   hop.update(micros());                          // Every loop
+ *   hop.onPacket(frame + dataLength, micros());    // Every packet received
+ *
+ * Date: 2025
+ */
+
+#ifndef FREQUENCY_HOP_H
+#define FREQUENCY_HOP_H
+
+#include <Arduino.h>
+#include <RF24.h>
+
+#define HOP_SLOTS 16
+#define HOP_SYNC_SLOT 0
+#define HOP_CHANNEL_MIN 2                 // 2402 MHz
+#define HOP_CHANNEL_MAX 81                // 2481 MHz: inside the 2.4 GHz ISM band
+#define HOP_MIN_SPACING 8                 // MHz between consecutive slots
+#define HOP_TRAILER_SIZE 4
+#define HOP_OFFSET_UNIT_US 100
+#define HOP_DEFAULT_SLOT_US 20000UL       // 4 control ticks at 200 Hz
+#define HOP_DEFAULT_GUARD_US 2500UL       // Half a control tick
+#define HOP_MAX_SLOT_US (255UL * HOP_OFFSET_UNIT_US)
+#define HOP_RX_LATENCY_US 1000            // Transmission -> read at the receiver (250 kbps frame)
+#define HOP_LOST_CYCLES 2                 // Cycles without packets before parking
+#define HOP_DRIFT_DIV 8                   // Late packets move the slot clock 1/8 of the error
+
+class HopSequence {
+private:
+    uint8_t _channels[HOP_SLOTS];
+    uint16_t _blacklist;
+
+public:
+    HopSequence();
+
+    // Same address = same sequence at both ends
+    void begin(uint64_t address);
+
+    // Channel used in a slot: its own, or the one of the closest slot before
+    // it that is not blacklisted
+    uint8_t getChannel(uint8_t slot);
+    uint8_t getBaseChannel(uint8_t slot) { return _channels[slot % HOP_SLOTS]; }
+
+    void setBlacklist(uint16_t blacklist) { _blacklist = blacklist & ~(1U << HOP_SYNC_SLOT); }
+    uint16_t getBlacklist() { return _blacklist; }
+    bool isBlacklisted(uint8_t slot) { return _blacklist & (1U << (slot % HOP_SLOTS)); }
+};
+
+struct HopTrailer {
+    uint8_t slot;
+    uint32_t offsetUs;      // Time into the slot when the packet was sent
+    uint16_t blacklist;
+};
+
+class HopCodec {
+public:
+    static uint8_t encode(const HopTrailer& trailer, uint8_t* buffer);
+    // False if the trailer is out of range
+    static bool decode(const uint8_t* buffer, HopTrailer& trailer);
+};
+
+class HopReceiver {
+private:
+    RF24* _radio;
+    HopSequence _sequence;
+    uint32_t _slotUs;
+
+    uint8_t _slot;
+    uint8_t _channel;         // Channel the radio is on
+    uint32_t _slotStartUs;
+    uint32_t _lastPacketUs;
+    bool _synced;
+
+    uint32_t _packets;
+    uint32_t _syncs;          // Times the receiver locked (first packet after parking)
+    uint32_t _lostSyncs;      // Times it gave up and parked
+
+    void _tune();
+
+public:
+    HopReceiver();
+
+    // The radio must be listening. Starts parked on the sync slot.
+    void begin(RF24* radio, uint64_t address, uint32_t nowUs, uint32_t slotUs = HOP_DEFAULT_SLOT_US);
+
+    // Every loop (at least a few times per slot): hops at the slot boundaries
+    void update(uint32_t nowUs);
+    // Trailer of a packet just read; re-aligns slot, clock and blacklist.
+    // False if the trailer is not valid.
+    bool onPacket(const uint8_t* trailer, uint32_t rxUs);
+
+    bool isSynced() { return _synced; }
+    uint8_t getSlot() { return _slot; }
+    uint8_t getChannel() { return _sequence.getChannel(_slot); }
+    uint16_t getBlacklist() { return _sequence.getBlacklist(); }
+    HopSequence& getSequence() { return _sequence; }
+
+    uint32_t getPackets() { return _packets; }
+    uint32_t getSyncs() { return _syncs; }
+    uint32_t getLostSyncs() { return _lostSyncs; }
+};
+
+#endif // FREQUENCY_HOP_H
@@ -0,0 +1,171 @@
+/**
+ * HopTransmitter Implementation
+ *
+ * Date: 2025
+ */
+
+#include "HopTransmitter.h"
+
+static uint8_t countBits(uint16_t value) {
+    uint8_t count = 0;
+    while (value) {
+        value &= value - 1;
+        count++;
+    }
+    return count;
+}
+
+HopTransmitter::HopTransmitter() {
+    _radio = nullptr;
+    _slotUs = HOP_DEFAULT_SLOT_US;
+    _slot = HOP_SYNC_SLOT;
+    _channel = 0;
+    _slotStartUs = 0;
+
+    _surveyUs = HOP_DEFAULT_SURVEY_US;
+    _lastSurveyUs = 0;
+    _surveySlot = 0;
+    memset(_carrier, 0, sizeof(_carrier));
+
+    _statsMux = portMUX_INITIALIZER_UNLOCKED;
+    resetStats();
+}
+
+bool HopTransmitter::begin(RF24* radio, uint64_t address, uint32_t nowUs, uint32_t slotUs, uint32_t guardUs) {
+    if (radio == nullptr) {
+        Serial.println("HopTransmitter: No radio");
+        return false;
+    }
+    if (slotUs == 0 || slotUs > HOP_MAX_SLOT_US || guardUs >= slotUs) {
+        Serial.println("HopTransmitter: Invalid slot length");
+        return false;
+    }
+
+    _radio = radio;
+    _sequence.begin(address);
+    _slotUs = slotUs;
+    _slot = HOP_SYNC_SLOT;
+    _slotStartUs = nowUs - guardUs;
+    _lastSurveyUs = nowUs;
+    _surveySlot = 0;
+    memset(_carrier, 0, sizeof(_carrier));
+    resetStats();
+    _tune();
+    return true;
+}
+
+void HopTransmitter::_tune() {
+    _channel = _sequence.getChannel(_slot);
+    _radio->setChannel(_channel);
+}
+
+void HopTransmitter::hop(uint32_t nowUs) {
+    if (_radio == nullptr) return;
+
+    uint32_t slots = (nowUs - _slotStartUs) / _slotUs;
+    if (slots == 0) return;
+    _slotStartUs += slots * _slotUs;
+    _slot = (_slot + slots) % HOP_SLOTS;
+    _tune();
+
+    portENTER_CRITICAL(&_statsMux);
+    _stats.hops++;
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+uint8_t HopTransmitter::writeTrailer(uint8_t* buffer, uint32_t nowUs) {
+    HopTrailer trailer;
+    trailer.slot = _slot;
+    trailer.offsetUs = nowUs - _slotStartUs;
+    trailer.blacklist = _sequence.getBlacklist();
+    return HopCodec::encode(trailer, buffer);
+}
+
+bool HopTransmitter::survey(uint32_t nowUs) {
+    if (_radio == nullptr || _surveyUs == 0 || nowUs - _lastSurveyUs < _surveyUs) return false;
+    _lastSurveyUs = nowUs;
+    uint32_t startUs = micros();
+
+    // RPD is only valid after 170 us in RX on the channel
+    uint8_t slot = _surveySlot;
+    _surveySlot = (_surveySlot + 1) % HOP_SLOTS;
+    _radio->setChannel(_sequence.getBaseChannel(slot));
+    _radio->startListening();
+    delayMicroseconds(HOP_RPD_SETTLE_US);
+    bool carrier = _radio->testCarrier();
+    _radio->stopListening();
+
+    _carrier[slot] = (_carrier[slot] << 1) | (carrier ? 1 : 0);
+    bool changed = _updateBlacklist(slot);
+    _tune();   // Back to this slot's channel (changed if it was just blacklisted)
+
+    uint32_t elapsedUs = micros() - startUs;
+    portENTER_CRITICAL(&_statsMux);
+    _stats.surveys++;
+    if (carrier) _stats.carrierHits++;
+    if (changed) {
+        _stats.blacklistChanges++;
+        _stats.blacklist = _sequence.getBlacklist();
+        _stats.blacklisted = countBits(_stats.blacklist);
+    }
+    if (elapsedUs > _stats.maxSurveyUs) _stats.maxSurveyUs = elapsedUs;
+    portEXIT_CRITICAL(&_statsMux);
+    return true;
+}
+
+// Blacklist with hysteresis: in after HOP_BLACKLIST_HITS hits, out after a clean history
+bool HopTransmitter::_updateBlacklist(uint8_t slot) {
+    if (slot == HOP_SYNC_SLOT) return false;
+
+    uint16_t blacklist = _sequence.getBlacklist();
+    uint16_t bit = 1U << slot;
+    uint8_t hits = countBits(_carrier[slot]);
+
+    if (!(blacklist & bit) && hits >= HOP_BLACKLIST_HITS && countBits(blacklist) < HOP_MAX_BLACKLISTED) {
+        _sequence.setBlacklist(blacklist | bit);
+        return true;
+    }
+    if ((blacklist & bit) && hits == 0) {
+        _sequence.setBlacklist(blacklist & ~bit);
+        return true;
+    }
+    return false;
+}
+
+// Statistics
+HopTransmitterStats HopTransmitter::getStats() {
+    HopTransmitterStats stats;
+
+    portENTER_CRITICAL(&_statsMux);
+    stats = _stats;
+    portEXIT_CRITICAL(&_statsMux);
+
+    return stats;
+}
+
+void HopTransmitter::resetStats() {
+    portENTER_CRITICAL(&_statsMux);
+    memset(&_stats, 0, sizeof(_stats));
+    _stats.blacklist = _sequence.getBlacklist();
+    _stats.blacklisted = countBits(_stats.blacklist);
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+void HopTransmitter::printStats() {
+    HopTransmitterStats stats = getStats();
+
+    Serial.print("HopTransmitter: hops: "); Serial.print(stats.hops);
+    Serial.print("  Surveys: "); Serial.print(stats.surveys);
+    Serial.print(" ("); Serial.print(stats.carrierHits); Serial.print(" with carrier, longest ");
+    Serial.print(stats.maxSurveyUs); Serial.println(" us)");
+
+    Serial.print("HopTransmitter: blacklisted "); Serial.print(stats.blacklisted);
+    Serial.print("/"); Serial.print(HOP_SLOTS);
+    Serial.print(" (changes: "); Serial.print(stats.blacklistChanges); Serial.print(")");
+    for (uint8_t slot = 0; slot < HOP_SLOTS; slot++) {
+        if (stats.blacklist & (1U << slot)) {
+            Serial.print(" ch"); Serial.print(_sequence.getBaseChannel(slot));
+        }
+    }
+    Serial.println();
+}
@@ -0,0 +1,110 @@
+/**
+ * HopTransmitter - Transmitter side of the frequency hopping link
+ *
+ * Keeps the slot clock, tunes the radio at every slot boundary and writes
+ * the trailer of each packet (see FrequencyHop.h). While the TX FIFO is
+ * empty it samples the carrier on the channels of the sequence, one per
+ * survey interval: the radio listens for HOP_RPD_SETTLE_US and the RPD bit
+ * says whether something above -64 dBm is on the air. A sample blocks for
+ * the settle time plus the RX -> TX turnaround of stopListening(). A slot whose channel shows
+ * a carrier in HOP_BLACKLIST_HITS of its last HOP_SURVEY_HISTORY samples is
+ * blacklisted (at most HOP_MAX_BLACKLISTED, never the sync slot) and comes
+ * back once HOP_SURVEY_HISTORY samples in a row are clean.
+ *
+ * Features:
+ * - isHopDue()/hop(): slot clock; the caller empties the TX FIFO first
+ * - Sync slot flag: the caller sends at least once in it (receiver lock)
+ * - writeTrailer(): slot, time into the slot and blacklist of this packet
+ * - survey(): carrier sample while the TX FIFO is empty, blacklist update
+ * - Statistics: hops, surveys, carrier hits, blacklist changes, longest
+ *   survey
+ *
+ * Usage (every control tick):
+ *   tx.poll(now);
+ *   if (hop.isHopDue(now)) { tx.flush(now); hop.hop(now); }
+ *   if (tx.isIdle()) hop.survey(now);
+ *   if (send) { ...frame + hop.writeTrailer(frame + length, micros())...; }
+ *
+ * Date: 2025
+ */
+
+#ifndef HOP_TRANSMITTER_H
+#define HOP_TRANSMITTER_H
+
+#include <Arduino.h>
+#include <RF24.h>
+#include "FrequencyHop.h"
+
+#define HOP_SURVEY_HISTORY 8
+#define HOP_BLACKLIST_HITS 3              // Carrier in 3 of the last 8 samples
+#define HOP_MAX_BLACKLISTED (HOP_SLOTS / 2)
+#define HOP_RPD_SETTLE_US 200             // RX time before RPD is valid (170 us + margin)
+#define HOP_DEFAULT_SURVEY_US 20000UL     // One channel per slot: all of them every 320 ms
+
+struct HopTransmitterStats {
+    uint32_t hops;
+    uint32_t surveys;
+    uint32_t carrierHits;       // Surveys that found a carrier
+    uint32_t blacklistChanges;
+    uint32_t maxSurveyUs;       // Longest time spent inside survey()
+    uint16_t blacklist;         // Current blacklist
+    uint8_t blacklisted;        // Slots in it
+};
+
+class HopTransmitter {
+private:
+    RF24* _radio;
+    HopSequence _sequence;
+    uint32_t _slotUs;
+
+    uint8_t _slot;
+    uint8_t _channel;
+    uint32_t _slotStartUs;
+
+    uint32_t _surveyUs;         // 0 = no survey, no blacklist
+    uint32_t _lastSurveyUs;
+    uint8_t _surveySlot;
+    uint8_t _carrier[HOP_SLOTS];    // Last samples per slot, newest in bit 0
+
+    // Statistics (written by the transmitting task only)
+    portMUX_TYPE _statsMux;
+    HopTransmitterStats _stats;
+
+    void _tune();
+    bool _updateBlacklist(uint8_t slot);
+
+public:
+    HopTransmitter();
+
+    // The radio must be started and in TX mode. The slot clock starts so that
+    // a tick at nowUs falls guardUs into slot HOP_SYNC_SLOT.
+    bool begin(RF24* radio, uint64_t address, uint32_t nowUs,
+               uint32_t slotUs = HOP_DEFAULT_SLOT_US, uint32_t guardUs = HOP_DEFAULT_GUARD_US);
+    void setSurveyInterval(uint32_t surveyUs) { _surveyUs = surveyUs; }
+
+    // The slot of nowUs is not the current one
+    bool isHopDue(uint32_t nowUs) { return nowUs - _slotStartUs >= _slotUs; }
+    // Move to the slot of nowUs and tune the radio (TX FIFO empty)
+    void hop(uint32_t nowUs);
+    bool isSyncSlot() { return _slot == HOP_SYNC_SLOT; }
+
+    // Trailer for a packet transmitted now; returns HOP_TRAILER_SIZE
+    uint8_t writeTrailer(uint8_t* buffer, uint32_t nowUs);
+
+    // Carrier sample on the next channel of the sequence, if the survey
+    // interval passed. Only while nothing is queued (it leaves TX mode);
+    // the radio is back on the slot channel when it returns.
+    bool survey(uint32_t nowUs);
+
+    uint8_t getSlot() { return _slot; }
+    uint8_t getChannel() { return _channel; }
+    uint16_t getBlacklist() { return _sequence.getBlacklist(); }
+    HopSequence& getSequence() { return _sequence; }
+
+    // Statistics
+    HopTransmitterStats getStats();
+    void resetStats();
+    void printStats();
+};
+
+#endif // HOP_TRANSMITTER_H
@@ -0,0 +1,58 @@
+/**
+ * EEPROM Implementation (host)
+ *
+ * Date: 2025
+ */
+
+#include "EEPROM.h"
+
+EEPROMClass EEPROM;
+
+namespace {
+
+// Contents survive end()/begin() like the flash sector on the target
+std::vector<uint8_t> flash;
+uint32_t commits = 0;
+
+}
+
+namespace HostMock {
+
+void clearEEPROM() {
+    flash.clear();
+    EEPROM.end();
+    commits = 0;
+}
+
+uint32_t getEEPROMCommits() {
+    return commits;
+}
+
+}
+
+bool EEPROMClass::begin(size_t size) {
+    if (size == 0) return false;
+    if (flash.size() < size) flash.resize(size, 0xFF); // Erased flash reads 0xFF
+    _data.assign(flash.begin(), flash.begin() + size);
+    return true;
+}
+
+void EEPROMClass::end() {
+    _data.clear();
+}
+
+bool EEPROMClass::commit() {
+    if (_data.empty()) return false;
+    std::copy(_data.begin(), _data.end(), flash.begin());
+    commits++;
+    return true;
+}
+
+uint8_t EEPROMClass::read(int address) {
+    if (address < 0 || (size_t)address >= _data.size()) return 0;
+    return _data[address];
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+    if (address >= 0 && (size_t)address < _data.size()) _data[address] = value;
+}
@@ -0,0 +1,46 @@
+/**
+ * EEPROM.h - Host (env:native) emulated EEPROM
+ *
+ * Date: 2025
+ */
+
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include <Arduino.h>
+#include <vector>
+
+class EEPROMClass {
+private:
+    std::vector<uint8_t> _data;
+
+public:
+    bool begin(size_t size);
+    void end();
+    bool commit();
+
+    uint8_t read(int address);
+    void write(int address, uint8_t value);
+    size_t length() { return _data.size(); }
+    uint8_t* getDataPtr() { return _data.empty() ? nullptr : _data.data(); }
+
+    template <typename T>
+    T& get(int address, T& value) {
+        if (address >= 0 && address + sizeof(T) <= _data.size()) {
+            memcpy(&value, &_data[address], sizeof(T));
+        }
+        return value;
+    }
+
+    template <typename T>
+    const T& put(int address, const T& value) {
+        if (address >= 0 && address + sizeof(T) <= _data.size()) {
+            memcpy(&_data[address], &value, sizeof(T));
+        }
+        return value;
+    }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // HOST_EEPROM_H
@@ -0,0 +1,96 @@
+/**
+ * Print / HardwareSerial Implementation (host)
+ *
+ * Date: 2025
+ */
+
+#include <Arduino.h>
+
+HardwareSerial Serial;
+
+namespace HostMock {
+bool serialOutputEnabled();
+}
+
+// Print
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        n += write(*buffer++);
+    }
+    return n;
+}
+
+size_t Print::write(const char* str) {
+    if (str == nullptr) return 0;
+    return write((const uint8_t*)str, strlen(str));
+}
+
+size_t Print::_printNumber(unsigned long long value, bool negative, int base) {
+    String text(value, (unsigned char)(base < 2 ? 10 : base));
+    size_t n = 0;
+    if (negative) n += write('-');
+    return n + write(text.c_str());
+}
+
+size_t Print::_printFloat(double value, int digits) {
+    if (isnan(value)) return write("nan");
+    if (isinf(value)) return write("inf");
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+    return write(buffer);
+}
+
+size_t Print::print(const char* str) { return write(str); }
+size_t Print::print(const String& str) { return write(str.c_str()); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+size_t Print::print(unsigned char value, int base) { return print((unsigned long long)value, base); }
+size_t Print::print(int value, int base) { return print((long long)value, base); }
+size_t Print::print(unsigned int value, int base) { return print((unsigned long long)value, base); }
+size_t Print::print(long value, int base) { return print((long long)value, base); }
+size_t Print::print(unsigned long value, int base) { return print((unsigned long long)value, base); }
+
+size_t Print::print(long long value, int base) {
+    if (base == 0) return write((uint8_t)value);
+    if (base == DEC && value < 0) return _printNumber(0ULL - (unsigned long long)value, true, DEC);
+    return _printNumber((unsigned long long)value, false, base);
+}
+
+size_t Print::print(unsigned long long value, int base) {
+    if (base == 0) return write((uint8_t)value);
+    return _printNumber(value, false, base);
+}
+
+size_t Print::print(double value, int digits) { return _printFloat(value, digits); }
+
+size_t Print::println() { return write("\r\n"); }
+
+size_t Print::printf(const char* format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length < 0) return 0;
+    if ((size_t)length >= sizeof(buffer)) length = sizeof(buffer) - 1;
+    return write((const uint8_t*)buffer, length);
+}
+
+// HardwareSerial
+size_t HardwareSerial::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    if (HostMock::serialOutputEnabled()) {
+        // Drop the carriage returns println() adds, the terminal does not need them
+        for (size_t i = 0; i < size; i++) {
+            if (buffer[i] != '\r') fputc(buffer[i], stdout);
+        }
+    }
+    return size;
+}
+
+void HardwareSerial::flush() {
+    fflush(stdout);
+}
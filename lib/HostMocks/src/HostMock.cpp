@@ -0,0 +1,423 @@
+/**
+ * HostMock Implementation - clock, GPIO, interrupts, tasks and esp_timer
+ *
+ * Date: 2025
+ */
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <soc/gpio_reg.h>
+#include "HostMock.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+struct HostTask {
+    TaskFunction_t function;
+    void* parameters;
+    uint32_t notifications;
+};
+
+struct esp_timer {
+    esp_timer_cb_t callback;
+    void* arg;
+    uint64_t periodUs;      // 0 = one-shot
+    uint64_t expiryUs;
+    bool armed;
+};
+
+struct HostInterrupt {
+    void (*handler)(void);
+    void (*handlerArg)(void*);
+    void* arg;
+    int mode;
+};
+
+namespace {
+
+bool realClock = false;
+uint64_t virtualUs = 0;
+std::chrono::steady_clock::time_point realStart = std::chrono::steady_clock::now();
+
+int analogValues[HOST_MOCK_PIN_COUNT];
+int digitalLevels[HOST_MOCK_PIN_COUNT];
+int digitalOutputs[HOST_MOCK_PIN_COUNT];
+int pinModes[HOST_MOCK_PIN_COUNT];
+bool digitalScripted[HOST_MOCK_PIN_COUNT];
+HostInterrupt interruptTable[HOST_MOCK_PIN_COUNT];
+uint32_t analogReads = 0;
+uint32_t digitalReads = 0;
+uint32_t gpioRegisterReads = 0;
+
+std::vector<esp_timer*> timers;
+std::vector<HostTask*> tasks;
+
+uint32_t randomState = 1;
+bool serialOutput = true;
+
+void fireInterrupt(uint8_t pin, int previous, int level) {
+    HostInterrupt& isr = interruptTable[pin];
+    if (isr.handler == nullptr && isr.handlerArg == nullptr) return;
+
+    bool fire = false;
+    switch (isr.mode) {
+        case RISING:  fire = previous == LOW && level == HIGH; break;
+        case FALLING: fire = previous == HIGH && level == LOW; break;
+        case CHANGE:  fire = previous != level; break;
+        case ONLOW:   fire = level == LOW; break;
+        case ONHIGH:  fire = level == HIGH; break;
+    }
+    if (!fire) return;
+
+    if (isr.handler) isr.handler();
+    else isr.handlerArg(isr.arg);
+}
+
+// Earliest armed timer expiring at or before limitUs
+esp_timer* nextTimer(uint64_t limitUs) {
+    esp_timer* next = nullptr;
+    for (esp_timer* timer : timers) {
+        if (!timer->armed || timer->expiryUs > limitUs) continue;
+        if (next == nullptr || timer->expiryUs < next->expiryUs) next = timer;
+    }
+    return next;
+}
+
+}
+
+namespace HostMock {
+
+void clearPreferences();
+void clearEEPROM();
+void resetRadio();
+
+bool serialOutputEnabled() {
+    return serialOutput;
+}
+
+void reset() {
+    realClock = false;
+    virtualUs = 0;
+    memset(analogValues, 0, sizeof(analogValues));
+    memset(digitalLevels, 0, sizeof(digitalLevels));
+    memset(digitalOutputs, 0, sizeof(digitalOutputs));
+    memset(pinModes, 0, sizeof(pinModes));
+    memset(digitalScripted, 0, sizeof(digitalScripted));
+    memset(interruptTable, 0, sizeof(interruptTable));
+    analogReads = 0;
+    digitalReads = 0;
+    gpioRegisterReads = 0;
+
+    for (esp_timer* timer : timers) timer->armed = false;
+    randomState = 1;
+
+    clearPreferences();
+    clearEEPROM();
+    resetRadio();
+}
+
+void useRealClock(bool enable) {
+    if (enable && !realClock) {
+        realStart = std::chrono::steady_clock::now() - std::chrono::microseconds(virtualUs);
+    } else if (!enable && realClock) {
+        virtualUs = nowUs();
+    }
+    realClock = enable;
+}
+
+bool isRealClock() {
+    return realClock;
+}
+
+void setTimeUs(uint64_t us) {
+    if (us > virtualUs) advanceUs(us - virtualUs);
+    else virtualUs = us;
+}
+
+void advanceUs(uint64_t us) {
+    if (realClock) {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+        return;
+    }
+
+    uint64_t targetUs = virtualUs + us;
+    esp_timer* timer;
+    while ((timer = nextTimer(targetUs)) != nullptr) {
+        virtualUs = timer->expiryUs;
+        if (timer->periodUs > 0) {
+            timer->expiryUs += timer->periodUs;
+        } else {
+            timer->armed = false;
+        }
+        timer->callback(timer->arg);
+    }
+    virtualUs = targetUs;
+}
+
+uint64_t nowUs() {
+    if (realClock) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - realStart).count();
+    }
+    return virtualUs;
+}
+
+void setAnalog(uint8_t pin, int value) {
+    if (pin < HOST_MOCK_PIN_COUNT) analogValues[pin] = value;
+}
+
+void setDigital(uint8_t pin, int value) {
+    if (pin >= HOST_MOCK_PIN_COUNT) return;
+    int previous = digitalLevels[pin];
+    digitalLevels[pin] = value ? HIGH : LOW;
+    digitalScripted[pin] = true;
+    fireInterrupt(pin, previous, digitalLevels[pin]);
+}
+
+int getDigitalOutput(uint8_t pin) {
+    return pin < HOST_MOCK_PIN_COUNT ? digitalOutputs[pin] : LOW;
+}
+
+int getPinMode(uint8_t pin) {
+    return pin < HOST_MOCK_PIN_COUNT ? pinModes[pin] : 0;
+}
+
+uint32_t getAnalogReadCount() {
+    return analogReads;
+}
+
+uint32_t getDigitalReadCount() {
+    return digitalReads;
+}
+
+// One bit per pin, like the GPIO_IN registers of the target
+uint32_t readRegister(uint32_t reg) {
+    uint8_t first;
+    if (reg == GPIO_IN_REG) first = 0;
+    else if (reg == GPIO_IN1_REG) first = 32;
+    else return 0;
+
+    gpioRegisterReads++;
+    uint32_t levels = 0;
+    for (uint8_t bit = 0; bit < 32 && first + bit < HOST_MOCK_PIN_COUNT; bit++) {
+        if (digitalLevels[first + bit] == HIGH) levels |= 1UL << bit;
+    }
+    return levels;
+}
+
+uint32_t getGpioRegisterReadCount() {
+    return gpioRegisterReads;
+}
+
+void setSerialOutput(bool enable) {
+    fflush(stdout);
+    serialOutput = enable;
+}
+
+}
+
+// Time
+unsigned long millis() {
+    return (uint32_t)(HostMock::nowUs() / 1000);
+}
+
+// Wraps at 32 bits like the target
+unsigned long micros() {
+    return (uint32_t)HostMock::nowUs();
+}
+
+void delay(uint32_t ms) {
+    HostMock::advanceUs((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us) {
+    HostMock::advanceUs(us);
+}
+
+void yield() {}
+
+// GPIO
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin >= HOST_MOCK_PIN_COUNT) return;
+    pinModes[pin] = mode;
+    // An unconnected input with pull-up reads HIGH until the host drives it
+    if (!digitalScripted[pin]) {
+        digitalLevels[pin] = (mode & PULLUP) ? HIGH : LOW;
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if (pin < HOST_MOCK_PIN_COUNT) digitalOutputs[pin] = value ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+    digitalReads++;
+    return pin < HOST_MOCK_PIN_COUNT ? digitalLevels[pin] : LOW;
+}
+
+uint16_t analogRead(uint8_t pin) {
+    analogReads++;
+    return pin < HOST_MOCK_PIN_COUNT ? (uint16_t)analogValues[pin] : 0;
+}
+
+void analogReadResolution(uint8_t bits) {
+    (void)bits;
+}
+
+void analogWrite(uint8_t pin, int value) {
+    if (pin < HOST_MOCK_PIN_COUNT) digitalOutputs[pin] = value;
+}
+
+// Interrupts
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode) {
+    if (pin >= HOST_MOCK_PIN_COUNT) return;
+    interruptTable[pin].handler = handler;
+    interruptTable[pin].handlerArg = nullptr;
+    interruptTable[pin].arg = nullptr;
+    interruptTable[pin].mode = mode;
+}
+
+void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* arg, int mode) {
+    if (pin >= HOST_MOCK_PIN_COUNT) return;
+    interruptTable[pin].handler = nullptr;
+    interruptTable[pin].handlerArg = handler;
+    interruptTable[pin].arg = arg;
+    interruptTable[pin].mode = mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+    if (pin < HOST_MOCK_PIN_COUNT) memset(&interruptTable[pin], 0, sizeof(HostInterrupt));
+}
+
+void noInterrupts() {}
+void interrupts() {}
+
+// Math
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    long divisor = inMax - inMin;
+    if (divisor == 0) return -1; // Same guard as the ESP32 core
+    return (x - inMin) * (outMax - outMin) / divisor + outMin;
+}
+
+// Deterministic across runs unless reseeded (the target seeds from hardware RNG)
+long random(long howBig) {
+    if (howBig <= 0) return 0;
+    randomState = randomState * 1103515245UL + 12345UL;
+    return (long)((randomState >> 1) % (uint32_t)howBig);
+}
+
+long random(long howSmall, long howBig) {
+    if (howSmall >= howBig) return howSmall;
+    return howSmall + random(howBig - howSmall);
+}
+
+void randomSeed(unsigned long seed) {
+    if (seed != 0) randomState = (uint32_t)seed;
+}
+
+// FreeRTOS tasks: recorded, never scheduled
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stackDepth,
+                       void* parameters, UBaseType_t priority, TaskHandle_t* handle) {
+    (void)name;
+    (void)stackDepth;
+    (void)priority;
+    HostTask* task = new HostTask{function, parameters, 0};
+    tasks.push_back(task);
+    if (handle) *handle = task;
+    return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth,
+                                   void* parameters, UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t core) {
+    (void)core;
+    return xTaskCreate(function, name, stackDepth, parameters, priority, handle);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    for (size_t i = 0; i < tasks.size(); i++) {
+        if (tasks[i] == task) {
+            delete task;
+            tasks.erase(tasks.begin() + i);
+            return;
+        }
+    }
+}
+
+void vTaskDelay(TickType_t ticks) {
+    HostMock::advanceUs((uint64_t)ticks * portTICK_PERIOD_MS * 1000);
+}
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)(HostMock::nowUs() / (portTICK_PERIOD_MS * 1000));
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    if (task) task->notifications++;
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken) {
+    xTaskNotifyGive(task);
+    if (higherPriorityTaskWoken) *higherPriorityTaskWoken = pdFALSE;
+}
+
+// Only meaningful if a host program runs a task body by hand; never blocks
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticksToWait) {
+    (void)clearOnExit;
+    (void)ticksToWait;
+    return 0;
+}
+
+// esp_timer on the virtual clock
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* handle) {
+    if (args == nullptr || args->callback == nullptr || handle == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_timer* timer = new esp_timer{args->callback, args->arg, 0, 0, false};
+    timers.push_back(timer);
+    *handle = timer;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t periodUs) {
+    if (timer == nullptr || periodUs == 0) return ESP_ERR_INVALID_ARG;
+    if (timer->armed) return ESP_ERR_INVALID_STATE;
+    timer->periodUs = periodUs;
+    timer->expiryUs = HostMock::nowUs() + periodUs;
+    timer->armed = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeoutUs) {
+    if (timer == nullptr) return ESP_ERR_INVALID_ARG;
+    if (timer->armed) return ESP_ERR_INVALID_STATE;
+    timer->periodUs = 0;
+    timer->expiryUs = HostMock::nowUs() + timeoutUs;
+    timer->armed = true;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    if (timer == nullptr || !timer->armed) return ESP_ERR_INVALID_STATE;
+    timer->armed = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+    if (timer == nullptr) return ESP_ERR_INVALID_ARG;
+    if (timer->armed) return ESP_ERR_INVALID_STATE;
+    for (size_t i = 0; i < timers.size(); i++) {
+        if (timers[i] == timer) {
+            timers.erase(timers.begin() + i);
+            break;
+        }
+    }
+    delete timer;
+    return ESP_OK;
+}
+
+int64_t esp_timer_get_time() {
+    return (int64_t)HostMock::nowUs();
+}
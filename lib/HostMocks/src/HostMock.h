@@ -0,0 +1,76 @@
+/**
+ * HostMock - Control surface of the host (env:native) HAL mocks
+ *
+ * The mocked Arduino/ESP32 API reads its inputs from here, so host programs
+ * can script what the hardware would do and inspect what the code wrote.
+ *
+ * Features:
+ * - Virtual microsecond clock (deterministic, advanced by delay() or by the
+ *   host program) or the real monotonic clock for benchmarks
+ * - Analog and digital input values per pin, digital output capture
+ * - GPIO input registers (REG_READ(GPIO_IN_REG / GPIO_IN1_REG)) built from
+ *   the same pin levels
+ * - Edge-triggered attachInterrupt() handlers fired by setDigital()
+ * - esp_timer periodic/one-shot timers fired as the virtual clock advances
+ * - Preferences read and write counters, EEPROM commit counter, Preferences write
+ *   latency and failures
+ * - Shared simulated air for every RF24 instance, with scripted frame loss
+ * - Serial output on/off (benchmarks run quiet)
+ *
+ * FreeRTOS tasks are not scheduled on the host: xTaskCreate() only records
+ * the task. Host programs call the tick functions directly.
+ *
+ * Date: 2025
+ */
+
+#ifndef HOST_MOCK_H
+#define HOST_MOCK_H
+
+#include <stdint.h>
+
+#define HOST_MOCK_PIN_COUNT 64
+
+namespace HostMock {
+
+// Reset clock, pins, timers, interrupts, storage and counters
+void reset();
+
+// Clock
+void useRealClock(bool enable);
+bool isRealClock();
+void setTimeUs(uint64_t us);
+void advanceUs(uint64_t us);      // Fires due esp_timer callbacks on the way
+uint64_t nowUs();
+
+// Pins
+void setAnalog(uint8_t pin, int value);
+void setDigital(uint8_t pin, int value);  // Fires attached interrupts on edges
+int getDigitalOutput(uint8_t pin);
+int getPinMode(uint8_t pin);
+uint32_t getAnalogReadCount();
+uint32_t getDigitalReadCount();
+uint32_t readRegister(uint32_t reg);      // REG_READ() of soc/soc.h
+uint32_t getGpioRegisterReadCount();
+
+// Persistent storage
+void clearPreferences();
+uint32_t getPreferencesWrites();  // put*/remove/clear calls that changed flash
+uint32_t getPreferencesReads();   // Key lookups: get*, getBytes*, isKey
+void setPreferencesWriteUs(uint32_t us);  // Virtual time taken by each of those writes
+void setPreferencesFail(bool fail);       // put* calls fail (full or worn-out flash)
+void clearEEPROM();
+uint32_t getEEPROMCommits();
+
+// Radio: frames reach RF24 instances listening on the same channel and address
+void setRadioLoss(uint8_t percent);   // Per transmission attempt, deterministic
+// Interference on one channel (0-125): lost attempts and RPD set while listening, percent
+void setChannelInterference(uint8_t channel, uint8_t percent);
+uint32_t getRadioFramesSent();        // Transmission attempts, retries included
+uint32_t getRadioFramesLost();
+
+// Serial
+void setSerialOutput(bool enable);
+
+}
+
+#endif // HOST_MOCK_H
@@ -0,0 +1,198 @@
+/**
+ * Preferences Implementation (host)
+ *
+ * Date: 2025
+ */
+
+#include "Preferences.h"
+#include "HostMock.h"
+#include <map>
+#include <vector>
+
+#define HOST_NVS_KEY_MAX 15
+#define HOST_NVS_ENTRIES 630   // Entries of a 20 KB nvs partition
+
+namespace {
+
+typedef std::map<std::string, std::vector<uint8_t>> HostNamespace;
+
+std::map<std::string, HostNamespace> store;
+uint32_t writes = 0;
+uint32_t reads = 0;
+uint32_t writeUs = 0;
+bool failWrites = false;
+
+// Each flash write takes writeUs of virtual time (NVS page write/erase)
+void flashWrite() {
+    writes++;
+    if (writeUs > 0) HostMock::advanceUs(writeUs);
+}
+
+bool validName(const char* name) {
+    return name != nullptr && name[0] != '\0' && strlen(name) <= HOST_NVS_KEY_MAX;
+}
+
+// Blobs use one entry per 32 bytes plus a header, like NVS
+size_t entriesFor(const std::vector<uint8_t>& value) {
+    return value.size() <= 8 ? 1 : 1 + (value.size() + 31) / 32;
+}
+
+}
+
+namespace HostMock {
+
+void clearPreferences() {
+    store.clear();
+    writes = 0;
+    reads = 0;
+    writeUs = 0;
+    failWrites = false;
+}
+
+void setPreferencesWriteUs(uint32_t us) {
+    writeUs = us;
+}
+
+void setPreferencesFail(bool fail) {
+    failWrites = fail;
+}
+
+uint32_t getPreferencesWrites() {
+    return writes;
+}
+
+uint32_t getPreferencesReads() {
+    return reads;
+}
+
+}
+
+Preferences::Preferences() {
+    _started = false;
+    _readOnly = false;
+}
+
+Preferences::~Preferences() {
+    end();
+}
+
+bool Preferences::begin(const char* name, bool readOnly, const char* partitionLabel) {
+    (void)partitionLabel;
+    if (_started || !validName(name)) return false;
+
+    // A read-only open of a namespace that was never written fails on NVS
+    if (readOnly && store.find(name) == store.end()) return false;
+
+    _namespace = name;
+    _readOnly = readOnly;
+    _started = true;
+    store[_namespace];
+    return true;
+}
+
+void Preferences::end() {
+    _started = false;
+}
+
+bool Preferences::clear() {
+    if (!_started || _readOnly) return false;
+    HostNamespace& ns = store[_namespace];
+    if (!ns.empty()) {
+        ns.clear();
+        flashWrite();
+    }
+    return true;
+}
+
+bool Preferences::remove(const char* key) {
+    if (!_started || _readOnly || !validName(key)) return false;
+    HostNamespace& ns = store[_namespace];
+    if (ns.erase(key) == 0) return false;
+    flashWrite();
+    return true;
+}
+
+bool Preferences::isKey(const char* key) {
+    if (!_started || !validName(key)) return false;
+    reads++;
+    HostNamespace& ns = store[_namespace];
+    return ns.find(key) != ns.end();
+}
+
+size_t Preferences::freeEntries() {
+    size_t used = 0;
+    for (auto& ns : store) {
+        for (auto& item : ns.second) used += entriesFor(item.second);
+    }
+    return used >= HOST_NVS_ENTRIES ? 0 : HOST_NVS_ENTRIES - used;
+}
+
+size_t Preferences::_put(const char* key, const void* value, size_t length) {
+    if (!_started || _readOnly || !validName(key) || value == nullptr || failWrites) return 0;
+
+    std::vector<uint8_t> data((const uint8_t*)value, (const uint8_t*)value + length);
+    std::vector<uint8_t>& slot = store[_namespace][key];
+    // NVS skips the flash write when the stored item is identical
+    if (slot != data) {
+        slot = data;
+        flashWrite();
+    }
+    return length;
+}
+
+size_t Preferences::_get(const char* key, void* value, size_t length) {
+    if (!_started || !validName(key)) return 0;
+    reads++;
+    HostNamespace& ns = store[_namespace];
+    auto item = ns.find(key);
+    if (item == ns.end() || item->second.size() != length) return 0;
+    memcpy(value, item->second.data(), length);
+    return length;
+}
+
+#define HOST_PREFERENCES_GET(Name, Type)                        \
+    Type Preferences::get##Name(const char* key, Type defaultValue) { \
+        Type value;                                              \
+        return _get(key, &value, sizeof(value)) ? value : defaultValue; \
+    }
+
+HOST_PREFERENCES_GET(Char, int8_t)
+HOST_PREFERENCES_GET(UChar, uint8_t)
+HOST_PREFERENCES_GET(Short, int16_t)
+HOST_PREFERENCES_GET(UShort, uint16_t)
+HOST_PREFERENCES_GET(Int, int32_t)
+HOST_PREFERENCES_GET(UInt, uint32_t)
+HOST_PREFERENCES_GET(Long, int32_t)
+HOST_PREFERENCES_GET(ULong, uint32_t)
+HOST_PREFERENCES_GET(Long64, int64_t)
+HOST_PREFERENCES_GET(ULong64, uint64_t)
+HOST_PREFERENCES_GET(Float, float)
+HOST_PREFERENCES_GET(Double, double)
+
+bool Preferences::getBool(const char* key, bool defaultValue) {
+    return getUChar(key, defaultValue ? 1 : 0) != 0;
+}
+
+String Preferences::getString(const char* key, const String defaultValue) {
+    size_t length = getBytesLength(key);
+    if (length == 0) return defaultValue;
+    std::vector<char> buffer(length + 1, '\0');
+    getBytes(key, buffer.data(), length);
+    return String(buffer.data());
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    if (!_started || !validName(key)) return 0;
+    reads++;
+    HostNamespace& ns = store[_namespace];
+    auto item = ns.find(key);
+    return item == ns.end() ? 0 : item->second.size();
+}
+
+// Like NVS: fails (0) if the blob does not fit in the buffer
+size_t Preferences::getBytes(const char* key, void* buffer, size_t maxLength) {
+    size_t length = getBytesLength(key);
+    if (length == 0 || buffer == nullptr || length > maxLength) return 0;
+    memcpy(buffer, store[_namespace][key].data(), length);
+    return length;
+}
@@ -0,0 +1,72 @@
+/**
+ * Preferences.h - Host (env:native) NVS key/value store
+ *
+ * Namespaces live in process memory and survive end()/begin() like flash
+ * does on the target; HostMock::clearPreferences() erases them. Key and
+ * namespace names follow the NVS 15 character limit.
+ *
+ * Date: 2025
+ */
+
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include <Arduino.h>
+
+class Preferences {
+private:
+    std::string _namespace;
+    bool _started;
+    bool _readOnly;
+
+    size_t _put(const char* key, const void* value, size_t length);
+    size_t _get(const char* key, void* value, size_t length);
+
+public:
+    Preferences();
+    ~Preferences();
+
+    bool begin(const char* name, bool readOnly = false, const char* partitionLabel = nullptr);
+    void end();
+
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key);
+    size_t freeEntries();
+
+    size_t putChar(const char* key, int8_t value) { return _put(key, &value, sizeof(value)); }
+    size_t putUChar(const char* key, uint8_t value) { return _put(key, &value, sizeof(value)); }
+    size_t putShort(const char* key, int16_t value) { return _put(key, &value, sizeof(value)); }
+    size_t putUShort(const char* key, uint16_t value) { return _put(key, &value, sizeof(value)); }
+    size_t putInt(const char* key, int32_t value) { return _put(key, &value, sizeof(value)); }
+    size_t putUInt(const char* key, uint32_t value) { return _put(key, &value, sizeof(value)); }
+    size_t putLong(const char* key, int32_t value) { return _put(key, &value, sizeof(value)); }
+    size_t putULong(const char* key, uint32_t value) { return _put(key, &value, sizeof(value)); }
+    size_t putLong64(const char* key, int64_t value) { return _put(key, &value, sizeof(value)); }
+    size_t putULong64(const char* key, uint64_t value) { return _put(key, &value, sizeof(value)); }
+    size_t putFloat(const char* key, float value) { return _put(key, &value, sizeof(value)); }
+    size_t putDouble(const char* key, double value) { return _put(key, &value, sizeof(value)); }
+    size_t putBool(const char* key, bool value) { return putUChar(key, value ? 1 : 0); }
+    size_t putString(const char* key, const char* value) { return _put(key, value, strlen(value) + 1); }
+    size_t putString(const char* key, const String& value) { return putString(key, value.c_str()); }
+    size_t putBytes(const char* key, const void* value, size_t length) { return _put(key, value, length); }
+
+    int8_t getChar(const char* key, int8_t defaultValue = 0);
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0);
+    int16_t getShort(const char* key, int16_t defaultValue = 0);
+    uint16_t getUShort(const char* key, uint16_t defaultValue = 0);
+    int32_t getInt(const char* key, int32_t defaultValue = 0);
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0);
+    int32_t getLong(const char* key, int32_t defaultValue = 0);
+    uint32_t getULong(const char* key, uint32_t defaultValue = 0);
+    int64_t getLong64(const char* key, int64_t defaultValue = 0);
+    uint64_t getULong64(const char* key, uint64_t defaultValue = 0);
+    float getFloat(const char* key, float defaultValue = NAN);
+    double getDouble(const char* key, double defaultValue = NAN);
+    bool getBool(const char* key, bool defaultValue = false);
+    String getString(const char* key, const String defaultValue = String());
+    size_t getBytesLength(const char* key);
+    size_t getBytes(const char* key, void* buffer, size_t maxLength);
+};
+
+#endif // HOST_PREFERENCES_H
@@ -0,0 +1,537 @@
+/**
+ * RF24 Implementation (host) - simulated air shared by every instance
+ *
+ * Date: 2025
+ */
+
+#include "RF24.h"
+#include "HostMock.h"
+#include <vector>
+
+#define RF24_ADDRESS_MASK 0xFFFFFFFFFFULL   // 5-byte addresses
+
+SPIClass SPI;
+
+namespace {
+
+std::vector<RF24*> radios;
+uint8_t lossPercent = 0;
+uint8_t channelNoise[126];       // Interference per channel, percent
+uint32_t lossState = 0x2545F491;
+uint32_t framesSent = 0;
+uint32_t framesLost = 0;
+
+// Independent of random() so scripted loss does not disturb the program's RNG
+bool rollLoss() {
+    if (lossPercent == 0) return false;
+    lossState ^= lossState << 13;
+    lossState ^= lossState >> 17;
+    lossState ^= lossState << 5;
+    return (lossState % 100) < lossPercent;
+}
+
+// Same generator; channels without interference do not advance it
+bool rollNoise(uint8_t channel) {
+    if (channelNoise[channel] == 0) return false;
+    lossState ^= lossState << 13;
+    lossState ^= lossState >> 17;
+    lossState ^= lossState << 5;
+    return (lossState % 100) < channelNoise[channel];
+}
+
+uint64_t addressFromBytes(const uint8_t* address) {
+    uint64_t value = 0;
+    for (int8_t i = 4; i >= 0; i--) {
+        value = (value << 8) | address[i]; // LSB first, as RF24 expects
+    }
+    return value;
+}
+
+}
+
+namespace HostMock {
+
+void setRadioLoss(uint8_t percent) {
+    lossPercent = percent > 100 ? 100 : percent;
+}
+
+void setChannelInterference(uint8_t channel, uint8_t percent) {
+    if (channel > 125) return;
+    channelNoise[channel] = percent > 100 ? 100 : percent;
+}
+
+uint32_t getRadioFramesSent() {
+    return framesSent;
+}
+
+uint32_t getRadioFramesLost() {
+    return framesLost;
+}
+
+void resetRadio() {
+    lossPercent = 0;
+    memset(channelNoise, 0, sizeof(channelNoise));
+    lossState = 0x2545F491;
+    framesSent = 0;
+    framesLost = 0;
+}
+
+}
+
+RF24::RF24(uint16_t cePin, uint16_t csnPin, uint32_t spiSpeed) : RF24() {
+    (void)cePin;
+    (void)csnPin;
+    (void)spiSpeed;
+}
+
+RF24::RF24() {
+    failureDetected = false;
+    _started = false;
+    _poweredUp = false;
+    _listening = false;
+    _channel = 76;
+    _paLevel = RF24_PA_MAX;
+    _dataRate = RF24_1MBPS;
+    _crcLength = RF24_CRC_16;
+    _payloadSize = RF24_MAX_PAYLOAD;
+    _dynamicPayloads = false;
+    _ackPayloads = false;
+    _autoAck = 0x3F;
+    _retryDelay = 5;
+    _retryCount = 15;
+    _txAddress = 0;
+    memset(_rxAddress, 0, sizeof(_rxAddress));
+    _rxEnabled = 0;
+    _rxCount = 0;
+    _ackCount = 0;
+    _arc = 0;
+    _plos = 0;
+    _txCount = 0;
+    _txAttempt = 0;
+    _txAttemptEndUs = 0;
+    _rpd = false;
+    _status = 0;
+    _irqMask = RF24_IRQ_ALL;
+    radios.push_back(this);
+}
+
+RF24::~RF24() {
+    for (size_t i = 0; i < radios.size(); i++) {
+        if (radios[i] == this) {
+            radios.erase(radios.begin() + i);
+            break;
+        }
+    }
+}
+
+bool RF24::begin() {
+    _started = true;
+    _poweredUp = true;
+    return true;
+}
+
+bool RF24::begin(SPIClass* spiBus) {
+    (void)spiBus;
+    return begin();
+}
+
+bool RF24::begin(SPIClass* spiBus, uint16_t cePin, uint16_t csnPin) {
+    (void)cePin;
+    (void)csnPin;
+    return begin(spiBus);
+}
+
+// Receiving
+void RF24::startListening() {
+    _listening = true;
+    _poweredUp = true;
+}
+
+// Like RF24, leaving RX mode with ACK payloads on empties the TX FIFO
+void RF24::stopListening() {
+    _listening = false;
+    if (_ackPayloads) flush_tx();
+}
+
+bool RF24::available() {
+    _processAir();
+    return _rxCount > 0;
+}
+
+bool RF24::available(uint8_t* pipe) {
+    _processAir();
+    if (_rxCount == 0) return false;
+    if (pipe) *pipe = _rxFifo[0].pipe;
+    return true;
+}
+
+void RF24::read(void* buffer, uint8_t length) {
+    if (_rxCount == 0) return;
+
+    const RF24Frame& frame = _rxFifo[0];
+    uint8_t copy = length < frame.length ? length : frame.length;
+    memcpy(buffer, frame.data, copy);
+    if (length > copy) memset((uint8_t*)buffer + copy, 0, length - copy);
+
+    for (uint8_t i = 1; i < _rxCount; i++) _rxFifo[i - 1] = _rxFifo[i];
+    _rxCount--;
+}
+
+uint8_t RF24::getDynamicPayloadSize() {
+    return _rxCount > 0 ? _rxFifo[0].length : 0;
+}
+
+int8_t RF24::_matchPipe(uint64_t address) {
+    address &= RF24_ADDRESS_MASK;
+    for (uint8_t pipe = 0; pipe < RF24_PIPES; pipe++) {
+        if ((_rxEnabled & (1 << pipe)) && (_rxAddress[pipe] & RF24_ADDRESS_MASK) == address) {
+            return pipe;
+        }
+    }
+    return -1;
+}
+
+uint8_t RF24::_frameLength(uint8_t length) {
+    if (length > RF24_MAX_PAYLOAD) length = RF24_MAX_PAYLOAD;
+    return _dynamicPayloads ? length : _payloadSize;
+}
+
+bool RF24::_receive(const RF24Frame& frame) {
+    _rpd = true;
+    if (_rxCount >= RF24_FIFO_DEPTH) return false; // RX FIFO full: frame is lost
+    _rxFifo[_rxCount++] = frame;
+    _status |= RF24_RX_DR;
+    return true;
+}
+
+// Transmitting
+// One transmission: loss roll, delivery to the listeners, ACK payload back
+bool RF24::_attempt(RF24Frame frame, bool acked) {
+    bool delivered = false;
+
+    framesSent++;
+    if (rollLoss() || rollNoise(_channel)) {
+        framesLost++;
+        return false;
+    }
+
+    for (RF24* radio : radios) {
+        if (radio == this || !radio->_started || !radio->_poweredUp || !radio->_listening) continue;
+        if (radio->_channel != _channel || radio->_dataRate != _dataRate) continue;
+
+        int8_t pipe = radio->_matchPipe(_txAddress);
+        if (pipe < 0) continue;
+
+        frame.pipe = pipe;
+        if (radio->_receive(frame)) {
+            delivered = true;
+            // The receiver answers with its queued ACK payload, if any
+            if (acked && radio->_ackPayloads && radio->_ackCount > 0) {
+                RF24Frame ack = radio->_ackFifo[0];
+                for (uint8_t i = 1; i < radio->_ackCount; i++) {
+                    radio->_ackFifo[i - 1] = radio->_ackFifo[i];
+                }
+                radio->_ackCount--;
+                ack.pipe = 0;
+                _receive(ack);
+            }
+        }
+    }
+    return delivered;
+}
+
+bool RF24::_transmit(const void* buffer, uint8_t length, bool multicast) {
+    if (!_started || !_poweredUp || _listening || buffer == nullptr) {
+        _status = (_status & ~RF24_TX_DS) | RF24_TX_DF;
+        return false;
+    }
+
+    RF24Frame frame = {};
+    frame.length = _frameLength(length);
+    memcpy(frame.data, buffer, length < frame.length ? length : frame.length);
+
+    bool acked = (_autoAck & 0x01) && !multicast;
+    uint8_t attempts = acked ? _retryCount + 1 : 1;
+    bool delivered = false;
+
+    _arc = 0;
+    for (uint8_t attempt = 0; attempt < attempts && !delivered; attempt++) {
+        _arc = attempt;
+        delivered = _attempt(frame, acked);
+    }
+
+    // Without ACKs the transmitter never knows if anyone heard it
+    if (!acked) delivered = true;
+    if (!delivered && _plos < 15) _plos++;
+    _status = (_status & ~(RF24_TX_DS | RF24_TX_DF)) | (delivered ? RF24_TX_DS : RF24_TX_DF);
+    return delivered;
+}
+
+uint32_t RF24::_airtimeUs(uint8_t length) {
+    uint8_t crcBytes = _crcLength == RF24_CRC_16 ? 2 : (_crcLength == RF24_CRC_8 ? 1 : 0);
+    uint32_t bits = (1 + 5 + length + crcBytes) * 8 + 9; // Preamble, address, payload, CRC + PCF
+    switch (_dataRate) {
+        case RF24_250KBPS: bits *= 4; break;
+        case RF24_2MBPS:   bits /= 2; break;
+        default:           break;
+    }
+    return RF24_TX_SETTLING_US + bits;
+}
+
+// Frames in the TX FIFO whose attempt has left the air by untilUs
+void RF24::_processTx(uint64_t untilUs) {
+    while (_txCount > 0 && !(_status & RF24_TX_DF) && _txAttemptEndUs <= untilUs) {
+        const RF24Frame& frame = _txFifo[0];
+        bool acked = (_autoAck & 0x01) && !_txNoAck[0];
+        bool delivered = _attempt(frame, acked);
+        uint64_t endUs = _txAttemptEndUs;
+
+        if (delivered || !acked) {
+            _arc = _txAttempt;
+            _status |= RF24_TX_DS;
+            for (uint8_t i = 1; i < _txCount; i++) {
+                _txFifo[i - 1] = _txFifo[i];
+                _txNoAck[i - 1] = _txNoAck[i];
+            }
+            _txCount--;
+            _txAttempt = 0;
+            // ACK turnaround before the next frame
+            if (acked) endUs += _airtimeUs(0);
+            if (_txCount > 0) _txAttemptEndUs = endUs + _airtimeUs(_txFifo[0].length);
+        } else if (_txAttempt >= _retryCount) {
+            // MAX_RT: the frame stays at the head until the flag is cleared
+            _arc = _txAttempt;
+            if (_plos < 15) _plos++;
+            _status |= RF24_TX_DF;
+        } else {
+            _txAttempt++;
+            _txAttemptEndUs = endUs + (_retryDelay + 1) * 250 + _airtimeUs(frame.length);
+        }
+    }
+}
+
+// Every radio's TX FIFO, in creation order, up to the virtual clock
+void RF24::_processAir() {
+    uint64_t nowUs = HostMock::nowUs();
+    for (RF24* radio : radios) {
+        radio->_processTx(nowUs);
+    }
+}
+
+bool RF24::write(const void* buffer, uint8_t length) {
+    return _transmit(buffer, length, false);
+}
+
+bool RF24::write(const void* buffer, uint8_t length, bool multicast) {
+    return _transmit(buffer, length, multicast);
+}
+
+bool RF24::writeFast(const void* buffer, uint8_t length) {
+    return writeFast(buffer, length, false);
+}
+
+// Queues the frame; it leaves the FIFO as the virtual clock passes. The real
+// writeFast() waits while the FIFO is full, here it returns false instead.
+bool RF24::writeFast(const void* buffer, uint8_t length, bool multicast) {
+    _processAir();
+    if (!_started || !_poweredUp || _listening || buffer == nullptr) return false;
+    if (_txCount >= RF24_FIFO_DEPTH) return false;
+
+    RF24Frame& frame = _txFifo[_txCount];
+    frame = RF24Frame();
+    frame.length = _frameLength(length);
+    memcpy(frame.data, buffer, length < frame.length ? length : frame.length);
+    _txNoAck[_txCount] = multicast;
+    if (_txCount == 0) {
+        _txAttempt = 0;
+        _txAttemptEndUs = HostMock::nowUs() + _airtimeUs(frame.length);
+    }
+    _txCount++;
+    return true;
+}
+
+// Sends what is left in the TX FIFO at once; on MAX_RT flushes it like RF24
+bool RF24::txStandBy() {
+    _processAir();
+    _processTx(UINT64_MAX);
+    if (_status & RF24_TX_DF) {
+        _status &= ~RF24_TX_DF;
+        flush_tx();
+        return false;
+    }
+    return true;
+}
+
+bool RF24::txStandBy(uint32_t timeout, bool startTx) {
+    (void)timeout;
+    (void)startTx;
+    return txStandBy();
+}
+
+bool RF24::writeAckPayload(uint8_t pipe, const void* buffer, uint8_t length) {
+    if (!_ackPayloads || buffer == nullptr || pipe >= RF24_PIPES) return false;
+    if (_ackCount >= RF24_FIFO_DEPTH) return false; // TX FIFO full
+
+    RF24Frame& frame = _ackFifo[_ackCount++];
+    frame.pipe = pipe;
+    frame.length = length > RF24_MAX_PAYLOAD ? RF24_MAX_PAYLOAD : length;
+    memcpy(frame.data, buffer, frame.length);
+    return true;
+}
+
+bool RF24::isAckPayloadAvailable() {
+    return _ackPayloads && _rxCount > 0;
+}
+
+void RF24::whatHappened(bool& txOk, bool& txFail, bool& rxReady) {
+    uint8_t status = clearStatusFlags(RF24_IRQ_ALL);
+    txOk = status & RF24_TX_DS;
+    txFail = status & RF24_TX_DF;
+    rxReady = status & RF24_RX_DR;
+}
+
+uint8_t RF24::update() {
+    _processAir();
+    return _status | (_txCount >= RF24_FIFO_DEPTH ? (1 << TX_FULL) : 0);
+}
+
+// Returns STATUS before clearing. Clearing MAX_RT retries the head frame.
+uint8_t RF24::clearStatusFlags(uint8_t flags) {
+    uint8_t status = update();
+    if ((flags & RF24_TX_DF) && (_status & RF24_TX_DF) && _txCount > 0) {
+        _txAttempt = 0;
+        _txAttemptEndUs = HostMock::nowUs() + _airtimeUs(_txFifo[0].length);
+    }
+    _status &= ~(flags & RF24_IRQ_ALL);
+    return status;
+}
+
+rf24_fifo_state_e RF24::isFifo(bool aboutTx) {
+    _processAir();
+    uint8_t count = aboutTx ? _txCount : _rxCount;
+    if (count == 0) return RF24_FIFO_EMPTY;
+    return count >= RF24_FIFO_DEPTH ? RF24_FIFO_FULL : RF24_FIFO_OCCUPIED;
+}
+
+bool RF24::isFifo(bool aboutTx, bool checkEmpty) {
+    return isFifo(aboutTx) == (checkEmpty ? RF24_FIFO_EMPTY : RF24_FIFO_FULL);
+}
+
+// Addressing
+void RF24::openWritingPipe(uint64_t address) {
+    _txAddress = address;
+    // Pipe 0 receives the ACKs, so it follows the writing address
+    _rxAddress[0] = address;
+}
+
+void RF24::openWritingPipe(const uint8_t* address) {
+    openWritingPipe(addressFromBytes(address));
+}
+
+void RF24::openReadingPipe(uint8_t pipe, uint64_t address) {
+    if (pipe >= RF24_PIPES) return;
+    _rxAddress[pipe] = address;
+    _rxEnabled |= (1 << pipe);
+}
+
+void RF24::openReadingPipe(uint8_t pipe, const uint8_t* address) {
+    openReadingPipe(pipe, addressFromBytes(address));
+}
+
+void RF24::closeReadingPipe(uint8_t pipe) {
+    if (pipe < RF24_PIPES) _rxEnabled &= ~(1 << pipe);
+}
+
+// Configuration
+// RPD: our own frames, or a carrier on the channel while listening
+bool RF24::testRPD() {
+    return _rpd || (_listening && rollNoise(_channel));
+}
+
+void RF24::setChannel(uint8_t channel) {
+    _channel = channel > 125 ? 125 : channel;
+    _plos = 0; // PLOS_CNT resets on RF_CH writes
+    _rpd = false;
+}
+
+void RF24::setPALevel(uint8_t level, bool lnaEnable) {
+    (void)lnaEnable;
+    _paLevel = level > (uint8_t)RF24_PA_MAX ? (uint8_t)RF24_PA_MAX : level;
+}
+
+bool RF24::setDataRate(rf24_datarate_e speed) {
+    _dataRate = speed;
+    return true;
+}
+
+void RF24::setRetries(uint8_t delay, uint8_t count) {
+    _retryDelay = delay > 15 ? 15 : delay;
+    _retryCount = count > 15 ? 15 : count;
+}
+
+void RF24::setAutoAck(bool enable) {
+    _autoAck = enable ? 0x3F : 0;
+    if (!enable) _ackPayloads = false;
+}
+
+void RF24::setAutoAck(uint8_t pipe, bool enable) {
+    if (pipe >= RF24_PIPES) return;
+    if (enable) _autoAck |= (1 << pipe);
+    else _autoAck &= ~(1 << pipe);
+}
+
+void RF24::setPayloadSize(uint8_t size) {
+    _payloadSize = size == 0 ? 1 : (size > RF24_MAX_PAYLOAD ? RF24_MAX_PAYLOAD : size);
+}
+
+void RF24::disableDynamicPayloads() {
+    _dynamicPayloads = false;
+    _ackPayloads = false;
+}
+
+// ACK payloads need dynamic payloads, RF24 turns them on as well
+void RF24::enableAckPayload() {
+    _ackPayloads = true;
+    _dynamicPayloads = true;
+}
+
+uint8_t RF24::flush_tx() {
+    _ackCount = 0;
+    _txCount = 0;
+    _txAttempt = 0;
+    return _status;
+}
+
+uint8_t RF24::flush_rx() {
+    _rxCount = 0;
+    return 0;
+}
+
+uint8_t RF24::read_register(uint8_t reg) {
+    switch (reg) {
+        case OBSERVE_TX: _processAir(); return (uint8_t)((_plos << PLOS_CNT) | (_arc & 0x0F));
+        case NRF_STATUS: return update();
+        case FIFO_STATUS:
+            _processAir();
+            return (_txCount == 0 ? (1 << TX_EMPTY) : 0) | (_txCount >= RF24_FIFO_DEPTH ? (1 << FIFO_FULL) : 0) |
+                   (_rxCount == 0 ? (1 << RX_EMPTY) : 0) | (_rxCount >= RF24_FIFO_DEPTH ? (1 << RX_FULL) : 0);
+        case RPD:        return _rpd ? 1 : 0;
+        case RF_CH:      return _channel;
+        default:         return 0;
+    }
+}
+
+void RF24::printDetails() {
+    Serial.print("RF24 (host) channel ");
+    Serial.print(_channel);
+    Serial.print(" rate ");
+    Serial.print((int)_dataRate);
+    Serial.print(" PA ");
+    Serial.print(_paLevel);
+    Serial.print(" autoAck 0x");
+    Serial.print(_autoAck, HEX);
+    Serial.print(" DPL ");
+    Serial.print(_dynamicPayloads ? "on" : "off");
+    Serial.print(" listening ");
+    Serial.println(_listening ? "yes" : "no");
+}
@@ -0,0 +1,180 @@
+/**
+ * RF24.h - Host (env:native) nRF24L01 radio
+ *
+ * Every RF24 instance in the process shares one simulated air. A frame
+ * written on a channel reaches the instances listening on that channel,
+ * data rate and pipe address, with the loss set by HostMock::setRadioLoss()
+ * and the per-channel interference set by HostMock::setChannelInterference()
+ * (also seen by testRPD()/testCarrier() while listening on that channel).
+ *
+ * Features:
+ * - 3-frame RX FIFO per instance, overflowing frames are dropped
+ * - Auto-ACK with retries: each retry is a new loss roll, ARC/PLOS counters
+ *   readable through read_register(OBSERVE_TX) like the real chip
+ * - ACK payloads queued with writeAckPayload() ride back on the next ACK
+ * - Static (padded) or dynamic payload sizes
+ * - 3-frame TX FIFO for writeFast(): frames go on air as the virtual clock
+ *   passes (settling + bits at the data rate, ACK wait and retry delay per
+ *   retry), setting TX_DS / MAX_RT in the STATUS flags like the real chip.
+ *   MAX_RT halts the FIFO until the flag is cleared or the FIFO flushed.
+ * - write() and txStandBy() complete immediately (the host cannot wait)
+ *
+ * Date: 2025
+ */
+
+#ifndef HOST_RF24_H
+#define HOST_RF24_H
+
+#include <Arduino.h>
+#include <SPI.h>
+#include "nRF24L01.h"
+
+#define RF24_FIFO_DEPTH 3
+#define RF24_MAX_PAYLOAD 32
+#define RF24_PIPES 6
+
+typedef enum { RF24_PA_MIN = 0, RF24_PA_LOW, RF24_PA_HIGH, RF24_PA_MAX, RF24_PA_ERROR } rf24_pa_dbm_e;
+typedef enum { RF24_1MBPS = 0, RF24_2MBPS, RF24_250KBPS } rf24_datarate_e;
+typedef enum { RF24_CRC_DISABLED = 0, RF24_CRC_8, RF24_CRC_16 } rf24_crclength_e;
+typedef enum { RF24_FIFO_OCCUPIED, RF24_FIFO_EMPTY, RF24_FIFO_FULL, RF24_FIFO_INVALID } rf24_fifo_state_e;
+typedef enum {
+    RF24_IRQ_NONE = 0,
+    RF24_TX_DF = 1 << MASK_MAX_RT,
+    RF24_TX_DS = 1 << TX_DS,
+    RF24_RX_DR = 1 << RX_DR,
+    RF24_IRQ_ALL = (1 << MASK_MAX_RT) | (1 << TX_DS) | (1 << RX_DR)
+} rf24_irq_flags_e;
+
+#define RF24_TX_SETTLING_US 130     // PLL settling before every frame
+
+struct RF24Frame {
+    uint8_t pipe;
+    uint8_t length;
+    uint8_t data[RF24_MAX_PAYLOAD];
+};
+
+class RF24 {
+private:
+    bool _started;
+    bool _poweredUp;
+    bool _listening;
+    uint8_t _channel;
+    uint8_t _paLevel;
+    rf24_datarate_e _dataRate;
+    rf24_crclength_e _crcLength;
+    uint8_t _payloadSize;
+    bool _dynamicPayloads;
+    bool _ackPayloads;
+    uint8_t _autoAck;            // Bit per pipe
+    uint8_t _retryDelay;
+    uint8_t _retryCount;
+
+    uint64_t _txAddress;
+    uint64_t _rxAddress[RF24_PIPES];
+    uint8_t _rxEnabled;          // Bit per pipe
+
+    RF24Frame _rxFifo[RF24_FIFO_DEPTH];
+    uint8_t _rxCount;
+    RF24Frame _ackFifo[RF24_FIFO_DEPTH];
+    uint8_t _ackCount;
+    RF24Frame _txFifo[RF24_FIFO_DEPTH];
+    bool _txNoAck[RF24_FIFO_DEPTH];
+    uint8_t _txCount;
+    uint8_t _txAttempt;          // Retries of the frame at the head of the TX FIFO
+    uint64_t _txAttemptEndUs;    // When its current attempt leaves the air
+
+    uint8_t _arc;                // Retransmissions of the last packet
+    uint8_t _plos;               // Lost packets since the channel was set
+    bool _rpd;
+    uint8_t _status;             // RF24_RX_DR | RF24_TX_DS | RF24_TX_DF
+    uint8_t _irqMask;            // Flags reflected on the IRQ pin (not wired on the host)
+
+    bool _transmit(const void* buffer, uint8_t length, bool multicast);
+    bool _attempt(RF24Frame frame, bool acked);
+    bool _receive(const RF24Frame& frame);
+    void _processTx(uint64_t untilUs);
+    static void _processAir();
+    uint32_t _airtimeUs(uint8_t length);
+    int8_t _matchPipe(uint64_t address);
+    uint8_t _frameLength(uint8_t length);
+
+protected:
+    uint8_t read_register(uint8_t reg);
+
+public:
+    RF24(uint16_t cePin, uint16_t csnPin, uint32_t spiSpeed = 10000000);
+    RF24();
+    ~RF24();
+
+    bool begin();
+    bool begin(SPIClass* spiBus);
+    bool begin(SPIClass* spiBus, uint16_t cePin, uint16_t csnPin);
+    bool isChipConnected() { return true; }
+    bool failureDetected;
+
+    void startListening();
+    void stopListening();
+    bool available();
+    bool available(uint8_t* pipe);
+    void read(void* buffer, uint8_t length);
+
+    bool write(const void* buffer, uint8_t length);
+    bool write(const void* buffer, uint8_t length, bool multicast);
+    bool writeFast(const void* buffer, uint8_t length);
+    bool writeFast(const void* buffer, uint8_t length, bool multicast);
+    bool txStandBy();
+    bool txStandBy(uint32_t timeout, bool startTx = false);
+    bool writeAckPayload(uint8_t pipe, const void* buffer, uint8_t length);
+    bool isAckPayloadAvailable();
+    void whatHappened(bool& txOk, bool& txFail, bool& rxReady);
+    uint8_t update();
+    uint8_t getStatusFlags() { return _status; }
+    uint8_t clearStatusFlags(uint8_t flags = RF24_IRQ_ALL);
+    void setStatusFlags(uint8_t flags = RF24_IRQ_NONE) { _irqMask = flags & RF24_IRQ_ALL; }
+    rf24_fifo_state_e isFifo(bool aboutTx);
+    bool isFifo(bool aboutTx, bool checkEmpty);
+    bool rxFifoFull() { return _rxCount >= RF24_FIFO_DEPTH; }
+
+    void openWritingPipe(uint64_t address);
+    void openWritingPipe(const uint8_t* address);
+    void openReadingPipe(uint8_t pipe, uint64_t address);
+    void openReadingPipe(uint8_t pipe, const uint8_t* address);
+    void closeReadingPipe(uint8_t pipe);
+
+    void setChannel(uint8_t channel);
+    uint8_t getChannel() { return _channel; }
+    void setPALevel(uint8_t level, bool lnaEnable = true);
+    uint8_t getPALevel() { return _paLevel; }
+    bool setDataRate(rf24_datarate_e speed);
+    rf24_datarate_e getDataRate() { return _dataRate; }
+    void setCRCLength(rf24_crclength_e length) { _crcLength = length; }
+    rf24_crclength_e getCRCLength() { return _crcLength; }
+    void disableCRC() { _crcLength = RF24_CRC_DISABLED; }
+    void setRetries(uint8_t delay, uint8_t count);
+    void setAutoAck(bool enable);
+    void setAutoAck(uint8_t pipe, bool enable);
+    void setAddressWidth(uint8_t width) { (void)width; }
+
+    void setPayloadSize(uint8_t size);
+    uint8_t getPayloadSize() { return _payloadSize; }
+    void enableDynamicPayloads() { _dynamicPayloads = true; }
+    void disableDynamicPayloads();
+    uint8_t getDynamicPayloadSize();
+    void enableAckPayload();
+    void disableAckPayload() { _ackPayloads = false; }
+    void enableDynamicAck() {}
+
+    void powerUp() { _poweredUp = true; }
+    void powerDown() { _poweredUp = false; }
+    uint8_t flush_tx();
+    uint8_t flush_rx();
+
+    bool testCarrier() { return testRPD(); }
+    bool testRPD();
+    uint8_t getARC() { return _arc; }
+
+    void printDetails();
+    void printPrettyDetails() { printDetails(); }
+};
+
+#endif // HOST_RF24_H
@@ -0,0 +1,27 @@
+/**
+ * SPI.h - Host (env:native) SPI bus placeholder
+ *
+ * Date: 2025
+ */
+
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include <Arduino.h>
+
+#define FSPI 0
+#define HSPI 1
+
+class SPIClass {
+public:
+    SPIClass(uint8_t bus = FSPI) { (void)bus; }
+    void begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1) {
+        (void)sck; (void)miso; (void)mosi; (void)ss;
+    }
+    void end() {}
+    uint8_t transfer(uint8_t data) { (void)data; return 0; }
+};
+
+extern SPIClass SPI;
+
+#endif // HOST_SPI_H
@@ -0,0 +1,125 @@
+/**
+ * WString Implementation (host)
+ *
+ * Date: 2025
+ */
+
+#include <Arduino.h>
+#include <ctype.h>
+
+std::string String::_formatInteger(unsigned long long value, bool negative, unsigned char base) {
+    if (base < 2 || base > 36) base = 10;
+
+    char buffer[66];
+    char* p = &buffer[sizeof(buffer) - 1];
+    *p = '\0';
+    do {
+        uint8_t digit = value % base;
+        *--p = digit < 10 ? '0' + digit : 'a' + digit - 10;
+        value /= base;
+    } while (value > 0);
+    if (negative) *--p = '-';
+    return std::string(p);
+}
+
+String::String(unsigned char value, unsigned char base) : _value(_formatInteger(value, false, base)) {}
+String::String(unsigned int value, unsigned char base) : _value(_formatInteger(value, false, base)) {}
+String::String(unsigned long value, unsigned char base) : _value(_formatInteger(value, false, base)) {}
+String::String(unsigned long long value, unsigned char base) : _value(_formatInteger(value, false, base)) {}
+
+// Negative values are only signed in base 10, like the Arduino core
+String::String(int value, unsigned char base)
+    : _value(base == 10 && value < 0 ? _formatInteger(-(long long)value, true, 10)
+                                     : _formatInteger((unsigned int)value, false, base)) {}
+String::String(long value, unsigned char base)
+    : _value(base == 10 && value < 0 ? _formatInteger(-(long long)value, true, 10)
+                                     : _formatInteger((unsigned long)value, false, base)) {}
+String::String(long long value, unsigned char base)
+    : _value(base == 10 && value < 0 ? _formatInteger(0ULL - (unsigned long long)value, true, 10)
+                                     : _formatInteger((unsigned long long)value, false, base)) {}
+
+String::String(float value, unsigned int decimalPlaces) : String((double)value, decimalPlaces) {}
+
+String::String(double value, unsigned int decimalPlaces) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", (int)decimalPlaces, value);
+    _value = buffer;
+}
+
+int String::indexOf(char c, unsigned int from) const {
+    size_t pos = _value.find(c, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const String& s, unsigned int from) const {
+    size_t pos = _value.find(s._value, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int from) const {
+    return substring(from, _value.length());
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    if (from >= _value.length()) return String();
+    if (to > _value.length()) to = _value.length();
+    return String(_value.substr(from, to - from));
+}
+
+bool String::startsWith(const String& prefix) const {
+    return _value.compare(0, prefix._value.length(), prefix._value) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+    if (suffix._value.length() > _value.length()) return false;
+    return _value.compare(_value.length() - suffix._value.length(), suffix._value.length(), suffix._value) == 0;
+}
+
+void String::trim() {
+    size_t begin = 0;
+    size_t end = _value.length();
+    while (begin < end && isspace((unsigned char)_value[begin])) begin++;
+    while (end > begin && isspace((unsigned char)_value[end - 1])) end--;
+    _value = _value.substr(begin, end - begin);
+}
+
+void String::toUpperCase() {
+    for (size_t i = 0; i < _value.length(); i++) _value[i] = toupper((unsigned char)_value[i]);
+}
+
+void String::toLowerCase() {
+    for (size_t i = 0; i < _value.length(); i++) _value[i] = tolower((unsigned char)_value[i]);
+}
+
+long String::toInt() const {
+    return atol(_value.c_str());
+}
+
+float String::toFloat() const {
+    return (float)atof(_value.c_str());
+}
+
+String operator+(const String& a, const String& b) {
+    String result(a);
+    result += b;
+    return result;
+}
+
+String operator+(const String& a, const char* b) {
+    String result(a);
+    result += b;
+    return result;
+}
+
+String operator+(const char* a, const String& b) {
+    String result(a);
+    result += b;
+    return result;
+}
+
+String operator+(const String& a, char b) {
+    String result(a);
+    result += b;
+    return result;
+}
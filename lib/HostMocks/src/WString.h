@@ -0,0 +1,78 @@
+/**
+ * WString.h - Host (env:native) Arduino String backed by std::string
+ *
+ * Date: 2025
+ */
+
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+#include <stdint.h>
+#include <string>
+
+class String {
+private:
+    std::string _value;
+
+    static std::string _formatInteger(unsigned long long value, bool negative, unsigned char base);
+
+public:
+    String() {}
+    String(const char* value) : _value(value ? value : "") {}
+    String(const std::string& value) : _value(value) {}
+    explicit String(char c) : _value(1, c) {}
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(long long value, unsigned char base = 10);
+    explicit String(unsigned long long value, unsigned char base = 10);
+    explicit String(float value, unsigned int decimalPlaces = 2);
+    explicit String(double value, unsigned int decimalPlaces = 2);
+
+    const char* c_str() const { return _value.c_str(); }
+    unsigned int length() const { return _value.length(); }
+    bool isEmpty() const { return _value.empty(); }
+    void reserve(unsigned int size) { _value.reserve(size); }
+
+    String& operator+=(const String& other) { _value += other._value; return *this; }
+    String& operator+=(const char* other) { _value += other; return *this; }
+    String& operator+=(char c) { _value += c; return *this; }
+    String& operator+=(int value) { return *this += String(value); }
+    String& operator+=(unsigned int value) { return *this += String(value); }
+    String& operator+=(long value) { return *this += String(value); }
+    String& operator+=(unsigned long value) { return *this += String(value); }
+    String& operator+=(float value) { return *this += String(value); }
+    String& operator+=(double value) { return *this += String(value); }
+    bool concat(const String& other) { *this += other; return true; }
+
+    bool operator==(const String& other) const { return _value == other._value; }
+    bool operator==(const char* other) const { return _value == other; }
+    bool operator!=(const String& other) const { return _value != other._value; }
+    bool operator!=(const char* other) const { return _value != other; }
+    bool operator<(const String& other) const { return _value < other._value; }
+    bool equals(const String& other) const { return _value == other._value; }
+
+    char charAt(unsigned int index) const { return index < _value.length() ? _value[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    int indexOf(char c, unsigned int from = 0) const;
+    int indexOf(const String& s, unsigned int from = 0) const;
+    String substring(unsigned int from) const;
+    String substring(unsigned int from, unsigned int to) const;
+    bool startsWith(const String& prefix) const;
+    bool endsWith(const String& suffix) const;
+    void trim();
+    void toUpperCase();
+    void toLowerCase();
+
+    long toInt() const;
+    float toFloat() const;
+};
+
+String operator+(const String& a, const String& b);
+String operator+(const String& a, const char* b);
+String operator+(const char* a, const String& b);
+String operator+(const String& a, char b);
+
+#endif // HOST_WSTRING_H
@@ -0,0 +1,37 @@
+/**
+ * nRF24L01.h - Host (env:native) nRF24L01 register map subset
+ *
+ * Date: 2025
+ */
+
+#ifndef HOST_NRF24L01_H
+#define HOST_NRF24L01_H
+
+#define NRF_CONFIG 0x00
+#define EN_AA 0x01
+#define EN_RXADDR 0x02
+#define SETUP_AW 0x03
+#define SETUP_RETR 0x04
+#define RF_CH 0x05
+#define RF_SETUP 0x06
+#define NRF_STATUS 0x07
+#define OBSERVE_TX 0x08
+#define RPD 0x09
+#define FIFO_STATUS 0x17
+#define DYNPD 0x1C
+#define FEATURE 0x1D
+
+#define MASK_MAX_RT 4
+#define RX_DR 6
+#define TX_DS 5
+#define MAX_RT 4
+#define TX_FULL 0
+#define PLOS_CNT 4
+#define ARC_CNT 0
+#define TX_REUSE 6
+#define FIFO_FULL 5
+#define TX_EMPTY 4
+#define RX_FULL 1
+#define RX_EMPTY 0
+
+#endif // HOST_NRF24L01_H
@@ -0,0 +1,17 @@
+/**
+ * soc/gpio_reg.h - Host (env:native) subset of the ESP32-S2 GPIO registers
+ *
+ * Date: 2025
+ */
+
+#ifndef HOST_SOC_GPIO_REG_H
+#define HOST_SOC_GPIO_REG_H
+
+#include "soc/soc.h"
+
+#define DR_REG_GPIO_BASE 0x3f404000
+
+#define GPIO_IN_REG (DR_REG_GPIO_BASE + 0x3C)    // Levels of GPIO0-31
+#define GPIO_IN1_REG (DR_REG_GPIO_BASE + 0x40)   // Levels of GPIO32-53
+
+#endif // HOST_SOC_GPIO_REG_H
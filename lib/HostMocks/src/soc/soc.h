@@ -0,0 +1,18 @@
+/**
+ * soc/soc.h - Host (env:native) register access
+ *
+ * REG_READ() of the GPIO input registers returns the mocked pin levels
+ * (see HostMock::readRegister()). Other registers read as 0.
+ *
+ * Date: 2025
+ */
+
+#ifndef HOST_SOC_H
+#define HOST_SOC_H
+
+#include <stdint.h>
+#include "HostMock.h"
+
+#define REG_READ(reg) HostMock::readRegister((uint32_t)(reg))
+
+#endif // HOST_SOC_H
@@ -22,15 +22,24 @@ Joystick::Joystick(uint8_t pinX, uint8_t pinY, uint8_t pinButton) {
     _useCircularDeadZone = true;
     _invertX = false;
     _invertY = false;
-    _useSmoothing = false;
-    _smoothingFactor = 0.1;
-    _lastX = 0;
-    _lastY = 0;
+    _expoPercent = 0;
+    _configureAxes();
     
     // Button configuration
     _lastButtonState = false;
     _lastDebounceTime = 0;
     _debounceDelay = 50;
+    _edgeCapture = nullptr;
+    _buttonChannel = EDGE_CAPTURE_NO_CHANNEL;
+    _seenPresses = 0;
+    _seenReleases = 0;
+    
+    // Sampling
+    memset(&_state, 0, sizeof(_state));
+    _manualSampling = false;
+    _adcReadCount = 0;
+    _analogReader = nullptr;
+    _analogReaderContext = nullptr;
 }
 
 // Initialize the joystick
@@ -40,12 +49,13 @@ void Joystick::begin() {
     }
     
     // Take initial readings for center position
-    _centerX = analogRead(_pinX);
-    _centerY = analogRead(_pinY);
+    _centerX = _readPin(_pinX);
+    _centerY = _readPin(_pinY);
     
     // Initialize smoothing values
-    _lastX = _centerX;
-    _lastY = _centerY;
+    _configureAxes();
+    _chainX.reset(_centerX);
+    _chainY.reset(_centerY);
 }
 
 // Manual calibration - call this and move joystick through full range
@@ -58,8 +68,8 @@ void Joystick::calibrate() {
     
     unsigned long startTime = millis();
     while (millis() - startTime < 5000) {
-        int x = analogRead(_pinX);
-        int y = analogRead(_pinY);
+        int x = _readPin(_pinX);
+        int y = _readPin(_pinY);
         
         if (x < _minX) _minX = x;
         if (x > _maxX) _maxX = x;
@@ -73,8 +83,9 @@ void Joystick::calibrate() {
     delay(2000);
     
     // Read center position
-    _centerX = analogRead(_pinX);
-    _centerY = analogRead(_pinY);
+    _centerX = _readPin(_pinX);
+    _centerY = _readPin(_pinY);
+    _configureAxes();
     
     Serial.println("Calibration complete!");
     Serial.print("X: Min="); Serial.print(_minX); 
@@ -92,8 +103,8 @@ void Joystick::autoCalibrate(unsigned long duration) {
     
     unsigned long startTime = millis();
     while (millis() - startTime < duration) {
-        int x = analogRead(_pinX);
-        int y = analogRead(_pinY);
+        int x = _readPin(_pinX);
+        int y = _readPin(_pinY);
         
         if (x < _minX) _minX = x;
         if (x > _maxX) _maxX = x;
@@ -105,6 +116,7 @@ void Joystick::autoCalibrate(unsigned long duration) {
     
     _centerX = (_minX + _maxX) / 2;
     _centerY = (_minY + _maxY) / 2;
+    _configureAxes();
 }
 
 // Configuration methods
@@ -118,38 +130,84 @@ void Joystick::setLimits(int minX, int maxX, int minY, int maxY) {
     _maxX = maxX;
     _minY = minY;
     _maxY = maxY;
+    _configureAxes();
 }
 
 void Joystick::setCenter(int centerX, int centerY) {
     _centerX = centerX;
     _centerY = centerY;
+    _configureAxes();
 }
 
 void Joystick::invertAxis(bool invertX, bool invertY) {
     _invertX = invertX;
     _invertY = invertY;
+    _configureAxes();
 }
 
 void Joystick::setSmoothing(bool enable, float factor) {
-    _useSmoothing = enable;
-    _smoothingFactor = constrain(factor, 0.0, 1.0);
+    int32_t alpha = enable ? signalQ16(constrain(factor, 0.0, 1.0)) : SIGNAL_Q16_ONE;
+    _chainX.stage<SmoothingStage>().setAlpha(alpha);
+    _chainY.stage<SmoothingStage>().setAlpha(alpha);
+}
+
+void Joystick::setOneEuro(float minCutoffHz, float beta, uint16_t sampleRateHz) {
+    _chainX.stage<SmoothingStage>().setOneEuro(minCutoffHz, beta, sampleRateHz);
+    _chainY.stage<SmoothingStage>().setOneEuro(minCutoffHz, beta, sampleRateHz);
+}
+
+void Joystick::setExpo(uint8_t percent) {
+    _expoPercent = percent;
+    _configureAxes();
 }
 
 void Joystick::setDebounceDelay(unsigned long delay) {
     _debounceDelay = delay;
 }
 
+void Joystick::setAnalogReader(AnalogReadFn reader, void* context) {
+    _analogReader = reader;
+    _analogReaderContext = context;
+}
+
+bool Joystick::setEdgeCapture(EdgeCapture* capture) {
+    if (capture == nullptr || _pinButton == 255) return false;
+
+    int8_t channel = capture->addPin(_pinButton, _debounceDelay * 1000);
+    if (channel == EDGE_CAPTURE_NO_CHANNEL) return false;
+
+    _edgeCapture = capture;
+    _buttonChannel = channel;
+    _seenPresses = capture->getActivations(channel);
+    _seenReleases = capture->getDeactivations(channel);
+    return true;
+}
+
 // Internal helper methods
-int Joystick::_readRawX() {
-    const int samples = 10;  // Número de lecturas
+int Joystick::_readPin(uint8_t pin) {
+    _adcReadCount++;
+    if (_analogReader != nullptr) {
+        return _analogReader(pin, _analogReaderContext);
+    }
+    return analogRead(pin);
+}
+
+int Joystick::_readAxis(uint8_t pin) {
+    // El lector externo ya entrega el valor filtrado, sin bloquear
+    if (_analogReader != nullptr) {
+        return _readPin(pin);
+    }
+
+    const int samples = JOYSTICK_ADC_SAMPLES;  // Número de lecturas
     int buffer[samples];
     int sum = 0;
 
     // Leer muestras
     for (int i = 0; i < samples; i++) {
-        buffer[i] = analogRead(_pinX);
+        buffer[i] = analogRead(pin);
         sum += buffer[i];
     }
+    _adcReadCount += samples;
 
     // Promedio inicial
     float avg = (float)sum / samples;
@@ -172,44 +230,63 @@ int Joystick::_readRawX() {
     return validSum / validCount;
 }
 
-int Joystick::_readRawY() {
-    const int samples = 10;
-    int buffer[samples];
-    int sum = 0;
-
-    for (int i = 0; i < samples; i++) {
-        buffer[i] = analogRead(_pinY);
-        sum += buffer[i];
+// Acquire both axes once and derive every processed value from them
+void Joystick::_acquire() {
+    int rawX = _readAxis(_pinX);
+    int rawY = _readAxis(_pinY); // necesario para deadzone circular
+    
+    _state.rawX = rawX;
+    _state.rawY = rawY;
+    _state.inDeadZone = _isInDeadZone(rawX, rawY);
+    
+    // Si está dentro de la zona muerta -> 0 en ambos ejes
+    if (_state.inDeadZone) {
+        _state.x = 0;
+        _state.y = 0;
+    } else {
+        _state.x = _chainX.process(rawX);
+        _state.y = _chainY.process(rawY);
     }
+    
+    _state.pressed = _buttonLevel();
+    _state.timestamp = millis();
+}
 
-    float avg = (float)sum / samples;
-
-    const int tolerance = 150;  
-    int validSum = 0;
-    int validCount = 0;
-
-    for (int i = 0; i < samples; i++) {
-        if (abs(buffer[i] - avg) < tolerance) {
-            validSum += buffer[i];
-            validCount++;
-        }
+// Without explicit sample() calls, keep the old behaviour: fresh reading per call
+void Joystick::_refresh() {
+    if (!_manualSampling) {
+        _acquire();
     }
+}
 
-    if (validCount == 0) return (int)avg;
-
-    return validSum / validCount;
+bool Joystick::_readButton() {
+    if (_pinButton == 255) return false;
+    if (_manualSampling) return _state.pressed;
+    return _buttonLevel();
 }
 
+// Debounced state kept by the interrupt, or the pin itself
+bool Joystick::_buttonLevel() {
+    if (_pinButton == 255) return false;
+    if (_edgeCapture) return _edgeCapture->isActive(_buttonChannel);
+    return !digitalRead(_pinButton); // Assuming pullup configuration
+}
 
-float Joystick::_applySmoothing(float newValue, float lastValue) {
-    return _useSmoothing ? (lastValue * (1.0 - _smoothingFactor) + newValue * _smoothingFactor) : newValue;
+// Calibration, inversion and expo into both axis chains (smoothing state is kept)
+void Joystick::_configureAxes() {
+    _chainX.stage<ScaleStage>().configure(_minX, _centerX, _maxX, 255, _invertX);
+    _chainY.stage<ScaleStage>().configure(_minY, _centerY, _maxY, 255, _invertY);
+    _chainX.stage<ClampStage>().setRange(-255, 255);
+    _chainY.stage<ClampStage>().setRange(-255, 255);
+    _chainX.stage<ExpoStage>().setExpo(_expoPercent, 255);
+    _chainY.stage<ExpoStage>().setExpo(_expoPercent, 255);
 }
 
 bool Joystick::_isInDeadZone(int x, int y) {
     if (_useCircularDeadZone) {
         int dx = x - _centerX;
         int dy = y - _centerY;
-        return (sqrt(dx*dx + dy*dy) <= _deadZoneRadius);
+        return signalInCircle(dx, dy, _deadZoneRadius);
     } else {
         return (abs(x - _centerX) <= _deadZoneRadius && abs(y - _centerY) <= _deadZoneRadius);
     }
@@ -223,72 +300,32 @@ int Joystick::_applyDeadZone(int value, int center, int deadZone) {
     return value;
 }
 
+// Sampling
+void Joystick::sample() {
+    _manualSampling = true;
+    _acquire();
+}
+
 // Reading methods - Raw values
 int Joystick::readRawX() {
-    return _readRawX();
+    if (_manualSampling) return _state.rawX;
+    return _readAxis(_pinX);
 }
 
 int Joystick::readRawY() {
-    return _readRawY();
+    if (_manualSampling) return _state.rawY;
+    return _readAxis(_pinY);
 }
 
 // Reading methods - Processed values (-255 to 255)
 int Joystick::readX() {
-    int rawX = _readRawX();
-    int rawY = _readRawY(); // necesario para deadzone circular
-
-    // Si está dentro de la zona muerta -> devolver 0
-    if (_isInDeadZone(rawX, rawY)) {
-        return 0;
-    }
-    
-    // Apply smoothing
-    float smoothedX = _applySmoothing(rawX, _lastX);
-    _lastX = smoothedX;
-    
-    // Map to -255 to 255 range
-    int processedX;
-    if (smoothedX >= _centerX) {
-        processedX = map(smoothedX, _centerX, _maxX, 0, 255);
-    } else {
-        processedX = map(smoothedX, _minX, _centerX, -255, 0);
-    }
-    
-    // Apply inversion if needed
-    if (_invertX) {
-        processedX = -processedX;
-    }
-    
-    return constrain(processedX, -255, 255);
+    _refresh();
+    return _state.x;
 }
 
 int Joystick::readY() {
-    int rawX = _readRawX();
-    int rawY = _readRawY(); // necesario para deadzone circular
-
-    // Si está dentro de la zona muerta -> devolver 0
-    if (_isInDeadZone(rawX, rawY)) {
-        return 0;
-    }
-    
-    // Apply smoothing
-    float smoothedY = _applySmoothing(rawY, _lastY);
-    _lastY = smoothedY;
-    
-    // Map to -255 to 255 range
-    int processedY;
-    if (smoothedY >= _centerY) {
-        processedY = map(smoothedY, _centerY, _maxY, 0, 255);
-    } else {
-        processedY = map(smoothedY, _minY, _centerY, -255, 0);
-    }
-    
-    // Apply inversion if needed
-    if (_invertY) {
-        processedY = -processedY;
-    }
-    
-    return constrain(processedY, -255, 255);
+    _refresh();
+    return _state.y;
 }
 
 // Reading methods - Float values (-1.0 to 1.0)
@@ -312,16 +349,16 @@ int Joystick::readYMapped(int minVal, int maxVal) {
 }
 
 // Reading methods - Magnitude and angle
+// Integer square root with 7 fractional bits (x^2 + y^2 <= 2 * 255^2)
 float Joystick::readMagnitude() {
-    float x = readXFloat();
-    float y = readYFloat();
-    return sqrt(x*x + y*y);
+    _refresh();
+    uint32_t squared = (uint32_t)(_state.x * _state.x + _state.y * _state.y);
+    return signalSqrt(squared << 14) / (255.0 * 128);
 }
 
 float Joystick::readAngle() {
-    float x = readXFloat();
-    float y = readYFloat();
-    return atan2(y, x);
+    _refresh();
+    return signalAtan2(_state.y, _state.x) / 32768.0;
 }
 
 float Joystick::readAngleDegrees() {
@@ -330,14 +367,21 @@ float Joystick::readAngleDegrees() {
 
 // Button methods
 bool Joystick::isPressed() {
-    if (_pinButton == 255) return false;
-    return !digitalRead(_pinButton); // Assuming pullup configuration
+    return _readButton();
 }
 
 bool Joystick::wasPressed() {
     if (_pinButton == 255) return false;
     
-    bool currentState = !digitalRead(_pinButton);
+    // Every press counted by the interrupt since the last call
+    if (_edgeCapture) {
+        uint16_t presses = _edgeCapture->getActivations(_buttonChannel);
+        bool pressed = presses != _seenPresses;
+        _seenPresses = presses;
+        return pressed;
+    }
+    
+    bool currentState = _readButton();
     bool wasPressed = false;
     
     if (currentState != _lastButtonState) {
@@ -357,7 +401,14 @@ bool Joystick::wasPressed() {
 bool Joystick::wasReleased() {
     if (_pinButton == 255) return false;
     
-    bool currentState = !digitalRead(_pinButton);
+    if (_edgeCapture) {
+        uint16_t releases = _edgeCapture->getDeactivations(_buttonChannel);
+        bool released = releases != _seenReleases;
+        _seenReleases = releases;
+        return released;
+    }
+    
+    bool currentState = _readButton();
     bool wasReleased = false;
     
     if (currentState != _lastButtonState) {
@@ -376,16 +427,16 @@ bool Joystick::wasReleased() {
 
 // Utility methods
 bool Joystick::isNeutral() {
-    return (readX() == 0 && readY() == 0);
+    _refresh();
+    return (_state.x == 0 && _state.y == 0);
 }
 
 bool Joystick::isAtEdge() {
-    int x = readX();
-    int y = readY();
-    return (abs(x) >= 95 || abs(y) >= 95); // Near max range
+    _refresh();
+    return (abs(_state.x) >= 95 || abs(_state.y) >= 95); // Near max range
 }
 
 void Joystick::resetPosition() {
-    _lastX = _centerX;
-    _lastY = _centerY;
+    _chainX.reset(_centerX);
+    _chainY.reset(_centerY);
 }
\ No newline at end of file
@@ -5,9 +5,17 @@
  * - Dead zone configuration
  * - Min/Max limits configuration
  * - Axis inversion
- * - Value smoothing/filtering
+ * - Value smoothing/filtering (EMA or one-euro) and expo curve
+ * - Fixed-point processing (SignalChain): no float math, sqrt() or map()
+ *   divisions per sample
  * - Calibration support
  * - Multiple output formats (raw, percentage, mapped)
+ * - Single-pass sampling: sample() acquires both axes once per control tick
+ *   and every read method becomes a cheap accessor over that snapshot
+ * - Optional external analog reader (e.g. AnalogAcquisition) instead of
+ *   blocking analogRead() bursts
+ * - Optional interrupt-driven button (EdgeCapture): debounced at the edge,
+ *   presses are never missed however seldom the button is checked
  * 
  * Author: GitHub Copilot
  * Date: 2025
@@ -17,6 +25,30 @@
 #define JOYSTICK_H
 
 #include <Arduino.h>
+#include <EdgeCapture.h>
+#include <SignalChain.h>
+
+// Number of ADC conversions averaged per axis acquisition
+#define JOYSTICK_ADC_SAMPLES 10
+
+// Per-axis processing: smoothing on the raw value, min/center/max to
+// -255..255 (inversion included), clamp, expo
+typedef SignalChain<SmoothingStage, ScaleStage, ClampStage, ExpoStage> JoystickAxisChain;
+
+// External analog reader, returns an already filtered value for the pin
+// (same signature as AnalogAcquisition::readPin)
+typedef int (*AnalogReadFn)(uint8_t pin, void* context);
+
+// Snapshot of one acquisition (filled by sample())
+struct JoystickState {
+    int rawX;               // Filtered ADC value, X axis
+    int rawY;               // Filtered ADC value, Y axis
+    int x;                  // Processed value (-255 to 255)
+    int y;                  // Processed value (-255 to 255)
+    bool inDeadZone;        // Both axes inside the dead zone
+    bool pressed;           // Button state at sample time
+    unsigned long timestamp; // millis() at sample time
+};
 
 class Joystick {
 private:
@@ -37,20 +69,34 @@ private:
     bool _invertX;
     bool _invertY;
     
-    // Smoothing filter
-    bool _useSmoothing;
-    float _smoothingFactor;
-    float _lastX, _lastY;
+    // Axis processing
+    JoystickAxisChain _chainX, _chainY;
+    uint8_t _expoPercent;
     
     // Button state
     bool _lastButtonState;
     unsigned long _lastDebounceTime;
     unsigned long _debounceDelay;
+    EdgeCapture* _edgeCapture;
+    int8_t _buttonChannel;
+    uint16_t _seenPresses;
+    uint16_t _seenReleases;
+    
+    // Sampled state
+    JoystickState _state;
+    bool _manualSampling;   // true once sample() has been called by the user
+    uint32_t _adcReadCount; // ADC values read by this instance (analogRead() or external reader)
+    AnalogReadFn _analogReader;
+    void* _analogReaderContext;
     
     // Internal helper methods
-    int _readRawX();
-    int _readRawY();
-    float _applySmoothing(float newValue, float lastValue);
+    int _readPin(uint8_t pin);
+    int _readAxis(uint8_t pin);
+    void _acquire();
+    void _refresh();
+    bool _readButton();
+    bool _buttonLevel();
+    void _configureAxes();
     bool _isInDeadZone(int x, int y);
     int _applyDeadZone(int value, int center, int deadZone);
     
@@ -69,7 +115,20 @@ public:
     void setCenter(int centerX, int centerY);
     void invertAxis(bool invertX, bool invertY);
     void setSmoothing(bool enable, float factor = 0.1);
+    // Smoothing that follows fast moves: cutoff = minCutoffHz + beta * speed
+    void setOneEuro(float minCutoffHz, float beta, uint16_t sampleRateHz);
+    void setExpo(uint8_t percent);
     void setDebounceDelay(unsigned long delay);
+    void setAnalogReader(AnalogReadFn reader, void* context = nullptr);
+    // Capture the button by interrupt (call after begin() and setDebounceDelay())
+    bool setEdgeCapture(EdgeCapture* capture);
+    
+    // Sampling - call once per control tick, then use the read methods freely.
+    // If sample() is never called, every read method acquires a fresh sample.
+    void sample();
+    const JoystickState& getState() { return _state; }
+    uint32_t getAdcReadCount() { return _adcReadCount; }
+    void resetAdcReadCount() { _adcReadCount = 0; }
     
     // Reading methods - Raw values
     int readRawX();
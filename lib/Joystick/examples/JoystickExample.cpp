@@ -40,6 +40,9 @@ void setup() {
 }
 
 void loop() {
+    // Acquire both axes once; every read below uses this snapshot
+    joystick.sample();
+    
     // Basic position reading (-100 to 100)
     int x = joystick.readX();
     int y = joystick.readY();
@@ -24,6 +24,9 @@ Lever::Lever(LeverType type, uint8_t pinA, uint8_t pinB, uint8_t pinButton) {
     // Default encoder configuration
     _encoderPosition = 0;
     _lastEncoderA = 0;
+    _encoderAttached = false;
+    _lastEncoderCount = 0;
+    _lastDirectionPosition = 0;
     _stepsPerDetent = 4;
     _minSteps = -100;
     _maxSteps = 100;
@@ -31,6 +34,8 @@ Lever::Lever(LeverType type, uint8_t pinA, uint8_t pinB, uint8_t pinButton) {
     // Default digital lever configuration
     _digitalPositions = 5;
     _currentDigitalPos = 0;
+    _lastPinAState = false;
+    _lastPinBState = false;
     
     // Movement detection
     _lastPosition = 0;
@@ -38,15 +43,28 @@ Lever::Lever(LeverType type, uint8_t pinA, uint8_t pinB, uint8_t pinButton) {
     _velocity = 0;
     _isMoving = false;
     
-    // Smoothing
-    _useSmoothing = false;
-    _smoothingFactor = 0.1;
-    _smoothedPosition = 0;
+    // Analog processing
+    _expoPercent = 0;
+    _configureChain();
     
     // Button configuration
     _lastButtonState = false;
     _lastDebounceTime = 0;
     _debounceDelay = 50;
+    
+    // Interrupt-driven switches
+    _edgeCapture = nullptr;
+    _channelA = EDGE_CAPTURE_NO_CHANNEL;
+    _channelB = EDGE_CAPTURE_NO_CHANNEL;
+    _buttonChannel = EDGE_CAPTURE_NO_CHANNEL;
+    _seenStepsUp = 0;
+    _seenStepsDown = 0;
+    _seenPresses = 0;
+    _seenReleases = 0;
+    
+    // External analog reader
+    _analogReader = nullptr;
+    _analogReaderContext = nullptr;
 }
 
 // Initialize the lever
@@ -54,7 +72,7 @@ void Lever::begin() {
     switch (_leverType) {
         case ANALOG_LEVER:
             // Analog input, no special setup needed
-            _smoothedPosition = analogRead(_pinA);
+            _chain.reset(_readAnalogPosition());
             break;
             
         case ROTARY_ENCODER:
@@ -78,13 +96,18 @@ void Lever::begin() {
     _lastUpdateTime = millis();
 }
 
-// Attach interrupt for encoder (call this after begin())
-void Lever::attachInterrupt() {
-    if (_leverType == ROTARY_ENCODER) {
-        // Note: You'll need to create a wrapper function for each encoder instance
-        // Example: attachInterrupt(digitalPinToInterrupt(_pinA), encoderISR, CHANGE);
-        Serial.println("Warning: attachInterrupt() must be implemented with external ISR function");
+// Attach the encoder to a pulse counter unit, or to pin interrupts (call this after begin()).
+// Every edge is counted (4 counts per quadrature cycle).
+bool Lever::attachInterrupt(bool allowHardware) {
+    if (_leverType != ROTARY_ENCODER || _pinB == 255) return false;
+
+    _encoderAttached = _encoder.begin(_pinA, _pinB, allowHardware);
+    if (!_encoderAttached) {
+        Serial.println("Lever: Encoder counter not available, polling in update()");
+        return false;
     }
+    _lastEncoderCount = _encoder.getCount();
+    return true;
 }
 
 // Configuration methods for analog levers
@@ -96,14 +119,17 @@ void Lever::setAnalogLimits(int minPos, int maxPos, int centerPos) {
     } else {
         _centerPosition = centerPos;
     }
+    _configureChain();
 }
 
 void Lever::setDeadZone(int deadZone) {
     _deadZone = deadZone;
+    _configureChain();
 }
 
 void Lever::invertDirection(bool invert) {
     _invertDirection = invert;
+    _configureChain();
 }
 
 // Configuration methods for encoders
@@ -127,20 +153,68 @@ void Lever::setDigitalPositions(int positions) {
 
 // General configuration
 void Lever::setSmoothing(bool enable, float factor) {
-    _useSmoothing = enable;
-    _smoothingFactor = constrain(factor, 0.0, 1.0);
+    _chain.stage<SmoothingStage>().setAlpha(enable ? signalQ16(constrain(factor, 0.0, 1.0)) : SIGNAL_Q16_ONE);
+}
+
+void Lever::setOneEuro(float minCutoffHz, float beta, uint16_t sampleRateHz) {
+    _chain.stage<SmoothingStage>().setOneEuro(minCutoffHz, beta, sampleRateHz);
+}
+
+void Lever::setExpo(uint8_t percent) {
+    _expoPercent = percent;
+    _configureChain();
 }
 
 void Lever::setDebounceDelay(unsigned long delay) {
     _debounceDelay = delay;
 }
 
+void Lever::setAnalogReader(AnalogReadFn reader, void* context) {
+    _analogReader = reader;
+    _analogReaderContext = context;
+}
+
+bool Lever::setEdgeCapture(EdgeCapture* capture) {
+    if (capture == nullptr) return false;
+
+    uint32_t debounceUs = _debounceDelay * 1000;
+    if (_leverType == DIGITAL_LEVER) {
+        _channelA = capture->addPin(_pinA, debounceUs);
+        _channelB = (_pinB != 255) ? capture->addPin(_pinB, debounceUs) : EDGE_CAPTURE_NO_CHANNEL;
+    }
+    if (_pinButton != 255) {
+        _buttonChannel = capture->addPin(_pinButton, debounceUs);
+    }
+    if (_channelA == EDGE_CAPTURE_NO_CHANNEL && _buttonChannel == EDGE_CAPTURE_NO_CHANNEL) {
+        return false;
+    }
+
+    _edgeCapture = capture;
+    _seenStepsUp = capture->getActivations(_channelA);
+    _seenStepsDown = capture->getActivations(_channelB);
+    _seenPresses = capture->getActivations(_buttonChannel);
+    _seenReleases = capture->getDeactivations(_buttonChannel);
+    return true;
+}
+
 // Internal helper methods
 int Lever::_readAnalogPosition() {
+    if (_analogReader != nullptr) {
+        return _analogReader(_pinA, _analogReaderContext);
+    }
     return analogRead(_pinA);
 }
 
 void Lever::_updateEncoder() {
+    // Counted in hardware/interrupts: apply what was counted since the last update
+    if (_encoderAttached) {
+        int32_t count = _encoder.getCount();
+        long delta = count - _lastEncoderCount;
+        _lastEncoderCount = count;
+        _encoderPosition = constrain(_encoderPosition + delta, _minSteps, _maxSteps);
+        return;
+    }
+    
     int currentA = digitalRead(_pinA);
     int currentB = digitalRead(_pinB);
     
@@ -159,25 +233,42 @@ void Lever::_updateEncoder() {
 }
 
 void Lever::_updateDigitalPosition() {
+    // Interrupt-driven: one step per press counted since the last update
+    if (_edgeCapture && _channelA != EDGE_CAPTURE_NO_CHANNEL) {
+        uint16_t stepsUp = _edgeCapture->getActivations(_channelA);
+        uint16_t stepsDown = _edgeCapture->getActivations(_channelB);
+        int delta = (uint16_t)(stepsUp - _seenStepsUp) - (uint16_t)(stepsDown - _seenStepsDown);
+        _seenStepsUp = stepsUp;
+        _seenStepsDown = stepsDown;
+        _currentDigitalPos = constrain(_currentDigitalPos + delta, 0, _digitalPositions - 1);
+        return;
+    }
+    
     bool pinAState = !digitalRead(_pinA);
     bool pinBState = (_pinB != 255) ? !digitalRead(_pinB) : false;
     
-    static bool lastPinAState = false;
-    static bool lastPinBState = false;
-    
-    if (pinAState && !lastPinAState) {
+    // Edge state is per instance
+    if (pinAState && !_lastPinAState) {
         _currentDigitalPos = min(_currentDigitalPos + 1, _digitalPositions - 1);
     }
     
-    if (pinBState && !lastPinBState) {
+    if (pinBState && !_lastPinBState) {
         _currentDigitalPos = max(_currentDigitalPos - 1, 0);
     }
     
-    lastPinAState = pinAState;
-    lastPinBState = pinBState;
+    _lastPinAState = pinAState;
+    _lastPinBState = pinBState;
 }
 
 float Lever::_calculateVelocity() {
+    // Attached encoder: counts over a fixed window, independent of the call rate
+    if (_encoderAttached) {
+        _encoder.update();
+        _velocity = _encoder.getVelocity();
+        _isMoving = (abs(_velocity) > 1.0);
+        return _velocity;
+    }
+    
     unsigned long currentTime = millis();
     float deltaTime = (currentTime - _lastUpdateTime) / 1000.0; // Convert to seconds
     
@@ -199,6 +290,14 @@ bool Lever::_isInDeadZone(int position) {
     return (abs(position - _centerPosition) <= _deadZone);
 }
 
+// Calibration, dead zone, inversion and expo into the chain (smoothing state is kept)
+void Lever::_configureChain() {
+    _chain.stage<DeadZoneStage>().setDeadZone(_centerPosition, _deadZone);
+    _chain.stage<ScaleStage>().configure(_minPosition, _centerPosition, _maxPosition, 100, _invertDirection);
+    _chain.stage<ClampStage>().setRange(-100, 100);
+    _chain.stage<ExpoStage>().setExpo(_expoPercent, 100);
+}
+
 // Reading methods - Raw values
 int Lever::readRaw() {
     switch (_leverType) {
@@ -228,32 +327,8 @@ int Lever::readPosition() {
     int rawValue = readRaw();
     
     switch (_leverType) {
-        case ANALOG_LEVER: {
-            if (_isInDeadZone(rawValue)) {
-                rawValue = _centerPosition;
-            }
-            
-            // Apply smoothing
-            if (_useSmoothing) {
-                _smoothedPosition = _smoothedPosition * (1.0 - _smoothingFactor) + rawValue * _smoothingFactor;
-                rawValue = (int)_smoothedPosition;
-            }
-            
-            // Map to -100 to 100 range
-            int processedValue;
-            if (rawValue >= _centerPosition) {
-                processedValue = map(rawValue, _centerPosition, _maxPosition, 0, 100);
-            } else {
-                processedValue = map(rawValue, _minPosition, _centerPosition, -100, 0);
-            }
-            
-            // Apply inversion if needed
-            if (_invertDirection) {
-                processedValue = -processedValue;
-            }
-            
-            return constrain(processedValue, -100, 100);
-        }
+        case ANALOG_LEVER:
+            return _chain.process(rawValue);
         
         case ROTARY_ENCODER: {
             int steps = _encoderPosition / _stepsPerDetent;
@@ -347,12 +422,23 @@ bool Lever::isInDeadZone() {
 // Button methods
 bool Lever::isPressed() {
     if (_pinButton == 255) return false;
+    if (_edgeCapture && _buttonChannel != EDGE_CAPTURE_NO_CHANNEL) {
+        return _edgeCapture->isActive(_buttonChannel);
+    }
     return !digitalRead(_pinButton);
 }
 
 bool Lever::wasPressed() {
     if (_pinButton == 255) return false;
     
+    // Every press counted by the interrupt since the last call
+    if (_edgeCapture && _buttonChannel != EDGE_CAPTURE_NO_CHANNEL) {
+        uint16_t presses = _edgeCapture->getActivations(_buttonChannel);
+        bool pressed = presses != _seenPresses;
+        _seenPresses = presses;
+        return pressed;
+    }
+    
     bool currentState = !digitalRead(_pinButton);
     bool wasPressed = false;
     
@@ -373,6 +459,13 @@ bool Lever::wasPressed() {
 bool Lever::wasReleased() {
     if (_pinButton == 255) return false;
     
+    if (_edgeCapture && _buttonChannel != EDGE_CAPTURE_NO_CHANNEL) {
+        uint16_t releases = _edgeCapture->getDeactivations(_buttonChannel);
+        bool released = releases != _seenReleases;
+        _seenReleases = releases;
+        return released;
+    }
+    
     bool currentState = !digitalRead(_pinButton);
     bool wasReleased = false;
     
@@ -404,17 +497,16 @@ long Lever::getEncoderPosition() {
 int Lever::getEncoderDirection() {
     if (_leverType != ROTARY_ENCODER) return 0;
     
-    static long lastPosition = 0;
     long currentPosition = _encoderPosition;
     
     int direction = 0;
-    if (currentPosition > lastPosition) {
+    if (currentPosition > _lastDirectionPosition) {
         direction = 1;
-    } else if (currentPosition < lastPosition) {
+    } else if (currentPosition < _lastDirectionPosition) {
         direction = -1;
     }
     
-    lastPosition = currentPosition;
+    _lastDirectionPosition = currentPosition;
     return direction;
 }
 
@@ -460,7 +552,7 @@ void Lever::update() {
 void Lever::reset() {
     switch (_leverType) {
         case ANALOG_LEVER:
-            _smoothedPosition = _centerPosition;
+            _chain.reset(_centerPosition);
             break;
             
         case ROTARY_ENCODER:
@@ -489,7 +581,7 @@ void Lever::calibrateAnalog() {
     
     unsigned long startTime = millis();
     while (millis() - startTime < 5000) {
-        int value = analogRead(_pinA);
+        int value = _readAnalogPosition();
         
         if (value < _minPosition) _minPosition = value;
         if (value > _maxPosition) _maxPosition = value;
@@ -500,7 +592,8 @@ void Lever::calibrateAnalog() {
     Serial.println("Center the lever and hold for 2 seconds...");
     delay(2000);
     
-    _centerPosition = analogRead(_pinA);
+    _centerPosition = _readAnalogPosition();
+    _configureChain();
     
     Serial.println("Calibration complete!");
     Serial.print("Min="); Serial.print(_minPosition);
@@ -510,7 +603,8 @@ void Lever::calibrateAnalog() {
 
 void Lever::calibrateCenter() {
     if (_leverType == ANALOG_LEVER) {
-        _centerPosition = analogRead(_pinA);
+        _centerPosition = _readAnalogPosition();
+        _configureChain();
         Serial.print("Center position set to: ");
         Serial.println(_centerPosition);
     } else if (_leverType == ROTARY_ENCODER) {
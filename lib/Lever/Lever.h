@@ -7,7 +7,13 @@
  * - Direction detection
  * - Speed/velocity calculation
  * - Step-based movement for encoders
- * - Smooth analog reading for potentiometer levers
+ * - Encoders counted in hardware (PCNT) or interrupts with attachInterrupt(),
+ *   with velocity from the counts over a fixed window (QuadratureEncoder)
+ * - Smooth analog reading for potentiometer levers (EMA or one-euro) and
+ *   expo curve, in fixed point (SignalChain)
+ * - Optional external analog reader (e.g. AnalogAcquisition)
+ * - Optional interrupt-driven switches and button (EdgeCapture) for digital
+ *   levers: steps and presses are counted at the edge, never missed
  * - Center detection and auto-return functionality
  * 
  * Author: GitHub Copilot
@@ -18,6 +24,13 @@
 #define LEVER_H
 
 #include <Arduino.h>
+#include <EdgeCapture.h>
+#include <QuadratureEncoder.h>
+#include <SignalChain.h>
+
+// External analog reader, returns an already filtered value for the pin
+// (same signature as AnalogAcquisition::readPin)
+typedef int (*AnalogReadFn)(uint8_t pin, void* context);
 
 // Lever types
 enum LeverType {
@@ -26,6 +39,10 @@ enum LeverType {
     DIGITAL_LEVER    // Switch-based discrete positions
 };
 
+// Analog lever processing: dead zone, smoothing, min/center/max to
+// -100..100 (inversion included), clamp, expo
+typedef SignalChain<DeadZoneStage, SmoothingStage, ScaleStage, ClampStage, ExpoStage> LeverChain;
+
 class Lever {
 private:
     // Configuration
@@ -44,6 +61,10 @@ private:
     // Encoder properties
     volatile long _encoderPosition;
     int _lastEncoderA;
+    QuadratureEncoder _encoder;
+    bool _encoderAttached;
+    int32_t _lastEncoderCount;
+    long _lastDirectionPosition;
     int _stepsPerDetent;
     int _minSteps;
     int _maxSteps;
@@ -51,6 +72,8 @@ private:
     // Digital lever properties
     int _digitalPositions;
     int _currentDigitalPos;
+    bool _lastPinAState;
+    bool _lastPinBState;
     
     // Movement detection
     float _lastPosition;
@@ -58,22 +81,36 @@ private:
     float _velocity;
     bool _isMoving;
     
-    // Smoothing
-    bool _useSmoothing;
-    float _smoothingFactor;
-    float _smoothedPosition;
+    // Analog processing
+    LeverChain _chain;
+    uint8_t _expoPercent;
     
     // Button state
     bool _lastButtonState;
     unsigned long _lastDebounceTime;
     unsigned long _debounceDelay;
     
+    // Interrupt-driven switches (digital lever pins and button)
+    EdgeCapture* _edgeCapture;
+    int8_t _channelA;
+    int8_t _channelB;
+    int8_t _buttonChannel;
+    uint16_t _seenStepsUp;
+    uint16_t _seenStepsDown;
+    uint16_t _seenPresses;
+    uint16_t _seenReleases;
+    
+    // External analog reader
+    AnalogReadFn _analogReader;
+    void* _analogReaderContext;
+    
     // Internal helper methods
     int _readAnalogPosition();
     void _updateEncoder();
     void _updateDigitalPosition();
     float _calculateVelocity();
     bool _isInDeadZone(int position);
+    void _configureChain();
     
 public:
     // Constructors for different lever types
@@ -81,7 +118,8 @@ public:
     
     // Initialization
     void begin();
-    void attachInterrupt();
+    // Rotary encoders: count every edge in PCNT or interrupts instead of update() polling
+    bool attachInterrupt(bool allowHardware = true);
     
     // Configuration methods for analog levers
     void setAnalogLimits(int minPos, int maxPos, int centerPos = -1);
@@ -98,7 +136,14 @@ public:
     
     // General configuration
     void setSmoothing(bool enable, float factor = 0.1);
+    // Smoothing that follows fast moves: cutoff = minCutoffHz + beta * speed
+    void setOneEuro(float minCutoffHz, float beta, uint16_t sampleRateHz);
+    void setExpo(uint8_t percent);
     void setDebounceDelay(unsigned long delay);
+    void setAnalogReader(AnalogReadFn reader, void* context = nullptr);
+    // Capture the digital lever switches and the button by interrupt
+    // (call after begin() and setDebounceDelay())
+    bool setEdgeCapture(EdgeCapture* capture);
     
     // Reading methods - Raw values
     int readRaw();
@@ -133,6 +178,7 @@ public:
     void resetEncoder();
     long getEncoderPosition();
     int getEncoderDirection(); // -1, 0, or 1
+    QuadratureEncoder& getEncoder() { return _encoder; }
     
     // Digital lever specific methods
     int getDigitalPosition();
@@ -0,0 +1,167 @@
+/**
+ * LeverTable Library - Table-driven reader for N three-position levers
+ *
+ * Each lever is a 3-position switch on two active-low pins with pull-up.
+ * The pins are declared once in a constexpr table; LeverTable samples all
+ * of them from one snapshot of the GPIO input registers, so adding a lever
+ * is one more table row and does not add GPIO reads.
+ *
+ * Features:
+ * - Compile-time lever count (template parameter) and pin table
+ * - One snapshot of GPIO_IN_REG/GPIO_IN1_REG per update(), masked per lever
+ *   (only the registers that hold a lever pin are read)
+ * - Per-lever debounce: a new position must be seen on consecutive updates
+ * - Positions and configured values (limits[position]) as arrays
+ * - update(levels) to feed a snapshot taken elsewhere (host tests)
+ *
+ * Usage:
+ *   constexpr LeverPins PINS[2] = {{13, 14}, {11, 12}};
+ *   LeverTable<2> levers(PINS);
+ *   levers.begin();          // INPUT_PULLUP + first read
+ *   levers.update();         // once per control cycle
+ *   uint8_t pos = levers.getPosition(0);
+ *
+ * Date: 2025
+ */
+
+#ifndef LEVER_TABLE_H
+#define LEVER_TABLE_H
+
+#include <Arduino.h>
+#include <soc/soc.h>
+#include <soc/gpio_reg.h>
+
+#define LEVER_TABLE_DEBOUNCE_SAMPLES 2
+#define LEVER_TABLE_CENTER 1
+
+// Pins of one lever (both active LOW)
+struct LeverPins {
+    uint8_t pin1;
+    uint8_t pin2;
+};
+
+template <uint8_t N>
+class LeverTable {
+private:
+    const LeverPins* _pins;
+    uint64_t _pin1Mask[N];
+    uint64_t _pin2Mask[N];
+    bool _readLow;             // Some pin in GPIO0-31
+    bool _readHigh;            // Some pin in GPIO32-63
+    uint8_t _debounceSamples;
+
+    uint8_t _position[N];      // Debounced positions
+    uint8_t _candidate[N];     // Position waiting to be confirmed
+    uint8_t _candidateCount[N];
+    uint32_t _changes;
+
+    static uint64_t _mask(uint8_t pin) {
+        return pin < 64 ? (uint64_t)1 << pin : 0;
+    }
+
+public:
+    explicit LeverTable(const LeverPins (&pins)[N], uint8_t debounceSamples = LEVER_TABLE_DEBOUNCE_SAMPLES)
+        : _pins(pins), _readLow(false), _readHigh(false), _changes(0) {
+        _debounceSamples = debounceSamples > 0 ? debounceSamples : 1;
+        for (uint8_t i = 0; i < N; i++) {
+            _pin1Mask[i] = _mask(pins[i].pin1);
+            _pin2Mask[i] = _mask(pins[i].pin2);
+            _readLow = _readLow || (uint32_t)(_pin1Mask[i] | _pin2Mask[i]) != 0;
+            _readHigh = _readHigh || ((_pin1Mask[i] | _pin2Mask[i]) >> 32) != 0;
+            _position[i] = LEVER_TABLE_CENTER;
+            _candidate[i] = LEVER_TABLE_CENTER;
+            _candidateCount[i] = 0;
+        }
+    }
+
+    // Position from the two pin levels: 0 = pin1 LOW, 1 = both HIGH (center), 2 = pin2 LOW.
+    // Both LOW is not a valid switch state and reads as center.
+    static uint8_t decode(bool pin1, bool pin2) {
+        if (!pin1 && pin2) return 0;
+        if (pin1 && !pin2) return 2;
+        return LEVER_TABLE_CENTER;
+    }
+
+    // Configure the pins and take the initial positions without debounce
+    void begin() {
+        for (uint8_t i = 0; i < N; i++) {
+            pinMode(_pins[i].pin1, INPUT_PULLUP);
+            pinMode(_pins[i].pin2, INPUT_PULLUP);
+        }
+        uint64_t levels = readLevels();
+        for (uint8_t i = 0; i < N; i++) {
+            _position[i] = decode(levels & _pin1Mask[i], levels & _pin2Mask[i]);
+            _candidate[i] = _position[i];
+            _candidateCount[i] = 0;
+        }
+    }
+
+    // Levels of GPIO0-63 (bit n = GPIOn) from the input registers the table uses
+    uint64_t readLevels() const {
+        uint64_t levels = 0;
+        if (_readLow) levels |= (uint32_t)REG_READ(GPIO_IN_REG);
+        if (_readHigh) levels |= (uint64_t)(uint32_t)REG_READ(GPIO_IN1_REG) << 32;
+        return levels;
+    }
+
+    // One acquisition of every lever. Returns true if a debounced position changed.
+    bool update() {
+        return update(readLevels());
+    }
+
+    bool update(uint64_t levels) {
+        bool changed = false;
+        for (uint8_t i = 0; i < N; i++) {
+            uint8_t position = decode(levels & _pin1Mask[i], levels & _pin2Mask[i]);
+            if (position == _position[i]) {
+                _candidateCount[i] = 0;
+                continue;
+            }
+            if (position != _candidate[i]) {
+                _candidate[i] = position;
+                _candidateCount[i] = 0;
+            }
+            if (++_candidateCount[i] >= _debounceSamples) {
+                _position[i] = position;
+                _candidateCount[i] = 0;
+                _changes++;
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    uint8_t getPosition(uint8_t lever) const {
+        return lever < N ? _position[lever] : LEVER_TABLE_CENTER;
+    }
+
+    const uint8_t* getPositions() const {
+        return _position;
+    }
+
+    // Configured value for the current position of a lever (limits[lever][position])
+    uint8_t getValue(uint8_t lever, const uint8_t limits[][3]) const {
+        return lever < N ? limits[lever][_position[lever]] : 0;
+    }
+
+    void getValues(const uint8_t limits[][3], uint8_t values[N]) const {
+        for (uint8_t i = 0; i < N; i++) {
+            values[i] = limits[i][_position[i]];
+        }
+    }
+
+    void setDebounceSamples(uint8_t samples) {
+        _debounceSamples = samples > 0 ? samples : 1;
+    }
+
+    // Debounced position changes since construction
+    uint32_t getChanges() const {
+        return _changes;
+    }
+
+    static constexpr uint8_t count() {
+        return N;
+    }
+};
+
+#endif // LEVER_TABLE_H
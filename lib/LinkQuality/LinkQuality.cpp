@@ -0,0 +1,215 @@
+/**
+ * LinkQuality Library Implementation
+ *
+ * Date: 2025
+ */
+
+#include "LinkQuality.h"
+
+LinkQuality::LinkQuality() {
+    _bucketMs = LINK_QUALITY_DEFAULT_BUCKET_MS;
+    _mux = portMUX_INITIALIZER_UNLOCKED;
+    reset();
+}
+
+void LinkQuality::setBucketMs(uint32_t bucketMs) {
+    if (bucketMs == 0) {
+        Serial.println("LinkQuality: Bucket must be > 0 ms");
+        return;
+    }
+    _bucketMs = bucketMs;
+    reset();
+}
+
+void LinkQuality::reset() {
+    portENTER_CRITICAL(&_mux);
+    memset(_buckets, 0, sizeof(_buckets));
+    _bucketIndex = 0;
+    _startMs = 0;
+    _started = false;
+    memset(_rtt, 0, sizeof(_rtt));
+    _rttCount = 0;
+    _rttNext = 0;
+    _plosTotal = 0;
+    _scoreX256 = 100 << 8;
+    _scoreValid = false;
+    portEXIT_CRITICAL(&_mux);
+}
+
+// Close the buckets that ended before nowMs (called with _mux held)
+void LinkQuality::_advance(uint32_t nowMs) {
+    uint32_t index = nowMs / _bucketMs;
+    if (!_started) {
+        _bucketIndex = index;
+        _startMs = nowMs;
+        _started = true;
+        return;
+    }
+
+    uint32_t elapsed = index - _bucketIndex;
+    if (elapsed == 0) return;
+
+    _scoreBucket(_buckets[_bucketIndex % LINK_QUALITY_BUCKETS]);
+    uint32_t clear = elapsed < LINK_QUALITY_BUCKETS ? elapsed : LINK_QUALITY_BUCKETS;
+    for (uint32_t i = 1; i <= clear; i++) {
+        memset(&_buckets[(_bucketIndex + i) % LINK_QUALITY_BUCKETS], 0, sizeof(Bucket));
+    }
+    _bucketIndex = index;
+}
+
+// Delivery efficiency of a closed bucket into the score. Buckets without
+// packets carry no information and leave it as it was.
+void LinkQuality::_scoreBucket(const Bucket& bucket) {
+    if (bucket.packets == 0) return;
+
+    uint32_t transmissions = (uint32_t)bucket.packets + bucket.retransmits;
+    int32_t efficiency = (int32_t)((uint32_t)bucket.acked * (100 << 8) / transmissions);
+    if (!_scoreValid) {
+        _scoreX256 = efficiency;
+        _scoreValid = true;
+    } else {
+        int32_t score = _scoreX256;
+        score += (efficiency - score) / (1 << LINK_QUALITY_EWMA_SHIFT);
+        _scoreX256 = score;
+    }
+}
+
+void LinkQuality::onPacket(bool acked, uint8_t retransmits, uint32_t nowMs) {
+    portENTER_CRITICAL(&_mux);
+    _advance(nowMs);
+    Bucket& bucket = _buckets[_bucketIndex % LINK_QUALITY_BUCKETS];
+    if (bucket.packets < UINT16_MAX) {
+        bucket.packets++;
+        if (acked) bucket.acked++;
+        bucket.retransmits += retransmits;
+    }
+    portEXIT_CRITICAL(&_mux);
+}
+
+void LinkQuality::onRpd(bool strong, uint32_t nowMs) {
+    portENTER_CRITICAL(&_mux);
+    _advance(nowMs);
+    Bucket& bucket = _buckets[_bucketIndex % LINK_QUALITY_BUCKETS];
+    if (bucket.rpdSamples < UINT16_MAX) {
+        bucket.rpdSamples++;
+        if (strong) bucket.rpdHits++;
+    }
+    portEXIT_CRITICAL(&_mux);
+}
+
+void LinkQuality::onRoundTrip(uint32_t rttUs) {
+    portENTER_CRITICAL(&_mux);
+    _rtt[_rttNext] = rttUs;
+    _rttNext = (_rttNext + 1) % LINK_QUALITY_RTT_SAMPLES;
+    if (_rttCount < LINK_QUALITY_RTT_SAMPLES) _rttCount++;
+    portEXIT_CRITICAL(&_mux);
+}
+
+uint8_t LinkQuality::observe(RF24& radio, bool acked, uint32_t nowMs) {
+    uint8_t arc = radio.getARC();
+
+    // PLOS_CNT counts exactly the packets that ran out of retries, but it
+    // saturates at 15 and only an RF_CH write clears it (the channel belongs
+    // to the caller or HopTransmitter): count the missing ACKs instead
+    portENTER_CRITICAL(&_mux);
+    if (!acked) _plosTotal++;
+    portEXIT_CRITICAL(&_mux);
+
+    onPacket(acked, arc, nowMs);
+    return arc;
+}
+
+bool LinkQuality::sampleRpd(RF24& radio, uint32_t nowMs) {
+    bool strong = radio.testRPD();
+    onRpd(strong, nowMs);
+    return strong;
+}
+
+uint8_t LinkQuality::getScore() {
+    portENTER_CRITICAL(&_mux);
+    uint8_t score = (_scoreX256 + 128) >> 8;
+    portEXIT_CRITICAL(&_mux);
+    return score;
+}
+
+LinkQualityReport LinkQuality::getReport(uint32_t nowMs) {
+    LinkQualityReport report;
+    memset(&report, 0, sizeof(report));
+    uint32_t rtt[LINK_QUALITY_RTT_SAMPLES];
+
+    portENTER_CRITICAL(&_mux);
+    if (_started) _advance(nowMs);
+    for (uint8_t i = 0; i < LINK_QUALITY_BUCKETS; i++) {
+        const Bucket& bucket = _buckets[i];
+        report.packets += bucket.packets;
+        report.acked += bucket.acked;
+        report.retransmits += bucket.retransmits;
+        report.rpdSamples += bucket.rpdSamples;
+        report.rpdHits += bucket.rpdHits;
+    }
+    uint32_t runningMs = _started ? nowMs - _startMs : 0;
+    report.plosTotal = _plosTotal;
+    report.score = (_scoreX256 + 128) >> 8;
+    report.valid = _scoreValid;
+    report.rttSamples = _rttCount;
+    memcpy(rtt, _rtt, _rttCount * sizeof(uint32_t));
+    portEXIT_CRITICAL(&_mux);
+
+    report.windowMs = runningMs < getWindowMs() ? runningMs : getWindowMs();
+    report.lost = report.packets - report.acked;
+    if (report.packets > 0) {
+        report.lossPercent = report.lost * 100 / report.packets;
+        report.retriesX100 = report.retransmits * 100 / report.packets;
+    }
+    if (report.rpdSamples > 0) {
+        report.rpdPercent = (uint32_t)report.rpdHits * 100 / report.rpdSamples;
+    }
+
+    // Percentiles by nearest rank over the samples kept
+    uint16_t count = report.rttSamples;
+    if (count > 0) {
+        for (uint16_t i = 1; i < count; i++) {
+            uint32_t value = rtt[i];
+            int16_t j = i - 1;
+            while (j >= 0 && rtt[j] > value) {
+                rtt[j + 1] = rtt[j];
+                j--;
+            }
+            rtt[j + 1] = value;
+        }
+        report.rttP50Us = rtt[(count - 1) * 50 / 100];
+        report.rttP90Us = rtt[(count - 1) * 90 / 100];
+        report.rttP99Us = rtt[(count - 1) * 99 / 100];
+        report.rttMaxUs = rtt[count - 1];
+    }
+    return report;
+}
+
+void LinkQuality::printReport(uint32_t nowMs) {
+    LinkQualityReport report = getReport(nowMs);
+
+    Serial.print("LinkQuality: score ");
+    if (report.valid) Serial.print(report.score);
+    else Serial.print("-");
+    Serial.print("  Loss: "); Serial.print(report.lossPercent);
+    Serial.print("% ("); Serial.print(report.lost); Serial.print("/"); Serial.print(report.packets);
+    Serial.print(" in "); Serial.print(report.windowMs); Serial.print(" ms)");
+    Serial.print("  Retries/pkt: "); Serial.print(report.retriesX100 / 100.0, 2);
+    Serial.print("  PLOS: "); Serial.println(report.plosTotal);
+
+    Serial.print("LinkQuality: RPD ");
+    if (report.rpdSamples > 0) {
+        Serial.print(report.rpdPercent); Serial.print("% of "); Serial.print(report.rpdSamples);
+    } else {
+        Serial.print("-");
+    }
+    Serial.print("  RTT: ");
+    if (report.rttSamples > 0) {
+        Serial.print(report.rttP50Us); Serial.print("/");
+        Serial.print(report.rttP90Us); Serial.print("/");
+        Serial.print(report.rttP99Us); Serial.print("/");
+        Serial.print(report.rttMaxUs); Serial.println(" us (p50/p90/p99/max)");
+    } else {
+        Serial.println("-");
+    }
+}
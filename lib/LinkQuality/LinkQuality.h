@@ -0,0 +1,124 @@
+/**
+ * LinkQuality Library - Sliding-window link quality estimator for the nRF24L01
+ *
+ * Sent/lost counters since boot say little about the link right now. With
+ * auto-ACK the chip reports, for every packet, how many retransmissions it
+ * needed (ARC_CNT) and counts the packets that ran out of retries
+ * (PLOS_CNT). LinkQuality keeps those per time bucket, together with
+ * received power detector samples (RPD: signal above -64 dBm) and round-trip
+ * times, and scores the link as the share of transmissions that delivered a
+ * packet, smoothed bucket by bucket.
+ *
+ * Features:
+ * - Sliding window of LINK_QUALITY_BUCKETS buckets (1 s by default):
+ *   packets, ACKed, lost, retransmissions, RPD hits
+ * - observe(): ARC_CNT of each packet through getARC(); lost packets are
+ *   counted from the missing ACKs, never touching RF_CH
+ * - Round-trip percentiles (p50/p90/p99/max) over the last
+ *   LINK_QUALITY_RTT_SAMPLES samples
+ * - Quality score 0-100: exponentially weighted average of the delivery
+ *   efficiency (ACKed packets / transmissions on air) of each bucket
+ * - Safe to read from another task (getReport() copies under a spinlock)
+ * - printReport(): one-screen Serial dashboard
+ *
+ * ARC_CNT and RPD need auto-ACK: without ACKs every packet counts as
+ * delivered and the score stays at 100.
+ *
+ * Usage:
+ *   LinkQuality link;
+ *   // When a packet ends (after write(), or from the RadioTx callback):
+ *   link.observe(radio, acked, millis());
+ *   link.sampleRpd(radio, millis());
+ *   link.onRoundTrip(latencyUs);
+ *   LinkQualityReport report = link.getReport(millis());
+ *
+ * Date: 2025
+ */
+
+#ifndef LINK_QUALITY_H
+#define LINK_QUALITY_H
+
+#include <Arduino.h>
+#include <RF24.h>
+
+#define LINK_QUALITY_BUCKETS 10
+#define LINK_QUALITY_DEFAULT_BUCKET_MS 100    // 10 x 100 ms = 1 s window
+#define LINK_QUALITY_RTT_SAMPLES 64
+#define LINK_QUALITY_EWMA_SHIFT 2             // Each bucket weighs 1/4 in the score
+
+struct LinkQualityReport {
+    uint32_t windowMs;          // Time covered by the counters below
+    uint32_t packets;           // Packets that ended (ACKed or not)
+    uint32_t acked;
+    uint32_t lost;              // No ACK after every retry
+    uint32_t retransmits;       // Sum of ARC_CNT
+    uint32_t plosTotal;         // Packets out of retries since reset() (what PLOS_CNT counts)
+    uint16_t rpdSamples;
+    uint16_t rpdHits;           // RPD set: received power above -64 dBm
+    uint8_t lossPercent;        // Lost / packets in the window
+    uint8_t rpdPercent;         // RPD hits / samples in the window
+    uint16_t retriesX100;       // Retransmissions per packet x 100
+    uint16_t rttSamples;        // Samples behind the percentiles
+    uint32_t rttP50Us;
+    uint32_t rttP90Us;
+    uint32_t rttP99Us;
+    uint32_t rttMaxUs;
+    uint8_t score;              // 0-100, smoothed delivery efficiency
+    bool valid;                 // At least one bucket scored
+};
+
+class LinkQuality {
+private:
+    struct Bucket {
+        uint16_t packets;
+        uint16_t acked;
+        uint16_t retransmits;
+        uint16_t rpdSamples;
+        uint16_t rpdHits;
+    };
+
+    Bucket _buckets[LINK_QUALITY_BUCKETS];
+    uint32_t _bucketMs;
+    uint32_t _bucketIndex;      // Absolute bucket number of the current one
+    uint32_t _startMs;
+    bool _started;
+
+    uint32_t _rtt[LINK_QUALITY_RTT_SAMPLES];
+    uint8_t _rttCount;
+    uint8_t _rttNext;
+
+    uint32_t _plosTotal;
+    uint16_t _scoreX256;        // Fixed point, 8 fractional bits
+    bool _scoreValid;
+
+    portMUX_TYPE _mux;
+
+    void _advance(uint32_t nowMs);
+    void _scoreBucket(const Bucket& bucket);
+
+public:
+    LinkQuality();
+
+    // Window = LINK_QUALITY_BUCKETS x bucketMs
+    void setBucketMs(uint32_t bucketMs);
+    uint32_t getWindowMs() { return _bucketMs * LINK_QUALITY_BUCKETS; }
+
+    // One packet ended: ACKed or not, and how many retransmissions it took
+    void onPacket(bool acked, uint8_t retransmits, uint32_t nowMs);
+    // One RPD reading (testRPD())
+    void onRpd(bool strong, uint32_t nowMs);
+    // One round-trip time (e.g. write() duration or submit -> TX_DS)
+    void onRoundTrip(uint32_t rttUs);
+
+    // Count a packet that ended, with its ARC_CNT (getARC()). Returns ARC_CNT.
+    uint8_t observe(RF24& radio, bool acked, uint32_t nowMs);
+    // testRPD() after an ACK: power of the receiver's answer
+    bool sampleRpd(RF24& radio, uint32_t nowMs);
+
+    uint8_t getScore();
+    LinkQualityReport getReport(uint32_t nowMs);
+    void reset();
+    void printReport(uint32_t nowMs);
+};
+
+#endif // LINK_QUALITY_H
@@ -37,8 +37,16 @@ NRF24Controller::NRF24Controller(uint8_t cePin, uint8_t csnPin) {
     _autoSend = false;
     _sendInterval = 50;
     _lastSendTime = 0;
+    _adaptiveRate = false;
+    _nonBlocking = false;
+    
+    // Keyframe/delta protocol
+    _keyframeInterval = 250;
+    _lastKeyframeTime = 0;
+    _forceKeyframe = true; // First packet is always a keyframe
     
     // Transmission settings
+    _fragmentation = true;
     _enableAck = true;
     _retryCount = 15;
     _retryDelay = 5;
@@ -50,6 +58,8 @@ NRF24Controller::NRF24Controller(uint8_t cePin, uint8_t csnPin) {
     
     // Initialize stats
     memset(&_stats, 0, sizeof(_stats));
+    memset(&_rxPacket, 0, sizeof(_rxPacket));
+    _rxNextFragment = 0;
     
     // Initialize last data arrays
     memset(_lastJoystickData, 0, sizeof(_lastJoystickData));
@@ -93,7 +103,9 @@ void NRF24Controller::_initializeRadio() {
     _radio->setChannel(_channel);
     _radio->enableAckPayload();
     _radio->setRetries(_retryDelay, _retryCount);
-    _radio->setPayloadSize(sizeof(DataPacket));
+    // Frames are encoded with PacketCodec, dynamic payloads avoid sending padding
+    _radio->enableDynamicPayloads();
+    _radio->setPayloadSize(PACKET_FRAME_MAX);
     
     _radio->openWritingPipe(_txAddress);
     _radio->openReadingPipe(1, _rxAddress);
@@ -226,6 +238,48 @@ void NRF24Controller::setAutoSend(bool enable, unsigned long interval) {
     _sendInterval = interval;
 }
 
+void NRF24Controller::setAdaptiveRate(bool enable, unsigned long activeMs, unsigned long heartbeatMs,
+                                      unsigned long failsafeMs) {
+    _adaptiveRate = enable;
+    if (enable) {
+        _scheduler.setIntervals(activeMs * 1000UL, heartbeatMs * 1000UL, failsafeMs * 1000UL);
+        _scheduler.forceSend();
+        _scheduler.resetStats();
+    }
+}
+
+void NRF24Controller::setNonBlocking(bool enable, unsigned long timeoutMs) {
+    if (enable == _nonBlocking) return;
+    
+    if (enable) {
+        // Up to 3 frames queued: a fragmented packet fits the FIFO
+        if (!_radioTx.begin(_radio)) return;
+        _radioTx.setDepth(RADIO_TX_FIFO_DEPTH);
+        _radioTx.setTimeout(timeoutMs * 1000UL);
+        _radioTx.onComplete(_onTxComplete, this);
+        _radioTx.resetStats();
+    } else {
+        _radioTx.end();
+    }
+    _nonBlocking = enable;
+}
+
+// Result of a queued frame (called from update() -> RadioTx::poll())
+void NRF24Controller::_onTxComplete(const RadioTxResult& result, void* context) {
+    NRF24Controller* controller = static_cast<NRF24Controller*>(context);
+    bool sent = result.status == RADIO_TX_SENT;
+    
+    controller->_updateStats(sent);
+    if (result.status != RADIO_TX_DROPPED) {
+        controller->_observeLink(sent, result.completedUs - result.queuedUs);
+    }
+    if (sent) {
+        controller->_processAckPayload();
+    } else {
+        controller->_forceKeyframe = true; // The receiver may have missed it
+    }
+}
+
 void NRF24Controller::setSendThresholds(int joystickThreshold, int leverThreshold) {
     _joystickThreshold = joystickThreshold;
     _leverThreshold = leverThreshold;
@@ -235,10 +289,36 @@ void NRF24Controller::setSendOnlyChanges(bool enable) {
     _sendOnlyChanges = enable;
 }
 
+void NRF24Controller::setFragmentation(bool enable) {
+    _fragmentation = enable;
+}
+
+// Upper bound for receiver recovery after a lost frame
+void NRF24Controller::setKeyframeInterval(unsigned long interval) {
+    _keyframeInterval = interval;
+}
+
+bool NRF24Controller::_isKeyframeDue() {
+    return _forceKeyframe || (millis() - _lastKeyframeTime >= _keyframeInterval);
+}
+
+// Acquire every joystick once; all reads below use that snapshot
+void NRF24Controller::_sampleInputs() {
+    for (uint8_t i = 0; i < MAX_JOYSTICKS; i++) {
+        if (_joysticks[i] != nullptr && _joystickEnabled[i]) {
+            _joysticks[i]->sample();
+        }
+    }
+}
+
 // Update control data
 void NRF24Controller::_updateControlData() {
     clearPacket();
     
+    // Keyframes carry every control with absolute values, deltas only what changed
+    bool keyframe = _isKeyframeDue();
+    _currentPacket.frameType = keyframe ? FRAME_KEYFRAME : FRAME_DELTA;
+    
     // Add joystick data
     for (uint8_t i = 0; i < MAX_JOYSTICKS; i++) {
         if (_joysticks[i] != nullptr && _joystickEnabled[i]) {
@@ -251,13 +331,20 @@ void NRF24Controller::_updateControlData() {
             if (_joysticks[i]->isAtEdge()) flags |= 0x04;
             
             // Check if data changed significantly
-            bool changed = !_sendOnlyChanges ||
+            bool changed = keyframe || !_sendOnlyChanges ||
                           abs(x - _lastJoystickData[i].valueX) >= _joystickThreshold ||
                           abs(y - _lastJoystickData[i].valueY) >= _joystickThreshold ||
                           flags != _lastJoystickData[i].flags;
             
-            if (changed) {
-                addToPacket(i, CONTROL_JOYSTICK, x, y, flags);
+            if (changed && _currentPacket.controlCount < PACKET_MAX_CONTROLS) {
+                if (keyframe) {
+                    addToPacket(i, CONTROL_JOYSTICK, x, y, flags);
+                } else {
+                    addToPacket(i, CONTROL_JOYSTICK,
+                                (int16_t)((uint16_t)x - (uint16_t)_lastJoystickData[i].valueX),
+                                (int16_t)((uint16_t)y - (uint16_t)_lastJoystickData[i].valueY),
+                                flags ^ _lastJoystickData[i].flags);
+                }
                 _lastJoystickData[i].valueX = x;
                 _lastJoystickData[i].valueY = y;
                 _lastJoystickData[i].flags = flags;
@@ -279,12 +366,19 @@ void NRF24Controller::_updateControlData() {
             if (_levers[i]->isMoving()) flags |= 0x10;
             
             // Check if data changed significantly
-            bool changed = !_sendOnlyChanges ||
+            bool changed = keyframe || !_sendOnlyChanges ||
                           abs(position - _lastLeverData[i].valueX) >= _leverThreshold ||
                           flags != _lastLeverData[i].flags;
             
-            if (changed) {
-                addToPacket(i + 100, _lastLeverData[i].type, position, velocity, flags);
+            if (changed && _currentPacket.controlCount < PACKET_MAX_CONTROLS) {
+                if (keyframe) {
+                    addToPacket(i + 100, _lastLeverData[i].type, position, velocity, flags);
+                } else {
+                    addToPacket(i + 100, _lastLeverData[i].type,
+                                (int16_t)((uint16_t)position - (uint16_t)_lastLeverData[i].valueX),
+                                (int16_t)((uint16_t)velocity - (uint16_t)_lastLeverData[i].valueY),
+                                flags ^ _lastLeverData[i].flags);
+                }
                 _lastLeverData[i].valueX = position;
                 _lastLeverData[i].valueY = velocity;
                 _lastLeverData[i].flags = flags;
@@ -320,20 +414,6 @@ bool NRF24Controller::_hasDataChanged() {
     return false;
 }
 
-// Calculate checksum
-uint16_t NRF24Controller::_calculateChecksum(const DataPacket& packet) {
-    uint16_t checksum = 0;
-    const uint8_t* data = (const uint8_t*)&packet;
-    
-    // Calculate checksum for all data except the checksum field itself
-    for (size_t i = 0; i < sizeof(DataPacket) - sizeof(uint16_t); i++) {
-        checksum ^= data[i];
-        checksum = (checksum << 1) | (checksum >> 15); // Rotate left
-    }
-    
-    return checksum;
-}
-
 // Update transmission statistics
 void NRF24Controller::_updateStats(bool success) {
     if (success) {
@@ -343,15 +423,26 @@ void NRF24Controller::_updateStats(bool success) {
     }
     
     _stats.lastTransmissionTime = millis();
-    
-    uint32_t totalAttempts = _stats.packetsSent + _stats.packetsLost;
-    if (totalAttempts > 0) {
-        _stats.successRate = (float)_stats.packetsSent / totalAttempts * 100.0;
+    _telemetry.onAck(success);
+}
+
+// One frame ended on air: retries, loss and RPD into the link quality window
+void NRF24Controller::_observeLink(bool acked, uint32_t rttUs) {
+    uint32_t now = millis();
+    _linkQuality.observe(*_radio, acked, now);
+    if (acked && _enableAck) {
+        _linkQuality.sampleRpd(*_radio, now);
+        _linkQuality.onRoundTrip(rttUs);
     }
 }
 
 // Main update function - call this in loop()
 void NRF24Controller::update() {
+    // Collect the frames that left the FIFO (non-blocking transmit)
+    if (_nonBlocking) {
+        _radioTx.poll(micros());
+    }
+    
     // Update levers (important for encoders)
     for (uint8_t i = 0; i < MAX_LEVERS; i++) {
         if (_levers[i] != nullptr) {
@@ -359,10 +450,28 @@ void NRF24Controller::update() {
         }
     }
     
+    // Adaptive rate: the scheduler decides; a packet without changes is a
+    // heartbeat and carries the full state (keyframe)
+    if (_autoSend && _adaptiveRate) {
+        _sampleInputs();
+        bool changed = _hasDataChanged();
+        if (_scheduler.update(changed, micros())) {
+            if (!changed) _forceKeyframe = true;
+            uint32_t bytesBefore = _stats.bytesSent;
+            _transmitControls();
+            if (_stats.bytesSent != bytesBefore) {
+                _scheduler.addBytesOnAir(_stats.bytesSent - bytesBefore + TX_SCHEDULER_FRAME_OVERHEAD);
+            }
+            _lastSendTime = millis();
+        }
+        return;
+    }
+    
     // Auto-send if enabled
     if (_autoSend && (millis() - _lastSendTime >= _sendInterval)) {
-        if (!_sendOnlyChanges || _hasDataChanged()) {
-            sendData();
+        _sampleInputs();
+        if (!_sendOnlyChanges || _hasDataChanged() || _isKeyframeDue()) {
+            _transmitControls();
         }
         _lastSendTime = millis();
     }
@@ -370,6 +479,12 @@ void NRF24Controller::update() {
 
 // Send current control data
 bool NRF24Controller::sendData() {
+    _sampleInputs();
+    return _transmitControls();
+}
+
+// Build a packet from the sampled controls and send it
+bool NRF24Controller::_transmitControls() {
     _updateControlData();
     
     if (_currentPacket.controlCount == 0) {
@@ -378,12 +493,22 @@ bool NRF24Controller::sendData() {
     
     _currentPacket.packetId = _packetCounter++;
     _currentPacket.timestamp = millis();
-    _currentPacket.checksum = _calculateChecksum(_currentPacket);
     
-    _radio->stopListening();
-    bool result = _radio->write(&_currentPacket, sizeof(DataPacket));
+    bool keyframe = (_currentPacket.frameType == FRAME_KEYFRAME);
+    bool result = _writePacket(_currentPacket);
     
-    _updateStats(result);
+    if (keyframe) {
+        _stats.keyframesSent++;
+        _lastKeyframeTime = millis();
+        _forceKeyframe = false;
+    } else {
+        _stats.deltaFramesSent++;
+    }
+    
+    // Not acknowledged: the receiver may have missed it, resync on the next packet
+    if (!result) {
+        _forceKeyframe = true;
+    }
     
     if (result) {
         Serial.print("Sent packet #");
@@ -403,26 +528,102 @@ bool NRF24Controller::sendCustomData(const ControlData& data) {
     _currentPacket.controlCount = 1;
     _currentPacket.packetId = _packetCounter++;
     _currentPacket.timestamp = millis();
-    _currentPacket.checksum = _calculateChecksum(_currentPacket);
     
-    _radio->stopListening();
-    bool result = _radio->write(&_currentPacket, sizeof(DataPacket));
-    _updateStats(result);
-    
-    return result;
+    return _writePacket(_currentPacket);
 }
 
 // Send custom packet
 bool NRF24Controller::sendCustomPacket(const DataPacket& packet) {
-    _radio->stopListening();
-    bool result = _radio->write(&packet, sizeof(DataPacket));
-    _updateStats(result);
+    return _writePacket(packet);
+}
+
+// Encode a packet and put its frame(s) on air
+bool NRF24Controller::_writePacket(const DataPacket& packet) {
+    uint8_t frame[PACKET_FRAME_MAX];
+    uint8_t first = 0;
+    uint8_t fragment = 0;
+    bool result = true;
+    
+    // Already in TX mode while frames are queued (stopListening() would flush them)
+    if (!_nonBlocking || _radioTx.isIdle()) {
+        _radio->stopListening();
+    }
+    // Telemetry echoes the packet id: round trip from here
+    _telemetry.markSent(packet.packetId, micros());
+    do {
+        uint8_t next;
+        uint8_t length = PacketCodec::encode(packet, frame, first, fragment, next);
+        if (length == 0) {
+            Serial.println("NRF24Controller: Packet encoding failed");
+            _updateStats(false);
+            return false;
+        }
+        
+        // Without fragmentation only the first frame is sent
+        if (next < packet.controlCount && !_fragmentation) {
+            frame[0] &= ~0x01; // Clear "more fragments"
+            frame[length - PACKET_CRC_SIZE] = PacketCodec::crc8(frame, length - PACKET_CRC_SIZE);
+            _stats.truncatedPackets++;
+            _forceKeyframe = true; // Dropped controls would break the delta chain
+            next = packet.controlCount;
+        }
+        
+        bool sent;
+        if (_nonBlocking) {
+            // Queued only: the ACK (or its absence) is handled by _onTxComplete()
+            sent = _radioTx.submit(frame, length, micros());
+            if (!sent) _updateStats(false);
+        } else {
+            uint32_t start = micros();
+            sent = _radio->write(frame, length);
+            _observeLink(sent, micros() - start);
+            if (sent) {
+                _processAckPayload();
+            }
+        }
+        result = sent && result;
+        _stats.bytesSent += length;
+        
+        first = next;
+        fragment++;
+    } while (first < packet.controlCount);
+    
+    if (fragment > 1) {
+        _stats.fragmentedPackets++;
+    }
+    if (!_nonBlocking) {
+        _updateStats(result);
+    }
     
     return result;
 }
 
+// Messages the receiver piggybacks on ACKs
+void NRF24Controller::_processAckPayload() {
+    while (_radio->isAckPayloadAvailable()) {
+        uint8_t payload[PACKET_FRAME_MAX];
+        uint8_t length = _radio->getDynamicPayloadSize();
+        if (length == 0 || length > PACKET_FRAME_MAX) {
+            _radio->flush_rx();
+            return;
+        }
+        _radio->read(payload, length);
+        
+        if (payload[0] == PACKET_ACK_KEYFRAME_REQUEST) {
+            _forceKeyframe = true;
+            _stats.keyframeRequests++;
+        } else if (payload[0] == TELEMETRY_FRAME_ID) {
+            _telemetry.parse(payload, length, micros());
+        }
+    }
+}
+
 // Check if data is available
 bool NRF24Controller::available() {
+    // Switching to RX would abort the frames still in the TX FIFO
+    if (!isTxIdle()) {
+        return false;
+    }
     _radio->startListening();
     return _radio->available();
 }
@@ -433,29 +634,52 @@ bool NRF24Controller::readData(DataPacket& packet) {
         return false;
     }
     
-    _radio->read(&packet, sizeof(DataPacket));
-    bool result = true;
+    uint8_t frame[PACKET_FRAME_MAX];
+    uint8_t length = _radio->getDynamicPayloadSize();
+    if (length == 0 || length > PACKET_FRAME_MAX) {
+        _radio->flush_rx(); // Corrupt length, drop the FIFO
+        return false;
+    }
+    _radio->read(frame, length);
     
-    if (result) {
-        // Verify checksum
-        uint16_t calculatedChecksum = _calculateChecksum(packet);
-        if (calculatedChecksum == packet.checksum) {
-            _stats.packetsReceived++;
-            return true;
-        } else {
-            Serial.println("Checksum mismatch - packet corrupted");
-            return false;
-        }
+    // Decode (CRC and version are checked by the codec)
+    bool complete = false;
+    if (!PacketCodec::decode(frame, length, _rxPacket, complete, _rxNextFragment)) {
+        Serial.println("Invalid frame - packet corrupted or unknown version");
+        return false;
+    }
+    if (!complete) {
+        return false; // Waiting for the remaining fragments
     }
     
-    return false;
+    _stats.packetsReceived++;
+    bool updated = _rxTracker.apply(_rxPacket, millis());
+    
+    // Out of sync: ask for a keyframe in the next ACK
+    if (_rxTracker.takeKeyframeRequest()) {
+        uint8_t request = PACKET_ACK_KEYFRAME_REQUEST;
+        _radio->writeAckPayload(1, &request, 1);
+    }
+    
+    if (!updated) {
+        return false; // Delta without a valid base state
+    }
+    
+    // The caller always gets the full state, whatever the frame type was
+    packet = _rxTracker.getState();
+    return true;
 }
 
 // Read specific control data from last received packet
 bool NRF24Controller::readControlData(uint8_t controlId, ControlData& data) {
-    // This would require storing the last received packet
-    // Implementation depends on your specific needs
-    return false; // Placeholder
+    const DataPacket& state = _rxTracker.getState();
+    for (uint8_t i = 0; i < state.controlCount; i++) {
+        if (state.controls[i].id == controlId) {
+            data = state.controls[i];
+            return true;
+        }
+    }
+    return false;
 }
 
 // Packet management
@@ -490,15 +714,20 @@ bool NRF24Controller::isConnected() {
 }
 
 TransmissionStats NRF24Controller::getStats() {
-    return _stats;
+    TransmissionStats stats = _stats;
+    uint32_t totalAttempts = stats.packetsSent + stats.packetsLost;
+    stats.successRate = totalAttempts > 0 ? (float)stats.packetsSent / totalAttempts * 100.0 : 0.0;
+    return stats;
 }
 
 void NRF24Controller::resetStats() {
     memset(&_stats, 0, sizeof(_stats));
+    _telemetry.resetStats();
+    _linkQuality.reset();
 }
 
 float NRF24Controller::getSignalQuality() {
-    return _stats.successRate;
+    return getStats().successRate;
 }
 
 void NRF24Controller::printStatus() {
@@ -510,10 +739,38 @@ void NRF24Controller::printStatus() {
     Serial.print("Joysticks: "); Serial.println(_joystickCount);
     Serial.print("Levers: "); Serial.println(_leverCount);
     Serial.print("Auto Send: "); Serial.println(_autoSend ? "Enabled" : "Disabled");
-    Serial.print("Send Interval: "); Serial.print(_sendInterval); Serial.println("ms");
+    Serial.print("Send Interval: "); Serial.print(getSendInterval()); Serial.print("ms");
+    Serial.println(_adaptiveRate ? " (adaptive)" : "");
     Serial.print("Packets Sent: "); Serial.println(_stats.packetsSent);
     Serial.print("Packets Lost: "); Serial.println(_stats.packetsLost);
-    Serial.print("Success Rate: "); Serial.print(_stats.successRate, 1); Serial.println("%");
+    Serial.print("Success Rate: "); Serial.print(getSignalQuality(), 1); Serial.println("%");
+    Serial.print("Bytes Sent: "); Serial.println(_stats.bytesSent);
+    Serial.print("Fragmented/Truncated: "); Serial.print(_stats.fragmentedPackets);
+    Serial.print("/"); Serial.println(_stats.truncatedPackets);
+    Serial.print("Keyframes/Deltas: "); Serial.print(_stats.keyframesSent);
+    Serial.print("/"); Serial.print(_stats.deltaFramesSent);
+    Serial.print("  Keyframe requests: "); Serial.println(_stats.keyframeRequests);
+    
+    if (_adaptiveRate) {
+        _scheduler.printStats();
+    }
+    if (_nonBlocking) {
+        _radioTx.printStats();
+    }
+    // Same task that sends and parses the ACKs: the state can be read directly
+    TelemetryState telemetry = _telemetry.getState();
+    if (telemetry.valid) {
+        _telemetry.printStats(telemetry);
+    }
+    _linkQuality.printReport(millis());
+    
+    PacketStreamStats stream = _rxTracker.getStats();
+    if (stream.keyframes > 0 || stream.gaps > 0) {
+        Serial.print("RX synced: "); Serial.print(_rxTracker.isSynced() ? "yes" : "no");
+        Serial.print("  Gaps: "); Serial.print(stream.gaps);
+        Serial.print("  Dropped deltas: "); Serial.print(stream.droppedDeltas);
+        Serial.print("  Max recovery: "); Serial.print(stream.maxRecoveryMs); Serial.println(" ms");
+    }
 }
 
 void NRF24Controller::printPacket(const DataPacket& packet) {
@@ -899,6 +1156,7 @@ void NRF24Controller::_executeActiveProfile() {
     }
     
     // Update channel values based on current profile
+    _sampleInputs();
     _updateChannelValues();
     
     // Create and send packet with channel data
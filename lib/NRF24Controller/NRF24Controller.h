@@ -4,7 +4,15 @@
  * Features:
  * - Easy integration with Joystick and Lever libraries
  * - Flexible data packet system
+ * - Compact bit-packed wire format (PacketCodec), always <= 32 bytes per frame
+ * - Keyframe + delta protocol with sequence numbers and keyframe requests
  * - Configurable transmission parameters
+ * - Adaptive transmit rate (TxScheduler): fast while controls move,
+ *   heartbeat when idle, never below a failsafe rate
+ * - Optional non-blocking transmit (RadioTx): frames go to the TX FIFO and
+ *   their ACK/failure is handled by update(), retries never stall the caller
+ * - Receiver telemetry (TelemetryLink) parsed from ACK payloads, with the
+ *   round trip measured on the packet id the receiver echoes
  * - Multiple joystick and lever support
  * - Automatic packet management
  * - Power level configuration
@@ -24,6 +32,11 @@
 #include <Joystick.h>
 #include <Lever.h>
 #include <EEPROM.h>
+#include <TxScheduler.h>
+#include <RadioTx.h>
+#include <TelemetryLink.h>
+#include <LinkQuality.h>
+#include "PacketCodec.h"
 
 // Maximum number of controls supported
 #define MAX_JOYSTICKS 4
@@ -45,42 +58,19 @@ enum DataRate {
     RATE_2MBPS = RF24_2MBPS
 };
 
-// Control types for packet identification
-enum ControlType {
-    CONTROL_JOYSTICK,
-    CONTROL_LEVER_ANALOG,
-    CONTROL_LEVER_ENCODER,
-    CONTROL_LEVER_DIGITAL,
-    CONTROL_BUTTON,
-    CONTROL_CUSTOM
-};
-
-// Individual control data structure
-struct ControlData {
-    uint8_t id;           // Control identifier (0-255)
-    ControlType type;     // Type of control
-    int16_t valueX;       // Primary value (or X axis for joystick)
-    int16_t valueY;       // Secondary value (or Y axis for joystick)
-    uint8_t flags;        // Status flags (button states, etc.)
-    uint32_t timestamp;   // Timestamp for this data
-};
-
-// Main data packet structure
-struct DataPacket {
-    uint8_t packetId;           // Packet identifier
-    uint8_t controlCount;       // Number of controls in this packet
-    ControlData controls[8];    // Control data array (max 8 per packet)
-    uint16_t checksum;          // Simple checksum for data integrity
-    uint32_t timestamp;         // Packet timestamp
-};
-
 // Transmission statistics
 struct TransmissionStats {
     uint32_t packetsSent;
     uint32_t packetsReceived;
     uint32_t packetsLost;
     uint32_t lastTransmissionTime;
-    float successRate;
+    float successRate;          // Since reset, computed by getStats()
+    uint32_t bytesSent;         // Encoded bytes put on air
+    uint32_t fragmentedPackets; // Packets that needed more than one frame
+    uint32_t truncatedPackets;  // Packets cut to one frame (fragmentation disabled)
+    uint32_t keyframesSent;     // Full-state frames
+    uint32_t deltaFramesSent;   // Change-only frames
+    uint32_t keyframeRequests;  // Requests received from the receiver (ACK payload)
 };
 
 // Control mapping configuration
@@ -190,8 +180,20 @@ private:
     bool _autoSend;
     unsigned long _sendInterval;
     unsigned long _lastSendTime;
+    bool _adaptiveRate;                 // TxScheduler instead of _sendInterval
+    TxScheduler _scheduler;
+    bool _nonBlocking;                  // Frames through RadioTx, results in update()
+    RadioTx _radioTx;
+    TelemetryLink _telemetry;           // Receiver telemetry from ACK payloads
+    LinkQuality _linkQuality;           // Sliding-window loss, retries, RPD, RTT
+    
+    // Keyframe/delta protocol
+    unsigned long _keyframeInterval;    // Max time between keyframes (ms)
+    unsigned long _lastKeyframeTime;
+    bool _forceKeyframe;                // Next packet must be a keyframe
     
     // Transmission control
+    bool _fragmentation;        // Allow splitting packets that do not fit one frame
     bool _enableAck;
     uint8_t _retryCount;
     uint8_t _retryDelay;
@@ -199,6 +201,11 @@ private:
     // Statistics
     TransmissionStats _stats;
     
+    // Reception (fragment reassembly and full received state)
+    DataPacket _rxPacket;
+    uint8_t _rxNextFragment;    // Fragment index expected next (0 = none pending)
+    PacketStateTracker _rxTracker;
+    
     // Control selection (which controls to include in packets)
     bool _joystickEnabled[MAX_JOYSTICKS];
     bool _leverEnabled[MAX_LEVERS];
@@ -224,10 +231,16 @@ private:
     
     // Internal helper methods
     void _initializeRadio();
+    void _sampleInputs();
+    bool _transmitControls();
+    bool _writePacket(const DataPacket& packet);
+    void _processAckPayload();
+    bool _isKeyframeDue();
     void _updateControlData();
     bool _hasDataChanged();
-    uint16_t _calculateChecksum(const DataPacket& packet);
     void _updateStats(bool success);
+    void _observeLink(bool acked, uint32_t rttUs);
+    static void _onTxComplete(const RadioTxResult& result, void* context);
     
     // Profile helper methods
     void _initializeProfiles();
@@ -259,8 +272,18 @@ public:
     
     // Transmission settings
     void setAutoSend(bool enable, unsigned long interval = 50);
+    // Auto-send at activeMs while controls change (and for a hold time after),
+    // backing off to heartbeatMs when idle; heartbeatMs is capped at failsafeMs
+    void setAdaptiveRate(bool enable, unsigned long activeMs = 5, unsigned long heartbeatMs = 100,
+                         unsigned long failsafeMs = 250);
+    // Non-blocking transmit: sendData() only queues the frames; update() collects
+    // ACKs/failures (success stats then count frames instead of packets)
+    void setNonBlocking(bool enable, unsigned long timeoutMs = 100);
     void setSendThresholds(int joystickThreshold = 5, int leverThreshold = 5);
     void setSendOnlyChanges(bool enable = true);
+    void setFragmentation(bool enable = true);
+    void setKeyframeInterval(unsigned long interval = 250);
+    void requestKeyframe() { _forceKeyframe = true; }
     
     // Data transmission methods
     bool sendData();
@@ -281,8 +304,15 @@ public:
     // Status and diagnostics
     bool isConnected();
     TransmissionStats getStats();
+    PacketStreamStats getStreamStats() { return _rxTracker.getStats(); }
+    TxSchedulerStats getRateStats() { return _scheduler.getStats(); }
+    RadioTxStats getTxStats() { return _radioTx.getStats(); }
+    TelemetryState getTelemetry() { return _telemetry.getState(); }
+    TelemetryStats getTelemetryStats() { return _telemetry.getStats(); }
+    LinkQualityReport getLinkQuality() { return _linkQuality.getReport(millis()); }
+    bool isStreamSynced() { return _rxTracker.isSynced(); }
     void resetStats();
-    float getSignalQuality(); // Based on success rate
+    float getSignalQuality(); // Based on success rate since reset (see getLinkQuality())
     void printStatus();
     void printPacket(const DataPacket& packet);
     
@@ -352,7 +382,10 @@ public:
     uint8_t getJoystickCount() { return _joystickCount; }
     uint8_t getLeverCount() { return _leverCount; }
     bool getAutoSend() { return _autoSend; }
-    unsigned long getSendInterval() { return _sendInterval; }
+    unsigned long getSendInterval() { return _adaptiveRate ? _scheduler.getIntervalUs() / 1000 : _sendInterval; }
+    bool getAdaptiveRate() { return _adaptiveRate; }
+    bool getNonBlocking() { return _nonBlocking; }
+    bool isTxIdle() { return !_nonBlocking || _radioTx.isIdle(); }
     uint8_t getProfileCount() { return _profileCount; }
     
     // ========== CONFIGURATION AND EEPROM MANAGEMENT ==========
@@ -0,0 +1,396 @@
+/**
+ * PacketCodec Implementation
+ *
+ * Date: 2025
+ */
+
+#include "PacketCodec.h"
+#include "NRF24Controller.h"
+
+// Bits available for controls in one frame (after header, count, frame type and CRC)
+#define PACKET_PAYLOAD_BITS ((PACKET_FRAME_MAX - PACKET_HEADER_SIZE - PACKET_CRC_SIZE) * 8 - 6)
+
+// BitWriter
+BitWriter::BitWriter(uint8_t* buffer, uint16_t capacityBytes) {
+    _buffer = buffer;
+    _capacityBits = capacityBytes * 8;
+    _bitPos = 0;
+    memset(_buffer, 0, capacityBytes);
+}
+
+bool BitWriter::write(uint32_t value, uint8_t bits) {
+    if (_bitPos + bits > _capacityBits) {
+        return false;
+    }
+    for (uint8_t i = 0; i < bits; i++) {
+        if (value & (1UL << i)) {
+            _buffer[_bitPos >> 3] |= (1 << (_bitPos & 7));
+        }
+        _bitPos++;
+    }
+    return true;
+}
+
+// BitReader
+BitReader::BitReader(const uint8_t* buffer, uint16_t lengthBytes) {
+    _buffer = buffer;
+    _lengthBits = lengthBytes * 8;
+    _bitPos = 0;
+    _overrun = false;
+}
+
+uint32_t BitReader::read(uint8_t bits) {
+    if (_bitPos + bits > _lengthBits) {
+        _overrun = true;
+        return 0;
+    }
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < bits; i++) {
+        if (_buffer[_bitPos >> 3] & (1 << (_bitPos & 7))) {
+            value |= (1UL << i);
+        }
+        _bitPos++;
+    }
+    return value;
+}
+
+int32_t BitReader::readSigned(uint8_t bits) {
+    uint32_t value = read(bits);
+    // Sign-extend
+    if (value & (1UL << (bits - 1))) {
+        value |= ~((1UL << bits) - 1);
+    }
+    return (int32_t)value;
+}
+
+// Helpers
+static const uint8_t VALUE_CLASS_BITS[4] = {0, 7, 11, 16};
+
+// Smallest width class that holds the value (class 0 = value is zero)
+static uint8_t valueClass(int16_t value) {
+    if (value == 0) return 0;
+    if (value >= -64 && value < 64) return 1;
+    if (value >= -1024 && value < 1024) return 2;
+    return 3;
+}
+
+static uint16_t controlBits(const ControlData& control, uint8_t prevId, uint8_t frameType) {
+    uint16_t bits = (control.id == (uint8_t)(prevId + 1)) ? 1 : 9;
+    if (frameType != FRAME_DELTA) bits += 3;                  // type
+    bits += 2 + VALUE_CLASS_BITS[valueClass(control.valueX)];
+    bits += 2 + VALUE_CLASS_BITS[valueClass(control.valueY)];
+    bits += 1 + (control.flags != 0 ? 8 : 0);                 // hasFlags, flags
+    return bits;
+}
+
+static void writeValue(BitWriter& writer, int16_t value) {
+    uint8_t cls = valueClass(value);
+    writer.write(cls, 2);
+    if (cls != 0) {
+        uint8_t bits = VALUE_CLASS_BITS[cls];
+        writer.write((uint16_t)value & ((1UL << bits) - 1), bits);
+    }
+}
+
+static int16_t readValue(BitReader& reader) {
+    uint8_t cls = reader.read(2);
+    return (cls == 0) ? 0 : (int16_t)reader.readSigned(VALUE_CLASS_BITS[cls]);
+}
+
+// Encoding
+uint8_t PacketCodec::encode(const DataPacket& packet, uint8_t* frame,
+                            uint8_t first, uint8_t fragmentIndex, uint8_t& next) {
+    next = first;
+    if (packet.controlCount > PACKET_MAX_CONTROLS || first > packet.controlCount ||
+        fragmentIndex >= PACKET_MAX_FRAGMENTS || packet.frameType > FRAME_DELTA) {
+        return 0;
+    }
+
+    // Sizing pass: how many controls fit in this frame
+    uint16_t usedBits = 0;
+    uint8_t prevId = 0xFF;
+    uint8_t last = first;
+    while (last < packet.controlCount) {
+        uint16_t bits = controlBits(packet.controls[last], prevId, packet.frameType);
+        if (usedBits + bits > PACKET_PAYLOAD_BITS) break;
+        usedBits += bits;
+        prevId = packet.controls[last].id;
+        last++;
+    }
+    if (last == first && first < packet.controlCount) {
+        return 0; // Cannot happen with the current field sizes, kept as a guard
+    }
+
+    bool more = last < packet.controlCount;
+    uint16_t timestamp = (uint16_t)packet.timestamp;
+
+    frame[0] = (PACKET_WIRE_VERSION << 4) | (fragmentIndex << 1) | (more ? 1 : 0);
+    frame[1] = packet.packetId;
+    frame[2] = timestamp & 0xFF;
+    frame[3] = timestamp >> 8;
+
+    BitWriter writer(frame + PACKET_HEADER_SIZE, PACKET_FRAME_MAX - PACKET_HEADER_SIZE - PACKET_CRC_SIZE);
+    writer.write(last - first, 4);
+    writer.write(packet.frameType, 2);
+
+    prevId = 0xFF;
+    for (uint8_t i = first; i < last; i++) {
+        const ControlData& control = packet.controls[i];
+
+        if (control.id == (uint8_t)(prevId + 1)) {
+            writer.write(1, 1);
+        } else {
+            writer.write(0, 1);
+            writer.write(control.id, 8);
+        }
+        if (packet.frameType != FRAME_DELTA) {
+            writer.write((uint8_t)control.type, 3);
+        }
+        writeValue(writer, control.valueX);
+        writeValue(writer, control.valueY);
+
+        writer.write(control.flags != 0 ? 1 : 0, 1);
+        if (control.flags != 0) {
+            writer.write(control.flags, 8);
+        }
+
+        prevId = control.id;
+    }
+
+    uint8_t length = PACKET_HEADER_SIZE + writer.getByteLength();
+    frame[length] = crc8(frame, length);
+    length += PACKET_CRC_SIZE;
+
+    next = last;
+    return length;
+}
+
+uint8_t PacketCodec::encode(const DataPacket& packet, uint8_t* frame) {
+    uint8_t next;
+    uint8_t length = encode(packet, frame, 0, 0, next);
+    if (next != packet.controlCount) {
+        return 0; // Needs fragmentation
+    }
+    return length;
+}
+
+// Decoding
+bool PacketCodec::decode(const uint8_t* frame, uint8_t length, DataPacket& packet, bool& complete,
+                         uint8_t& nextFragment) {
+    complete = false;
+    if (length < PACKET_HEADER_SIZE + PACKET_CRC_SIZE || length > PACKET_FRAME_MAX) {
+        return false;
+    }
+    if ((frame[0] >> 4) != PACKET_WIRE_VERSION) {
+        return false;
+    }
+    if (crc8(frame, length - PACKET_CRC_SIZE) != frame[length - PACKET_CRC_SIZE]) {
+        return false;
+    }
+
+    uint8_t fragmentIndex = (frame[0] >> 1) & 0x07;
+    bool more = frame[0] & 0x01;
+    uint8_t packetId = frame[1];
+    uint16_t timestamp = frame[2] | (frame[3] << 8);
+
+    BitReader reader(frame + PACKET_HEADER_SIZE, length - PACKET_HEADER_SIZE - PACKET_CRC_SIZE);
+    uint8_t count = reader.read(4);
+    uint8_t frameType = reader.read(2);
+    if (frameType > FRAME_DELTA) {
+        return false;
+    }
+
+    if (fragmentIndex == 0) {
+        memset(&packet, 0, sizeof(DataPacket));
+        packet.packetId = packetId;
+        packet.timestamp = timestamp;
+        packet.frameType = frameType;
+    } else if (nextFragment != fragmentIndex || packet.packetId != packetId ||
+               packet.timestamp != timestamp || packet.frameType != frameType) {
+        return false; // Duplicate, out of order or of a packet we did not start
+    }
+    if (packet.controlCount + count > PACKET_MAX_CONTROLS) {
+        return false;
+    }
+
+    uint8_t prevId = 0xFF;
+    for (uint8_t i = 0; i < count; i++) {
+        ControlData& control = packet.controls[packet.controlCount + i];
+
+        control.id = reader.read(1) ? (uint8_t)(prevId + 1) : reader.read(8);
+        control.type = (frameType != FRAME_DELTA) ? (ControlType)reader.read(3) : CONTROL_CUSTOM;
+        control.valueX = readValue(reader);
+        control.valueY = readValue(reader);
+        control.flags = reader.read(1) ? reader.read(8) : 0;
+        control.timestamp = timestamp;
+
+        prevId = control.id;
+    }
+    if (reader.hasOverrun()) {
+        return false;
+    }
+
+    packet.controlCount += count;
+    packet.checksum = frame[length - PACKET_CRC_SIZE];
+    nextFragment = more ? fragmentIndex + 1 : 0;
+    complete = !more;
+    return true;
+}
+
+// Size queries
+uint16_t PacketCodec::encodedSize(const DataPacket& packet) {
+    uint8_t frame[PACKET_FRAME_MAX];
+    uint16_t total = 0;
+    uint8_t first = 0;
+    uint8_t fragment = 0;
+    do {
+        uint8_t next;
+        uint8_t length = encode(packet, frame, first, fragment++, next);
+        if (length == 0) return 0;
+        total += length;
+        first = next;
+    } while (first < packet.controlCount);
+    return total;
+}
+
+uint8_t PacketCodec::fragmentCount(const DataPacket& packet) {
+    uint8_t frame[PACKET_FRAME_MAX];
+    uint8_t first = 0;
+    uint8_t fragments = 0;
+    do {
+        uint8_t next;
+        if (encode(packet, frame, first, fragments, next) == 0) return 0;
+        fragments++;
+        first = next;
+    } while (first < packet.controlCount);
+    return fragments;
+}
+
+// CRC-8, polynomial 0x07
+uint8_t PacketCodec::crc8(const uint8_t* data, uint8_t length) {
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+// PacketStateTracker
+PacketStateTracker::PacketStateTracker() {
+    reset();
+    resetStats();
+}
+
+void PacketStateTracker::reset() {
+    memset(&_state, 0, sizeof(_state));
+    _state.frameType = FRAME_KEYFRAME;
+    _synced = false;
+    _hasSequence = false;
+    _lastSequence = 0;
+    _keyframeRequested = false;
+    _recovering = false;
+    _gapTime = 0;
+}
+
+void PacketStateTracker::resetStats() {
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+void PacketStateTracker::_markGap(unsigned long nowMs) {
+    _synced = false;
+    if (!_recovering) {
+        _recovering = true;
+        _gapTime = nowMs;
+        _keyframeRequested = true;
+    }
+}
+
+void PacketStateTracker::_applyControl(const ControlData& control, uint8_t frameType) {
+    ControlData* target = nullptr;
+    for (uint8_t i = 0; i < _state.controlCount; i++) {
+        if (_state.controls[i].id == control.id) {
+            target = &_state.controls[i];
+            break;
+        }
+    }
+
+    if (frameType == FRAME_DELTA) {
+        if (target == nullptr) return; // Unknown control, wait for the next keyframe
+        // Differences are taken modulo 2^16 on both sides, so wrap-around is exact
+        target->valueX = (int16_t)((uint16_t)target->valueX + (uint16_t)control.valueX);
+        target->valueY = (int16_t)((uint16_t)target->valueY + (uint16_t)control.valueY);
+        target->flags ^= control.flags;
+        target->timestamp = control.timestamp;
+        return;
+    }
+
+    if (target == nullptr) {
+        if (_state.controlCount >= PACKET_MAX_CONTROLS) return;
+        target = &_state.controls[_state.controlCount++];
+    }
+    *target = control;
+}
+
+bool PacketStateTracker::apply(const DataPacket& packet, unsigned long nowMs) {
+    // Sequence check: every complete packet advances the id by one
+    if (_hasSequence && packet.packetId != (uint8_t)(_lastSequence + 1)) {
+        _stats.gaps++;
+        _markGap(nowMs);
+    }
+    _hasSequence = true;
+    _lastSequence = packet.packetId;
+
+    switch (packet.frameType) {
+        case FRAME_KEYFRAME:
+            _state.controlCount = 0;
+            for (uint8_t i = 0; i < packet.controlCount; i++) {
+                _applyControl(packet.controls[i], FRAME_KEYFRAME);
+            }
+            if (_recovering) {
+                _stats.recoveries++;
+                _stats.lastRecoveryMs = nowMs - _gapTime;
+                if (_stats.lastRecoveryMs > _stats.maxRecoveryMs) {
+                    _stats.maxRecoveryMs = _stats.lastRecoveryMs;
+                }
+            }
+            _synced = true;
+            _recovering = false;
+            _keyframeRequested = false;
+            _stats.keyframes++;
+            break;
+
+        case FRAME_DELTA:
+            if (!_synced) {
+                // Joined mid-stream or lost a frame: deltas are useless until a keyframe
+                _markGap(nowMs);
+                _stats.droppedDeltas++;
+                return false;
+            }
+            for (uint8_t i = 0; i < packet.controlCount; i++) {
+                _applyControl(packet.controls[i], FRAME_DELTA);
+            }
+            _stats.deltas++;
+            break;
+
+        default: // FRAME_ABSOLUTE
+            for (uint8_t i = 0; i < packet.controlCount; i++) {
+                _applyControl(packet.controls[i], FRAME_ABSOLUTE);
+            }
+            break;
+    }
+
+    _state.packetId = packet.packetId;
+    _state.timestamp = packet.timestamp;
+    return true;
+}
+
+bool PacketStateTracker::takeKeyframeRequest() {
+    if (_keyframeRequested) {
+        _keyframeRequested = false;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,188 @@
+/**
+ * PacketCodec - Compact bit-packed wire format for DataPacket
+ *
+ * The in-memory DataPacket (8 x ControlData with enums, int16 values and a
+ * 32-bit timestamp per control) is far larger than the 32-byte nRF24 payload.
+ * PacketCodec serializes it into a versioned bit stream that always fits in
+ * one radio frame, splitting into fragments only when the controls really
+ * do not fit.
+ *
+ * Frame layout (version 2):
+ *   byte 0    version (4 bits) | fragment index (3 bits) | more fragments (1 bit)
+ *   byte 1    packet id, doubles as the sequence number
+ *   byte 2-3  packet timestamp, low 16 bits of millis(), little endian
+ *   bits      control count (4 bits), frame type (2 bits), then per control:
+ *               id       1 bit "previous id + 1", otherwise 0 + 8-bit id
+ *               type     3 bits (not present in delta frames)
+ *               valueX   2-bit width class (zero / 7 / 11 / 16 bits) + value
+ *               valueY   same encoding as valueX
+ *               hasFlags 1 bit, then flags (8 bits) if set
+ *   last byte CRC-8 (poly 0x07) over every previous byte
+ *
+ * Frame types:
+ *   absolute  values replace the receiver's copy of those controls
+ *   keyframe  absolute values for every control, resynchronizes the receiver
+ *   delta     values are differences (mod 2^16) against the previous frame,
+ *             flags are XOR-ed with the previous flags (0 = unchanged)
+ *
+ * Per-control timestamps are not transmitted; the decoder copies the packet
+ * timestamp into every control.
+ *
+ * PacketStateTracker is the receiving side of the keyframe/delta protocol:
+ * it applies frames to a full state copy, detects sequence gaps, drops
+ * deltas until the next keyframe and measures how long recovery took.
+ *
+ * Date: 2025
+ */
+
+#ifndef PACKET_CODEC_H
+#define PACKET_CODEC_H
+
+#include <Arduino.h>
+
+#define PACKET_WIRE_VERSION 2
+#define PACKET_FRAME_MAX 32            // nRF24 payload limit
+#define PACKET_HEADER_SIZE 4
+#define PACKET_CRC_SIZE 1
+#define PACKET_MAX_FRAGMENTS 8
+#define PACKET_MAX_CONTROLS 8
+
+// ACK payload sent by a receiver that lost sync
+#define PACKET_ACK_KEYFRAME_REQUEST 0x4B
+
+enum PacketFrameType {
+    FRAME_ABSOLUTE = 0,
+    FRAME_KEYFRAME = 1,
+    FRAME_DELTA = 2
+};
+
+// Control types for packet identification
+enum ControlType {
+    CONTROL_JOYSTICK,
+    CONTROL_LEVER_ANALOG,
+    CONTROL_LEVER_ENCODER,
+    CONTROL_LEVER_DIGITAL,
+    CONTROL_BUTTON,
+    CONTROL_CUSTOM
+};
+
+// Individual control data structure
+struct ControlData {
+    uint8_t id;           // Control identifier (0-255)
+    ControlType type;     // Type of control
+    int16_t valueX;       // Primary value (or X axis for joystick)
+    int16_t valueY;       // Secondary value (or Y axis for joystick)
+    uint8_t flags;        // Status flags (button states, etc.)
+    uint32_t timestamp;   // Timestamp for this data
+};
+
+// Main data packet structure
+struct DataPacket {
+    uint8_t packetId;           // Packet identifier
+    uint8_t controlCount;       // Number of controls in this packet
+    ControlData controls[8];    // Control data array (max 8 per packet)
+    uint16_t checksum;          // Simple checksum for data integrity
+    uint32_t timestamp;         // Packet timestamp
+    uint8_t frameType;          // PacketFrameType (0 = absolute values)
+};
+
+// Sequential bit writer over a byte buffer (LSB first)
+class BitWriter {
+private:
+    uint8_t* _buffer;
+    uint16_t _capacityBits;
+    uint16_t _bitPos;
+
+public:
+    BitWriter(uint8_t* buffer, uint16_t capacityBytes);
+
+    bool write(uint32_t value, uint8_t bits);
+    uint16_t getBitPosition() { return _bitPos; }
+    uint16_t getByteLength() { return (_bitPos + 7) / 8; }
+};
+
+// Sequential bit reader, mirrors BitWriter
+class BitReader {
+private:
+    const uint8_t* _buffer;
+    uint16_t _lengthBits;
+    uint16_t _bitPos;
+    bool _overrun;
+
+public:
+    BitReader(const uint8_t* buffer, uint16_t lengthBytes);
+
+    uint32_t read(uint8_t bits);
+    int32_t readSigned(uint8_t bits);
+    bool hasOverrun() { return _overrun; }
+};
+
+class PacketCodec {
+public:
+    // Encode packet.controls[first..] into a single frame (<= PACKET_FRAME_MAX bytes).
+    // Returns the frame length, 0 on error. 'next' receives the index of the first
+    // control that did not fit (== controlCount when the packet is complete).
+    static uint8_t encode(const DataPacket& packet, uint8_t* frame,
+                          uint8_t first, uint8_t fragmentIndex, uint8_t& next);
+
+    // Encode the whole packet in one frame. Returns 0 if it does not fit.
+    static uint8_t encode(const DataPacket& packet, uint8_t* frame);
+
+    // Decode a frame. Fragment 0 resets the packet, later fragments of the same
+    // packet id are appended only in order: 'nextFragment' is the reassembly state
+    // (fragment index expected next, 0 = none pending) and a duplicated or skipped
+    // fragment is rejected, so the packet never completes with controls missing or
+    // repeated. 'complete' is true after the last fragment.
+    static bool decode(const uint8_t* frame, uint8_t length, DataPacket& packet, bool& complete,
+                       uint8_t& nextFragment);
+
+    // Size of the frame(s) needed for the whole packet
+    static uint16_t encodedSize(const DataPacket& packet);
+    static uint8_t fragmentCount(const DataPacket& packet);
+
+    static uint8_t crc8(const uint8_t* data, uint8_t length);
+};
+
+// Receiver side of the keyframe/delta protocol
+struct PacketStreamStats {
+    uint32_t keyframes;         // Keyframes applied
+    uint32_t deltas;            // Delta frames applied
+    uint32_t gaps;              // Sequence gaps detected
+    uint32_t droppedDeltas;     // Deltas ignored while out of sync
+    uint32_t recoveries;        // Gaps closed by a keyframe
+    uint32_t lastRecoveryMs;    // Gap detection to resync, last time
+    uint32_t maxRecoveryMs;     // Worst case observed
+};
+
+class PacketStateTracker {
+private:
+    DataPacket _state;          // Full state of every control seen
+    bool _synced;
+    bool _hasSequence;
+    uint8_t _lastSequence;
+    bool _keyframeRequested;
+    bool _recovering;           // Between losing sync and the next keyframe
+    unsigned long _gapTime;
+    PacketStreamStats _stats;
+
+    void _applyControl(const ControlData& control, uint8_t frameType);
+    void _markGap(unsigned long nowMs);
+
+public:
+    PacketStateTracker();
+
+    // Apply a complete decoded packet. Returns true if the state changed.
+    bool apply(const DataPacket& packet, unsigned long nowMs);
+    void reset();
+
+    const DataPacket& getState() { return _state; }
+    bool isSynced() { return _synced; }
+
+    // True once per gap: the caller should ask the transmitter for a keyframe
+    bool takeKeyframeRequest();
+
+    PacketStreamStats getStats() { return _stats; }
+    void resetStats();
+};
+
+#endif // PACKET_CODEC_H
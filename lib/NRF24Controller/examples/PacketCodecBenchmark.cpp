@@ -0,0 +1,309 @@
+/**
+ * PacketCodec Round-Trip and Benchmark Example
+ *
+ * Runs without a radio attached:
+ * 1. Fuzz test: random packets are encoded (fragmenting when needed),
+ *    decoded and compared field by field. Single bit flips must be rejected.
+ * 2. Benchmark: encoded size, encode/decode time and estimated airtime at
+ *    250 kbps against the old raw struct dump (sizeof(DataPacket)).
+ * 3. Stream simulation: 50 Hz stick motion with random frame loss, sent as
+ *    keyframes only and as keyframe + delta. Reports average airtime, gaps
+ *    and the worst-case time the receiver needed to resynchronize.
+ */
+
+#include <NRF24Controller.h>
+
+#define FUZZ_ITERATIONS 20000
+#define BENCH_ITERATIONS 5000
+#define STREAM_TICKS 15000          // 5 minutes at 50 Hz
+#define STREAM_PERIOD_MS 20
+#define STREAM_KEYFRAME_MS 250
+#define STREAM_LOSS_PERCENT 5
+#define STREAM_THRESHOLD 5
+
+// Airtime of one Enhanced ShockBurst frame with 5-byte address and CRC16
+uint32_t airtimeUs(uint16_t payloadBytes, uint32_t bitsPerSecond) {
+    uint32_t bits = (1 + 5 + payloadBytes + 2) * 8 + 9;
+    return (uint32_t)((uint64_t)bits * 1000000UL / bitsPerSecond);
+}
+
+int16_t randomValue() {
+    switch (random(4)) {
+        case 0: return random(-255, 256);           // Joystick range
+        case 1: return random(-100, 101);           // Lever range
+        case 2: return 0;
+        default: return (int16_t)random(-32768, 32768); // Anything
+    }
+}
+
+void randomPacket(DataPacket& packet) {
+    memset(&packet, 0, sizeof(packet));
+    packet.packetId = random(256);
+    packet.timestamp = random(0x7FFFFFFF);
+    packet.controlCount = random(9);
+    packet.frameType = random(FRAME_DELTA + 1);
+
+    uint8_t id = random(256);
+    for (uint8_t i = 0; i < packet.controlCount; i++) {
+        id = random(3) ? id + 1 : random(256); // Mostly consecutive ids
+        ControlData& control = packet.controls[i];
+        control.id = id;
+        control.type = (ControlType)random(CONTROL_CUSTOM + 1);
+        control.valueX = randomValue();
+        control.valueY = randomValue();
+        control.flags = random(3) ? 0 : random(256);
+    }
+}
+
+bool samePacket(const DataPacket& a, const DataPacket& b) {
+    if (a.packetId != b.packetId || a.controlCount != b.controlCount ||
+        a.frameType != b.frameType || (uint16_t)a.timestamp != (uint16_t)b.timestamp) {
+        return false;
+    }
+    for (uint8_t i = 0; i < a.controlCount; i++) {
+        const ControlData& x = a.controls[i];
+        const ControlData& y = b.controls[i];
+        // Delta frames do not carry the control type
+        bool typeMatches = (a.frameType == FRAME_DELTA) || x.type == y.type;
+        if (x.id != y.id || !typeMatches || x.valueX != y.valueX ||
+            x.valueY != y.valueY || x.flags != y.flags) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Encode into frames and decode them back. Returns number of frames, 0 on failure.
+uint8_t roundTrip(const DataPacket& packet, DataPacket& decoded, bool flipBit) {
+    uint8_t frame[PACKET_FRAME_MAX];
+    uint8_t first = 0;
+    uint8_t fragment = 0;
+    uint8_t nextFragment = 0;
+    bool complete = false;
+
+    do {
+        uint8_t next;
+        uint8_t length = PacketCodec::encode(packet, frame, first, fragment, next);
+        if (length == 0 || length > PACKET_FRAME_MAX) return 0;
+
+        if (flipBit) {
+            uint16_t bit = random(length * 8);
+            frame[bit / 8] ^= (1 << (bit % 8));
+            return PacketCodec::decode(frame, length, decoded, complete, nextFragment) ? 0 : 1;
+        }
+
+        if (!PacketCodec::decode(frame, length, decoded, complete, nextFragment)) return 0;
+        first = next;
+        fragment++;
+    } while (first < packet.controlCount);
+
+    return complete ? fragment : 0;
+}
+
+void runFuzz() {
+    Serial.println("=== PacketCodec fuzz ===");
+    uint32_t failures = 0;
+    uint32_t undetected = 0;
+    uint32_t fragmented = 0;
+    DataPacket packet, decoded;
+
+    for (uint32_t i = 0; i < FUZZ_ITERATIONS; i++) {
+        randomPacket(packet);
+
+        uint8_t frames = roundTrip(packet, decoded, false);
+        if (frames == 0 || !samePacket(packet, decoded)) {
+            failures++;
+            Serial.print("Mismatch on packet "); Serial.println(packet.packetId);
+        }
+        if (frames > 1) fragmented++;
+
+        if (roundTrip(packet, decoded, true) == 0) {
+            undetected++;
+        }
+    }
+
+    Serial.print("Iterations: "); Serial.println(FUZZ_ITERATIONS);
+    Serial.print("Round-trip failures: "); Serial.println(failures);
+    Serial.print("Undetected bit flips: "); Serial.println(undetected);
+    Serial.print("Fragmented packets: "); Serial.println(fragmented);
+    Serial.println(failures == 0 && undetected == 0 ? "PASS" : "FAIL");
+}
+
+void runBenchmark() {
+    Serial.println("=== PacketCodec benchmark ===");
+
+    // Typical transmitter packet: 2 joysticks with flags, 2 levers
+    DataPacket packet;
+    memset(&packet, 0, sizeof(packet));
+    packet.packetId = 42;
+    packet.timestamp = millis();
+    packet.controlCount = 4;
+    packet.controls[0] = {0, CONTROL_JOYSTICK, 120, -87, 0x01, 0};
+    packet.controls[1] = {1, CONTROL_JOYSTICK, -255, 3, 0x04, 0};
+    packet.controls[2] = {100, CONTROL_LEVER_DIGITAL, 50, 0, 0x02, 0};
+    packet.controls[3] = {101, CONTROL_LEVER_ANALOG, -37, 12, 0x10, 0};
+
+    uint8_t frame[PACKET_FRAME_MAX];
+    uint8_t raw[sizeof(DataPacket)];
+    DataPacket decoded;
+    bool complete;
+    uint8_t nextFragment = 0;
+    uint8_t length = 0;
+
+    uint32_t start = micros();
+    for (uint16_t i = 0; i < BENCH_ITERATIONS; i++) {
+        packet.packetId = i;
+        length = PacketCodec::encode(packet, frame);
+    }
+    uint32_t encodeNs = (micros() - start) * 1000UL / BENCH_ITERATIONS;
+
+    start = micros();
+    for (uint16_t i = 0; i < BENCH_ITERATIONS; i++) {
+        PacketCodec::decode(frame, length, decoded, complete, nextFragment);
+    }
+    uint32_t decodeNs = (micros() - start) * 1000UL / BENCH_ITERATIONS;
+
+    start = micros();
+    for (uint16_t i = 0; i < BENCH_ITERATIONS; i++) {
+        packet.packetId = i;
+        memcpy(raw, &packet, sizeof(DataPacket));
+    }
+    uint32_t dumpNs = (micros() - start) * 1000UL / BENCH_ITERATIONS;
+
+    // The struct dump needs several 32-byte frames to go out at all
+    uint16_t rawFrames = (sizeof(DataPacket) + MAX_PACKET_SIZE - 1) / MAX_PACKET_SIZE;
+
+    Serial.print("Struct dump: "); Serial.print(sizeof(DataPacket));
+    Serial.print(" bytes ("); Serial.print(rawFrames); Serial.print(" frames), ");
+    Serial.print(dumpNs); Serial.print(" ns, airtime ");
+    Serial.print(rawFrames * airtimeUs(MAX_PACKET_SIZE, 250000)); Serial.println(" us");
+
+    Serial.print("PacketCodec: "); Serial.print(length);
+    Serial.print(" bytes (1 frame), encode "); Serial.print(encodeNs);
+    Serial.print(" ns, decode "); Serial.print(decodeNs);
+    Serial.print(" ns, airtime "); Serial.print(airtimeUs(length, 250000)); Serial.println(" us");
+
+    // Worst case: 8 controls with 16-bit values and flags
+    for (uint8_t i = 0; i < 8; i++) {
+        packet.controls[i] = {(uint8_t)(i * 7), CONTROL_CUSTOM, -30000, 30000, 0xFF, 0};
+    }
+    packet.controlCount = 8;
+    Serial.print("Worst case: "); Serial.print(PacketCodec::encodedSize(packet));
+    Serial.print(" bytes in "); Serial.print(PacketCodec::fragmentCount(packet));
+    Serial.println(" frames");
+}
+
+// Simulated inputs: two joysticks moving smoothly, two levers stepping
+void streamInputs(uint32_t tick, ControlData* controls) {
+    float t = tick * STREAM_PERIOD_MS / 1000.0;
+    controls[0] = {0, CONTROL_JOYSTICK, (int16_t)(200 * sin(t * 0.7)), (int16_t)(150 * sin(t * 0.3)), 0, 0};
+    controls[1] = {1, CONTROL_JOYSTICK, (int16_t)(60 * sin(t * 1.3)), 0, (uint8_t)((tick / 97) % 2), 0};
+    controls[2] = {100, CONTROL_LEVER_DIGITAL, (int16_t)(((tick / 400) % 3) * 50), 0, 0x02, 0};
+    controls[3] = {101, CONTROL_LEVER_DIGITAL, (int16_t)(((tick / 650) % 3) * 50), 0, 0, 0};
+}
+
+void runStream(bool useDeltas) {
+    PacketStateTracker receiver;
+    ControlData current[4];
+    ControlData lastSent[4];
+    memset(lastSent, 0, sizeof(lastSent));
+
+    uint32_t bytes = 0;
+    uint32_t frames = 0;
+    uint32_t mismatches = 0;
+    unsigned long lastKeyframe = 0;
+    bool forceKeyframe = true;
+    uint8_t sequence = 0;
+
+    for (uint32_t tick = 0; tick < STREAM_TICKS; tick++) {
+        unsigned long now = tick * STREAM_PERIOD_MS;
+        streamInputs(tick, current);
+
+        DataPacket packet;
+        memset(&packet, 0, sizeof(packet));
+        bool keyframe = !useDeltas || forceKeyframe || now - lastKeyframe >= STREAM_KEYFRAME_MS;
+        packet.frameType = keyframe ? FRAME_KEYFRAME : FRAME_DELTA;
+
+        for (uint8_t i = 0; i < 4; i++) {
+            bool changed = keyframe ||
+                           abs(current[i].valueX - lastSent[i].valueX) >= STREAM_THRESHOLD ||
+                           abs(current[i].valueY - lastSent[i].valueY) >= STREAM_THRESHOLD ||
+                           current[i].flags != lastSent[i].flags;
+            if (!changed) continue;
+
+            ControlData& control = packet.controls[packet.controlCount++];
+            control = current[i];
+            if (!keyframe) {
+                control.valueX = current[i].valueX - lastSent[i].valueX;
+                control.valueY = current[i].valueY - lastSent[i].valueY;
+                control.flags = current[i].flags ^ lastSent[i].flags;
+            }
+            lastSent[i] = current[i];
+        }
+        if (packet.controlCount == 0) continue;
+
+        packet.packetId = sequence++;
+        packet.timestamp = now;
+        if (keyframe) {
+            lastKeyframe = now;
+            forceKeyframe = false;
+        }
+
+        uint8_t frame[PACKET_FRAME_MAX];
+        uint8_t length = PacketCodec::encode(packet, frame);
+        bytes += length;
+        frames++;
+
+        // Lossy channel without ACKs: the transmitter never learns about the loss
+        if (random(100) < STREAM_LOSS_PERCENT) continue;
+
+        DataPacket decoded;
+        bool complete;
+        uint8_t nextFragment = 0;
+        if (PacketCodec::decode(frame, length, decoded, complete, nextFragment) && complete) {
+            receiver.apply(decoded, now);
+        }
+
+        // While synced, the receiver must hold exactly what was last sent
+        if (receiver.isSynced()) {
+            const DataPacket& state = receiver.getState();
+            for (uint8_t i = 0; i < state.controlCount; i++) {
+                const ControlData& c = state.controls[i];
+                const ControlData& sent = lastSent[(c.id >= 100) ? c.id - 98 : c.id];
+                if (c.valueX != sent.valueX || c.valueY != sent.valueY || c.flags != sent.flags) {
+                    mismatches++;
+                    break;
+                }
+            }
+        }
+    }
+
+    PacketStreamStats stats = receiver.getStats();
+    uint32_t avgBytes = frames ? bytes / frames : 0;
+    Serial.print(useDeltas ? "Keyframe+delta: " : "Keyframes only: ");
+    Serial.print(frames); Serial.print(" frames, avg "); Serial.print(avgBytes);
+    Serial.print(" bytes, avg airtime "); Serial.print(frames ? airtimeUs(avgBytes, 250000) : 0);
+    Serial.print(" us, gaps "); Serial.print(stats.gaps);
+    Serial.print(", dropped deltas "); Serial.print(stats.droppedDeltas);
+    Serial.print(", max recovery "); Serial.print(stats.maxRecoveryMs);
+    Serial.print(" ms, state mismatches "); Serial.println(mismatches);
+}
+
+void runStreamSimulation() {
+    Serial.println("=== Keyframe/delta stream ===");
+    runStream(false);
+    runStream(true);
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    randomSeed(12345);
+
+    runFuzz();
+    runBenchmark();
+    runStreamSimulation();
+}
+
+void loop() {
+}
@@ -0,0 +1,232 @@
+/**
+ * QuadratureEncoder Library Implementation
+ *
+ * Date: 2025
+ */
+
+#include "QuadratureEncoder.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+#include <driver/pcnt.h>
+
+// ========== PCNT BACKEND ==========
+
+uint8_t PcntEncoderBackend::_unitsUsed = 0;
+bool PcntEncoderBackend::_isrInstalled = false;
+
+PcntEncoderBackend::PcntEncoderBackend() {
+    _unit = -1;
+    _overflow = 0;
+}
+
+bool PcntEncoderBackend::begin(uint8_t pinA, uint8_t pinB) {
+    int unit = -1;
+    for (int i = 0; i < PCNT_UNIT_MAX && i < 8; i++) {
+        if (!(_unitsUsed & (1 << i))) {
+            unit = i;
+            break;
+        }
+    }
+    if (unit < 0) return false;
+
+    // Channel 0 counts A edges, channel 1 B edges; the other pin sets the direction
+    pcnt_config_t config = {};
+    config.pulse_gpio_num = pinA;
+    config.ctrl_gpio_num = pinB;
+    config.channel = PCNT_CHANNEL_0;
+    config.unit = (pcnt_unit_t)unit;
+    config.pos_mode = PCNT_COUNT_DEC;
+    config.neg_mode = PCNT_COUNT_INC;
+    config.lctrl_mode = PCNT_MODE_REVERSE;
+    config.hctrl_mode = PCNT_MODE_KEEP;
+    config.counter_h_lim = QUADRATURE_PCNT_LIMIT;
+    config.counter_l_lim = -QUADRATURE_PCNT_LIMIT;
+    if (pcnt_unit_config(&config) != ESP_OK) return false;
+
+    config.pulse_gpio_num = pinB;
+    config.ctrl_gpio_num = pinA;
+    config.channel = PCNT_CHANNEL_1;
+    config.pos_mode = PCNT_COUNT_INC;
+    config.neg_mode = PCNT_COUNT_DEC;
+    if (pcnt_unit_config(&config) != ESP_OK) return false;
+
+    // Encoder inputs are open contacts with pull-ups
+    pinMode(pinA, INPUT_PULLUP);
+    pinMode(pinB, INPUT_PULLUP);
+
+    pcnt_set_filter_value((pcnt_unit_t)unit, QUADRATURE_PCNT_FILTER);
+    pcnt_filter_enable((pcnt_unit_t)unit);
+
+    // The counter resets to 0 at each limit; the interrupt folds the limit into _overflow
+    pcnt_event_enable((pcnt_unit_t)unit, PCNT_EVT_H_LIM);
+    pcnt_event_enable((pcnt_unit_t)unit, PCNT_EVT_L_LIM);
+    if (!_isrInstalled) {
+        esp_err_t err = pcnt_isr_service_install(0);
+        if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+            Serial.println("QuadratureEncoder: PCNT interrupt service failed");
+            return false;
+        }
+        _isrInstalled = true;
+    }
+
+    _unit = unit;
+    _overflow = 0;
+    pcnt_isr_handler_add((pcnt_unit_t)unit, _onLimit, this);
+
+    pcnt_counter_pause((pcnt_unit_t)unit);
+    pcnt_counter_clear((pcnt_unit_t)unit);
+    pcnt_counter_resume((pcnt_unit_t)unit);
+
+    _unitsUsed |= 1 << unit;
+    return true;
+}
+
+void PcntEncoderBackend::end() {
+    if (_unit < 0) return;
+    pcnt_counter_pause((pcnt_unit_t)_unit);
+    pcnt_isr_handler_remove((pcnt_unit_t)_unit);
+    _unitsUsed &= ~(1 << _unit);
+    _unit = -1;
+}
+
+void IRAM_ATTR PcntEncoderBackend::_onLimit(void* arg) {
+    PcntEncoderBackend* backend = (PcntEncoderBackend*)arg;
+    uint32_t status = 0;
+    pcnt_get_event_status((pcnt_unit_t)backend->_unit, &status);
+    if (status & PCNT_EVT_H_LIM) backend->_overflow += QUADRATURE_PCNT_LIMIT;
+    if (status & PCNT_EVT_L_LIM) backend->_overflow -= QUADRATURE_PCNT_LIMIT;
+}
+
+int32_t PcntEncoderBackend::getCount() {
+    if (_unit < 0) return 0;
+
+    // Retry if the limit interrupt ran between the two reads
+    int32_t overflow;
+    int16_t value;
+    do {
+        overflow = _overflow;
+        pcnt_get_counter_value((pcnt_unit_t)_unit, &value);
+    } while (overflow != _overflow);
+    return overflow + value;
+}
+
+#endif
+
+// ========== INTERRUPT BACKEND ==========
+
+// Count change for (previous AB << 2 | current AB). 0 on the diagonal (no
+// change) and where both pins changed (invalid, an edge was missed).
+static const int8_t QUADRATURE_TABLE[16] = {
+     0, -1,  1,  0,
+     1,  0,  0, -1,
+    -1,  0,  0,  1,
+     0,  1, -1,  0
+};
+
+IsrEncoderBackend::IsrEncoderBackend() {
+    _pinA = 255;
+    _pinB = 255;
+    _attached = false;
+    _state = 0;
+    _count = 0;
+    _errors = 0;
+}
+
+bool IsrEncoderBackend::begin(uint8_t pinA, uint8_t pinB) {
+    if (digitalPinToInterrupt(pinA) == NOT_AN_INTERRUPT || digitalPinToInterrupt(pinB) == NOT_AN_INTERRUPT) {
+        Serial.println("QuadratureEncoder: Pins without interrupt");
+        return false;
+    }
+
+    _pinA = pinA;
+    _pinB = pinB;
+    pinMode(pinA, INPUT_PULLUP);
+    pinMode(pinB, INPUT_PULLUP);
+    _state = (digitalRead(pinA) << 1) | digitalRead(pinB);
+    _count = 0;
+    _errors = 0;
+
+    attachInterruptArg(digitalPinToInterrupt(pinA), _isr, this, CHANGE);
+    attachInterruptArg(digitalPinToInterrupt(pinB), _isr, this, CHANGE);
+    _attached = true;
+    return true;
+}
+
+void IsrEncoderBackend::end() {
+    if (!_attached) return;
+    detachInterrupt(digitalPinToInterrupt(_pinA));
+    detachInterrupt(digitalPinToInterrupt(_pinB));
+    _attached = false;
+}
+
+// Both pins share the handler: whichever changed, the new AB pair is decoded
+void IRAM_ATTR IsrEncoderBackend::_isr(void* arg) {
+    IsrEncoderBackend* backend = (IsrEncoderBackend*)arg;
+    backend->onEdge(digitalRead(backend->_pinA), digitalRead(backend->_pinB));
+}
+
+void IRAM_ATTR IsrEncoderBackend::onEdge(bool levelA, bool levelB) {
+    uint8_t state = (levelA << 1) | levelB;
+    uint8_t previous = _state;
+    if (state == previous) return;
+
+    int8_t delta = QUADRATURE_TABLE[(previous << 2) | state];
+    if (delta == 0) _errors++;
+    else _count += delta;
+    _state = state;
+}
+
+// ========== ENCODER ==========
+
+QuadratureEncoder::QuadratureEncoder() {
+    _backend = nullptr;
+    _windowUs = QUADRATURE_VELOCITY_WINDOW_US;
+    _windowStartUs = 0;
+    _windowStartCount = 0;
+    _velocity = 0;
+}
+
+bool QuadratureEncoder::begin(uint8_t pinA, uint8_t pinB, bool allowHardware) {
+    end();
+
+#if defined(ARDUINO_ARCH_ESP32)
+    if (allowHardware && _pcnt.begin(pinA, pinB)) {
+        _backend = &_pcnt;
+    }
+#else
+    (void)allowHardware;
+#endif
+    if (_backend == nullptr && _isr.begin(pinA, pinB)) {
+        _backend = &_isr;
+    }
+    if (_backend == nullptr) return false;
+
+    _windowStartUs = micros();
+    _windowStartCount = _backend->getCount();
+    _velocity = 0;
+    return true;
+}
+
+void QuadratureEncoder::end() {
+    if (_backend) _backend->end();
+    _backend = nullptr;
+    _velocity = 0;
+}
+
+void QuadratureEncoder::update() {
+    if (_backend == nullptr) return;
+
+    uint32_t now = micros();
+    uint32_t elapsed = now - _windowStartUs;
+    if (elapsed < _windowUs) return;
+
+    int32_t count = _backend->getCount();
+    _velocity = (int32_t)((int64_t)(count - _windowStartCount) * 1000000 / elapsed);
+    _windowStartUs = now;
+    _windowStartCount = count;
+}
+
+void QuadratureEncoder::setVelocityWindow(uint32_t windowUs) {
+    _windowUs = windowUs > 0 ? windowUs : 1;
+}
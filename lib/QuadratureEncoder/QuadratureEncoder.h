@@ -0,0 +1,127 @@
+/**
+ * QuadratureEncoder Library - Rotary encoder counting without polling
+ *
+ * Counts every edge of a quadrature encoder (x4 decoding) in hardware or
+ * in interrupts, so steps are not lost however fast the encoder turns or
+ * however seldom the count is read. The counter backend is abstracted the
+ * same way AnalogAcquisition abstracts its sample source.
+ *
+ * Features:
+ * - PcntEncoderBackend: ESP32 pulse counter (PCNT) unit, both channels in
+ *   full quadrature, glitch filter, 16-bit overflow extended to 32 bits
+ *   (ESP32 builds with PCNT only)
+ * - IsrEncoderBackend: software quadrature decoding from CHANGE interrupts
+ *   on both pins, one state per instance; counts invalid transitions
+ * - begin() picks PCNT when a unit is free and falls back to interrupts
+ * - Velocity from the counts over a fixed window (counts per second)
+ *
+ * Date: 2025
+ */
+
+#ifndef QUADRATURE_ENCODER_H
+#define QUADRATURE_ENCODER_H
+
+#include <Arduino.h>
+
+#define QUADRATURE_VELOCITY_WINDOW_US 20000   // Velocity estimation window
+#define QUADRATURE_PCNT_LIMIT 16384           // Hardware counter range before folding into 32 bits
+#define QUADRATURE_PCNT_FILTER 250            // Glitch filter, APB cycles (~3 us at 80 MHz)
+
+// Anything that counts quadrature edges
+class EncoderBackend {
+public:
+    virtual ~EncoderBackend() {}
+
+    virtual bool begin(uint8_t pinA, uint8_t pinB) = 0;
+    virtual void end() = 0;
+
+    // Signed edge count (4 per quadrature cycle) since begin()
+    virtual int32_t getCount() = 0;
+
+    // Transitions where both pins changed at once (an edge was missed)
+    virtual uint32_t getErrorCount() { return 0; }
+
+    virtual const char* getName() = 0;
+};
+
+#if defined(ARDUINO_ARCH_ESP32)
+
+// ESP32 pulse counter unit in x4 quadrature mode
+class PcntEncoderBackend : public EncoderBackend {
+private:
+    int _unit;
+    volatile int32_t _overflow;   // Counts folded in by the limit interrupt
+
+    static uint8_t _unitsUsed;    // Bit per PCNT unit
+    static bool _isrInstalled;
+    static void _onLimit(void* arg);
+
+public:
+    PcntEncoderBackend();
+
+    bool begin(uint8_t pinA, uint8_t pinB) override;
+    void end() override;
+    int32_t getCount() override;
+    const char* getName() override { return "PCNT"; }
+};
+
+#endif
+
+// Software quadrature decoding from pin-change interrupts
+class IsrEncoderBackend : public EncoderBackend {
+private:
+    uint8_t _pinA;
+    uint8_t _pinB;
+    bool _attached;
+    volatile uint8_t _state;      // Last AB levels (A = bit 1)
+    volatile int32_t _count;
+    volatile uint32_t _errors;
+
+    static void _isr(void* arg);
+
+public:
+    IsrEncoderBackend();
+
+    bool begin(uint8_t pinA, uint8_t pinB) override;
+    void end() override;
+    int32_t getCount() override { return _count; }
+    uint32_t getErrorCount() override { return _errors; }
+    const char* getName() override { return "ISR"; }
+
+    // Decode one transition (as the interrupt does) from the current AB levels
+    void onEdge(bool levelA, bool levelB);
+};
+
+class QuadratureEncoder {
+private:
+#if defined(ARDUINO_ARCH_ESP32)
+    PcntEncoderBackend _pcnt;
+#endif
+    IsrEncoderBackend _isr;
+    EncoderBackend* _backend;
+
+    // Velocity window
+    uint32_t _windowUs;
+    uint32_t _windowStartUs;
+    int32_t _windowStartCount;
+    int32_t _velocity;            // Counts per second over the last full window
+
+public:
+    QuadratureEncoder();
+
+    // Hardware counter when available (allowHardware), interrupts otherwise
+    bool begin(uint8_t pinA, uint8_t pinB, bool allowHardware = true);
+    void end();
+    bool isRunning() { return _backend != nullptr; }
+    const char* getBackendName() { return _backend ? _backend->getName() : "none"; }
+
+    int32_t getCount() { return _backend ? _backend->getCount() : 0; }
+    uint32_t getErrorCount() { return _backend ? _backend->getErrorCount() : 0; }
+
+    // Close the velocity window when it has elapsed. Call regularly.
+    void update();
+    void setVelocityWindow(uint32_t windowUs);
+    int32_t getVelocity() { return _velocity; }
+};
+
+#endif // QUADRATURE_ENCODER_H
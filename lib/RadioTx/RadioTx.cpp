@@ -0,0 +1,265 @@
+/**
+ * RadioTx Library Implementation
+ *
+ * Date: 2025
+ */
+
+#include "RadioTx.h"
+
+RadioTx::RadioTx() {
+    _radio = nullptr;
+    _depth = RADIO_TX_FIFO_DEPTH;
+    _timeoutUs = RADIO_TX_DEFAULT_TIMEOUT_US;
+    _irqPin = RADIO_TX_NO_IRQ;
+    _irqPending = false;
+    _irqUs = 0;
+
+    _count = 0;
+    _sequence = 0;
+
+    _callback = nullptr;
+    _context = nullptr;
+
+    _statsMux = portMUX_INITIALIZER_UNLOCKED;
+    resetStats();
+}
+
+bool RadioTx::begin(RF24* radio, int8_t irqPin) {
+    if (radio == nullptr) {
+        Serial.println("RadioTx: No radio");
+        return false;
+    }
+
+    _radio = radio;
+    _irqPin = irqPin;
+    _irqPending = false;
+    _count = 0;
+
+    _radio->flush_tx();
+    _radio->clearStatusFlags(RF24_TX_DS | RF24_TX_DF);
+
+    if (_irqPin != RADIO_TX_NO_IRQ) {
+        // Only the transmit events pull the IRQ line low
+        _radio->setStatusFlags(RF24_TX_DS | RF24_TX_DF);
+        pinMode(_irqPin, INPUT_PULLUP);
+        attachInterruptArg(digitalPinToInterrupt(_irqPin), _isr, this, FALLING);
+    }
+    return true;
+}
+
+void RadioTx::end() {
+    if (_irqPin != RADIO_TX_NO_IRQ) {
+        detachInterrupt(digitalPinToInterrupt(_irqPin));
+        _irqPin = RADIO_TX_NO_IRQ;
+    }
+    if (_radio != nullptr) {
+        flush(micros());
+    }
+    _radio = nullptr;
+}
+
+void RadioTx::setDepth(uint8_t depth) {
+    if (depth < 1) depth = 1;
+    if (depth > RADIO_TX_FIFO_DEPTH) depth = RADIO_TX_FIFO_DEPTH;
+    _depth = depth;
+    if (_count > _depth) {
+        flush(micros());
+    }
+}
+
+// nRF24 IRQ line: only timestamps, poll() reads and clears the flags
+void IRAM_ATTR RadioTx::_isr(void* arg) {
+    RadioTx* tx = static_cast<RadioTx*>(arg);
+    tx->_irqUs = micros();
+    tx->_irqPending = true;
+}
+
+bool RadioTx::submit(const void* payload, uint8_t length, uint32_t nowUs, bool multicast) {
+    uint32_t startUs = micros();
+
+    if (_radio == nullptr || payload == nullptr || length == 0 || length > RADIO_TX_MAX_PAYLOAD) {
+        portENTER_CRITICAL(&_statsMux);
+        _stats.rejected++;
+        portEXIT_CRITICAL(&_statsMux);
+        return false;
+    }
+
+    // Queue full: older frames are worth less than this one
+    if (_count >= _depth) {
+        _flush(RADIO_TX_DROPPED, nowUs);
+    }
+
+    // The FIFO has room, so writeFast() loads the frame and returns
+    if (!_radio->writeFast(payload, length, multicast)) {
+        portENTER_CRITICAL(&_statsMux);
+        _stats.rejected++;
+        portEXIT_CRITICAL(&_statsMux);
+        return false;
+    }
+
+    InFlight& frame = _inFlight[_count++];
+    frame.sequence = ++_sequence;
+    frame.queuedUs = nowUs;
+
+    uint32_t elapsedUs = micros() - startUs;
+    portENTER_CRITICAL(&_statsMux);
+    _stats.submitted++;
+    if (_count > _stats.maxInFlight) _stats.maxInFlight = _count;
+    if (elapsedUs > _stats.maxSubmitUs) _stats.maxSubmitUs = elapsedUs;
+    portEXIT_CRITICAL(&_statsMux);
+    return true;
+}
+
+uint8_t RadioTx::poll(uint32_t nowUs) {
+    if (_radio == nullptr || _count == 0) {
+        _irqPending = false;
+        return 0;
+    }
+
+    uint32_t startUs = micros();
+    uint8_t before = _count;
+    uint32_t completedUs = nowUs;
+
+    // With the IRQ pin the STATUS register is only read after an interrupt
+    bool check = true;
+    if (_irqPin != RADIO_TX_NO_IRQ) {
+        check = _irqPending;
+        if (check) {
+            _irqPending = false;
+            completedUs = _irqUs;
+            portENTER_CRITICAL(&_statsMux);
+            _stats.irqs++;
+            portEXIT_CRITICAL(&_statsMux);
+        }
+    }
+
+    if (check) {
+        uint8_t status = _radio->clearStatusFlags(RF24_TX_DS);
+        rf24_fifo_state_e fifo = _radio->isFifo(true);
+
+        // Frames no longer in the FIFO have been sent
+        uint8_t remaining = _count;
+        if (fifo == RF24_FIFO_EMPTY) remaining = 0;
+        else if (fifo == RF24_FIFO_OCCUPIED && remaining > RADIO_TX_FIFO_DEPTH - 1) remaining = RADIO_TX_FIFO_DEPTH - 1;
+        uint8_t sent = _count - remaining;
+        if (sent == 0 && (status & RF24_TX_DS) && !(status & RF24_TX_DF) && _count > 1) sent = 1;
+        _retire(sent, RADIO_TX_SENT, completedUs);
+
+        // MAX_RT: the head frame ran out of retries and halts the FIFO
+        if (status & RF24_TX_DF) {
+            _retire(1, RADIO_TX_FAILED, completedUs);
+            _flush(RADIO_TX_DROPPED, completedUs);
+        }
+    }
+
+    // Nothing heard from the radio for too long
+    if (_count > 0 && nowUs - _inFlight[0].queuedUs > _timeoutUs) {
+        _retire(1, RADIO_TX_TIMEOUT, nowUs);
+        _flush(RADIO_TX_DROPPED, nowUs);
+    }
+
+    // FIFO empty: back to STANDBY-I (returns at once, nothing left to send)
+    if (_count == 0) {
+        _radio->txStandBy();
+    }
+
+    uint32_t elapsedUs = micros() - startUs;
+    portENTER_CRITICAL(&_statsMux);
+    if (elapsedUs > _stats.maxPollUs) _stats.maxPollUs = elapsedUs;
+    portEXIT_CRITICAL(&_statsMux);
+
+    return before - _count;
+}
+
+// Report the oldest 'frames' in flight as finished
+void RadioTx::_retire(uint8_t frames, uint8_t status, uint32_t nowUs) {
+    while (frames > 0 && _count > 0) {
+        RadioTxResult result;
+        result.sequence = _inFlight[0].sequence;
+        result.queuedUs = _inFlight[0].queuedUs;
+        result.completedUs = nowUs;
+        result.status = status;
+
+        for (uint8_t i = 1; i < _count; i++) {
+            _inFlight[i - 1] = _inFlight[i];
+        }
+        _count--;
+        frames--;
+
+        portENTER_CRITICAL(&_statsMux);
+        switch (status) {
+            case RADIO_TX_SENT: {
+                uint32_t latencyUs = result.completedUs - result.queuedUs;
+                _stats.sent++;
+                if (latencyUs < _stats.minLatencyUs) _stats.minLatencyUs = latencyUs;
+                if (latencyUs > _stats.maxLatencyUs) _stats.maxLatencyUs = latencyUs;
+                _stats.sumLatencyUs += latencyUs;
+                break;
+            }
+            case RADIO_TX_FAILED:  _stats.failed++; break;
+            case RADIO_TX_TIMEOUT: _stats.timeouts++; break;
+            default:               _stats.dropped++; break;
+        }
+        portEXIT_CRITICAL(&_statsMux);
+
+        if (_callback != nullptr) {
+            _callback(result, _context);
+        }
+    }
+}
+
+// Empty the TX FIFO and report what was in it
+void RadioTx::_flush(uint8_t status, uint32_t nowUs) {
+    if (_radio == nullptr || _count == 0) return;
+
+    _radio->flush_tx();
+    _radio->clearStatusFlags(RF24_TX_DS | RF24_TX_DF);
+    _retire(_count, status, nowUs);
+}
+
+RadioTxStats RadioTx::getStats() {
+    RadioTxStats stats;
+
+    portENTER_CRITICAL(&_statsMux);
+    stats = _stats;
+    portEXIT_CRITICAL(&_statsMux);
+
+    return stats;
+}
+
+void RadioTx::resetStats() {
+    portENTER_CRITICAL(&_statsMux);
+    memset(&_stats, 0, sizeof(_stats));
+    _stats.minLatencyUs = UINT32_MAX;
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+void RadioTx::printStats() {
+    RadioTxStats stats = getStats();
+
+    Serial.print("RadioTx: sent/failed/dropped/timeout: ");
+    Serial.print(stats.sent); Serial.print("/");
+    Serial.print(stats.failed); Serial.print("/");
+    Serial.print(stats.dropped); Serial.print("/");
+    Serial.print(stats.timeouts);
+    if (stats.rejected > 0) {
+        Serial.print("  Rejected: "); Serial.print(stats.rejected);
+    }
+    Serial.print("  Latency: ");
+    if (stats.sent > 0) {
+        Serial.print(stats.minLatencyUs); Serial.print("/");
+        Serial.print((uint32_t)(stats.sumLatencyUs / stats.sent)); Serial.print("/");
+        Serial.print(stats.maxLatencyUs); Serial.println(" us (min/mean/max)");
+    } else {
+        Serial.println("-");
+    }
+
+    Serial.print("RadioTx: longest submit/poll: ");
+    Serial.print(stats.maxSubmitUs); Serial.print("/");
+    Serial.print(stats.maxPollUs); Serial.print(" us  In flight (max): ");
+    Serial.print(stats.maxInFlight);
+    if (_irqPin != RADIO_TX_NO_IRQ) {
+        Serial.print("  IRQs: "); Serial.print(stats.irqs);
+    }
+    Serial.println();
+}
@@ -0,0 +1,144 @@
+/**
+ * RadioTx Library - Non-blocking transmit path for the nRF24L01
+ *
+ * RF24::write() waits until the frame has left the air, and with auto-ACK
+ * until every retry is spent (up to 15 x (delay + airtime), tens of ms when
+ * the receiver is out of range). RadioTx only loads frames into the chip's
+ * 3-level TX FIFO (writeFast) and learns how they ended from the STATUS
+ * flags (TX_DS / MAX_RT) on the next poll() or IRQ, so submit() and poll()
+ * cost a few SPI transactions and never wait for the air.
+ *
+ * Features:
+ * - Bounded queue depth (1-3 frames). When it is full the FIFO is flushed
+ *   and the new frame replaces the queued ones: the newest state wins and
+ *   the caller never waits
+ * - Per-frame sequence number and timestamps (queued, completed)
+ * - Completion callback (called from poll(), task context): sent, failed
+ *   (MAX_RT), dropped (replaced by newer data) or timed out
+ * - Timeout for frames that stay in the FIFO (MAX_RT not seen, radio hung)
+ * - Optional IRQ pin (active low, TX_DS / MAX_RT only): poll() then skips
+ *   the SPI status read while nothing happened and takes the completion
+ *   time from the interrupt
+ * - Statistics: sent/failed/dropped/timeouts, submit->completion latency,
+ *   longest submit()/poll() call
+ *
+ * Completions are exact while one frame is in flight. With deeper queues a
+ * TX_DS retires the oldest frame and an empty FIFO retires all of them.
+ *
+ * Usage:
+ *   RadioTx tx;
+ *   tx.begin(&radio);                    // After radio.begin()/stopListening()
+ *   tx.onComplete(txDone, nullptr);
+ *   tx.poll(micros());                   // Every tick, before submitting
+ *   tx.submit(&data, sizeof(data), micros());
+ *
+ * Date: 2025
+ */
+
+#ifndef RADIO_TX_H
+#define RADIO_TX_H
+
+#include <Arduino.h>
+#include <RF24.h>
+
+#define RADIO_TX_FIFO_DEPTH 3
+#define RADIO_TX_MAX_PAYLOAD 32
+#define RADIO_TX_DEFAULT_TIMEOUT_US 100000   // Longer than 15 retries at 250 kbps
+#define RADIO_TX_NO_IRQ -1
+
+enum RadioTxStatus : uint8_t {
+    RADIO_TX_SENT = 0,      // TX_DS: on air (ACKed if auto-ACK is on)
+    RADIO_TX_FAILED,        // MAX_RT: no ACK after every retry
+    RADIO_TX_DROPPED,       // Flushed to make room for newer data
+    RADIO_TX_TIMEOUT        // Still in the FIFO after the timeout
+};
+
+struct RadioTxResult {
+    uint32_t sequence;      // From submit()
+    uint32_t queuedUs;      // micros() at submit()
+    uint32_t completedUs;   // When the completion was seen (or the IRQ time)
+    uint8_t status;         // RadioTxStatus
+};
+
+typedef void (*RadioTxCallback)(const RadioTxResult& result, void* context);
+
+struct RadioTxStats {
+    uint32_t submitted;
+    uint32_t sent;
+    uint32_t failed;
+    uint32_t dropped;
+    uint32_t timeouts;
+    uint32_t rejected;        // submit() refused (radio not started, bad length)
+    uint32_t irqs;            // Interrupts seen (IRQ pin only)
+    uint32_t minLatencyUs;    // submit() -> TX_DS
+    uint32_t maxLatencyUs;
+    uint64_t sumLatencyUs;
+    uint32_t maxSubmitUs;     // Longest time spent inside submit()
+    uint32_t maxPollUs;       // Longest time spent inside poll()
+    uint8_t maxInFlight;
+};
+
+class RadioTx {
+private:
+    struct InFlight {
+        uint32_t sequence;
+        uint32_t queuedUs;
+    };
+
+    RF24* _radio;
+    uint8_t _depth;
+    uint32_t _timeoutUs;
+    int8_t _irqPin;
+    volatile bool _irqPending;
+    volatile uint32_t _irqUs;
+
+    InFlight _inFlight[RADIO_TX_FIFO_DEPTH];
+    uint8_t _count;
+    uint32_t _sequence;
+
+    RadioTxCallback _callback;
+    void* _context;
+
+    // Statistics (written by the transmitting task only)
+    portMUX_TYPE _statsMux;
+    RadioTxStats _stats;
+
+    static void _isr(void* arg);
+    void _retire(uint8_t frames, uint8_t status, uint32_t nowUs);
+    void _flush(uint8_t status, uint32_t nowUs);
+
+public:
+    RadioTx();
+
+    // The radio must be started and in TX mode (stopListening()).
+    // irqPin: nRF24 IRQ line, or RADIO_TX_NO_IRQ to poll the STATUS register.
+    bool begin(RF24* radio, int8_t irqPin = RADIO_TX_NO_IRQ);
+    void end();
+
+    // Frames queued at most (1 = only the newest state is ever in the air)
+    void setDepth(uint8_t depth);
+    void setTimeout(uint32_t timeoutUs) { _timeoutUs = timeoutUs; }
+    void onComplete(RadioTxCallback callback, void* context) {
+        _callback = callback;
+        _context = context;
+    }
+
+    // Queue a frame without waiting. Returns false only if it was not loaded
+    // (frames it replaced are reported as RADIO_TX_DROPPED).
+    bool submit(const void* payload, uint8_t length, uint32_t nowUs, bool multicast = false);
+    // Collect completions and call the callback; returns how many ended
+    uint8_t poll(uint32_t nowUs);
+    // Drop everything queued (e.g. before changing channel or address)
+    void flush(uint32_t nowUs) { _flush(RADIO_TX_DROPPED, nowUs); }
+
+    uint8_t inFlight() { return _count; }
+    bool isIdle() { return _count == 0; }
+    uint32_t getLastSequence() { return _sequence; }
+
+    // Statistics
+    RadioTxStats getStats();
+    void resetStats();
+    void printStats();
+};
+
+#endif // RADIO_TX_H
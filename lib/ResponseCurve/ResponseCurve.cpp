@@ -0,0 +1,69 @@
+/**
+ * ResponseCurve Library Implementation
+ *
+ * Date: 2025
+ */
+
+#include "ResponseCurve.h"
+
+static const char* const CURVE_NAMES[CURVE_TYPES_COUNT] = {"Lineal", "Expo", "Curva S", "Puntos"};
+
+ResponseCurve::ResponseCurve() {
+    ResponseCurveConfig config;
+    defaultConfig(config);
+    build(config);
+}
+
+void ResponseCurve::defaultConfig(ResponseCurveConfig& config) {
+    config.type = CURVE_LINEAR;
+    config.amount = 0;
+    for (uint8_t i = 0; i < RESPONSE_CURVE_POINTS; i++) {
+        config.points[i] = (uint16_t)i * 255 / (RESPONSE_CURVE_POINTS - 1);
+    }
+}
+
+const char* ResponseCurve::typeName(uint8_t type) {
+    return type < CURVE_TYPES_COUNT ? CURVE_NAMES[type] : "?";
+}
+
+// Curve output (0-1) for an input x in 0-1
+float ResponseCurve::_evaluate(const ResponseCurveConfig& config, float x) {
+    float a = (config.amount > 100 ? 100 : config.amount) / 100.0f;
+    switch (config.type) {
+        case CURVE_EXPO:
+            return (1 - a) * x + a * x * x * x;
+
+        case CURVE_SCURVE:
+            return (1 - a) * x + a * x * x * (3 - 2 * x);
+
+        case CURVE_POINTS: {
+            float position = x * (RESPONSE_CURVE_POINTS - 1);
+            uint8_t segment = position >= RESPONSE_CURVE_POINTS - 1 ? RESPONSE_CURVE_POINTS - 2 : (uint8_t)position;
+            float t = position - segment;
+            return (config.points[segment] * (1 - t) + config.points[segment + 1] * t) / 255.0f;
+        }
+
+        default:
+            return x;
+    }
+}
+
+void ResponseCurve::build(const ResponseCurveConfig& config) {
+    _type = config.type < CURVE_TYPES_COUNT ? config.type : (uint8_t)CURVE_LINEAR;
+    ResponseCurveConfig shape = config;
+    shape.type = _type;
+
+    const float scale = 255.0f * (1 << RESPONSE_CURVE_SCALE_BITS);
+    const uint8_t step = 256 / RESPONSE_CURVE_SEGMENTS;
+    for (uint8_t i = 0; i < RESPONSE_CURVE_SEGMENTS; i++) {
+        float value = _evaluate(shape, i * step / 255.0f) * scale;
+        _table[i] = (uint16_t)constrain(value + 0.5f, 0.0f, scale);
+    }
+
+    // Last segment: input 255 (fraction step - 1) must give the curve end.
+    // Extrapolated in integers so the linear curve stays exact.
+    int32_t last = _table[RESPONSE_CURVE_SEGMENTS - 1];
+    int32_t end = (int32_t)(_evaluate(shape, 1.0f) * scale + 0.5f);
+    int32_t extended = last + ((end - last) * step + (step - 1) / 2) / (step - 1);
+    _table[RESPONSE_CURVE_SEGMENTS] = constrain(extended, 0, 65535);
+}
@@ -0,0 +1,96 @@
+/**
+ * ResponseCurve Library - Precomputed response curves for output channels
+ *
+ * Shapes a stick deflection (0-255) before it is scaled to a channel limit.
+ * The curve is evaluated once, when a profile is loaded or edited, into a
+ * small table; at runtime a channel costs one table lookup with linear
+ * interpolation and one scale to the limit, with no float math.
+ *
+ * Features:
+ * - Linear, expo (soft center), S-curve (soft center and ends) and custom
+ *   points (RESPONSE_CURVE_POINTS outputs at evenly spaced inputs)
+ * - 17-entry table (16 segments), outputs x128: the linear curve is exact,
+ *   apply() then gives the same integers as map(input, 0, 255, 0, max)
+ * - ResponseCurveConfig is a small POD to store per profile (ConfigStorage)
+ * - Trivially copyable: curves can be published with SeqLock
+ *
+ * Usage:
+ *   ResponseCurveConfig config = {CURVE_EXPO, 40, {0, 64, 128, 191, 255}};
+ *   ResponseCurve curve;
+ *   curve.build(config);                     // UI task, on profile load
+ *   uint8_t ch = curve.apply(stick, limit);  // Control task
+ *
+ * Date: 2025
+ */
+
+#ifndef RESPONSE_CURVE_H
+#define RESPONSE_CURVE_H
+
+#include <Arduino.h>
+
+#define RESPONSE_CURVE_SEGMENTS 16            // Table entries - 1 (power of two)
+#define RESPONSE_CURVE_SEGMENT_BITS 4         // log2(256 / RESPONSE_CURVE_SEGMENTS)
+#define RESPONSE_CURVE_SCALE_BITS 7           // Table outputs are x128
+#define RESPONSE_CURVE_POINTS 5               // Custom curve points (0, 25, 50, 75, 100%)
+
+enum ResponseCurveType : uint8_t {
+    CURVE_LINEAR = 0,
+    CURVE_EXPO,                               // (1 - a) x + a x^3
+    CURVE_SCURVE,                             // (1 - a) x + a (3x^2 - 2x^3)
+    CURVE_POINTS,                             // Straight lines through points[]
+    CURVE_TYPES_COUNT
+};
+
+// Stored form of a curve (one per channel and profile)
+struct ResponseCurveConfig {
+    uint8_t type;                             // ResponseCurveType
+    uint8_t amount;                           // 0-100 %, expo and S-curve
+    uint8_t points[RESPONSE_CURVE_POINTS];    // 0-255, custom curve
+};
+
+class ResponseCurve {
+private:
+    // Output x128 at inputs 0, 16, ... 240 and a last entry that makes
+    // input 255 land on the curve end
+    uint16_t _table[RESPONSE_CURVE_SEGMENTS + 1];
+    uint8_t _type;
+
+    static float _evaluate(const ResponseCurveConfig& config, float x);
+
+public:
+    ResponseCurve();
+
+    // Linear, amount 0 and evenly spaced points
+    static void defaultConfig(ResponseCurveConfig& config);
+    static const char* typeName(uint8_t type);
+
+    // Precompute the table (not for the control loop: uses float). Invalid
+    // types or amounts fall back to linear / are clamped.
+    void build(const ResponseCurveConfig& config);
+    uint8_t getType() const { return _type; }
+
+    // Shaped deflection, 0-255
+    uint8_t lookup(uint8_t input) const {
+        uint8_t index = input >> RESPONSE_CURVE_SEGMENT_BITS;
+        int32_t fraction = input & ((1 << RESPONSE_CURVE_SEGMENT_BITS) - 1);
+        int32_t a = _table[index];
+        int32_t b = _table[index + 1];
+        int32_t value = (a << RESPONSE_CURVE_SEGMENT_BITS) + (b - a) * fraction;
+        value = (value + (1 << (RESPONSE_CURVE_SEGMENT_BITS + RESPONSE_CURVE_SCALE_BITS - 1))) >>
+                (RESPONSE_CURVE_SEGMENT_BITS + RESPONSE_CURVE_SCALE_BITS);
+        return value < 0 ? 0 : (value > 255 ? 255 : value);
+    }
+
+    // Same table (compares the members: the object has padding)
+    bool operator==(const ResponseCurve& other) const {
+        return _type == other._type && memcmp(_table, other._table, sizeof(_table)) == 0;
+    }
+    bool operator!=(const ResponseCurve& other) const { return !(*this == other); }
+
+    // Shaped deflection scaled to 0..maxOutput
+    uint8_t apply(uint8_t input, uint8_t maxOutput) const {
+        return (uint16_t)lookup(input) * maxOutput / 255;
+    }
+};
+
+#endif // RESPONSE_CURVE_H
@@ -0,0 +1,341 @@
+/**
+ * SignalChain Library - Fixed-point filter chain for analog controls
+ *
+ * Integer replacement for the float processing of joystick axes and
+ * analog levers (the ESP32-S2 has no FPU: every float multiply, divide,
+ * sqrt() or atan2() is a software routine). Each stage is a small class
+ * with process()/reset(); SignalChain<...> composes them at compile time,
+ * so the chain is a fixed sequence of inlined calls with no virtual
+ * dispatch and no per-sample configuration checks beyond each stage's own.
+ *
+ * Features:
+ * - DeadZoneStage: values within +/-width of the center snap to the center
+ * - SmoothingStage: EMA with a Q16 coefficient, or one-euro filter (cutoff
+ *   that rises with the speed of the signal); state in Q12
+ * - ScaleStage: two-sided min/center/max scaling to +/-outMax, bit-exact
+ *   with Arduino map() (reciprocal multiply instead of a division)
+ * - ClampStage: constrain() to a range
+ * - ExpoStage: expo curve y = (1-e)x + e x^3 (0% = linear, exact)
+ * - signalSqrt(), signalAtan2(), signalInCircle(): magnitude, angle and
+ *   circular dead zone without sqrt()/atan2()
+ *
+ * Usage:
+ *   typedef SignalChain<SmoothingStage, ScaleStage, ClampStage> AxisChain;
+ *   AxisChain axis;
+ *   axis.stage<ScaleStage>().configure(0, 2048, 4095, 255, false);
+ *   axis.stage<ClampStage>().setRange(-255, 255);
+ *   axis.reset(2048);
+ *   int32_t out = axis.process(raw);
+ *
+ * Date: 2025
+ */
+
+#ifndef SIGNAL_CHAIN_H
+#define SIGNAL_CHAIN_H
+
+#include <Arduino.h>
+
+#define SIGNAL_Q16_ONE 65536                // 1.0 for coefficients
+#define SIGNAL_STATE_BITS 12                // Fractional bits of filter state
+#define SIGNAL_DIVIDER_SHIFT 40             // Reciprocal precision of SignalDivider
+#define SIGNAL_PI_Q15 102944                // Angles from signalAtan2()
+
+// Q16 coefficient from a float (configuration time only)
+inline int32_t signalQ16(float value) {
+    return (int32_t)(value * SIGNAL_Q16_ONE + (value >= 0 ? 0.5f : -0.5f));
+}
+
+// floor(sqrt(value)), bit by bit
+inline uint32_t signalSqrt(uint32_t value) {
+    if (value == 0) return 0;
+    uint32_t root = 0;
+    uint32_t bit = 1UL << ((31 - __builtin_clz(value)) & ~1);   // Highest power of 4 <= value
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+// atan2(y, x) in Q15 radians (-SIGNAL_PI_Q15..SIGNAL_PI_Q15). One division;
+// atan(z) ~ pi/4 z + z (1 - z)(0.2447 + 0.0663 z) on the first octant,
+// max error about 0.0015 rad.
+inline int32_t signalAtan2(int32_t y, int32_t x) {
+    if (x == 0 && y == 0) return 0;
+    uint32_t ax = x < 0 ? -x : x;
+    uint32_t ay = y < 0 ? -y : y;
+    bool steep = ay > ax;
+    int32_t z = (int32_t)(((uint64_t)(steep ? ax : ay) << 15) / (steep ? ay : ax));
+
+    int32_t angle = (25736 * z) >> 15;
+    int32_t bend = (z * (32768 - z)) >> 15;
+    angle += (bend * (8018 + ((2173 * z) >> 15))) >> 15;
+
+    if (steep) angle = SIGNAL_PI_Q15 / 2 - angle;
+    if (x < 0) angle = SIGNAL_PI_Q15 - angle;
+    return y < 0 ? -angle : angle;
+}
+
+// dx^2 + dy^2 <= radius^2 (|dx|, |dy|, radius < 32768)
+inline bool signalInCircle(int32_t dx, int32_t dy, int32_t radius) {
+    if (radius < 0) return false;
+    return (uint32_t)(dx * dx) + (uint32_t)(dy * dy) <= (uint32_t)(radius * radius);
+}
+
+// Truncating division by a constant, as '/' does, with a multiply by a
+// precomputed reciprocal. Exact for |n| * |d| < 2^40 (n*m - n/d stays below
+// one step); larger dividends fall back to '/'.
+class SignalDivider {
+private:
+    int32_t _divisor;
+    uint64_t _magic;               // ceil(2^40 / |d|)
+    uint32_t _maxDividend;         // Exact range of the reciprocal
+
+public:
+    SignalDivider() { setDivisor(1); }
+
+    void setDivisor(int32_t divisor) {
+        _divisor = divisor;
+        uint32_t d = divisor < 0 ? -divisor : divisor;
+        if (d == 0) {
+            _magic = 0;
+            _maxDividend = 0;
+            return;
+        }
+        _magic = (((uint64_t)1 << SIGNAL_DIVIDER_SHIFT) + d - 1) / d;
+        uint64_t limit = (((uint64_t)1 << SIGNAL_DIVIDER_SHIFT) - 1) / d;
+        _maxDividend = limit < (1UL << 23) ? (uint32_t)limit : (1UL << 23);
+    }
+
+    int32_t getDivisor() const { return _divisor; }
+
+    int32_t divide(int32_t n) const {
+        if (_divisor == 0) return 0;
+        uint32_t an = n < 0 ? -n : n;
+        if (an >= _maxDividend) return n / _divisor;
+        int32_t q = (int32_t)((an * _magic) >> SIGNAL_DIVIDER_SHIFT);
+        return (n < 0) != (_divisor < 0) ? -q : q;
+    }
+};
+
+// ========== STAGES ==========
+
+// Values within +/-width of the center become the center
+class DeadZoneStage {
+private:
+    int32_t _center;
+    int32_t _width;
+
+public:
+    DeadZoneStage() : _center(0), _width(0) {}
+
+    void setDeadZone(int32_t center, int32_t width) {
+        _center = center;
+        _width = width;
+    }
+
+    void reset(int32_t) {}
+
+    int32_t process(int32_t value) {
+        int32_t diff = value - _center;
+        return (diff <= _width && diff >= -_width) ? _center : value;
+    }
+};
+
+// EMA (state += alpha * (x - state)) or one-euro filter. Inputs within
+// +/-2^19; output is the state rounded down, like (int) of the float EMA.
+class SmoothingStage {
+private:
+    int32_t _alpha;                // Q16, SIGNAL_Q16_ONE = pass-through
+    int32_t _state;                // Q12
+
+    // One-euro filter
+    bool _oneEuro;
+    int32_t _minCutoff;            // Q16 Hz
+    int32_t _betaRate;             // Q16, beta * sample rate
+    int32_t _rate;                 // Hz
+    int32_t _derivativeAlpha;      // Q16, 1 Hz cutoff
+    int32_t _derivative;           // Q12 units per sample, smoothed
+
+    static int32_t _smooth(int32_t state, int32_t target, int32_t alpha) {
+        return state + (int32_t)(((int64_t)(target - state) * alpha + (SIGNAL_Q16_ONE / 2)) >> 16);
+    }
+
+    // alpha = w / (w + rate), w = 2 pi cutoff
+    int32_t _cutoffAlpha(int32_t cutoffQ16) {
+        int64_t w = ((int64_t)cutoffQ16 * 411775) >> 16;     // 2 pi in Q16
+        return (int32_t)((w << 16) / (w + ((int64_t)_rate << 16)));
+    }
+
+public:
+    SmoothingStage()
+        : _alpha(SIGNAL_Q16_ONE), _state(0), _oneEuro(false), _minCutoff(0), _betaRate(0),
+          _rate(1), _derivativeAlpha(0), _derivative(0) {}
+
+    void setAlpha(int32_t alphaQ16) {
+        _alpha = constrain(alphaQ16, 1, SIGNAL_Q16_ONE);
+        _oneEuro = false;
+    }
+
+    // One-euro filter at a fixed sample rate. beta is per (unit/s) of speed.
+    void setOneEuro(float minCutoffHz, float beta, uint16_t sampleRateHz) {
+        _rate = sampleRateHz > 0 ? sampleRateHz : 1;
+        _minCutoff = signalQ16(minCutoffHz);
+        _betaRate = signalQ16(beta * _rate);
+        _derivativeAlpha = _cutoffAlpha(SIGNAL_Q16_ONE);
+        _derivative = 0;
+        _oneEuro = true;
+    }
+
+    bool isEnabled() const { return _oneEuro || _alpha < SIGNAL_Q16_ONE; }
+
+    void reset(int32_t value) {
+        _state = value * (1 << SIGNAL_STATE_BITS);
+        _derivative = 0;
+    }
+
+    int32_t process(int32_t value) {
+        int32_t target = value * (1 << SIGNAL_STATE_BITS);
+        if (_oneEuro) {
+            _derivative = _smooth(_derivative, target - _state, _derivativeAlpha);
+            int32_t speed = _derivative < 0 ? -_derivative : _derivative;
+            int32_t cutoff = _minCutoff + (int32_t)(((int64_t)_betaRate * speed) >> SIGNAL_STATE_BITS);
+            _state = _smooth(_state, target, _cutoffAlpha(cutoff));
+        } else if (_alpha < SIGNAL_Q16_ONE) {
+            _state = _smooth(_state, target, _alpha);
+        } else {
+            _state = target;
+        }
+        return _state >> SIGNAL_STATE_BITS;
+    }
+};
+
+// min..center..max to -outMax..0..outMax, the same integers as
+// map(v, center, max, 0, outMax) / map(v, min, center, -outMax, 0)
+class ScaleStage {
+private:
+    int32_t _min;
+    int32_t _center;
+    int32_t _outMax;
+    bool _invert;
+    SignalDivider _upper;          // max - center
+    SignalDivider _lower;          // center - min
+
+public:
+    ScaleStage() : _min(0), _center(0), _outMax(0), _invert(false) {}
+
+    void configure(int32_t minValue, int32_t center, int32_t maxValue, int32_t outMax, bool invert) {
+        _min = minValue;
+        _center = center;
+        _outMax = outMax;
+        _invert = invert;
+        _upper.setDivisor(maxValue - center);
+        _lower.setDivisor(center - minValue);
+    }
+
+    void reset(int32_t) {}
+
+    int32_t process(int32_t value) {
+        int32_t out;
+        if (value >= _center) {
+            // map() returns -1 for an empty input range
+            out = _upper.getDivisor() ? _upper.divide((value - _center) * _outMax) : -1;
+        } else {
+            out = _lower.getDivisor() ? _lower.divide((value - _min) * _outMax) - _outMax : -1;
+        }
+        return _invert ? -out : out;
+    }
+};
+
+class ClampStage {
+private:
+    int32_t _low;
+    int32_t _high;
+
+public:
+    ClampStage() : _low(INT32_MIN), _high(INT32_MAX) {}
+
+    void setRange(int32_t low, int32_t high) {
+        _low = low;
+        _high = high;
+    }
+
+    void reset(int32_t) {}
+
+    int32_t process(int32_t value) {
+        return value < _low ? _low : (value > _high ? _high : value);
+    }
+};
+
+// y = x + e (x^3 / full^2 - x): softer around the center, same end points
+class ExpoStage {
+private:
+    int32_t _expo;                 // Q16, 0 = linear
+    SignalDivider _fullSquared;
+
+public:
+    ExpoStage() : _expo(0) {}
+
+    // percent 0..100 over a signal of +/-fullScale (fullScale <= 255)
+    void setExpo(uint8_t percent, int32_t fullScale) {
+        _expo = (int32_t)(percent > 100 ? 100 : percent) * SIGNAL_Q16_ONE / 100;
+        _fullSquared.setDivisor(fullScale * fullScale);
+    }
+
+    uint8_t getExpoPercent() const { return (uint8_t)((_expo * 100 + SIGNAL_Q16_ONE / 2) >> 16); }
+
+    void reset(int32_t) {}
+
+    int32_t process(int32_t value) {
+        if (_expo == 0) return value;
+        int32_t magnitude = value < 0 ? -value : value;
+        int32_t cube = _fullSquared.divide(magnitude * magnitude * magnitude);
+        int32_t out = magnitude + (int32_t)(((int64_t)_expo * (cube - magnitude)) >> 16);
+        return value < 0 ? -out : out;
+    }
+};
+
+// ========== CHAIN ==========
+
+// Stages run left to right. Each stage is a base class: configure it
+// through stage<T>() (one stage of each type per chain).
+template <typename... Stages>
+class SignalChain : public Stages... {
+private:
+    template <typename S>
+    int32_t _run(int32_t value) {
+        return S::process(value);
+    }
+
+    template <typename S, typename Next, typename... More>
+    int32_t _run(int32_t value) {
+        return _run<Next, More...>(S::process(value));
+    }
+
+    template <typename S>
+    void _reset(int32_t value) {
+        S::reset(value);
+    }
+
+    template <typename S, typename Next, typename... More>
+    void _reset(int32_t value) {
+        S::reset(value);
+        _reset<Next, More...>(S::process(value));
+    }
+
+public:
+    template <typename S>
+    S& stage() { return *this; }
+
+    int32_t process(int32_t value) { return _run<Stages...>(value); }
+
+    // Start every stateful stage from this input (its value as each stage sees it)
+    void reset(int32_t value) { _reset<Stages...>(value); }
+};
+
+#endif // SIGNAL_CHAIN_H
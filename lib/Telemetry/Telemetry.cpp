@@ -0,0 +1,59 @@
+/**
+ * Telemetry Library Implementation
+ *
+ * Date: 2025
+ */
+
+#include "Telemetry.h"
+
+uint8_t TelemetryCodec::encode(const TelemetryFrame& frame, uint8_t* buffer) {
+    buffer[0] = TELEMETRY_FRAME_ID;
+    buffer[1] = frame.ackSequence;
+    buffer[2] = frame.batteryMv & 0xFF;
+    buffer[3] = frame.batteryMv >> 8;
+    buffer[4] = (uint16_t)frame.motorCurrentMa & 0xFF;
+    buffer[5] = (uint16_t)frame.motorCurrentMa >> 8;
+    buffer[6] = frame.rssi > 100 ? 100 : frame.rssi;
+    buffer[7] = frame.flags;
+    return TELEMETRY_FRAME_SIZE;
+}
+
+bool TelemetryCodec::decode(const uint8_t* buffer, uint8_t length, TelemetryFrame& frame) {
+    if (buffer == nullptr || length != TELEMETRY_FRAME_SIZE || buffer[0] != TELEMETRY_FRAME_ID) {
+        return false;
+    }
+    frame.ackSequence = buffer[1];
+    frame.batteryMv = buffer[2] | (uint16_t)buffer[3] << 8;
+    frame.motorCurrentMa = (int16_t)(buffer[4] | (uint16_t)buffer[5] << 8);
+    frame.rssi = buffer[6] > 100 ? 100 : buffer[6];
+    frame.flags = buffer[7];
+    return true;
+}
+
+TelemetryResponder::TelemetryResponder() {
+    _rpdHistory = 0;
+    _samples = 0;
+    _lastSequence = 0;
+}
+
+void TelemetryResponder::onPacket(uint8_t sequence, bool strongSignal) {
+    _lastSequence = sequence;
+    _rpdHistory = (_rpdHistory << 1) | (strongSignal ? 1 : 0);
+    if (_samples < TELEMETRY_HISTORY) _samples++;
+}
+
+uint8_t TelemetryResponder::getRssi() {
+    if (_samples == 0) return 0;
+    uint32_t mask = _samples >= TELEMETRY_HISTORY ? 0xFFFFFFFFUL : (1UL << _samples) - 1;
+    return __builtin_popcountl(_rpdHistory & mask) * 100 / _samples;
+}
+
+uint8_t TelemetryResponder::build(uint8_t* buffer, uint16_t batteryMv, int16_t motorCurrentMa, uint8_t flags) {
+    TelemetryFrame frame;
+    frame.ackSequence = _lastSequence;
+    frame.batteryMv = batteryMv;
+    frame.motorCurrentMa = motorCurrentMa;
+    frame.rssi = getRssi();
+    frame.flags = flags;
+    return TelemetryCodec::encode(frame, buffer);
+}
@@ -0,0 +1,92 @@
+/**
+ * Telemetry Library - Receiver telemetry carried back in nRF24 ACK payloads
+ *
+ * With auto-ACK on, the receiver can load a payload that rides back on the
+ * ACK of the next packet it gets: telemetry reaches the transmitter without
+ * switching either radio between TX and RX. Every control packet carries a
+ * sequence byte and the receiver echoes the last one it got, so the
+ * transmitter measures the real round trip and which packets arrived.
+ *
+ * Frame layout (TELEMETRY_FRAME_SIZE bytes, little endian):
+ *   byte 0    TELEMETRY_FRAME_ID
+ *   byte 1    last sequence received
+ *   byte 2-3  receiver battery, mV
+ *   byte 4-5  motor current, mA (signed, negative = braking / reverse)
+ *   byte 6    RSSI proxy, 0-100 % of recent packets above -64 dBm (RPD bit)
+ *   byte 7    flags (TELEMETRY_FLAG_*)
+ *
+ * The ACK that carries a frame belongs to the packet after the one echoed
+ * (the receiver loads the frame after reading a packet), so the measured
+ * round trip includes one transmit interval.
+ *
+ * Features:
+ * - TelemetryCodec: frame encode/decode
+ * - TelemetryResponder (receiver): RSSI proxy over the last 32 packets and
+ *   the frame to load with writeAckPayload()
+ * - TelemetryLink (transmitter, TelemetryLink.h): packet sequence numbers,
+ *   frame parsing, round-trip time, ACK ratio over the last 32 packets
+ * - Telemetry.h/.cpp do not depend on the ESP32 core, so the receiver
+ *   (e.g. an Arduino Nano) can build them as they are
+ *
+ * Usage (transmitter, auto-ACK and ACK payloads enabled):
+ *   frame[length] = link.nextSequence(micros());   // Sequence after the data
+ *   ...when the packet ends: link.onAck(acked);
+ *   while (radio.available()) { ...read...; link.parse(buffer, size, micros()); }
+ *   TelemetryState telemetry = link.getState();
+ *
+ * Usage (receiver):
+ *   responder.onPacket(frame[length - 1], radio.testRPD());
+ *   uint8_t size = responder.build(buffer, batteryMv, currentMa);
+ *   radio.writeAckPayload(1, buffer, size);
+ *
+ * Date: 2025
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+
+#define TELEMETRY_FRAME_ID 0xA7
+#define TELEMETRY_FRAME_SIZE 8
+#define TELEMETRY_SEQUENCE_SIZE 1        // Appended to every control packet
+#define TELEMETRY_HISTORY 32             // Packets in the ACK ratio / RSSI windows
+
+// Flags sent by the receiver
+#define TELEMETRY_FLAG_FAILSAFE 0x01     // Outputs stopped since the last frame (link lost)
+#define TELEMETRY_FLAG_LOW_BATTERY 0x02
+
+struct TelemetryFrame {
+    uint8_t ackSequence;      // Last sequence the receiver got
+    uint16_t batteryMv;
+    int16_t motorCurrentMa;
+    uint8_t rssi;             // 0-100
+    uint8_t flags;
+};
+
+class TelemetryCodec {
+public:
+    static uint8_t encode(const TelemetryFrame& frame, uint8_t* buffer);
+    // False if the buffer is not a telemetry frame
+    static bool decode(const uint8_t* buffer, uint8_t length, TelemetryFrame& frame);
+};
+
+class TelemetryResponder {
+private:
+    uint32_t _rpdHistory;
+    uint8_t _samples;
+    uint8_t _lastSequence;
+
+public:
+    TelemetryResponder();
+
+    // Every packet received: its sequence byte and testRPD() right after reading it
+    void onPacket(uint8_t sequence, bool strongSignal);
+    uint8_t getRssi();
+    uint8_t getLastSequence() { return _lastSequence; }
+
+    // Frame to load with writeAckPayload(); returns its size
+    uint8_t build(uint8_t* buffer, uint16_t batteryMv, int16_t motorCurrentMa, uint8_t flags = 0);
+};
+
+#endif // TELEMETRY_H
@@ -0,0 +1,124 @@
+/**
+ * TelemetryLink Implementation
+ *
+ * Date: 2025
+ */
+
+#include "TelemetryLink.h"
+
+TelemetryLink::TelemetryLink() {
+    _statsMux = portMUX_INITIALIZER_UNLOCKED;
+    reset();
+    resetStats();
+}
+
+void TelemetryLink::reset() {
+    _sequence = 0;
+    memset(_pendingSequence, 0, sizeof(_pendingSequence));
+    memset(_pendingUs, 0, sizeof(_pendingUs));
+    _pendingValid = 0;
+    _ackHistory = 0;
+    _ackSamples = 0;
+    memset(&_state, 0, sizeof(_state));
+}
+
+uint8_t TelemetryLink::nextSequence(uint32_t nowUs) {
+    markSent(++_sequence, nowUs);
+    return _sequence;
+}
+
+void TelemetryLink::markSent(uint8_t sequence, uint32_t nowUs) {
+    uint8_t slot = sequence % TELEMETRY_PENDING;
+    _pendingSequence[slot] = sequence;
+    _pendingUs[slot] = nowUs;
+    _pendingValid |= 1 << slot;
+}
+
+void TelemetryLink::onAck(bool acked) {
+    _ackHistory = (_ackHistory << 1) | (acked ? 1 : 0);
+    if (_ackSamples < TELEMETRY_HISTORY) _ackSamples++;
+    uint32_t mask = _ackSamples >= TELEMETRY_HISTORY ? 0xFFFFFFFFUL : (1UL << _ackSamples) - 1;
+    _state.ackRate = __builtin_popcountl(_ackHistory & mask) * 100 / _ackSamples;
+
+    portENTER_CRITICAL(&_statsMux);
+    if (acked) _stats.acked++;
+    else _stats.lost++;
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+bool TelemetryLink::parse(const uint8_t* payload, uint8_t length, uint32_t nowUs) {
+    TelemetryFrame frame;
+    if (!TelemetryCodec::decode(payload, length, frame)) {
+        portENTER_CRITICAL(&_statsMux);
+        _stats.invalid++;
+        portEXIT_CRITICAL(&_statsMux);
+        return false;
+    }
+
+    _state.valid = true;
+    _state.frame = frame;
+    _state.receivedUs = nowUs;
+
+    // Round trip: only the first echo of a sequence still remembered
+    uint8_t slot = frame.ackSequence % TELEMETRY_PENDING;
+    bool measured = (_pendingValid & (1 << slot)) && _pendingSequence[slot] == frame.ackSequence;
+    uint32_t rttUs = 0;
+    if (measured) {
+        rttUs = nowUs - _pendingUs[slot];
+        _pendingValid &= ~(1 << slot);
+        _state.rttUs = rttUs;
+    }
+
+    portENTER_CRITICAL(&_statsMux);
+    _stats.frames++;
+    if (measured) {
+        _stats.rttSamples++;
+        if (rttUs < _stats.minRttUs) _stats.minRttUs = rttUs;
+        if (rttUs > _stats.maxRttUs) _stats.maxRttUs = rttUs;
+        _stats.sumRttUs += rttUs;
+    }
+    portEXIT_CRITICAL(&_statsMux);
+    return true;
+}
+
+TelemetryStats TelemetryLink::getStats() {
+    TelemetryStats stats;
+
+    portENTER_CRITICAL(&_statsMux);
+    stats = _stats;
+    portEXIT_CRITICAL(&_statsMux);
+
+    return stats;
+}
+
+void TelemetryLink::resetStats() {
+    portENTER_CRITICAL(&_statsMux);
+    memset(&_stats, 0, sizeof(_stats));
+    _stats.minRttUs = UINT32_MAX;
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+void TelemetryLink::printStats(const TelemetryState& state) {
+    TelemetryStats stats = getStats();
+
+    Serial.print("Telemetry: frames/invalid: ");
+    Serial.print(stats.frames); Serial.print("/"); Serial.print(stats.invalid);
+    Serial.print("  ACKed/lost: ");
+    Serial.print(stats.acked); Serial.print("/"); Serial.print(stats.lost);
+    Serial.print("  RTT: ");
+    if (stats.rttSamples > 0) {
+        Serial.print(stats.minRttUs); Serial.print("/");
+        Serial.print((uint32_t)(stats.sumRttUs / stats.rttSamples)); Serial.print("/");
+        Serial.print(stats.maxRttUs); Serial.println(" us (min/mean/max)");
+    } else {
+        Serial.println("-");
+    }
+
+    if (state.valid) {
+        Serial.print("Telemetry: battery "); Serial.print(state.frame.batteryMv);
+        Serial.print(" mV  motor "); Serial.print(state.frame.motorCurrentMa);
+        Serial.print(" mA  RSSI "); Serial.print(state.frame.rssi);
+        Serial.print("%  ACK "); Serial.print(state.ackRate);
+        Serial.print("%  flags 0x"); Serial.println(state.frame.flags, HEX);
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * TelemetryLink - Transmitter side of the ACK payload telemetry (Telemetry.h)
+ *
+ * Numbers the control packets, remembers when each one left and turns the
+ * ACK payloads read back from the radio into a TelemetryState: the last
+ * receiver frame, the round trip of the sequence it echoed and the share of
+ * recent packets that were ACKed.
+ *
+ * Date: 2025
+ */
+
+#ifndef TELEMETRY_LINK_H
+#define TELEMETRY_LINK_H
+
+#include <Arduino.h>
+#include "Telemetry.h"
+
+#define TELEMETRY_PENDING 16             // Send times kept for the round trip
+
+// What the transmitter knows about the receiver
+struct TelemetryState {
+    bool valid;               // At least one frame received
+    TelemetryFrame frame;     // Last frame
+    uint32_t receivedUs;      // micros() when it arrived
+    uint32_t rttUs;           // Send -> echo of the last sequence measured
+    uint8_t ackRate;          // 0-100 % of the last packets ACKed
+};
+
+struct TelemetryStats {
+    uint32_t frames;          // Valid telemetry frames
+    uint32_t invalid;         // ACK payloads that were not telemetry
+    uint32_t acked;           // Packets ACKed by the receiver
+    uint32_t lost;            // Packets without ACK
+    uint32_t rttSamples;
+    uint32_t minRttUs;
+    uint32_t maxRttUs;
+    uint64_t sumRttUs;
+};
+
+class TelemetryLink {
+private:
+    uint8_t _sequence;
+    uint8_t _pendingSequence[TELEMETRY_PENDING];
+    uint32_t _pendingUs[TELEMETRY_PENDING];
+    uint16_t _pendingValid;
+
+    uint32_t _ackHistory;
+    uint8_t _ackSamples;
+    TelemetryState _state;
+
+    // Statistics (written by the transmitting task only)
+    portMUX_TYPE _statsMux;
+    TelemetryStats _stats;
+
+public:
+    TelemetryLink();
+
+    // Sequence byte for the packet about to be sent (remembers when it left)
+    uint8_t nextSequence(uint32_t nowUs);
+    // Same, for packets that already carry their own sequence number
+    void markSent(uint8_t sequence, uint32_t nowUs);
+    // How the packet ended: ACKed or not (no ACK = not received)
+    void onAck(bool acked);
+    // ACK payload read from the RX FIFO. Returns true if it was telemetry.
+    bool parse(const uint8_t* payload, uint8_t length, uint32_t nowUs);
+
+    // Transmitting task only; other tasks read the copy it publishes (e.g. ControlState)
+    TelemetryState getState() { return _state; }
+    // A frame arrived less than maxAgeUs ago
+    bool isFresh(uint32_t nowUs, uint32_t maxAgeUs) {
+        return _state.valid && nowUs - _state.receivedUs < maxAgeUs;
+    }
+    // Forget the receiver (e.g. after changing channel or address)
+    void reset();
+
+    // Statistics. printStats() takes the receiver state from the caller: _state
+    // belongs to the transmitting task.
+    TelemetryStats getStats();
+    void resetStats();
+    void printStats(const TelemetryState& state);
+};
+
+#endif // TELEMETRY_LINK_H
@@ -0,0 +1,94 @@
+/**
+ * Implementación de TransmitterLogic
+ *
+ * Fecha: 2025
+ */
+
+#include "TransmitterLogic.h"
+
+void configureJoysticks(Joystick& izquierdo, Joystick& derecho, EdgeCapture& botones) {
+    izquierdo.begin();
+    izquierdo.setCenter(5520, 5160);
+    izquierdo.setDeadZone(100, true);
+    izquierdo.setLimits(60, 8180, 65, 8180);
+    izquierdo.invertAxis(false, false);
+
+    derecho.begin();
+    derecho.setCenter(5060, 4970);
+    derecho.setDeadZone(100, true);
+    derecho.setLimits(60, 8180, 65, 8180);
+    derecho.invertAxis(false, false);
+
+    // Botones por interrupción: el boost se ve en el flanco, no en el siguiente muestreo
+    izquierdo.setEdgeCapture(&botones);
+    derecho.setEdgeCapture(&botones);
+}
+
+void sampleControlInputs(Joystick& izquierdo, Joystick& derecho, PalancaTable& palancas,
+                         ControlInputs& inputs) {
+    // Una sola adquisición de ambos ejes por joystick y por ciclo
+    izquierdo.sample();
+    derecho.sample();
+
+    inputs.izquierdo_X = izquierdo.readX();
+    inputs.izquierdo_Y = izquierdo.readY();
+    inputs.derecho_X = derecho.readX();
+    inputs.derecho_Y = derecho.readY();
+    inputs.derecho_pressed = derecho.isPressed();
+
+    // Todas las palancas de una misma lectura del registro de entradas, con antirrebote
+    palancas.update();
+    memcpy(inputs.palanca_position, palancas.getPositions(), PALANCAS_COUNT);
+}
+
+void computeSentData(const ControlInputs& inputs, const uint8_t limits[PALANCAS_COUNT][3],
+                     const ResponseCurve curves[CURVAS_COUNT], Data_to_be_sent& data) {
+    const uint8_t* palanca1 = limits[0];
+    const uint8_t* palanca2 = limits[1];
+    const uint8_t* palanca3 = limits[2];
+    const uint8_t* palanca4 = limits[3];
+
+    // Joystick izquierdo Y: velocidad limitada por palanca1, boost suma palanca3.
+    // La curva de cada sentido da la forma; el límite, la escala.
+    uint16_t max_val = palanca1[inputs.palanca_position[0]];
+    if (inputs.derecho_pressed) {
+        max_val += palanca3[inputs.palanca_position[2]];
+        if (max_val > 255) max_val = 255;
+    }
+
+    int val_izquierdo_Y = inputs.izquierdo_Y;
+    if (val_izquierdo_Y > 0) {
+        data.ch1 = curves[CURVA_CH1].apply(val_izquierdo_Y, max_val);
+        data.ch2 = 0;
+    } else if (val_izquierdo_Y < 0) {
+        data.ch2 = curves[CURVA_CH2].apply(-val_izquierdo_Y, max_val);
+        data.ch1 = 0;
+    } else {
+        data.ch1 = 0;
+        data.ch2 = 0;
+    }
+
+    // Joystick derecho X: giro limitado por palanca2
+    int val_Derecho_X = inputs.derecho_X;
+    uint8_t giro_max = palanca2[inputs.palanca_position[1]];
+    if (val_Derecho_X > 0) {
+        data.ch3 = curves[CURVA_CH3].apply(val_Derecho_X, giro_max);
+        data.ch4 = 0;
+    } else if (val_Derecho_X < 0) {
+        data.ch4 = curves[CURVA_CH4].apply(-val_Derecho_X, giro_max);
+        data.ch3 = 0;
+    } else {
+        data.ch3 = 0;
+        data.ch4 = 0;
+    }
+
+    // Palanca4: valor configurado directo en ch5
+    int val_palanca4 = palanca4[inputs.palanca_position[3]];
+    if (val_palanca4 >= 0) {
+        data.ch5 = map(val_palanca4, 0, 255, 0, 255);
+        data.ch6 = 0;
+    } else {
+        data.ch5 = 0;
+        data.ch6 = map(val_palanca4, -255, 0, 255, 0);
+    }
+}
@@ -0,0 +1,109 @@
+/**
+ * TransmitterLogic - Lógica del lazo de control del transmisor, sin UI
+ *
+ * Contiene lo que controlTick() hace en cada ciclo, separado de LVGL y del
+ * hardware para que main.cpp y el simulador de host (src/host/) ejecuten
+ * exactamente el mismo código.
+ *
+ * Características:
+ * - Pines de joysticks y palancas del hardware
+ * - Configuración de los joysticks (centro, zona muerta, límites) y de sus
+ *   botones por interrupción (EdgeCapture)
+ * - Tabla de las palancas de 3 posiciones (PALANCA_PINS) para LeverTable
+ * - Cálculo de Data_to_be_sent: velocidad con boost (palanca1 + palanca3),
+ *   giro (palanca2) y canal extra (palanca4)
+ * - Curva de respuesta (ResponseCurve) por canal de joystick, ch1 a ch4
+ *
+ * Fecha: 2025
+ */
+
+#ifndef TRANSMITTER_LOGIC_H
+#define TRANSMITTER_LOGIC_H
+
+#include <Arduino.h>
+#include <Joystick.h>
+#include <LeverTable.h>
+#include <EdgeCapture.h>
+#include <ResponseCurve.h>
+
+// ========== PINES ==========
+// Joysticks (X, Y, botón)
+#define JOYSTICK_IZQ_X 5
+#define JOYSTICK_IZQ_Y 2
+#define JOYSTICK_IZQ_BTN 4
+#define JOYSTICK_DER_X 8
+#define JOYSTICK_DER_Y 9
+#define JOYSTICK_DER_BTN 10
+
+// Palancas de 3 posiciones (dos pines con pull-up cada una)
+#define P1_1 13
+#define P1_2 14
+
+#define P2_1 11
+#define P2_2 12
+
+#define P3_1 40
+#define P3_2 39
+
+#define P4_1 16
+#define P4_2 17
+
+#define PALANCAS_COUNT 4
+
+// Una fila por palanca, en el orden de palanca1 ... palanca4. Para añadir una
+// palanca basta con una fila más (y subir PALANCAS_COUNT).
+constexpr LeverPins PALANCA_PINS[PALANCAS_COUNT] = {
+    {P1_1, P1_2},
+    {P2_1, P2_2},
+    {P3_1, P3_2},
+    {P4_1, P4_2}
+};
+
+typedef LeverTable<PALANCAS_COUNT> PalancaTable;
+
+// Curvas de respuesta, una por canal de joystick (ch1 ... ch4)
+enum {
+    CURVA_CH1 = 0,          // Avance
+    CURVA_CH2,              // Reversa
+    CURVA_CH3,              // Giro derecha
+    CURVA_CH4,              // Giro izquierda
+    CURVAS_COUNT
+};
+
+// Paquete que se transmite por el NRF24 (7 canales de 0-255)
+struct Data_to_be_sent {
+    byte ch1;   // Avance
+    byte ch2;   // Reversa
+    byte ch3;   // Giro derecha
+    byte ch4;   // Giro izquierda
+    byte ch5;   // Extra (palanca4)
+    byte ch6;
+    byte ch7;
+};
+
+// Entradas ya muestreadas de un ciclo de control
+struct ControlInputs {
+    int izquierdo_X;
+    int izquierdo_Y;              // Velocidad (-255 a 255)
+    int derecho_X;                // Giro (-255 a 255)
+    int derecho_Y;
+    bool derecho_pressed;         // Botón del joystick derecho = boost
+    uint8_t palanca_position[PALANCAS_COUNT];   // 0, 1 (centro) o 2
+};
+
+// Centro, zona muerta y límites medidos en el hardware. Los botones se capturan
+// por interrupción en 'botones' (botones.service() en cada ciclo de control).
+void configureJoysticks(Joystick& izquierdo, Joystick& derecho, EdgeCapture& botones);
+
+// Una adquisición de ambos joysticks y de todas las palancas (una sola lectura de GPIO)
+void sampleControlInputs(Joystick& izquierdo, Joystick& derecho, PalancaTable& palancas,
+                         ControlInputs& inputs);
+
+// Canales a transmitir según las entradas y los límites de cada palanca
+// (limits[i] = límites de palanca i+1 para las posiciones 0, 1 y 2). La
+// desviación de cada joystick pasa por la curva de su canal antes de escalarse
+// al límite; con curvas lineales el resultado es el mismo que map().
+void computeSentData(const ControlInputs& inputs, const uint8_t limits[PALANCAS_COUNT][3],
+                     const ResponseCurve curves[CURVAS_COUNT], Data_to_be_sent& data);
+
+#endif // TRANSMITTER_LOGIC_H
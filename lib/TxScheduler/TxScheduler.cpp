@@ -0,0 +1,151 @@
+/**
+ * TxScheduler Library Implementation
+ *
+ * Date: 2025
+ */
+
+#include "TxScheduler.h"
+
+TxScheduler::TxScheduler() {
+    _activeUs = TX_SCHEDULER_DEFAULT_ACTIVE_US;
+    _heartbeatUs = TX_SCHEDULER_DEFAULT_HEARTBEAT_US;
+    _failsafeUs = TX_SCHEDULER_DEFAULT_FAILSAFE_US;
+    _holdUs = TX_SCHEDULER_DEFAULT_HOLD_US;
+    _threshold = 0;
+
+    _intervalUs = _activeUs;
+    _lastSendUs = 0;
+    _lastChangeUs = 0;
+    _started = false;
+    _forced = false;
+
+    memset(_last, 0, sizeof(_last));
+    _lastLength = 0;
+
+    _statsMux = portMUX_INITIALIZER_UNLOCKED;
+    resetStats();
+}
+
+void TxScheduler::setIntervals(uint32_t activeUs, uint32_t heartbeatUs, uint32_t failsafeUs) {
+    if (activeUs == 0 || failsafeUs == 0) {
+        Serial.println("TxScheduler: Intervals must be > 0");
+        return;
+    }
+    if (heartbeatUs > failsafeUs) {
+        Serial.println("TxScheduler: Heartbeat limited to the failsafe interval");
+        heartbeatUs = failsafeUs;
+    }
+    if (activeUs > heartbeatUs) activeUs = heartbeatUs;
+
+    _activeUs = activeUs;
+    _heartbeatUs = heartbeatUs;
+    _failsafeUs = failsafeUs;
+    _intervalUs = activeUs;
+}
+
+bool TxScheduler::update(bool changed, uint32_t nowUs) {
+    uint32_t elapsedUs = nowUs - _lastSendUs;
+    bool first = !_started;
+
+    if (changed || first) _lastChangeUs = nowUs;
+    bool active = nowUs - _lastChangeUs < _holdUs;
+    if (active) _intervalUs = _activeUs;
+
+    // A tick that runs a little early (up to 1/8 of the active interval) still meets it
+    if (!first && !_forced && elapsedUs + _activeUs / TX_SCHEDULER_JITTER_DIV < _intervalUs) {
+        return false;
+    }
+
+    // Idle: double the interval after each packet, up to the heartbeat
+    if (!active) {
+        _intervalUs = _intervalUs * 2 < _heartbeatUs ? _intervalUs * 2 : _heartbeatUs;
+    }
+
+    portENTER_CRITICAL(&_statsMux);
+    if (!first) {
+        if (elapsedUs < _stats.minIntervalUs) _stats.minIntervalUs = elapsedUs;
+        if (elapsedUs > _stats.maxIntervalUs) _stats.maxIntervalUs = elapsedUs;
+        _stats.sumIntervalUs += elapsedUs;
+        _stats.intervals++;
+    }
+    _stats.packets++;
+    if (active) _stats.activePackets++;
+    else _stats.heartbeatPackets++;
+    _stats.currentIntervalUs = _intervalUs;
+    portEXIT_CRITICAL(&_statsMux);
+
+    _lastSendUs = nowUs;
+    _started = true;
+    _forced = false;
+    return true;
+}
+
+bool TxScheduler::_payloadChanged(const uint8_t* payload, uint8_t length) {
+    if (length != _lastLength) return true;
+    for (uint8_t i = 0; i < length; i++) {
+        int difference = payload[i] - _last[i];
+        if (difference > _threshold || -difference > _threshold) return true;
+    }
+    return false;
+}
+
+bool TxScheduler::poll(const void* payload, uint8_t length, uint32_t nowUs) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(payload);
+    if (length > TX_SCHEDULER_MAX_PAYLOAD) length = TX_SCHEDULER_MAX_PAYLOAD;
+
+    if (!update(_payloadChanged(bytes, length), nowUs)) {
+        return false;
+    }
+
+    memcpy(_last, bytes, length);
+    _lastLength = length;
+    addBytesOnAir(length + TX_SCHEDULER_FRAME_OVERHEAD);
+    return true;
+}
+
+void TxScheduler::addBytesOnAir(uint32_t bytes) {
+    portENTER_CRITICAL(&_statsMux);
+    _stats.bytesOnAir += bytes;
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+TxSchedulerStats TxScheduler::getStats() {
+    TxSchedulerStats stats;
+
+    portENTER_CRITICAL(&_statsMux);
+    stats = _stats;
+    portEXIT_CRITICAL(&_statsMux);
+
+    stats.windowUs = micros() - _statsStartUs;
+    return stats;
+}
+
+void TxScheduler::resetStats() {
+    portENTER_CRITICAL(&_statsMux);
+    memset(&_stats, 0, sizeof(_stats));
+    _stats.minIntervalUs = UINT32_MAX;
+    _stats.currentIntervalUs = _intervalUs;
+    _statsStartUs = micros();
+    portEXIT_CRITICAL(&_statsMux);
+}
+
+void TxScheduler::printStats() {
+    TxSchedulerStats stats = getStats();
+    float seconds = stats.windowUs / 1000000.0;
+    if (seconds <= 0) return;
+
+    Serial.print("TxScheduler: "); Serial.print(stats.packets / seconds, 1); Serial.print(" pkt/s");
+    Serial.print("  "); Serial.print(stats.bytesOnAir / seconds, 0); Serial.print(" B/s on air");
+    Serial.print("  Active/heartbeat: "); Serial.print(stats.activePackets);
+    Serial.print("/"); Serial.println(stats.heartbeatPackets);
+
+    Serial.print("TxScheduler interval: ");
+    if (stats.intervals > 0) {
+        Serial.print(stats.minIntervalUs / 1000.0, 1); Serial.print("/");
+        Serial.print(stats.sumIntervalUs / (float)stats.intervals / 1000.0, 1); Serial.print("/");
+        Serial.print(stats.maxIntervalUs / 1000.0, 1); Serial.print(" ms (min/mean/max)");
+    } else {
+        Serial.print("-");
+    }
+    Serial.print("  Now: "); Serial.print(stats.currentIntervalUs / 1000.0, 1); Serial.println(" ms");
+}
@@ -0,0 +1,111 @@
+/**
+ * TxScheduler Library - Adaptive transmit rate for a radio link
+ *
+ * Decides, once per control tick, whether the current packet goes on air.
+ * While the inputs move it transmits at the active rate (every tick at
+ * 200 Hz); once they stop it keeps that rate for a hold time (repeats the
+ * last change in case a frame was lost) and then backs off, doubling the
+ * interval up to a heartbeat. The heartbeat never exceeds the failsafe
+ * interval, so the receiver always hears from the transmitter at least at
+ * the failsafe rate.
+ *
+ * Features:
+ * - Configurable active, heartbeat and failsafe intervals and hold time
+ * - poll(): change detection against the last sent payload (with threshold)
+ * - update(): scheduling only, for callers that detect changes themselves
+ * - Statistics: packets and bytes on air per second, min/mean/max interval,
+ *   active vs heartbeat packets, current interval
+ *
+ * Usage:
+ *   TxScheduler scheduler;
+ *   scheduler.setIntervals(5000, 100000, 250000);   // us
+ *   if (scheduler.poll(&data, sizeof(data), micros())) radio.write(&data, sizeof(data));
+ *
+ * Date: 2025
+ */
+
+#ifndef TX_SCHEDULER_H
+#define TX_SCHEDULER_H
+
+#include <Arduino.h>
+
+#define TX_SCHEDULER_DEFAULT_ACTIVE_US 5000       // 200 Hz while the inputs move
+#define TX_SCHEDULER_DEFAULT_HEARTBEAT_US 100000  // 10 Hz when idle
+#define TX_SCHEDULER_DEFAULT_FAILSAFE_US 250000   // Upper bound for the heartbeat
+#define TX_SCHEDULER_DEFAULT_HOLD_US 200000       // Active rate kept after the last change
+#define TX_SCHEDULER_MAX_PAYLOAD 32
+#define TX_SCHEDULER_FRAME_OVERHEAD 8             // nRF24 preamble + 5-byte address + 2-byte CRC
+#define TX_SCHEDULER_JITTER_DIV 8                 // Tick jitter allowed: 1/8 of the active interval
+
+struct TxSchedulerStats {
+    uint32_t windowUs;          // Time covered by the statistics
+    uint32_t packets;           // Packets put on air
+    uint32_t activePackets;     // Sent at the active rate (change or hold time)
+    uint32_t heartbeatPackets;  // Sent while backing off / at the heartbeat
+    uint32_t bytesOnAir;        // Payload + frame overhead
+    uint32_t minIntervalUs;     // Between consecutive packets
+    uint32_t maxIntervalUs;
+    uint64_t sumIntervalUs;
+    uint32_t intervals;
+    uint32_t currentIntervalUs; // Interval the scheduler is using now
+};
+
+class TxScheduler {
+private:
+    uint32_t _activeUs;
+    uint32_t _heartbeatUs;
+    uint32_t _failsafeUs;
+    uint32_t _holdUs;
+    uint8_t _threshold;
+
+    uint32_t _intervalUs;
+    uint32_t _lastSendUs;
+    uint32_t _lastChangeUs;
+    bool _started;
+    bool _forced;
+
+    uint8_t _last[TX_SCHEDULER_MAX_PAYLOAD];
+    uint8_t _lastLength;
+
+    // Statistics (written by the transmitting task only)
+    portMUX_TYPE _statsMux;
+    uint32_t _statsStartUs;
+    TxSchedulerStats _stats;
+
+    bool _payloadChanged(const uint8_t* payload, uint8_t length);
+
+public:
+    TxScheduler();
+
+    // Intervals in microseconds. The heartbeat is clamped to the failsafe
+    // interval and the active interval to the heartbeat.
+    void setIntervals(uint32_t activeUs, uint32_t heartbeatUs, uint32_t failsafeUs);
+    void setHoldTime(uint32_t holdUs) { _holdUs = holdUs; }
+    // Minimum change of any payload byte that counts as activity (0 = any change)
+    void setThreshold(uint8_t threshold) { _threshold = threshold; }
+
+    // Transmit now? 'changed' = the inputs moved since the last packet sent.
+    // A true return counts the packet; add its size with addBytesOnAir().
+    bool update(bool changed, uint32_t nowUs);
+    // Same, comparing the payload with the last one sent (counts its bytes)
+    bool poll(const void* payload, uint8_t length, uint32_t nowUs);
+    void addBytesOnAir(uint32_t bytes);
+
+    // Next packet is sent on the next call (e.g. after reconfiguring the radio
+    // or a lost packet). It does not count as activity: an idle link stays on
+    // the heartbeat.
+    void forceSend() { _forced = true; }
+
+    uint32_t getIntervalUs() { return _intervalUs; }
+    uint32_t getActiveUs() { return _activeUs; }
+    uint32_t getHeartbeatUs() { return _heartbeatUs; }
+    uint32_t getFailsafeUs() { return _failsafeUs; }
+    bool isActive(uint32_t nowUs) { return _started && nowUs - _lastChangeUs < _holdUs; }
+
+    // Statistics
+    TxSchedulerStats getStats();
+    void resetStats();
+    void printStats();
+};
+
+#endif // TX_SCHEDULER_H
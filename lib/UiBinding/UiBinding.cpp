@@ -0,0 +1,180 @@
+/**
+ * UiBinding Library Implementation
+ *
+ * Date: 2025
+ */
+
+#include "UiBinding.h"
+
+// Constructor
+UiBinding::UiBinding() {
+    memset(_bindings, 0, sizeof(_bindings));
+    _count = 0;
+    _loadedScreen = nullptr;
+    memset(&_stats, 0, sizeof(_stats));
+    _statsStartMs = 0;
+}
+
+int8_t UiBinding::bind(lv_obj_t** ref, UiBindingType type, uint16_t threshold, bool animate) {
+    if (ref == nullptr || _count >= UI_BINDING_MAX) {
+        return -1;
+    }
+
+    Binding& binding = _bindings[_count];
+    binding.ref = ref;
+    binding.obj = nullptr;
+    binding.screen = nullptr;
+    binding.type = type;
+    binding.format = nullptr;
+    binding.animate = animate;
+    binding.threshold = threshold;
+    binding.rendered = 0;
+    binding.value = 0;
+    binding.valid = false;
+    binding.dirty = false;
+    binding.hasValue = false;
+    return _count++;
+}
+
+int8_t UiBinding::bindLabel(lv_obj_t** ref, const char* format, uint16_t threshold) {
+    if (format == nullptr) return -1;
+
+    int8_t handle = bind(ref, UI_BIND_LABEL_INT, threshold, false);
+    if (handle >= 0) {
+        _bindings[handle].format = format;
+    }
+    return handle;
+}
+
+void UiBinding::set(int8_t handle, int32_t value) {
+    if (handle < 0 || handle >= _count) return;
+
+    Binding& binding = _bindings[handle];
+    binding.value = value;
+    binding.dirty = true;
+    binding.hasValue = true;
+    _stats.updates++;
+}
+
+// Follow the SquareLine pointer; a new widget has nothing rendered yet
+bool UiBinding::_resolve(Binding& binding) {
+    lv_obj_t* obj = *binding.ref;
+    if (obj != binding.obj) {
+        binding.obj = obj;
+        binding.screen = obj ? lv_obj_get_screen(obj) : nullptr;
+        binding.valid = false;
+    }
+    return obj != nullptr;
+}
+
+// During a screen transition both the old and the new screen are visible
+bool UiBinding::_isShown(const Binding& binding) {
+    return binding.screen == lv_scr_act() || binding.screen == lv_disp_get_scr_prev(nullptr);
+}
+
+// Rest positions and full scale must be exact, even with a threshold
+bool UiBinding::_atLimit(const Binding& binding) {
+    if (binding.type != UI_BIND_BAR_VALUE && binding.type != UI_BIND_BAR_START_VALUE) return false;
+    return binding.value <= lv_bar_get_min_value(binding.obj) ||
+           binding.value >= lv_bar_get_max_value(binding.obj);
+}
+
+void UiBinding::_push(Binding& binding, bool animate) {
+    lv_anim_enable_t anim = animate ? LV_ANIM_ON : LV_ANIM_OFF;
+    switch (binding.type) {
+        case UI_BIND_BAR_VALUE:
+            lv_bar_set_value(binding.obj, binding.value, anim);
+            break;
+        case UI_BIND_BAR_START_VALUE:
+            lv_bar_set_start_value(binding.obj, binding.value, anim);
+            break;
+        case UI_BIND_IMG_ANGLE:
+            lv_img_set_angle(binding.obj, binding.value);
+            break;
+        case UI_BIND_LABEL_INT:
+            lv_label_set_text_fmt(binding.obj, binding.format, (int)binding.value);
+            break;
+    }
+    binding.rendered = binding.value;
+    binding.valid = true;
+    _stats.pushed++;
+}
+
+void UiBinding::apply() {
+    if (_statsStartMs == 0) _statsStartMs = millis();
+
+    // A newly loaded screen shows whatever its widgets had when it was left
+    lv_obj_t* screen = lv_scr_act();
+    bool screenLoaded = screen != _loadedScreen;
+    if (screenLoaded) {
+        _loadedScreen = screen;
+        _stats.screenLoads++;
+    }
+
+    for (uint8_t i = 0; i < _count; i++) {
+        Binding& binding = _bindings[i];
+        bool dirty = binding.dirty;
+        binding.dirty = false;
+
+        if (!_resolve(binding) || !_isShown(binding)) {
+            if (dirty) _stats.offscreen++;
+            continue;
+        }
+
+        if (!binding.hasValue) continue;
+
+        // First render, or the screen was just loaded: jump straight to the value
+        if (!binding.valid || (screenLoaded && binding.screen == screen && binding.value != binding.rendered)) {
+            _push(binding, false);
+            continue;
+        }
+        if (!dirty) continue;
+
+        if (binding.value == binding.rendered) {
+            _stats.unchanged++;
+            continue;
+        }
+        if (abs(binding.value - binding.rendered) < binding.threshold && !_atLimit(binding)) {
+            _stats.belowThreshold++;
+            continue;
+        }
+        _push(binding, binding.animate);
+    }
+}
+
+void UiBinding::invalidateAll() {
+    for (uint8_t i = 0; i < _count; i++) {
+        _bindings[i].valid = false;
+    }
+    _loadedScreen = nullptr;
+}
+
+// Statistics
+UiBindingStats UiBinding::getStats() {
+    UiBindingStats stats = _stats;
+    stats.windowMs = _statsStartMs == 0 ? 0 : millis() - _statsStartMs;
+    return stats;
+}
+
+void UiBinding::resetStats() {
+    memset(&_stats, 0, sizeof(_stats));
+    _statsStartMs = millis();
+}
+
+void UiBinding::printStats() {
+    UiBindingStats stats = getStats();
+    uint32_t avoided = stats.unchanged + stats.belowThreshold + stats.offscreen;
+
+    Serial.print("UiBinding: "); Serial.print(_count); Serial.print(" widgets");
+    Serial.print("  Updates: "); Serial.print(stats.updates);
+    Serial.print("  Pushed: "); Serial.print(stats.pushed);
+    Serial.print("  Avoided: "); Serial.print(avoided);
+    Serial.print(" (same "); Serial.print(stats.unchanged);
+    Serial.print(", threshold "); Serial.print(stats.belowThreshold);
+    Serial.print(", offscreen "); Serial.print(stats.offscreen); Serial.print(")");
+    if (stats.windowMs > 0) {
+        Serial.print("  Avoided/s: "); Serial.print((uint32_t)((uint64_t)avoided * 1000 / stats.windowMs));
+        Serial.print("  Pushed/s: "); Serial.print((uint32_t)((uint64_t)stats.pushed * 1000 / stats.windowMs));
+    }
+    Serial.println();
+}
@@ -0,0 +1,101 @@
+/**
+ * UiBinding Library - Dirty-tracking binding between values and LVGL widgets
+ *
+ * The UI loop publishes values every iteration; UiBinding only calls LVGL
+ * when a value actually changed enough to be visible and the widget is on
+ * the screen being shown. Every avoided lv_bar_set_value()/lv_img_set_angle()
+ * is an avoided invalidation (and redraw + flush of its area).
+ *
+ * Features:
+ * - Bar value, bar start value, image angle and numeric label bindings
+ * - Widgets are bound through their SquareLine pointer (ui_X), so screens
+ *   that are destroyed and created again are picked up automatically
+ * - Last rendered value per widget, per-widget change threshold
+ * - Bar limits (min/max) are always rendered exactly, whatever the threshold
+ * - Widgets on screens that are not loaded are skipped and refreshed as soon
+ *   as their screen is loaded (without animation)
+ * - Counters: updates pushed and invalidations avoided, per second
+ *
+ * Date: 2025
+ */
+
+#ifndef UI_BINDING_H
+#define UI_BINDING_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+
+#define UI_BINDING_MAX 32
+
+enum UiBindingType {
+    UI_BIND_BAR_VALUE,         // lv_bar_set_value()
+    UI_BIND_BAR_START_VALUE,   // lv_bar_set_start_value() (range bars)
+    UI_BIND_IMG_ANGLE,         // lv_img_set_angle(), 0.1 degree units
+    UI_BIND_LABEL_INT          // lv_label_set_text_fmt() with one int argument
+};
+
+// Counters since the last resetStats()
+struct UiBindingStats {
+    uint32_t updates;          // set() calls
+    uint32_t pushed;           // LVGL calls made
+    uint32_t unchanged;        // Avoided: same value as rendered
+    uint32_t belowThreshold;   // Avoided: change smaller than the threshold
+    uint32_t offscreen;        // Avoided: widget not on the loaded screen
+    uint32_t screenLoads;      // Screen changes that forced a refresh
+    uint32_t windowMs;         // Time covered by the counters
+};
+
+class UiBinding {
+private:
+    struct Binding {
+        lv_obj_t** ref;        // SquareLine global (NULL while its screen does not exist)
+        lv_obj_t* obj;         // Widget the rendered value belongs to
+        lv_obj_t* screen;
+        UiBindingType type;
+        const char* format;    // Labels only (must outlive the binding)
+        bool animate;
+        uint16_t threshold;
+        int32_t rendered;
+        int32_t value;
+        bool valid;            // rendered holds what LVGL shows
+        bool dirty;            // value was set since the last apply()
+        bool hasValue;         // set() was called at least once
+    };
+
+    Binding _bindings[UI_BINDING_MAX];
+    uint8_t _count;
+    lv_obj_t* _loadedScreen;
+    UiBindingStats _stats;
+    uint32_t _statsStartMs;
+
+    bool _resolve(Binding& binding);
+    bool _isShown(const Binding& binding);
+    bool _atLimit(const Binding& binding);
+    void _push(Binding& binding, bool animate);
+
+public:
+    UiBinding();
+
+    // Register a widget by its pointer (e.g. &ui_Bar1). Returns a handle for set(), or -1 if full.
+    int8_t bind(lv_obj_t** ref, UiBindingType type, uint16_t threshold = 0, bool animate = true);
+    // Label that shows the value through a printf format with one int (e.g. "%d mV")
+    int8_t bindLabel(lv_obj_t** ref, const char* format, uint16_t threshold = 0);
+
+    // Publish the value for a widget; nothing is drawn until apply()
+    void set(int8_t handle, int32_t value);
+
+    // Push the changed values of the widgets on the loaded screen. Call once per UI loop.
+    void apply();
+
+    // Forget what was rendered (e.g. after rebuilding a screen)
+    void invalidateAll();
+
+    uint8_t getCount() { return _count; }
+
+    // Statistics
+    UiBindingStats getStats();
+    void resetStats();
+    void printStats();
+};
+
+#endif // UI_BINDING_H
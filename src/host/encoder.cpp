@@ -0,0 +1,171 @@
+/**
+ * Modo encoder: cuadratura sintética a distintas velocidades
+ *
+ * Genera en los pines simulados una secuencia de cuadratura (avance, y
+ * luego retroceso de la mitad) a cada velocidad de la lista, con el
+ * Lever::update() del lazo de control a 200 Hz, y compara:
+ * - Encoder leído por update() (sondeo de los pines, comportamiento previo)
+ * - Encoder con attachInterrupt() (en el host, el backend por interrupciones;
+ *   el PCNT solo existe en el ESP32)
+ *
+ * Para cada velocidad informa pasos esperados, contados, perdidos,
+ * transiciones inválidas y la velocidad estimada frente a la real.
+ *
+ * Uso:
+ *   program encoder [--rate flancos/s] [--cycles n] [--quiet]
+ *
+ * El código de salida es 0 si el encoder por interrupciones no pierde pasos
+ * y su velocidad estimada queda dentro del 5% cuando la ventana tiene
+ * suficientes flancos.
+ */
+
+#include "host_modes.h"
+#include <HostMock.h>
+#include <Lever.h>
+
+#define ENCODER_PIN_A 20
+#define ENCODER_PIN_B 21
+#define ENCODER_POLLED_PIN_A 22
+#define ENCODER_POLLED_PIN_B 23
+#define ENCODER_UPDATE_US 5000              // CONTROL_RATE_HZ de main.cpp
+#define ENCODER_DEFAULT_CYCLES 2000
+#define ENCODER_VELOCITY_TOLERANCE 0.05
+#define ENCODER_VELOCITY_MIN_COUNTS 100     // Flancos por ventana para exigir la tolerancia
+
+// Niveles AB de cada cuarto de ciclo, sentido positivo (A adelanta a B)
+static const uint8_t QUADRATURE_SEQUENCE[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+
+struct EncoderRun {
+    uint32_t edgesPerSecond;
+    long expectedIsr;             // 4 flancos por ciclo
+    long countedIsr;
+    long expectedPolled;          // update() solo cuenta los flancos de A
+    long countedPolled;
+    uint32_t errors;
+    int32_t velocity;             // Última estimación durante el avance
+};
+
+static Lever* makeEncoder(uint8_t pinA, uint8_t pinB) {
+    Lever* lever = new Lever(ROTARY_ENCODER, pinA, pinB);
+    lever->begin();
+    lever->setEncoderLimits(-100000000, 100000000);
+    return lever;
+}
+
+static void setPins(uint8_t step, bool attachedEncoder) {
+    const uint8_t* levels = QUADRATURE_SEQUENCE[step & 3];
+    uint8_t pinA = attachedEncoder ? ENCODER_PIN_A : ENCODER_POLLED_PIN_A;
+    uint8_t pinB = attachedEncoder ? ENCODER_PIN_B : ENCODER_POLLED_PIN_B;
+    HostMock::setDigital(pinA, levels[0] ? HIGH : LOW);
+    HostMock::setDigital(pinB, levels[1] ? HIGH : LOW);
+}
+
+static EncoderRun runRate(uint32_t edgesPerSecond, uint32_t cycles) {
+    HostMock::reset();
+    HostMock::setSerialOutput(false);
+    setPins(0, true);
+    setPins(0, false);
+
+    Lever* attached = makeEncoder(ENCODER_PIN_A, ENCODER_PIN_B);
+    attached->attachInterrupt();
+    Lever* polled = makeEncoder(ENCODER_POLLED_PIN_A, ENCODER_POLLED_PIN_B);
+
+    EncoderRun run = {};
+    run.edgesPerSecond = edgesPerSecond;
+
+    // Avance de 'cycles' ciclos y retroceso de la mitad
+    const long forwardEdges = (long)cycles * 4;
+    const long backwardEdges = forwardEdges / 2;
+    const double edgeUs = 1000000.0 / edgesPerSecond;
+    const uint64_t startUs = HostMock::nowUs();
+    uint64_t nextUpdateUs = startUs + ENCODER_UPDATE_US;
+    long step = 0;
+    long edges = 0;
+
+    while (edges < forwardEdges + backwardEdges) {
+        uint64_t edgeAtUs = startUs + (uint64_t)((edges + 1) * edgeUs);
+        if (nextUpdateUs <= edgeAtUs) {
+            HostMock::setTimeUs(nextUpdateUs);
+            attached->update();
+            polled->update();
+            if (edges < forwardEdges) run.velocity = attached->getEncoder().getVelocity();
+            nextUpdateUs += ENCODER_UPDATE_US;
+            continue;
+        }
+
+        HostMock::setTimeUs(edgeAtUs);
+        step += edges < forwardEdges ? 1 : -1;
+        // Un pin por flanco: los dos encoders ven la misma secuencia
+        setPins((uint8_t)(step & 3), true);
+        setPins((uint8_t)(step & 3), false);
+        edges++;
+    }
+    HostMock::advanceUs(ENCODER_UPDATE_US);
+    attached->update();
+    polled->update();
+
+    run.expectedIsr = forwardEdges - backwardEdges;
+    run.countedIsr = attached->readEncoderSteps();
+    run.expectedPolled = run.expectedIsr / 2;
+    run.countedPolled = polled->readEncoderSteps();
+    run.errors = attached->getEncoder().getErrorCount();
+
+    delete attached;
+    delete polled;
+    HostMock::setSerialOutput(true);
+    return run;
+}
+
+int runEncoder(int argc, char** argv) {
+    uint32_t cycles = ENCODER_DEFAULT_CYCLES;
+    uint32_t onlyRate = 0;
+    bool quiet = false;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) onlyRate = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--cycles") == 0 && i + 1 < argc) cycles = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--quiet") == 0) quiet = true;
+        else {
+            printf("encoder: opción desconocida %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (cycles == 0) cycles = ENCODER_DEFAULT_CYCLES;
+
+    static const uint32_t RATES[] = {100, 400, 1000, 5000, 20000, 100000};
+    const uint8_t rateCount = onlyRate ? 1 : sizeof(RATES) / sizeof(RATES[0]);
+
+    HostChecks checks = {0, 0};
+    if (!quiet) {
+        printf("%10s  %22s  %22s  %9s  %20s\n", "flancos/s", "interrupciones", "sondeo update()",
+               "inválidas", "velocidad (est/real)");
+    }
+    for (uint8_t i = 0; i < rateCount; i++) {
+        uint32_t rate = onlyRate ? onlyRate : RATES[i];
+        EncoderRun run = runRate(rate, cycles);
+
+        long lostIsr = run.expectedIsr - run.countedIsr;
+        long lostPolled = run.expectedPolled - run.countedPolled;
+        double velocityError = fabs((double)run.velocity - rate) / rate;
+        bool checkVelocity = (uint64_t)rate * QUADRATURE_VELOCITY_WINDOW_US / 1000000 >= ENCODER_VELOCITY_MIN_COUNTS;
+
+        if (!quiet) {
+            printf("%10u  %8ld/%-8ld p=%-4ld  %8ld/%-8ld p=%-4ld  %9u  %9d/%-9u%s\n", rate,
+                   run.countedIsr, run.expectedIsr, lostIsr, run.countedPolled, run.expectedPolled, lostPolled,
+                   run.errors, run.velocity, rate, checkVelocity ? "" : " (*)");
+        }
+
+        HOST_CHECK(checks, lostIsr == 0 && run.errors == 0, "encoder por interrupciones sin pasos perdidos");
+        if (checkVelocity) {
+            HOST_CHECK(checks, velocityError <= ENCODER_VELOCITY_TOLERANCE, "velocidad estimada dentro del 5%");
+        }
+    }
+    if (!quiet) {
+        printf("contados/esperados, p = pasos perdidos (negativo: contados de más o al revés)\n");
+        printf("(*) menos de %u flancos por ventana de %u ms: estimación no exigida\n",
+               ENCODER_VELOCITY_MIN_COUNTS, QUADRATURE_VELOCITY_WINDOW_US / 1000);
+    }
+
+    printf("encoder: %u comprobaciones correctas, %u fallos\n", checks.passed, checks.failed);
+    return checks.failed == 0 ? 0 : 1;
+}
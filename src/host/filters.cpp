@@ -0,0 +1,384 @@
+/**
+ * Modo filters: cadena de filtros en punto fijo frente al código float
+ *
+ * Compara, muestra a muestra, la cadena SignalChain que usan Joystick y
+ * Lever con una copia del procesado float anterior (map(), sqrt(), atan2(),
+ * suavizado float):
+ * - Eje de joystick sin suavizado (barrido de todo el rango del ADC)
+ * - Eje de joystick con EMA y con filtro one-euro (señal sintética con ruido)
+ * - Palanca analógica (zona muerta + suavizado + escala a ±100)
+ * - Curva expo, zona muerta circular, magnitud y ángulo
+ * - Curvas de respuesta de los canales (ResponseCurve): tabla interpolada
+ *   frente a map() (lineal, todos los topes) y frente a la curva en float
+ *
+ * Para cada caso informa ns/muestra de ambas versiones en el host (orientativo:
+ * en el ESP32-S2, sin FPU, la diferencia es mayor) y el error máximo y medio
+ * del punto fijo respecto al float.
+ *
+ * Uso:
+ *   program filters [--samples n] [--quiet]
+ *
+ * El código de salida es 0 si el escalado y la zona muerta son idénticos al
+ * código anterior y el resto de errores queda dentro de su tolerancia.
+ */
+
+#include "host_modes.h"
+#include <HostMock.h>
+#include <SignalChain.h>
+#include <ResponseCurve.h>
+#include <Joystick.h>
+#include <Lever.h>
+#include <chrono>
+
+#define FILTERS_DEFAULT_SAMPLES 200000
+#define FILTERS_RATE_HZ 200                 // CONTROL_RATE_HZ de main.cpp
+#define FILTERS_ADC_MAX 8191                // ADC de 13 bits del ESP32-S2
+
+// Calibración del joystick izquierdo del transmisor
+#define FILTERS_MIN 60
+#define FILTERS_CENTER 5520
+#define FILTERS_MAX 8180
+
+struct FilterResult {
+    const char* name;
+    double floatNs;
+    double fixedNs;
+    double maxError;
+    double meanError;
+    double tolerance;
+    const char* unit;
+};
+
+// ========== REFERENCIA FLOAT (procesado anterior) ==========
+
+static int floatAxis(float raw, float& last, bool smoothing, float factor, bool invert) {
+    float smoothed = smoothing ? (last * (1.0 - factor) + raw * factor) : raw;
+    last = smoothed;
+    int processed;
+    if (smoothed >= FILTERS_CENTER) {
+        processed = map(smoothed, FILTERS_CENTER, FILTERS_MAX, 0, 255);
+    } else {
+        processed = map(smoothed, FILTERS_MIN, FILTERS_CENTER, -255, 0);
+    }
+    if (invert) processed = -processed;
+    return constrain(processed, -255, 255);
+}
+
+static int floatLever(int raw, float& smoothedPosition, int deadZone, float factor) {
+    if (abs(raw - FILTERS_CENTER) <= deadZone) raw = FILTERS_CENTER;
+    smoothedPosition = smoothedPosition * (1.0 - factor) + raw * factor;
+    raw = (int)smoothedPosition;
+    int processed;
+    if (raw >= FILTERS_CENTER) processed = map(raw, FILTERS_CENTER, FILTERS_MAX, 0, 100);
+    else processed = map(raw, FILTERS_MIN, FILTERS_CENTER, -100, 0);
+    return constrain(processed, -100, 100);
+}
+
+struct FloatOneEuro {
+    float minCutoff, beta, rate;
+    float state, derivative;
+
+    float alpha(float cutoff) {
+        float w = 2 * PI * cutoff;
+        return w / (w + rate);
+    }
+
+    int process(float x) {
+        derivative += alpha(1.0) * ((x - state) * rate - derivative);
+        state += alpha(minCutoff + beta * fabs(derivative)) * (x - state);
+        return (int)state;
+    }
+};
+
+static int floatExpo(int x, float expo) {
+    float v = x / 255.0;
+    return (int)(255 * ((1 - expo) * v + expo * v * v * v));
+}
+
+// ========== MEDIDA ==========
+
+typedef std::chrono::steady_clock FiltersClock;
+static volatile int32_t sink;
+
+static double elapsedNs(FiltersClock::time_point start, uint32_t samples) {
+    return std::chrono::duration<double, std::nano>(FiltersClock::now() - start).count() / samples;
+}
+
+// Entrada sintética: barridos lentos y rápidos sobre el rango calibrado, con ruido de ADC
+static void makeSignal(int32_t* input, uint32_t samples) {
+    for (uint32_t i = 0; i < samples; i++) {
+        double t = (double)i / FILTERS_RATE_HZ;
+        double position = 0.7 * sin(2 * PI * 0.3 * t) + 0.3 * sin(2 * PI * 3.1 * t);
+        int32_t noise = random(-12, 13);
+        int32_t value = position >= 0 ? FILTERS_CENTER + (int32_t)(position * (FILTERS_MAX - FILTERS_CENTER))
+                                      : FILTERS_CENTER + (int32_t)(position * (FILTERS_CENTER - FILTERS_MIN));
+        input[i] = constrain(value + noise, 0, FILTERS_ADC_MAX);
+    }
+}
+
+static void accumulate(FilterResult& result, double error, uint32_t samples) {
+    error = fabs(error);
+    if (error > result.maxError) result.maxError = error;
+    result.meanError += error / samples;
+}
+
+static FilterResult benchAxis(const char* name, const int32_t* input, uint32_t samples, int mode) {
+    FilterResult result = {name, 0, 0, 0, 0, mode == 0 ? 0.0 : 1.0, "LSB"};
+    const float factor = 0.2;
+    int32_t* expected = new int32_t[samples];
+
+    JoystickAxisChain chain;
+    chain.stage<ScaleStage>().configure(FILTERS_MIN, FILTERS_CENTER, FILTERS_MAX, 255, false);
+    chain.stage<ClampStage>().setRange(-255, 255);
+    FloatOneEuro euro = {1.0, 0.002, FILTERS_RATE_HZ, FILTERS_CENTER, 0};
+    if (mode == 1) chain.stage<SmoothingStage>().setAlpha(signalQ16(factor));
+    if (mode == 2) chain.stage<SmoothingStage>().setOneEuro(euro.minCutoff, euro.beta, FILTERS_RATE_HZ);
+    chain.reset(FILTERS_CENTER);
+
+    float last = FILTERS_CENTER;
+    FiltersClock::time_point start = FiltersClock::now();
+    for (uint32_t i = 0; i < samples; i++) {
+        if (mode == 2) {
+            float v = euro.process(input[i]);
+            expected[i] = floatAxis(v, last, false, 0, false);
+        } else {
+            expected[i] = floatAxis(input[i], last, mode == 1, factor, false);
+        }
+    }
+    result.floatNs = elapsedNs(start, samples);
+
+    start = FiltersClock::now();
+    int32_t sum = 0;
+    for (uint32_t i = 0; i < samples; i++) sum += chain.process(input[i]);
+    result.fixedNs = elapsedNs(start, samples);
+    sink = sum;
+
+    chain.reset(FILTERS_CENTER);
+    for (uint32_t i = 0; i < samples; i++) accumulate(result, chain.process(input[i]) - expected[i], samples);
+    delete[] expected;
+    return result;
+}
+
+static FilterResult benchLever(const int32_t* input, uint32_t samples) {
+    FilterResult result = {"palanca analógica (EMA 0.2)", 0, 0, 0, 0, 1.0, "LSB"};
+    const int deadZone = 50;
+    const float factor = 0.2;
+    int32_t* expected = new int32_t[samples];
+
+    LeverChain chain;
+    chain.stage<DeadZoneStage>().setDeadZone(FILTERS_CENTER, deadZone);
+    chain.stage<SmoothingStage>().setAlpha(signalQ16(factor));
+    chain.stage<ScaleStage>().configure(FILTERS_MIN, FILTERS_CENTER, FILTERS_MAX, 100, false);
+    chain.stage<ClampStage>().setRange(-100, 100);
+    chain.reset(FILTERS_CENTER);
+
+    float smoothed = FILTERS_CENTER;
+    FiltersClock::time_point start = FiltersClock::now();
+    for (uint32_t i = 0; i < samples; i++) expected[i] = floatLever(input[i], smoothed, deadZone, factor);
+    result.floatNs = elapsedNs(start, samples);
+
+    start = FiltersClock::now();
+    int32_t sum = 0;
+    for (uint32_t i = 0; i < samples; i++) sum += chain.process(input[i]);
+    result.fixedNs = elapsedNs(start, samples);
+    sink = sum;
+
+    chain.reset(FILTERS_CENTER);
+    for (uint32_t i = 0; i < samples; i++) accumulate(result, chain.process(input[i]) - expected[i], samples);
+    delete[] expected;
+    return result;
+}
+
+static FilterResult benchExpo() {
+    FilterResult result = {"expo 40% (±255)", 0, 0, 0, 0, 1.0, "LSB"};
+    const uint32_t samples = 511 * 200;
+    ExpoStage expo;
+    expo.setExpo(40, 255);
+
+    FiltersClock::time_point start = FiltersClock::now();
+    int32_t sum = 0;
+    for (uint32_t i = 0; i < samples; i++) sum += floatExpo((int)(i % 511) - 255, 0.4);
+    result.floatNs = elapsedNs(start, samples);
+    sink = sum;
+
+    start = FiltersClock::now();
+    sum = 0;
+    for (uint32_t i = 0; i < samples; i++) sum += expo.process((int32_t)(i % 511) - 255);
+    result.fixedNs = elapsedNs(start, samples);
+    sink = sum;
+
+    for (int32_t x = -255; x <= 255; x++) accumulate(result, expo.process(x) - floatExpo(x, 0.4), 511);
+    return result;
+}
+
+// Rejilla de desviaciones respecto al centro, radio 100 como en el transmisor
+static FilterResult benchDeadZone() {
+    FilterResult result = {"zona muerta circular", 0, 0, 0, 0, 0.0, "difer."};
+    const int radius = 100;
+    const int span = 400;
+    const uint32_t samples = (2 * span + 1) * (2 * span + 1);
+
+    FiltersClock::time_point start = FiltersClock::now();
+    int32_t sum = 0;
+    for (int dx = -span; dx <= span; dx++) {
+        for (int dy = -span; dy <= span; dy++) sum += sqrt(dx * dx + dy * dy) <= radius;
+    }
+    result.floatNs = elapsedNs(start, samples);
+    sink = sum;
+
+    start = FiltersClock::now();
+    sum = 0;
+    for (int dx = -span; dx <= span; dx++) {
+        for (int dy = -span; dy <= span; dy++) sum += signalInCircle(dx, dy, radius);
+    }
+    result.fixedNs = elapsedNs(start, samples);
+    sink = sum;
+
+    for (int dx = -span; dx <= span; dx++) {
+        for (int dy = -span; dy <= span; dy++) {
+            bool expected = sqrt(dx * dx + dy * dy) <= radius;
+            if (expected != signalInCircle(dx, dy, radius)) result.maxError = 1;
+        }
+    }
+    return result;
+}
+
+// Todo el cuadrado de salidas ±255 (angle = true: ángulo, false: magnitud)
+static FilterResult benchPolar(bool angle) {
+    FilterResult result = {angle ? "ángulo (atan2)" : "magnitud (sqrt)", 0, 0, 0, 0, angle ? 0.002 : 0.01,
+                           angle ? "rad" : "[0-1.41]"};
+    const uint32_t samples = 511 * 511;
+
+    FiltersClock::time_point start = FiltersClock::now();
+    float total = 0;
+    for (int x = -255; x <= 255; x++) {
+        for (int y = -255; y <= 255; y++) {
+            float fx = x / 255.0, fy = y / 255.0;
+            total += angle ? atan2(fy, fx) : sqrt(fx * fx + fy * fy);
+        }
+    }
+    result.floatNs = elapsedNs(start, samples);
+    sink = (int32_t)total;
+
+    start = FiltersClock::now();
+    int32_t sum = 0;
+    for (int x = -255; x <= 255; x++) {
+        for (int y = -255; y <= 255; y++) {
+            sum += angle ? signalAtan2(y, x) : (int32_t)signalSqrt((uint32_t)(x * x + y * y) << 14);
+        }
+    }
+    result.fixedNs = elapsedNs(start, samples);
+    sink = sum;
+
+    for (int x = -255; x <= 255; x++) {
+        for (int y = -255; y <= 255; y++) {
+            double expected = angle ? atan2((double)y, (double)x) : sqrt((double)(x * x + y * y)) / 255;
+            double fixed = angle ? signalAtan2(y, x) / 32768.0
+                                 : signalSqrt((uint32_t)(x * x + y * y) << 14) / (255.0 * 128);
+            // -pi y pi son el mismo ángulo
+            double error = fabs(fixed - expected);
+            if (angle && error > PI) error = 2 * PI - error;
+            accumulate(result, error, samples);
+        }
+    }
+    return result;
+}
+
+// Curva en float, como se evaluaría en cada ciclo sin tabla
+static int floatCurve(uint8_t type, float amount, int input) {
+    float x = input / 255.0f;
+    float y = type == CURVE_EXPO ? (1 - amount) * x + amount * x * x * x
+                                 : (1 - amount) * x + amount * x * x * (3 - 2 * x);
+    return (int)(y * 255 + 0.5f);
+}
+
+// Lineal: apply() frente a map() con todos los topes. Expo / S: lookup() frente a float.
+static FilterResult benchCurve(uint8_t type) {
+    static const char* const NAMES[] = {"curva lineal vs map()", "curva expo 50%", "curva S 50%"};
+    FilterResult result = {NAMES[type < CURVE_POINTS ? type : 0], 0, 0, 0, 0, type == CURVE_LINEAR ? 0.0 : 1.0,
+                           "LSB"};
+    ResponseCurveConfig config;
+    ResponseCurve::defaultConfig(config);
+    config.type = type;
+    config.amount = 50;
+    ResponseCurve curve;
+    curve.build(config);
+    const uint32_t samples = 256 * 256;
+
+    FiltersClock::time_point start = FiltersClock::now();
+    int32_t sum = 0;
+    for (uint32_t i = 0; i < samples; i++) {
+        sum += type == CURVE_LINEAR ? map(i & 255, 0, 255, 0, i >> 8) : floatCurve(type, 0.5f, i & 255);
+    }
+    result.floatNs = elapsedNs(start, samples);
+    sink = sum;
+
+    start = FiltersClock::now();
+    sum = 0;
+    for (uint32_t i = 0; i < samples; i++) {
+        sum += type == CURVE_LINEAR ? curve.apply(i & 255, i >> 8) : curve.lookup(i & 255);
+    }
+    result.fixedNs = elapsedNs(start, samples);
+    sink = sum;
+
+    for (uint32_t i = 0; i < samples; i++) {
+        int input = i & 255;
+        double error = type == CURVE_LINEAR ? curve.apply(input, i >> 8) - map(input, 0, 255, 0, i >> 8)
+                                            : curve.lookup(input) - floatCurve(type, 0.5f, input);
+        accumulate(result, error, samples);
+    }
+    return result;
+}
+
+int runFilters(int argc, char** argv) {
+    uint32_t samples = FILTERS_DEFAULT_SAMPLES;
+    bool quiet = false;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) samples = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--quiet") == 0) quiet = true;
+        else {
+            printf("filters: opción desconocida %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (samples == 0) samples = FILTERS_DEFAULT_SAMPLES;
+
+    // Barrido completo del ADC repetido, y señal sintética
+    int32_t* sweep = new int32_t[samples];
+    for (uint32_t i = 0; i < samples; i++) sweep[i] = i % (FILTERS_ADC_MAX + 1);
+    int32_t* signal = new int32_t[samples];
+    makeSignal(signal, samples);
+
+    FilterResult results[] = {
+        benchAxis("eje joystick (sin suavizado)", sweep, samples, 0),
+        benchAxis("eje joystick (EMA 0.2)", signal, samples, 1),
+        benchAxis("eje joystick (one-euro)", signal, samples, 2),
+        benchLever(signal, samples),
+        benchExpo(),
+        benchDeadZone(),
+        benchPolar(false),
+        benchPolar(true),
+        benchCurve(CURVE_LINEAR),
+        benchCurve(CURVE_EXPO),
+        benchCurve(CURVE_SCURVE),
+    };
+    delete[] sweep;
+    delete[] signal;
+
+    HostChecks checks = {0, 0};
+    if (!quiet) {
+        printf("%-30s  %10s  %10s  %12s  %12s\n", "caso", "float ns", "fijo ns", "error máx", "error medio");
+    }
+    for (uint8_t i = 0; i < sizeof(results) / sizeof(results[0]); i++) {
+        const FilterResult& r = results[i];
+        if (!quiet) {
+            printf("%-30s  %10.1f  %10.1f  %12.4f  %12.4f  %s\n", r.name, r.floatNs, r.fixedNs, r.maxError,
+                   r.meanError, r.unit);
+        }
+        HOST_CHECK(checks, r.maxError <= r.tolerance, r.name);
+    }
+
+    printf("filters: %u comprobaciones correctas, %u fallos\n", checks.passed, checks.failed);
+    return checks.failed == 0 ? 0 : 1;
+}
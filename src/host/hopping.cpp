@@ -0,0 +1,362 @@
+/**
+ * Modo hopping: salto de frecuencia con interferencia por canal
+ *
+ * Simula el enlace de main.cpp (TxScheduler + RadioTx a 200 Hz, sin ACK)
+ * con un receptor como test/receptor_beta.cpp que lee la radio cada 250 us,
+ * con interferencia inyectada por canal (por defecto dos redes WiFi en los
+ * canales 1 y 6: canales NRF 1-23 y 26-48 al 60%). Compara:
+ * - Canal fijo (por defecto el 40, dentro de la segunda red)
+ * - Salto de frecuencia sin lista negra (survey desactivado)
+ * - Salto de frecuencia con lista negra (como RADIO_HOPPING en main.cpp)
+ *
+ * Cada escenario pasa por cuatro fases: sticks en movimiento, un corte del
+ * enlace de 1 s (el receptor pierde el sincronismo) en movimiento, la
+ * recuperación y sticks en reposo (latido). Informa paquetes recibidos frente
+ * a enviados por fase, tiempo hasta el primer paquete tras el corte, hueco
+ * máximo entre paquetes en reposo y la lista negra final. El reloj del
+ * receptor puede derivar respecto al del transmisor (--drift, ppm).
+ *
+ * Uso:
+ *   program hopping [--seconds n] [--jam desde hasta %]... [--channel c]
+ *                   [--drift ppm] [--quiet]
+ *
+ * El código de salida es 0 si el salto con lista negra entrega más que el
+ * canal fijo (si tiene interferencia) y que el salto sin ella, solo pone en la lista negra canales con
+ * interferencia y el receptor se recupera del corte antes de su failsafe.
+ */
+
+#include "host_modes.h"
+#include <HostMock.h>
+#include <TxScheduler.h>
+#include <RadioTx.h>
+#include <FrequencyHop.h>
+#include <HopTransmitter.h>
+
+#define HOPPING_TICK_US 5000                // CONTROL_RATE_HZ de main.cpp
+#define HOPPING_RX_POLL_US 250              // Vuelta del loop() del receptor
+#define HOPPING_DEFAULT_SECONDS 3           // Duración de cada fase
+#define HOPPING_BLACKOUT_US 1000000UL       // Corte del enlace: más de HOP_LOST_CYCLES ciclos
+#define HOPPING_FAILSAFE_US 1000000UL       // Failsafe de test/receptor_beta.cpp
+#define HOPPING_DEFAULT_CHANNEL 40
+#define HOPPING_DEFAULT_DRIFT_PPM 2000      // Resonador cerámico del Nano (0,2%)
+#define HOPPING_MAX_JAM 8
+#define HOPPING_MIN_DELIVERY 0.85           // Salto con lista negra, recuperación (lista ya formada)
+
+// main.cpp
+#define HOPPING_TX_HEARTBEAT_US 100000UL
+#define HOPPING_TX_FAILSAFE_US 250000UL
+#define HOPPING_TX_HOLD_US 200000UL
+
+static const uint64_t HOPPING_ADDRESS = 0xE8E8F0F0E1LL;
+
+struct HoppingJam {
+    uint8_t from;
+    uint8_t to;
+    uint8_t percent;
+};
+
+enum HoppingPhase {
+    PHASE_ACTIVE,
+    PHASE_BLACKOUT,
+    PHASE_RECOVERY,
+    PHASE_IDLE,
+    PHASE_COUNT
+};
+
+static const char* const PHASE_NAMES[PHASE_COUNT] = {"movimiento", "corte", "recuperación", "reposo"};
+
+struct HoppingScenario {
+    const char* name;
+    bool hopping;
+    bool blacklist;
+};
+
+struct HoppingRun {
+    uint32_t sent[PHASE_COUNT];         // Paquetes que salieron al aire
+    uint32_t received[PHASE_COUNT];
+    uint32_t resyncUs;                  // Fin del corte -> primer paquete recibido
+    uint32_t maxIdleGapUs;              // Hueco máximo entre paquetes en reposo
+    uint16_t blacklist;
+    bool blacklistClean;                // Solo canales con interferencia en la lista negra
+    bool synced;
+    uint32_t syncs;
+    uint32_t lostSyncs;
+    uint32_t surveys;
+    uint32_t maxSurveyUs;
+};
+
+struct HoppingContext {
+    HoppingRun* run;
+    HoppingPhase phase;
+};
+
+static void countSent(const RadioTxResult& result, void* context) {
+    HoppingContext* hopping = (HoppingContext*)context;
+    if (result.status == RADIO_TX_SENT) hopping->run->sent[hopping->phase]++;
+}
+
+static HoppingPhase phaseAt(uint64_t t, uint64_t phaseUs) {
+    if (t < phaseUs) return PHASE_ACTIVE;
+    if (t < phaseUs + HOPPING_BLACKOUT_US) return PHASE_BLACKOUT;
+    if (t < 2 * phaseUs) return PHASE_RECOVERY;
+    return PHASE_IDLE;
+}
+
+static HoppingRun runScenario(const HoppingScenario& scenario, const HoppingJam* jams, uint8_t jamCount,
+                              uint8_t fixedChannel, int32_t driftPpm, uint64_t phaseUs) {
+    HostMock::reset();
+    HostMock::setSerialOutput(false);
+    for (uint8_t i = 0; i < jamCount; i++) {
+        for (uint16_t channel = jams[i].from; channel <= jams[i].to; channel++) {
+            HostMock::setChannelInterference(channel, jams[i].percent);
+        }
+    }
+
+    HoppingRun run = {};
+    HoppingContext context = {&run, PHASE_ACTIVE};
+
+    RF24 radio(6, 7);
+    RF24 receiver(16, 17);
+    RF24* radios[] = {&radio, &receiver};
+    for (RF24* r : radios) {
+        r->begin();
+        r->setAutoAck(false);
+        r->setDataRate(RF24_250KBPS);
+        r->setChannel(fixedChannel);
+    }
+    radio.openWritingPipe(HOPPING_ADDRESS);
+    radio.stopListening();
+    receiver.openReadingPipe(1, HOPPING_ADDRESS);
+    receiver.startListening();
+
+    TxScheduler scheduler;
+    scheduler.setIntervals(HOPPING_TICK_US, HOPPING_TX_HEARTBEAT_US, HOPPING_TX_FAILSAFE_US);
+    scheduler.setHoldTime(HOPPING_TX_HOLD_US);
+    RadioTx tx;
+    tx.begin(&radio);
+    tx.setDepth(1);
+    tx.onComplete(countSent, &context);
+
+    // Reloj del receptor: deriva driftPpm respecto al del transmisor
+    const uint64_t startUs = HostMock::nowUs();
+    HopTransmitter hop;
+    HopReceiver hopReceiver;
+    if (scenario.hopping) {
+        hop.begin(&radio, HOPPING_ADDRESS, (uint32_t)startUs);
+        if (!scenario.blacklist) hop.setSurveyInterval(0);
+        hopReceiver.begin(&receiver, HOPPING_ADDRESS, (uint32_t)startUs);
+    }
+
+    uint8_t payload[7] = {};
+    uint32_t tick = 0;
+    uint64_t lastReceivedUs = startUs;
+    bool waitingResync = false;
+    const uint64_t endUs = startUs + 3 * phaseUs;
+
+    for (uint64_t t = startUs; t < endUs; t += HOPPING_RX_POLL_US) {
+        // survey() avanza el reloj simulado: nunca hacia atrás
+        if (HostMock::nowUs() < t) HostMock::advanceUs(t - HostMock::nowUs());
+        uint64_t elapsed = t - startUs;
+        HoppingPhase phase = phaseAt(elapsed, phaseUs);
+        if (phase != context.phase) {
+            HostMock::setRadioLoss(phase == PHASE_BLACKOUT ? 100 : 0);
+            if (phase == PHASE_RECOVERY) waitingResync = true;
+            if (phase == PHASE_IDLE) lastReceivedUs = t;
+            context.phase = phase;
+        }
+
+        // Transmisor: ciclo de control de main.cpp
+        if (elapsed % HOPPING_TICK_US == 0) {
+            uint32_t now = micros();
+            if (phase != PHASE_IDLE) payload[0] = (uint8_t)tick;   // Sticks en movimiento
+            tick++;
+
+            tx.poll(now);
+            if (scenario.hopping && hop.isHopDue(now)) {
+                tx.flush(now);
+                hop.hop(now);
+                if (hop.isSyncSlot()) scheduler.forceSend();
+            }
+            if (scenario.hopping && tx.isIdle()) {
+                hop.survey(now);
+            }
+            if (scheduler.poll(payload, sizeof(payload), now)) {
+                uint8_t frame[sizeof(payload) + HOP_TRAILER_SIZE];
+                uint8_t length = sizeof(payload);
+                memcpy(frame, payload, length);
+                if (scenario.hopping) length += hop.writeTrailer(frame + length, micros());
+                tx.submit(frame, length, now);
+            }
+        }
+
+        // Receptor: loop() de test/receptor_beta.cpp con su propio reloj
+        uint64_t nowUs = HostMock::nowUs();
+        uint32_t rxUs = (uint32_t)(nowUs + (int64_t)(nowUs - startUs) * driftPpm / 1000000);
+        while (receiver.available()) {
+            uint8_t frame[sizeof(payload) + HOP_TRAILER_SIZE];
+            receiver.read(frame, sizeof(frame));
+            if (scenario.hopping && !hopReceiver.onPacket(frame + sizeof(payload), rxUs)) continue;
+
+            run.received[phase]++;
+            if (waitingResync) {
+                run.resyncUs = nowUs - (startUs + phaseUs + HOPPING_BLACKOUT_US);
+                waitingResync = false;
+            }
+            if (phase == PHASE_IDLE && nowUs - lastReceivedUs > run.maxIdleGapUs) {
+                run.maxIdleGapUs = nowUs - lastReceivedUs;
+            }
+            lastReceivedUs = nowUs;
+        }
+        if (scenario.hopping) hopReceiver.update(rxUs);
+    }
+    if (waitingResync) run.resyncUs = 2 * phaseUs;
+    if (endUs - lastReceivedUs > run.maxIdleGapUs) run.maxIdleGapUs = endUs - lastReceivedUs;
+
+    if (scenario.hopping) {
+        HopTransmitterStats stats = hop.getStats();
+        run.blacklist = stats.blacklist;
+        run.surveys = stats.surveys;
+        run.maxSurveyUs = stats.maxSurveyUs;
+        run.synced = hopReceiver.isSynced();
+        run.syncs = hopReceiver.getSyncs();
+        run.lostSyncs = hopReceiver.getLostSyncs();
+    } else {
+        run.synced = true;
+    }
+    run.blacklistClean = true;
+    for (uint8_t slot = 0; slot < HOP_SLOTS; slot++) {
+        if (!(run.blacklist & (1U << slot))) continue;
+        uint8_t channel = hop.getSequence().getBaseChannel(slot);
+        bool jammed = false;
+        for (uint8_t i = 0; i < jamCount; i++) {
+            if (channel >= jams[i].from && channel <= jams[i].to && jams[i].percent > 0) jammed = true;
+        }
+        if (!jammed) run.blacklistClean = false;
+    }
+
+    HostMock::setRadioLoss(0);
+    HostMock::setSerialOutput(true);
+    return run;
+}
+
+static double delivery(const HoppingRun& run, HoppingPhase phase) {
+    return run.sent[phase] ? (double)run.received[phase] / run.sent[phase] : 0;
+}
+
+// Fases con los sticks en movimiento fuera del corte
+static double activeDelivery(const HoppingRun& run) {
+    uint32_t sent = run.sent[PHASE_ACTIVE] + run.sent[PHASE_RECOVERY];
+    uint32_t received = run.received[PHASE_ACTIVE] + run.received[PHASE_RECOVERY];
+    return sent ? (double)received / sent : 0;
+}
+
+int runHopping(int argc, char** argv) {
+    uint32_t seconds = HOPPING_DEFAULT_SECONDS;
+    uint8_t fixedChannel = HOPPING_DEFAULT_CHANNEL;
+    int32_t driftPpm = HOPPING_DEFAULT_DRIFT_PPM;
+    HoppingJam jams[HOPPING_MAX_JAM];
+    uint8_t jamCount = 0;
+    bool quiet = false;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) seconds = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--channel") == 0 && i + 1 < argc) fixedChannel = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--drift") == 0 && i + 1 < argc) driftPpm = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--jam") == 0 && i + 3 < argc && jamCount < HOPPING_MAX_JAM) {
+            HoppingJam& jam = jams[jamCount++];
+            jam.from = atoi(argv[++i]);
+            jam.to = atoi(argv[++i]);
+            jam.percent = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--quiet") == 0) quiet = true;
+        else {
+            printf("hopping: opción desconocida %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (seconds < 2) seconds = 2;
+    if (fixedChannel > 125) fixedChannel = 125;
+    if (jamCount == 0) {
+        // Redes WiFi en los canales 1 (2412 MHz) y 6 (2437 MHz), 22 MHz de ancho
+        jams[jamCount++] = {1, 23, 60};
+        jams[jamCount++] = {26, 48, 60};
+    }
+
+    char fixedName[24];
+    snprintf(fixedName, sizeof(fixedName), "canal fijo %u", fixedChannel);
+    const HoppingScenario scenarios[] = {
+        {fixedName, false, false},
+        {"salto sin lista negra", true, false},
+        {"salto con lista negra", true, true},
+    };
+    const uint8_t scenarioCount = sizeof(scenarios) / sizeof(scenarios[0]);
+    HoppingRun runs[scenarioCount];
+
+    HostChecks checks = {0, 0};
+    if (!quiet) {
+        printf("Interferencia:");
+        for (uint8_t i = 0; i < jamCount; i++) {
+            printf(" %u-%u al %u%%", jams[i].from, jams[i].to, jams[i].percent);
+        }
+        printf("  Fases de %u s, deriva del receptor %d ppm\n", seconds, driftPpm);
+        printf("%-22s", "escenario");
+        for (uint8_t phase = 0; phase < PHASE_COUNT; phase++) {
+            if (phase != PHASE_BLACKOUT) printf("  %18s", PHASE_NAMES[phase]);
+        }
+        printf("  %8s  %9s  %s\n", "resinc", "hueco máx", "lista negra");
+    }
+    for (uint8_t i = 0; i < scenarioCount; i++) {
+        HoppingRun& run = runs[i];
+        run = runScenario(scenarios[i], jams, jamCount, fixedChannel, driftPpm, (uint64_t)seconds * 1000000);
+
+        if (!quiet) {
+            printf("%-22s", scenarios[i].name);
+            for (uint8_t phase = 0; phase < PHASE_COUNT; phase++) {
+                if (phase == PHASE_BLACKOUT) continue;
+                printf("  %5.1f%% %5u/%-5u", delivery(run, (HoppingPhase)phase) * 100,
+                       run.received[phase], run.sent[phase]);
+            }
+            printf("  %5u ms  %6u ms  ", run.resyncUs / 1000, run.maxIdleGapUs / 1000);
+            if (!scenarios[i].hopping) {
+                printf("-\n");
+                continue;
+            }
+            uint8_t blacklisted = 0;
+            for (uint8_t slot = 0; slot < HOP_SLOTS; slot++) {
+                if (run.blacklist & (1U << slot)) blacklisted++;
+            }
+            printf("%u/%u (sincronismos %u, perdidos %u, survey máx %u us)\n", blacklisted, HOP_SLOTS,
+                   run.syncs, run.lostSyncs, run.maxSurveyUs);
+        }
+
+        HOST_CHECK(checks, run.synced, "receptor sincronizado al terminar");
+        HOST_CHECK(checks, run.received[PHASE_BLACKOUT] == 0, "nada recibido durante el corte");
+    }
+
+    const HoppingRun& fixed = runs[0];
+    const HoppingRun& plain = runs[1];
+    const HoppingRun& blacklist = runs[2];
+    bool fixedJammed = false;
+    for (uint8_t i = 0; i < jamCount; i++) {
+        if (fixedChannel >= jams[i].from && fixedChannel <= jams[i].to && jams[i].percent > 0) fixedJammed = true;
+    }
+    if (fixedJammed) {
+        HOST_CHECK(checks, activeDelivery(blacklist) > activeDelivery(fixed),
+                   "salto con lista negra entrega más que el canal fijo con interferencia");
+    }
+    HOST_CHECK(checks, activeDelivery(blacklist) > activeDelivery(plain), "la lista negra mejora el salto");
+    HOST_CHECK(checks, delivery(blacklist, PHASE_RECOVERY) >= HOPPING_MIN_DELIVERY,
+               "salto con la lista negra formada entrega el 85% en movimiento");
+    HOST_CHECK(checks, blacklist.blacklist != 0 && blacklist.blacklistClean, "lista negra solo con canales con interferencia");
+    HOST_CHECK(checks, plain.blacklist == 0, "sin survey no hay lista negra");
+    HOST_CHECK(checks, blacklist.lostSyncs >= 1 && blacklist.resyncUs < HOPPING_FAILSAFE_US,
+               "resincronismo tras el corte antes del failsafe del receptor");
+    HOST_CHECK(checks, blacklist.maxIdleGapUs < HOPPING_FAILSAFE_US, "en reposo el latido llega antes del failsafe");
+
+    if (!quiet) {
+        printf("recibidos/enviados por fase; resinc = fin del corte -> primer paquete recibido\n");
+    }
+
+    printf("hopping: %u comprobaciones correctas, %u fallos\n", checks.passed, checks.failed);
+    return checks.failed == 0 ? 0 : 1;
+}
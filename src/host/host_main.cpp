@@ -0,0 +1,63 @@
+/**
+ * Ejecutable de host (env:native)
+ *
+ * Compila las librerías de lib/ contra los mocks de HostMocks y las ejecuta
+ * en Linux, sin placa. Es la base para simulaciones y benchmarks.
+ *
+ * Uso:
+ *   pio run -e native
+ *   .pio/build/native/program [modo]
+ *
+ * Modos:
+ *   smoke   Ejercita cada librería contra los mocks (por defecto)
+ *   replay  Reproduce una traza de entradas sobre el lazo de control
+ *   encoder Cuadratura sintética a distintas velocidades (pasos perdidos)
+ *   filters Cadena de filtros en punto fijo frente al float (ns y error)
+ *   hopping Salto de frecuencia frente a canal fijo con interferencia por canal
+ *   persist Parada del loop al guardar la configuración (en el loop o en su tarea)
+ *
+ * El código de salida es 0 si todas las comprobaciones pasan.
+ */
+
+#include <Arduino.h>
+#include <HostMock.h>
+#include "host_modes.h"
+
+struct HostMode {
+    const char* name;
+    const char* description;
+    int (*run)(int argc, char** argv);
+};
+
+static const HostMode modes[] = {
+    {"smoke", "Ejercita cada librería contra los mocks", runSmoke},
+    {"replay", "Reproduce una traza de entradas sobre el lazo de control", runReplay},
+    {"encoder", "Cuadratura sintética a distintas velocidades", runEncoder},
+    {"filters", "Cadena de filtros en punto fijo frente al float", runFilters},
+    {"hopping", "Salto de frecuencia frente a canal fijo con interferencia", runHopping},
+    {"persist", "Parada del loop al guardar la configuración", runPersist},
+};
+
+static const uint8_t MODE_COUNT = sizeof(modes) / sizeof(modes[0]);
+
+static void printUsage(const char* program) {
+    printf("Uso: %s [modo] [opciones]\n\nModos:\n", program);
+    for (uint8_t i = 0; i < MODE_COUNT; i++) {
+        printf("  %-8s %s\n", modes[i].name, modes[i].description);
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* mode = argc > 1 ? argv[1] : "smoke";
+
+    for (uint8_t i = 0; i < MODE_COUNT; i++) {
+        if (strcmp(mode, modes[i].name) == 0) {
+            HostMock::reset();
+            // Los argumentos del modo empiezan después de su nombre
+            return modes[i].run(argc > 1 ? argc - 2 : 0, argc > 1 ? argv + 2 : argv + argc);
+        }
+    }
+
+    printUsage(argv[0]);
+    return 2;
+}
@@ -0,0 +1,47 @@
+/**
+ * Modos del ejecutable de host (env:native)
+ *
+ * Cada modo recibe los argumentos que siguen a su nombre y devuelve el
+ * código de salida del proceso.
+ */
+
+#ifndef HOST_MODES_H
+#define HOST_MODES_H
+
+#include <Arduino.h>
+
+// Comprobación rápida de cada librería contra los mocks
+int runSmoke(int argc, char** argv);
+
+// Simulador determinista del lazo de control a partir de una traza
+int runReplay(int argc, char** argv);
+
+// Encoder de cuadratura con flancos sintéticos a distintas velocidades
+int runEncoder(int argc, char** argv);
+
+// Cadena de filtros en punto fijo frente al procesado float: ns/muestra y error
+int runFilters(int argc, char** argv);
+
+// Salto de frecuencia frente a canal fijo con interferencia por canal
+int runHopping(int argc, char** argv);
+
+// Parada del loop() de la UI al guardar la configuración: en el loop frente a la tarea de escritura
+int runPersist(int argc, char** argv);
+
+// Contador de comprobaciones compartido por los modos
+struct HostChecks {
+    uint32_t passed;
+    uint32_t failed;
+};
+
+#define HOST_CHECK(checks, condition, label)                  \
+    do {                                                       \
+        if (condition) {                                       \
+            (checks).passed++;                                 \
+        } else {                                               \
+            (checks).failed++;                                 \
+            printf("  FALLO: %s (%s:%d)\n", label, __FILE__, __LINE__); \
+        }                                                      \
+    } while (0)
+
+#endif // HOST_MODES_H
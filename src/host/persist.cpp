@@ -0,0 +1,189 @@
+/**
+ * Modo persist: cuánto se detiene el loop() de la UI al guardar la configuración
+ *
+ * Simula el loop() de main.cpp (una vuelta de lv_timer_handler() cada
+ * PERSIST_LOOP_US) con la forma de usar ConfigStorage de ui_events.c:
+ * arrastres de slider que guardan en cada evento y cambios de perfil. Cada
+ * escritura en flash tarda --write-us de reloj virtual (NVS a 80 MHz: unos
+ * milisegundos por clave). Compara:
+ * - Guardado inmediato en el loop (commit sin retraso, como antes de la caché)
+ * - Guardado diferido en el loop (poll() sin tarea de escritura)
+ * - Tarea de escritura (startWriter(), como main.cpp): la simulación ejecuta
+ *   la tarea entre vueltas del loop, fuera del tiempo medido
+ *
+ * Informa por escenario la vuelta del loop más larga por culpa de
+ * ConfigStorage (guardar, cambiar de perfil, poll()), la media, las
+ * escrituras en flash y la latencia máxima hasta que un cambio está en flash.
+ *
+ * Uso:
+ *   program persist [--seconds n] [--write-us us] [--quiet]
+ *
+ * El código de salida es 0 si con la tarea de escritura el loop se detiene
+ * menos que escribiendo en él y los tres escenarios dejan en flash lo mismo
+ * que hay en RAM.
+ */
+
+#include "host_modes.h"
+#include <HostMock.h>
+#include <ConfigStorage.h>
+
+#define PERSIST_LOOP_US 5000                // Vuelta de lv_timer_handler() con la pantalla quieta
+#define PERSIST_DEFAULT_SECONDS 30
+#define PERSIST_DEFAULT_WRITE_US 3000       // Una clave de Preferences en flash
+#define PERSIST_DRAG_EVERY_US 3000000UL     // Un arrastre de slider cada 3 s (más que CONFIG_COMMIT_DELAY_MS)
+#define PERSIST_DRAG_EVENTS 12              // Eventos LV_EVENT_VALUE_CHANGED por arrastre
+#define PERSIST_SWITCH_EVERY 2              // Un cambio de perfil cada 2 arrastres
+
+struct PersistScenario {
+    const char* name;
+    uint32_t commitDelayMs;
+    bool writerTask;
+};
+
+struct PersistRun {
+    uint32_t loops;
+    uint32_t maxStallUs;
+    uint64_t totalStallUs;
+    uint32_t flashWrites;
+    ConfigStorageStats stats;
+    bool persisted;
+};
+
+static PersistRun runScenario(const PersistScenario& scenario, uint64_t durationUs, uint32_t writeUs) {
+    PersistRun run;
+    memset(&run, 0, sizeof(run));
+
+    HostMock::reset();
+    HostMock::setSerialOutput(false);
+
+    ConfigStorage config;
+    config.begin();
+    config.setCommitDelay(scenario.commitDelayMs);
+    if (scenario.writerTask) config.startWriter();
+    config.resetStats();
+    HostMock::setPreferencesWriteUs(writeUs);
+    uint32_t writesBefore = HostMock::getPreferencesWrites();
+
+    uint64_t endUs = HostMock::nowUs() + durationUs;
+    uint64_t nextDragUs = HostMock::nowUs() + PERSIST_DRAG_EVERY_US;
+    uint32_t drags = 0;
+    uint8_t dragEvents = 0;
+    uint8_t value = 0;
+
+    while (HostMock::nowUs() < endUs) {
+        uint64_t loopStartUs = HostMock::nowUs();
+
+        // Eventos de la UI en esta vuelta (ui_events.c guarda en cada cambio del slider)
+        uint64_t configStartUs = HostMock::nowUs();
+        if (HostMock::nowUs() >= nextDragUs) {
+            if (dragEvents == 0 && drags % PERSIST_SWITCH_EVERY == PERSIST_SWITCH_EVERY - 1) {
+                config.setActiveProfile((config.getActiveProfile() + 1) % MAX_PROFILES);
+            }
+            config.setSpeedLimit(0, value++);
+            config.saveCurrentConfig();
+            if (++dragEvents == PERSIST_DRAG_EVENTS) {
+                dragEvents = 0;
+                drags++;
+                nextDragUs += PERSIST_DRAG_EVERY_US;
+            }
+        }
+        config.poll(millis());
+        uint32_t stallUs = HostMock::nowUs() - configStartUs;
+
+        run.loops++;
+        run.totalStallUs += stallUs;
+        if (stallUs > run.maxStallUs) run.maxStallUs = stallUs;
+
+        // Resto de la vuelta (LVGL); la tarea de escritura corre mientras
+        uint64_t loopEndUs = loopStartUs + stallUs + PERSIST_LOOP_US;
+        if (scenario.writerTask) config.processWrites();
+        if (HostMock::nowUs() < loopEndUs) HostMock::setTimeUs(loopEndUs);
+    }
+
+    // Lo que queda pendiente se escribe al cerrar; después se compara con una lectura nueva
+    if (scenario.writerTask) {
+        config.flush(0);
+        config.processWrites();
+    }
+    config.flush(0);
+    run.stats = config.getStats();
+    run.flashWrites = HostMock::getPreferencesWrites() - writesBefore;
+
+    ConfigStorage reopened;
+    reopened.begin();
+    run.persisted = reopened.getActiveProfile() == config.getActiveProfile();
+    for (uint8_t i = 0; i < MAX_PROFILES; i++) {
+        uint8_t expected[CONFIG_VALUES_COUNT];
+        uint8_t actual[CONFIG_VALUES_COUNT];
+        uint64_t expectedAddress = 0;
+        uint64_t actualAddress = 0;
+        bool expectedValid = config.quickLoad(i, expected, &expectedAddress);
+        bool actualValid = reopened.quickLoad(i, actual, &actualAddress);
+        if (expectedValid != actualValid ||
+            (expectedValid && (memcmp(expected, actual, sizeof(expected)) != 0 || expectedAddress != actualAddress))) {
+            run.persisted = false;
+        }
+    }
+
+    HostMock::setSerialOutput(true);
+    return run;
+}
+
+int runPersist(int argc, char** argv) {
+    uint32_t seconds = PERSIST_DEFAULT_SECONDS;
+    uint32_t writeUs = PERSIST_DEFAULT_WRITE_US;
+    bool quiet = false;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) seconds = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--write-us") == 0 && i + 1 < argc) writeUs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--quiet") == 0) quiet = true;
+        else {
+            printf("persist: opción desconocida %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (seconds < 5) seconds = 5;
+
+    const PersistScenario scenarios[] = {
+        {"inmediato en el loop", 0, false},
+        {"diferido en el loop", CONFIG_COMMIT_DELAY_MS, false},
+        {"tarea de escritura", CONFIG_COMMIT_DELAY_MS, true},
+    };
+    const uint8_t scenarioCount = sizeof(scenarios) / sizeof(scenarios[0]);
+    PersistRun runs[scenarioCount];
+
+    HostChecks checks = {0, 0};
+    if (!quiet) {
+        printf("%u s, escritura en flash de %u us por clave, vuelta del loop de %u us\n",
+               seconds, writeUs, PERSIST_LOOP_US);
+        printf("%-22s  %12s  %11s  %9s  %8s  %13s\n", "escenario", "parada máx", "media", "escrituras",
+               "errores", "latencia máx");
+    }
+    for (uint8_t i = 0; i < scenarioCount; i++) {
+        PersistRun& run = runs[i];
+        run = runScenario(scenarios[i], (uint64_t)seconds * 1000000, writeUs);
+        if (!quiet) {
+            printf("%-22s  %9u us  %8.1f us  %10u  %8u  %10u ms\n", scenarios[i].name, run.maxStallUs,
+                   run.loops ? (double)run.totalStallUs / run.loops : 0.0, run.flashWrites,
+                   run.stats.writeErrors, run.stats.maxLatencyUs / 1000);
+        }
+        HOST_CHECK(checks, run.persisted, "flash igual que la RAM");
+        HOST_CHECK(checks, run.stats.writeErrors == 0, "sin errores de escritura");
+    }
+
+    const PersistRun& immediate = runs[0];
+    const PersistRun& deferred = runs[1];
+    const PersistRun& background = runs[2];
+    HOST_CHECK(checks, deferred.flashWrites < immediate.flashWrites, "diferido escribe menos");
+    HOST_CHECK(checks, background.flashWrites == deferred.flashWrites, "la tarea escribe lo mismo");
+    HOST_CHECK(checks, background.maxStallUs < writeUs, "la tarea no detiene el loop");
+    HOST_CHECK(checks, background.maxStallUs < deferred.maxStallUs &&
+               background.maxStallUs < immediate.maxStallUs, "menos parada que escribiendo en el loop");
+
+    if (!quiet) {
+        printf("parada = tiempo de una vuelta del loop dentro de ConfigStorage (guardar, cambio de perfil, poll)\n");
+    }
+    printf("persist: %u comprobaciones correctas, %u fallos\n", checks.passed, checks.failed);
+    return checks.failed == 0 ? 0 : 1;
+}
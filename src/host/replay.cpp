@@ -0,0 +1,799 @@
+/**
+ * Modo replay: simulador determinista del lazo de control del transmisor
+ *
+ * Reproduce una traza de entradas (ADC por pin, pines de las palancas,
+ * botones y eventos táctiles de la UI) sobre el reloj virtual y ejecuta la
+ * misma secuencia que controlTick() en main.cpp: AnalogAcquisition.poll(),
+ * sampleControlInputs(), computeSentData() y RadioTx.submit() cuando lo
+ * decide TxScheduler. Un segundo RF24 en el aire simulado recibe el flujo de
+ * Data_to_be_sent: los paquetes llegan cuando termina su tiempo en el aire
+ * y el receptor consulta la radio cada REPLAY_RX_POLL_US.
+ *
+ * Uso:
+ *   program replay [traza] [--csv salida.csv] [--expect referencia.csv]
+ *                  [--rate hz] [--noise n] [--fixed] [--telemetry] [--quiet]
+ *
+ * Sin traza se usa un escenario integrado (rampas, boost y cambios de límites).
+ * --fixed transmite en cada ciclo (sin TxScheduler) para comparar.
+ * --telemetry usa el modo bidireccional (RADIO_TELEMETRY de main.cpp): auto-ACK,
+ * secuencia en cada paquete y el receptor devuelve telemetría en el ACK, como
+ * test/receptor_telemetria.cpp.
+ *
+ * Formato de la traza (una línea por evento, '#' comenta):
+ *   <ms> adc <pin> <valor>               Valor crudo del ADC (13 bits)
+ *   <ms> joy <izq|der> <x> <y>           Ambos ejes de un joystick
+ *   <ms> pin <pin> <0|1>                 Nivel de un pin digital
+ *   <ms> palanca <1-4> <0-2>             Posición de una palanca
+ *   <ms> boton <izq|der> <0|1>           1 = pulsado
+ *   <ms> touch turn|speed|boost|extra <a> <b> <c>   Guardar límites desde la UI
+ *   <ms> touch live <1-4> <pos> <valor>  Edición en vivo (modo calibración)
+ *   <ms> touch profile <0-3>             Cambiar perfil activo
+ *   <ms> touch curve <1-4> <tipo> <n>    Curva de ch1-ch4 (tipo 0-3, cantidad 0-100)
+ *   <ms> fin                             Fin de la simulación
+ *
+ * Resultados:
+ * - Paquetes transmitidos, frecuencia real, bytes en el aire e intervalo
+ *   máximo entre paquetes (no puede superar el failsafe)
+ * - RadioTx: paquetes enviados/descartados, latencia submit -> TX_DS y
+ *   tiempo máximo dentro de submit()/poll()
+ * - Con --telemetry: tramas recibidas en los ACK, tasa de ACK y tiempo de
+ *   ida y vuelta (paquete -> eco de su secuencia en la telemetría), y la
+ *   calidad del enlace del último segundo (pérdidas, reintentos, RPD, latencia)
+ * - Latencia entrada -> paquete: desde cada evento hasta el primer paquete
+ *   recibido que cambia respecto al anterior al evento
+ * - Comprobación del mapeo en cada paquete: ch1/ch2 nunca a la vez, tope de
+ *   velocidad = palanca1 (+ palanca3 con boost, máximo 255), tope de giro =
+ *   palanca2, ch5 = palanca4, y valor exacto del tope con el stick a fondo
+ *   (el final de la curva de ch1/ch2 escalado al tope)
+ * - Comparación opcional con un CSV de referencia (regresiones)
+ */
+
+#include "host_modes.h"
+#include <HostMock.h>
+#include <RF24.h>
+#include <AnalogAcquisition.h>
+#include <AnalogSources.h>
+#include <ConfigStorage.h>
+#include <Joystick.h>
+#include <EdgeCapture.h>
+#include <TransmitterLogic.h>
+#include <ControlState.h>
+#include <ProfileSwitch.h>
+#include <TxScheduler.h>
+#include <RadioTx.h>
+#include <TelemetryLink.h>
+#include <LinkQuality.h>
+
+#include <algorithm>
+#include <vector>
+
+#define REPLAY_DEFAULT_RATE_HZ 200           // CONTROL_RATE_HZ de main.cpp
+#define REPLAY_ADC_RATE_HZ 20000             // ANALOG_SAMPLE_RATE_HZ de main.cpp
+#define REPLAY_BATTERY_PIN 3
+#define REPLAY_TAIL_MS 500                   // Tiempo simulado tras el último evento
+#define REPLAY_FULL_SCALE_SETTLE_MS 20       // Stick a fondo: tiempo para exigir el tope exacto
+#define REPLAY_ADC_MAX 8180                  // setLimits() de configureJoysticks()
+#define REPLAY_ADC_MIN 65
+#define REPLAY_TX_HEARTBEAT_US 100000        // TX_HEARTBEAT_US de main.cpp
+#define REPLAY_TX_FAILSAFE_US 250000         // TX_FAILSAFE_US de main.cpp
+#define REPLAY_TX_HOLD_US 200000             // TX_HOLD_US de main.cpp
+#define REPLAY_RX_POLL_US 250                // El receptor consulta la radio a 4 kHz
+#define REPLAY_TELEMETRY_RETRY_DELAY 5       // TELEMETRY_RETRY_DELAY de main.cpp
+#define REPLAY_TELEMETRY_RETRIES 1           // TELEMETRY_RETRIES de main.cpp
+#define REPLAY_CAR_BATTERY_MV 7400           // Batería que informa el receptor simulado
+#define REPLAY_CAR_MA_PER_STEP 40            // Corriente simulada del motor por paso de ch1/ch2
+
+static const char* DEFAULT_TRACE =
+    "# Escenario integrado: sticks centrados, rampas, boost, límites y reposo\n"
+    "0 joy izq 5520 5160\n"
+    "0 joy der 5060 4970\n"
+    "100 adc 2 8180\n"          // Acelerador a fondo (palanca1 centro)
+    "300 boton der 1\n"         // Boost: palanca1 + palanca3
+    "400 palanca 3 2\n"         // Boost máximo
+    "500 boton der 0\n"
+    "600 adc 2 65\n"            // Reversa a fondo
+    "700 palanca 1 0\n"         // Límite de velocidad bajo
+    "800 adc 2 5160\n"
+    "900 adc 8 8180\n"          // Giro a la derecha
+    "1000 palanca 2 2\n"
+    "1100 adc 8 60\n"           // Giro a la izquierda
+    "1200 adc 8 5060\n"
+    "1300 palanca 4 2\n"
+    "1400 touch turn 30 60 90\n" // Nuevos límites de velocidad desde la UI
+    "1500 adc 2 8180\n"
+    "1600 touch live 1 0 200\n"  // Calibración en vivo de palanca1
+    "1700 boton der 1\n"
+    "1800 adc 2 5160\n"
+    "1900 boton der 0\n"
+    "2000 touch curve 1 1 60\n" // Expo 60% en el avance
+    "2100 adc 2 6800\n"         // Medio acelerador: la curva reduce el valor
+    "2200 adc 2 8180\n"         // A fondo: mismo tope que sin curva
+    "2300 adc 2 5160\n"         // Aparcado: la transmisión baja al latido
+    "4300 fin\n";
+
+enum ReplayEventType {
+    EVENT_ADC,
+    EVENT_PIN,
+    EVENT_TOUCH_LIMITS,
+    EVENT_TOUCH_LIVE,
+    EVENT_TOUCH_PROFILE,
+    EVENT_TOUCH_CURVE,
+    EVENT_END
+};
+
+struct ReplayEvent {
+    uint64_t timeUs;
+    ReplayEventType type;
+    int args[4];
+    uint16_t line;
+};
+
+struct ReplayPacket {
+    uint32_t timeMs;
+    Data_to_be_sent data;
+};
+
+// Estado del transmisor simulado (equivalente a los globales de main.cpp).
+// ConfigStorage se construye en el primer uso: su constructor imprime por Serial
+static ConfigStorage& replayConfig() {
+    static ConfigStorage config;
+    return config;
+}
+static Joystick joystick_izquierdo(JOYSTICK_IZQ_X, JOYSTICK_IZQ_Y, JOYSTICK_IZQ_BTN);
+static Joystick joystick_derecho(JOYSTICK_DER_X, JOYSTICK_DER_Y, JOYSTICK_DER_BTN);
+static AnalogAcquisition analog_input;
+static EdgeCapture botones;
+static RF24 radio(6, 7);
+static Data_to_be_sent sent_data;
+static uint8_t palanca1[3];
+static uint8_t palanca2[3];
+static uint8_t palanca3[3];
+static uint8_t palanca4[3];
+static uint8_t* const palancaVectors[PALANCAS_COUNT] = {palanca1, palanca2, palanca3, palanca4};
+static ResponseCurve curvas[CURVAS_COUNT];
+static PalancaTable palancas(PALANCA_PINS);
+static SeqLock<ControlLimits> control_limits;
+static ProfileSwitch profile_switch;
+static TxScheduler tx_scheduler;
+static RadioTx radio_tx;
+static bool fixedRate = false;
+static TelemetryLink telemetry;
+static LinkQuality link_quality;
+static bool telemetryMode = false;
+
+static uint16_t adcValues[HOST_MOCK_PIN_COUNT];
+static int adcNoise = 0;
+
+// El ADC continuo devuelve el valor de la traza, con ruido opcional
+static uint16_t traceAdc(uint8_t pin, uint32_t sampleIndex, void* context) {
+    (void)sampleIndex;
+    (void)context;
+    int value = pin < HOST_MOCK_PIN_COUNT ? adcValues[pin] : 0;
+    if (adcNoise > 0) value += random(-adcNoise, adcNoise + 1);
+    return constrain(value, 0, 8191);
+}
+
+static void setAdc(uint8_t pin, int value) {
+    if (pin >= HOST_MOCK_PIN_COUNT) return;
+    adcValues[pin] = constrain(value, 0, 8191);
+    HostMock::setAnalog(pin, adcValues[pin]); // Para los analogRead() de begin()
+}
+
+// Mismo orden que updatePalancaNVector() en main.cpp
+static void loadPalancaVectors() {
+    replayConfig().getTurnLimits(&palanca1[0], &palanca1[1], &palanca1[2]);
+    replayConfig().getSpeedLimits(&palanca2[0], &palanca2[1], &palanca2[2]);
+    replayConfig().getBoostLimits(&palanca3[0], &palanca3[1], &palanca3[2]);
+    replayConfig().getExtraLimits(&palanca4[0], &palanca4[1], &palanca4[2]);
+}
+
+// Igual que loadResponseCurves() en main.cpp
+static void loadResponseCurves() {
+    for (uint8_t i = 0; i < CURVAS_COUNT; i++) {
+        curvas[i].build(replayConfig().getCurve(i));
+    }
+}
+
+static uint8_t* palancaVector(int palanca) {
+    return palanca >= 1 && palanca <= PALANCAS_COUNT ? palancaVectors[palanca - 1] : nullptr;
+}
+
+// ========== LECTURA DE LA TRAZA ==========
+
+static bool addPinEvent(std::vector<ReplayEvent>& events, ReplayEvent event, int pin, int level) {
+    event.type = EVENT_PIN;
+    event.args[0] = pin;
+    event.args[1] = level;
+    events.push_back(event);
+    return true;
+}
+
+static bool parseLine(char* line, uint16_t lineNumber, std::vector<ReplayEvent>& events) {
+    char* comment = strchr(line, '#');
+    if (comment) *comment = '\0';
+
+    char command[16] = "";
+    char target[16] = "";
+    double timeMs = 0;
+    int a = 0, b = 0, c = 0;
+    int fields = sscanf(line, "%lf %15s", &timeMs, command);
+    if (fields <= 0) return true; // Línea vacía
+    if (fields < 2 || timeMs < 0) return false;
+
+    ReplayEvent event = {};
+    event.timeUs = (uint64_t)(timeMs * 1000.0);
+    event.line = lineNumber;
+    const char* args = strstr(line, command) + strlen(command);
+
+    if (strcmp(command, "adc") == 0 && sscanf(args, "%d %d", &a, &b) == 2) {
+        event.type = EVENT_ADC;
+        event.args[0] = a;
+        event.args[1] = b;
+        events.push_back(event);
+    } else if (strcmp(command, "joy") == 0 && sscanf(args, "%15s %d %d", target, &a, &b) == 3) {
+        bool izquierdo = strcmp(target, "izq") == 0;
+        event.type = EVENT_ADC;
+        event.args[0] = izquierdo ? JOYSTICK_IZQ_X : JOYSTICK_DER_X;
+        event.args[1] = a;
+        events.push_back(event);
+        event.args[0] = izquierdo ? JOYSTICK_IZQ_Y : JOYSTICK_DER_Y;
+        event.args[1] = b;
+        events.push_back(event);
+    } else if (strcmp(command, "pin") == 0 && sscanf(args, "%d %d", &a, &b) == 2) {
+        addPinEvent(events, event, a, b ? HIGH : LOW);
+    } else if (strcmp(command, "palanca") == 0 && sscanf(args, "%d %d", &a, &b) == 2) {
+        if (a < 1 || a > PALANCAS_COUNT || b < 0 || b > 2) return false;
+        // Inversa de LeverTable::decode(): pines activos en LOW
+        addPinEvent(events, event, PALANCA_PINS[a - 1].pin1, b == 0 ? LOW : HIGH);
+        addPinEvent(events, event, PALANCA_PINS[a - 1].pin2, b == 2 ? LOW : HIGH);
+    } else if (strcmp(command, "boton") == 0 && sscanf(args, "%15s %d", target, &a) == 2) {
+        int pin = strcmp(target, "izq") == 0 ? JOYSTICK_IZQ_BTN : JOYSTICK_DER_BTN;
+        addPinEvent(events, event, pin, a ? LOW : HIGH);
+    } else if (strcmp(command, "touch") == 0 && sscanf(args, "%15s", target) == 1) {
+        const char* touchArgs = strstr(args, target) + strlen(target);
+        if (strcmp(target, "live") == 0 && sscanf(touchArgs, "%d %d %d", &a, &b, &c) == 3) {
+            event.type = EVENT_TOUCH_LIVE;
+        } else if (strcmp(target, "profile") == 0 && sscanf(touchArgs, "%d", &a) == 1) {
+            event.type = EVENT_TOUCH_PROFILE;
+        } else if (strcmp(target, "curve") == 0 && sscanf(touchArgs, "%d %d %d", &a, &b, &c) == 3) {
+            if (a < 1 || a > CURVAS_COUNT || b < 0 || b >= CURVE_TYPES_COUNT) return false;
+            event.type = EVENT_TOUCH_CURVE;
+        } else if (sscanf(touchArgs, "%d %d %d", &a, &b, &c) == 3) {
+            event.type = EVENT_TOUCH_LIMITS;
+            if (strcmp(target, "turn") == 0) event.args[3] = 1;
+            else if (strcmp(target, "speed") == 0) event.args[3] = 2;
+            else if (strcmp(target, "boost") == 0) event.args[3] = 3;
+            else if (strcmp(target, "extra") == 0) event.args[3] = 4;
+            else return false;
+        } else {
+            return false;
+        }
+        event.args[0] = a;
+        event.args[1] = b;
+        event.args[2] = c;
+        events.push_back(event);
+    } else if (strcmp(command, "fin") == 0) {
+        event.type = EVENT_END;
+        events.push_back(event);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool loadTrace(const char* path, std::vector<ReplayEvent>& events) {
+    char line[160];
+    uint16_t lineNumber = 0;
+
+    if (path == nullptr) {
+        const char* p = DEFAULT_TRACE;
+        while (*p) {
+            const char* end = strchr(p, '\n');
+            size_t length = end ? (size_t)(end - p) : strlen(p);
+            if (length >= sizeof(line)) length = sizeof(line) - 1;
+            memcpy(line, p, length);
+            line[length] = '\0';
+            if (!parseLine(line, ++lineNumber, events)) return false;
+            p += end ? length + 1 : length;
+        }
+    } else {
+        FILE* file = fopen(path, "r");
+        if (file == nullptr) {
+            printf("replay: no se puede abrir %s\n", path);
+            return false;
+        }
+        while (fgets(line, sizeof(line), file)) {
+            if (!parseLine(line, ++lineNumber, events)) {
+                printf("replay: línea %u inválida: %s", lineNumber, line);
+                fclose(file);
+                return false;
+            }
+        }
+        fclose(file);
+    }
+
+    // Orden estable: eventos del mismo instante se aplican en orden de la traza
+    std::stable_sort(events.begin(), events.end(),
+                     [](const ReplayEvent& x, const ReplayEvent& y) { return x.timeUs < y.timeUs; });
+    return true;
+}
+
+// ========== SIMULACIÓN ==========
+
+static void applyEvent(const ReplayEvent& event) {
+    switch (event.type) {
+        case EVENT_ADC:
+            setAdc(event.args[0], event.args[1]);
+            break;
+        case EVENT_PIN:
+            HostMock::setDigital(event.args[0], event.args[1]);
+            break;
+        case EVENT_TOUCH_LIMITS:
+            // Lo que hacen los callbacks de ui_events: setXLimits() + updatePalancaNVector()
+            switch (event.args[3]) {
+                case 1: replayConfig().setTurnLimits(event.args[0], event.args[1], event.args[2]); break;
+                case 2: replayConfig().setSpeedLimits(event.args[0], event.args[1], event.args[2]); break;
+                case 3: replayConfig().setBoostLimits(event.args[0], event.args[1], event.args[2]); break;
+                case 4: replayConfig().setExtraLimits(event.args[0], event.args[1], event.args[2]); break;
+            }
+            loadPalancaVectors();
+            break;
+        case EVENT_TOUCH_LIVE: {
+            uint8_t* vector = palancaVector(event.args[0]);
+            if (vector && event.args[1] >= 0 && event.args[1] < 3) {
+                vector[event.args[1]] = constrain(event.args[2], 0, 255);
+            }
+            break;
+        }
+        case EVENT_TOUCH_PROFILE:
+            replayConfig().setActiveProfile(event.args[0]);
+            loadPalancaVectors();
+            loadResponseCurves();
+            break;
+        case EVENT_TOUCH_CURVE: {
+            // Lo que hace ui_events al guardar una curva: setCurve() + updateCurves()
+            ResponseCurveConfig curve = replayConfig().getCurve(event.args[0] - 1);
+            curve.type = event.args[1];
+            curve.amount = constrain(event.args[2], 0, 100);
+            replayConfig().setCurve(event.args[0] - 1, curve);
+            loadResponseCurves();
+            break;
+        }
+        case EVENT_END:
+            break;
+    }
+}
+
+// Igual que publishControlLimits() en main.cpp (tarea de UI)
+static void publishControlLimits() {
+    ControlLimits limits;
+    for (uint8_t i = 0; i < PALANCAS_COUNT; i++) {
+        memcpy(limits.palanca[i], palancaVectors[i], 3);
+    }
+    for (uint8_t i = 0; i < CURVAS_COUNT; i++) {
+        limits.curves[i] = curvas[i];
+    }
+    limits.radio.address = replayConfig().getNRFAddress();
+    limits.radio.channel = replayConfig().getExtraConfig();
+    limits.radio.paLevel = ProfileSwitch::paLevelFor(replayConfig().getIntensityLimit());
+    limits.profile = replayConfig().getActiveProfile();
+    limits.publishedUs = micros();
+    control_limits.publish(limits);
+}
+
+// Misma secuencia que controlTick() en main.cpp
+static void replayControlTick() {
+    analog_input.poll();
+    botones.service();
+
+    ControlInputs inputs;
+    sampleControlInputs(joystick_izquierdo, joystick_derecho, palancas, inputs);
+
+    uint32_t limits_token;
+    const ControlLimits* limits;
+    RadioProfile radioProfile;
+    uint32_t publishedUs;
+    do {
+        limits = control_limits.beginRead(limits_token);
+        computeSentData(inputs, limits->palanca, limits->curves, sent_data);
+        radioProfile = limits->radio;
+        publishedUs = limits->publishedUs;
+    } while (!control_limits.endRead(limits_token));
+
+    uint32_t now = micros();
+    radio_tx.poll(now);
+    if (telemetryMode) {
+        // readTelemetry() de main.cpp
+        uint8_t buffer[32];
+        while (radio.available()) {
+            uint8_t length = radio.getDynamicPayloadSize();
+            radio.read(buffer, length);
+            telemetry.parse(buffer, length, now);
+        }
+    }
+    if (profile_switch.pending(radioProfile)) {
+        if (!radio_tx.isIdle()) radio_tx.flush(now);
+        profile_switch.apply(radioProfile);
+        tx_scheduler.forceSend();
+    }
+    if (fixedRate || tx_scheduler.poll(&sent_data, sizeof(Data_to_be_sent), now)) {
+        if (telemetryMode) {
+            uint8_t frame[sizeof(Data_to_be_sent) + TELEMETRY_SEQUENCE_SIZE];
+            memcpy(frame, &sent_data, sizeof(Data_to_be_sent));
+            frame[sizeof(Data_to_be_sent)] = telemetry.nextSequence(now);
+            radio_tx.submit(frame, sizeof(frame), now);
+        } else {
+            radio_tx.submit(&sent_data, sizeof(Data_to_be_sent), now);
+        }
+        profile_switch.onFrame(limits_token >> 1, publishedUs, micros());
+    }
+}
+
+// radioTxDone() de main.cpp
+static void replayTxDone(const RadioTxResult& result, void* context) {
+    if (result.status != RADIO_TX_SENT) {
+        tx_scheduler.forceSend();
+    }
+    if (telemetryMode && result.status != RADIO_TX_DROPPED) {
+        bool acked = result.status == RADIO_TX_SENT;
+        telemetry.onAck(acked);
+
+        uint32_t now = millis();
+        link_quality.observe(radio, acked, now);
+        if (acked) {
+            link_quality.sampleRpd(radio, now);
+            link_quality.onRoundTrip(result.completedUs - result.queuedUs);
+        }
+    }
+}
+
+// Comprobación independiente del mapeo a partir del estado de la traza
+static uint32_t checkPacket(const Data_to_be_sent& data, uint32_t fullScaleSinceMs, int fullScaleDir,
+                            uint32_t nowMs, bool verbose) {
+    // Posiciones ya filtradas por el antirrebote (las del ciclo que generó el paquete)
+    const uint8_t* pos = palancas.getPositions();
+    bool boost = digitalRead(JOYSTICK_DER_BTN) == LOW;
+
+    int speedCap = palanca1[pos[0]] + (boost ? palanca3[pos[2]] : 0);
+    if (speedCap > 255) speedCap = 255;
+    int turnCap = palanca2[pos[1]];
+
+    uint32_t errors = 0;
+    const char* error = nullptr;
+    if (data.ch1 && data.ch2) error = "ch1 y ch2 a la vez";
+    else if (data.ch3 && data.ch4) error = "ch3 y ch4 a la vez";
+    else if (data.ch1 > speedCap || data.ch2 > speedCap) error = "velocidad por encima del tope";
+    else if (data.ch3 > turnCap || data.ch4 > turnCap) error = "giro por encima del tope";
+    else if (data.ch5 != palanca4[pos[3]] || data.ch6 != 0 || data.ch7 != 0) error = "ch5-ch7 no corresponden a palanca4";
+    else if (fullScaleDir != 0 && nowMs - fullScaleSinceMs >= REPLAY_FULL_SCALE_SETTLE_MS) {
+        uint8_t value = fullScaleDir > 0 ? data.ch1 : data.ch2;
+        const ResponseCurve& curve = curvas[fullScaleDir > 0 ? CURVA_CH1 : CURVA_CH2];
+        if (value != curve.apply(255, speedCap)) error = "stick a fondo no llega al tope";
+    }
+
+    if (error) {
+        errors++;
+        if (verbose) {
+            printf("  %u ms: %s (ch1=%u ch2=%u ch3=%u ch4=%u ch5=%u, tope vel=%d giro=%d)\n",
+                   nowMs, error, data.ch1, data.ch2, data.ch3, data.ch4, data.ch5, speedCap, turnCap);
+        }
+    }
+    return errors;
+}
+
+static bool samePacket(const Data_to_be_sent& a, const Data_to_be_sent& b) {
+    return memcmp(&a, &b, sizeof(Data_to_be_sent)) == 0;
+}
+
+static void printLatency(std::vector<uint32_t>& latencies) {
+    if (latencies.empty()) {
+        printf("Latencia entrada->paquete: sin muestras\n");
+        return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    uint64_t sum = 0;
+    for (uint32_t value : latencies) sum += value;
+    size_t n = latencies.size();
+    printf("Latencia entrada->paquete (%zu eventos): min %.2f  media %.2f  p50 %.2f  p99 %.2f  max %.2f ms\n",
+           n, latencies[0] / 1000.0, sum / (double)n / 1000.0, latencies[n / 2] / 1000.0,
+           latencies[(n * 99) / 100 < n ? (n * 99) / 100 : n - 1] / 1000.0, latencies[n - 1] / 1000.0);
+}
+
+static uint32_t compareWithExpected(const char* path, const std::vector<ReplayPacket>& packets) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+        printf("replay: no se puede abrir %s\n", path);
+        return 1;
+    }
+
+    char line[128];
+    size_t index = 0;
+    uint32_t mismatches = 0;
+    while (fgets(line, sizeof(line), file)) {
+        unsigned t, c[7];
+        if (sscanf(line, "%u,%u,%u,%u,%u,%u,%u,%u", &t, &c[0], &c[1], &c[2], &c[3], &c[4], &c[5], &c[6]) != 8) {
+            continue; // Cabecera
+        }
+        if (index >= packets.size()) {
+            mismatches++;
+            continue;
+        }
+        const ReplayPacket& packet = packets[index++];
+        const uint8_t* d = (const uint8_t*)&packet.data;
+        bool equal = packet.timeMs == t;
+        for (uint8_t i = 0; i < 7; i++) equal = equal && d[i] == c[i];
+        if (!equal) {
+            if (mismatches == 0) {
+                printf("  Primera diferencia en el paquete %zu (%u ms)\n", index - 1, packet.timeMs);
+            }
+            mismatches++;
+        }
+    }
+    fclose(file);
+    if (index < packets.size()) mismatches += packets.size() - index;
+    return mismatches;
+}
+
+int runReplay(int argc, char** argv) {
+    const char* tracePath = nullptr;
+    const char* csvPath = nullptr;
+    const char* expectPath = nullptr;
+    uint32_t rateHz = REPLAY_DEFAULT_RATE_HZ;
+    bool quiet = false;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) csvPath = argv[++i];
+        else if (strcmp(argv[i], "--expect") == 0 && i + 1 < argc) expectPath = argv[++i];
+        else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) rateHz = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--noise") == 0 && i + 1 < argc) adcNoise = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--fixed") == 0) fixedRate = true;
+        else if (strcmp(argv[i], "--telemetry") == 0) telemetryMode = true;
+        else if (strcmp(argv[i], "--quiet") == 0) quiet = true;
+        else if (argv[i][0] != '-') tracePath = argv[i];
+        else {
+            printf("replay: opción desconocida %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (rateHz == 0) rateHz = REPLAY_DEFAULT_RATE_HZ;
+
+    std::vector<ReplayEvent> events;
+    if (!loadTrace(tracePath, events)) return 2;
+
+    uint64_t endUs = events.empty() ? 0 : events.back().timeUs + REPLAY_TAIL_MS * 1000ULL;
+    for (const ReplayEvent& event : events) {
+        if (event.type == EVENT_END) {
+            endUs = event.timeUs;
+            break;
+        }
+    }
+
+    // Arranque equivalente a setup(): sticks centrados y palancas en el centro
+    HostMock::setSerialOutput(false);
+    memset(adcValues, 0, sizeof(adcValues));
+    setAdc(JOYSTICK_IZQ_X, 5520);
+    setAdc(JOYSTICK_IZQ_Y, 5160);
+    setAdc(JOYSTICK_DER_X, 5060);
+    setAdc(JOYSTICK_DER_Y, 4970);
+    setAdc(REPLAY_BATTERY_PIN, 5600);
+
+    replayConfig().begin();
+    loadPalancaVectors();
+    loadResponseCurves();
+    publishControlLimits();
+    memset(&sent_data, 0, sizeof(sent_data));
+
+    const uint64_t address = replayConfig().getNRFAddress();
+    radio.begin();
+    radio.setAutoAck(telemetryMode);
+    radio.setDataRate(RF24_250KBPS);
+    profile_switch.begin(&radio, control_limits.front().radio, control_limits.getVersion());
+    radio.stopListening();
+
+    // Receptor en el aire simulado: recoge el flujo que vería el auto
+    RF24 receiver(16, 17);
+    receiver.begin();
+    receiver.setAutoAck(telemetryMode);
+    receiver.setDataRate(RF24_250KBPS);
+    receiver.setChannel(replayConfig().getExtraConfig());
+    if (telemetryMode) {
+        RF24* radios[] = {&radio, &receiver};
+        for (RF24* r : radios) {
+            r->enableDynamicPayloads();
+            r->enableAckPayload();
+        }
+        radio.setRetries(REPLAY_TELEMETRY_RETRY_DELAY, REPLAY_TELEMETRY_RETRIES);
+    } else {
+        receiver.setPayloadSize(sizeof(Data_to_be_sent));
+        radio.setPayloadSize(sizeof(Data_to_be_sent));
+    }
+    receiver.openReadingPipe(1, address);
+    receiver.startListening();
+    TelemetryResponder responder;
+
+    tx_scheduler.setIntervals(1000000UL / rateHz, REPLAY_TX_HEARTBEAT_US, REPLAY_TX_FAILSAFE_US);
+    tx_scheduler.setHoldTime(REPLAY_TX_HOLD_US);
+    radio_tx.begin(&radio);
+    radio_tx.setDepth(1);
+    radio_tx.onComplete(replayTxDone, nullptr);
+
+    palancas.begin();
+    configureJoysticks(joystick_izquierdo, joystick_derecho, botones);
+
+    SyntheticAnalogSource adc(13);
+    adc.setGenerator(traceAdc);
+    analog_input.addChannel(JOYSTICK_IZQ_X);
+    analog_input.addChannel(JOYSTICK_IZQ_Y);
+    analog_input.addChannel(JOYSTICK_DER_X);
+    analog_input.addChannel(JOYSTICK_DER_Y);
+    analog_input.addChannel(REPLAY_BATTERY_PIN);
+    analog_input.begin(&adc, REPLAY_ADC_RATE_HZ);
+    joystick_izquierdo.setAnalogReader(AnalogAcquisition::readPin, &analog_input);
+    joystick_derecho.setAnalogReader(AnalogAcquisition::readPin, &analog_input);
+
+    // Bucle de simulación: eventos y ticks en orden de tiempo virtual
+    const uint64_t startUs = HostMock::nowUs();
+    const uint64_t periodUs = 1000000ULL / rateHz;
+    uint64_t nextTickUs = startUs + periodUs;
+    uint64_t nextRxUs = startUs + REPLAY_RX_POLL_US;
+    size_t nextEvent = 0;
+
+    std::vector<ReplayPacket> packets;
+    std::vector<uint32_t> latencies;
+    Data_to_be_sent lastReceived = {};
+    bool pendingEvent = false;
+    uint64_t pendingEventUs = 0;
+    Data_to_be_sent pendingBase = {};
+    uint32_t eventsWithoutEffect = 0;
+    uint32_t mappingErrors = 0;
+    uint32_t ticks = 0;
+    int fullScaleDir = 0;
+    uint32_t fullScaleSinceMs = 0;
+    uint64_t lastPacketUs = startUs;
+    uint64_t maxGapUs = 0;
+
+    while (true) {
+        bool eventFirst = nextEvent < events.size() && startUs + events[nextEvent].timeUs <= nextTickUs &&
+                          startUs + events[nextEvent].timeUs <= nextRxUs;
+        bool rxFirst = !eventFirst && nextRxUs < nextTickUs;
+        uint64_t targetUs = eventFirst ? startUs + events[nextEvent].timeUs : (rxFirst ? nextRxUs : nextTickUs);
+        if (targetUs > startUs + endUs) break;
+        HostMock::setTimeUs(targetUs);
+
+        if (eventFirst) {
+            const ReplayEvent& event = events[nextEvent++];
+            if (event.type == EVENT_END) break;
+            // El DMA convierte continuamente: las muestras previas al evento llevan el valor anterior
+            analog_input.poll();
+            applyEvent(event);
+            publishControlLimits();
+
+            // Stick izquierdo Y a fondo: a partir de aquí se exige el tope exacto
+            // (con ruido la lectura puede quedar por debajo del límite calibrado)
+            if (event.type == EVENT_ADC && event.args[0] == JOYSTICK_IZQ_Y && adcNoise == 0) {
+                int dir = event.args[1] >= REPLAY_ADC_MAX ? 1 : (event.args[1] <= REPLAY_ADC_MIN ? -1 : 0);
+                if (dir != fullScaleDir) {
+                    fullScaleDir = dir;
+                    fullScaleSinceMs = millis();
+                }
+            }
+
+            // Eventos del mismo instante (joy, palanca) cuentan como una sola entrada
+            if (pendingEvent && pendingEventUs == targetUs) continue;
+            if (pendingEvent) eventsWithoutEffect++;
+            pendingEvent = true;
+            pendingEventUs = targetUs;
+            pendingBase = lastReceived;
+            continue;
+        }
+
+        if (rxFirst) {
+            nextRxUs += REPLAY_RX_POLL_US;
+        } else {
+            replayControlTick();
+            ticks++;
+            nextTickUs += periodUs;
+        }
+
+        bool received = false;
+        while (receiver.available()) {
+            ReplayPacket packet;
+            uint8_t frame[32];
+            uint8_t length = telemetryMode ? receiver.getDynamicPayloadSize() : sizeof(Data_to_be_sent);
+            receiver.read(frame, length);
+            memcpy(&packet.data, frame, sizeof(Data_to_be_sent));
+            if (telemetryMode) responder.onPacket(frame[length - 1], receiver.testRPD());
+            received = true;
+            packet.timeMs = (uint32_t)((HostMock::nowUs() - startUs) / 1000);
+            packets.push_back(packet);
+            if (HostMock::nowUs() - lastPacketUs > maxGapUs) maxGapUs = HostMock::nowUs() - lastPacketUs;
+            lastPacketUs = HostMock::nowUs();
+
+            mappingErrors += checkPacket(packet.data, fullScaleSinceMs, fullScaleDir, millis(), !quiet);
+
+            if (pendingEvent && !samePacket(packet.data, pendingBase)) {
+                latencies.push_back((uint32_t)(HostMock::nowUs() - pendingEventUs));
+                pendingEvent = false;
+            }
+            lastReceived = packet.data;
+        }
+
+        // Telemetría para el ACK del próximo paquete (test/receptor_telemetria.cpp)
+        if (telemetryMode && received) {
+            uint8_t frame[TELEMETRY_FRAME_SIZE];
+            int16_t currentMa = ((int)lastReceived.ch1 - lastReceived.ch2) * REPLAY_CAR_MA_PER_STEP;
+            uint8_t length = responder.build(frame, REPLAY_CAR_BATTERY_MV, currentMa);
+            receiver.flush_tx();
+            receiver.writeAckPayload(1, frame, length);
+        }
+    }
+    if (pendingEvent) eventsWithoutEffect++;
+    HostMock::setSerialOutput(true);
+
+    if (csvPath) {
+        FILE* csv = strcmp(csvPath, "-") == 0 ? stdout : fopen(csvPath, "w");
+        if (csv == nullptr) {
+            printf("replay: no se puede escribir %s\n", csvPath);
+            return 2;
+        }
+        fprintf(csv, "t_ms,ch1,ch2,ch3,ch4,ch5,ch6,ch7\n");
+        for (const ReplayPacket& packet : packets) {
+            const Data_to_be_sent& d = packet.data;
+            fprintf(csv, "%u,%u,%u,%u,%u,%u,%u,%u\n", packet.timeMs, d.ch1, d.ch2, d.ch3, d.ch4, d.ch5, d.ch6, d.ch7);
+        }
+        if (csv != stdout) fclose(csv);
+    }
+
+    double seconds = (HostMock::nowUs() - startUs) / 1000000.0;
+    printf("Replay: %s, %.3f s simulados, lazo a %u Hz\n", tracePath ? tracePath : "escenario integrado",
+           seconds, rateHz);
+    printf("Ticks: %u  Paquetes recibidos: %zu  Frecuencia: %.1f paquetes/s\n", ticks, packets.size(),
+           seconds > 0 ? packets.size() / seconds : 0.0);
+    size_t frameSize = sizeof(Data_to_be_sent) + (telemetryMode ? TELEMETRY_SEQUENCE_SIZE : 0);
+    size_t bytesOnAir = packets.size() * (frameSize + TX_SCHEDULER_FRAME_OVERHEAD);
+    printf("Transmisión %s: %zu bytes en el aire (%.0f B/s), intervalo máximo %.1f ms (failsafe %.1f ms)\n",
+           fixedRate ? "fija" : "adaptativa", bytesOnAir, seconds > 0 ? bytesOnAir / seconds : 0.0,
+           maxGapUs / 1000.0, REPLAY_TX_FAILSAFE_US / 1000.0);
+    RadioTxStats txStats = radio_tx.getStats();
+    printf("RadioTx: %u enviados, %u descartados, %u fallidos; latencia submit->TX_DS %u/%.0f/%u us "
+           "(min/media/max)\n",
+           txStats.sent, txStats.dropped + txStats.timeouts, txStats.failed,
+           txStats.sent ? txStats.minLatencyUs : 0, txStats.sent ? (double)txStats.sumLatencyUs / txStats.sent : 0.0,
+           txStats.maxLatencyUs);
+    ProfileSwitchStats swapStats = profile_switch.getStats();
+    printf("Cambios de perfil: %u imágenes en el aire, %u reconfiguraciones de radio; latencia "
+           "publicación->paquete %u/%u us (última/máx)\n",
+           swapStats.swaps, swapStats.radioChanges, swapStats.lastLatencyUs, swapStats.maxLatencyUs);
+    bool telemetryOk = true;
+    if (telemetryMode) {
+        TelemetryStats stats = telemetry.getStats();
+        TelemetryState state = telemetry.getState();
+        telemetryOk = stats.frames > 0 && state.frame.batteryMv == REPLAY_CAR_BATTERY_MV;
+        printf("Telemetría: %u tramas, %u inválidas, ACK %u/%u; ida y vuelta %.2f/%.2f/%.2f ms (min/media/max)\n",
+               stats.frames, stats.invalid, stats.acked, stats.acked + stats.lost,
+               stats.rttSamples ? stats.minRttUs / 1000.0 : 0.0,
+               stats.rttSamples ? stats.sumRttUs / 1000.0 / stats.rttSamples : 0.0,
+               stats.rttSamples ? stats.maxRttUs / 1000.0 : 0.0);
+        if (!telemetryOk) printf("Telemetría del receptor no recibida\n");
+
+        LinkQualityReport link = link_quality.getReport(millis());
+        printf("Enlace (último %u ms): calidad %u, pérdidas %u%%, reintentos/paquete %.2f, RPD %u%%, "
+               "ida y vuelta p50/p90/p99 %u/%u/%u us\n",
+               link.windowMs, link.score, link.lossPercent, link.retriesX100 / 100.0, link.rpdPercent,
+               link.rttP50Us, link.rttP90Us, link.rttP99Us);
+    }
+    printLatency(latencies);
+    printf("Eventos sin efecto en la salida: %u\n", eventsWithoutEffect);
+    printf("Errores de mapeo: %u\n", mappingErrors);
+    bool failsafeOk = maxGapUs <= REPLAY_TX_FAILSAFE_US;
+    if (!failsafeOk) printf("Intervalo entre paquetes por encima del failsafe\n");
+
+    uint32_t mismatches = 0;
+    if (expectPath) {
+        mismatches = compareWithExpected(expectPath, packets);
+        printf("Diferencias con %s: %u\n", expectPath, mismatches);
+    }
+
+    analog_input.end();
+    return (mappingErrors == 0 && mismatches == 0 && failsafeOk && telemetryOk) ? 0 : 1;
+}
@@ -0,0 +1,1179 @@
+/**
+ * Modo smoke: cada librería de lib/ contra los mocks de host
+ *
+ * No sustituye a probar en la placa; comprueba que el código compila y se
+ * comporta igual fuera del ESP32 antes de usarlo en simulaciones.
+ */
+
+#include "host_modes.h"
+#include <HostMock.h>
+#include <esp_timer.h>
+#include <AnalogAcquisition.h>
+#include <AnalogSources.h>
+#include <ConfigStorage.h>
+#include <ControlLoop.h>
+#include <Joystick.h>
+#include <Lever.h>
+#include <QuadratureEncoder.h>
+#include <EdgeCapture.h>
+#include <LeverTable.h>
+#include <NRF24Controller.h>
+#include <PacketCodec.h>
+#include <SeqLock.h>
+#include <ProfileSwitch.h>
+#include <SignalChain.h>
+#include <ResponseCurve.h>
+#include <TxScheduler.h>
+#include <RadioTx.h>
+#include <TelemetryLink.h>
+#include <LinkQuality.h>
+#include <FrequencyHop.h>
+
+struct ControlLimitsTest {
+    uint8_t v[3];
+};
+
+static void onTimer(void* arg) {
+    (*(uint32_t*)arg)++;
+}
+
+static void onControlTick(void* context) {
+    (void)context;
+}
+
+static void checkClock(HostChecks& checks) {
+    HostMock::reset();
+    uint32_t fired = 0;
+    esp_timer_handle_t timer;
+    esp_timer_create_args_t args = {};
+    args.callback = onTimer;
+    args.arg = &fired;
+
+    HOST_CHECK(checks, esp_timer_create(&args, &timer) == ESP_OK, "esp_timer_create");
+    esp_timer_start_periodic(timer, 5000);
+    delay(100);
+    HOST_CHECK(checks, millis() == 100, "delay avanza el reloj virtual");
+    HOST_CHECK(checks, fired == 20, "timer periódico cada 5 ms");
+    esp_timer_stop(timer);
+    esp_timer_delete(timer);
+
+    ControlLoop loop;
+    HOST_CHECK(checks, loop.begin(onControlTick, nullptr, 200), "ControlLoop begin");
+    loop.end();
+}
+
+static void checkJoystick(HostChecks& checks) {
+    HostMock::reset();
+    HostMock::setAnalog(5, 2048);
+    HostMock::setAnalog(2, 2048);
+
+    Joystick joystick(5, 2, 4);
+    joystick.begin();
+    HOST_CHECK(checks, HostMock::getPinMode(4) == INPUT_PULLUP, "botón con pull-up");
+    HOST_CHECK(checks, !joystick.isPressed(), "botón suelto lee HIGH");
+
+    joystick.sample();
+    HOST_CHECK(checks, abs(joystick.readX()) <= 1 && abs(joystick.readY()) <= 1, "joystick centrado");
+
+    HostMock::setAnalog(5, 4095);
+    joystick.sample();
+    HOST_CHECK(checks, joystick.readX() == 255, "joystick al máximo en X");
+
+    HostMock::setDigital(4, LOW);
+    joystick.sample();
+    HOST_CHECK(checks, joystick.isPressed(), "botón pulsado");
+}
+
+static void checkLever(HostChecks& checks) {
+    HostMock::reset();
+    HostMock::setAnalog(6, 0);
+
+    Lever lever(ANALOG_LEVER, 6);
+    lever.begin();
+    HostMock::setAnalog(6, 8191);
+    delay(20);
+    lever.update();
+    HOST_CHECK(checks, lever.readRaw() == 8191, "palanca analógica lee el pin");
+}
+
+static void checkSignalChain(HostChecks& checks) {
+    // Escalado idéntico a map() en los extremos, el centro y fuera de rango
+    ScaleStage scale;
+    scale.configure(60, 5520, 8180, 255, false);
+    static const int32_t values[] = {0, 60, 61, 2790, 5519, 5520, 5521, 6850, 8179, 8180, 8191};
+    bool exact = true;
+    for (uint8_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        int32_t v = values[i];
+        long expected = v >= 5520 ? map(v, 5520, 8180, 0, 255) : map(v, 60, 5520, -255, 0);
+        if (scale.process(v) != expected) exact = false;
+    }
+    HOST_CHECK(checks, exact, "ScaleStage igual que map()");
+
+    ExpoStage expo;
+    expo.setExpo(50, 255);
+    HOST_CHECK(checks, expo.process(255) == 255 && expo.process(-255) == -255 && expo.process(0) == 0 &&
+               abs(expo.process(128)) < 128, "expo conserva los extremos y suaviza el centro");
+
+    HOST_CHECK(checks, signalAtan2(0, 1) == 0 && abs(signalAtan2(1, 0) - SIGNAL_PI_Q15 / 2) <= 1 &&
+               abs(signalAtan2(0, -1) - SIGNAL_PI_Q15) <= 1 && signalAtan2(-1, -1) < 0, "atan2 en punto fijo");
+    HOST_CHECK(checks, signalSqrt(65535) == 255 && signalSqrt(65536) == 256 && signalInCircle(60, 80, 100) &&
+               !signalInCircle(60, 81, 100), "raíz entera y zona muerta circular");
+
+    // Cadena compuesta: EMA a medio camino, luego escala
+    SignalChain<SmoothingStage, ScaleStage> chain;
+    chain.stage<SmoothingStage>().setAlpha(SIGNAL_Q16_ONE / 2);
+    chain.stage<ScaleStage>().configure(0, 100, 200, 100, true);
+    chain.reset(100);
+    HOST_CHECK(checks, chain.process(200) == -50, "cadena: suavizado, escala e inversión");
+}
+
+static void checkResponseCurve(HostChecks& checks) {
+    ResponseCurveConfig config;
+    ResponseCurve::defaultConfig(config);
+    ResponseCurve curve;
+    bool identity = true;
+    for (int x = 0; x <= 255; x++) identity = identity && curve.lookup(x) == x && curve.apply(x, 180) == x * 180 / 255;
+    HOST_CHECK(checks, identity, "curva lineal = map()");
+
+    config.type = CURVE_EXPO;
+    config.amount = 100;
+    curve.build(config);
+    HOST_CHECK(checks, curve.lookup(0) == 0 && curve.lookup(255) == 255 && curve.lookup(128) < 40,
+               "curva expo: extremos exactos y centro suave");
+    HOST_CHECK(checks, curve.apply(255, 200) == 200, "curva expo: tope exacto a fondo");
+
+    config.type = CURVE_POINTS;
+    uint8_t points[RESPONSE_CURVE_POINTS] = {0, 20, 60, 200, 255};
+    memcpy(config.points, points, sizeof(points));
+    curve.build(config);
+    uint8_t atThreeQuarters = curve.lookup(191);
+    HOST_CHECK(checks, curve.lookup(64) == 20 && atThreeQuarters >= 199 && atThreeQuarters <= 201 &&
+               curve.lookup(255) == 255, "curva por puntos");
+
+    config.type = 99;
+    curve.build(config);
+    HOST_CHECK(checks, curve.getType() == CURVE_LINEAR && curve.lookup(100) == 100, "tipo inválido = lineal");
+}
+
+static void checkLeverTable(HostChecks& checks) {
+    HostMock::reset();
+    static constexpr LeverPins pins[3] = {{13, 14}, {40, 39}, {16, 17}};
+    LeverTable<3> levers(pins);
+    levers.begin();
+    HOST_CHECK(checks, levers.getPosition(0) == 1 && levers.getPosition(1) == 1, "palancas al centro con pull-up");
+
+    // Una sola instantánea de los registros de entrada por update(), sin digitalRead()
+    HostMock::setDigital(13, LOW);
+    HostMock::setDigital(39, LOW);
+    uint32_t registerReads = HostMock::getGpioRegisterReadCount();
+    levers.update();
+    HOST_CHECK(checks, HostMock::getGpioRegisterReadCount() - registerReads == 2 &&
+               HostMock::getDigitalReadCount() == 0, "una lectura de GPIO_IN_REG/GPIO_IN1_REG por ciclo");
+    HOST_CHECK(checks, levers.getPosition(0) == 1, "antirrebote: un solo ciclo no cambia la posición");
+
+    levers.update();
+    static const uint8_t limits[3][3] = {{10, 20, 30}, {40, 50, 60}, {70, 80, 90}};
+    HOST_CHECK(checks, levers.getPosition(0) == 0 && levers.getPosition(1) == 2 && levers.getPosition(2) == 1 &&
+               levers.getValue(1, limits) == 60, "posiciones y valores tras el antirrebote");
+
+    // Un rebote de un ciclo se descarta
+    HostMock::setDigital(13, HIGH);
+    levers.update();
+    HostMock::setDigital(13, LOW);
+    levers.update();
+    HOST_CHECK(checks, levers.getPosition(0) == 0 && levers.getChanges() == 2, "rebote descartado");
+}
+
+static void checkEdgeCapture(HostChecks& checks) {
+    HostMock::reset();
+    EdgeCapture capture;
+    int8_t channel = capture.addPin(4, 5000);
+    capture.enableEvents(true);
+    HOST_CHECK(checks, channel == 0 && !capture.isActive(channel), "EdgeCapture pin con pull-up suelto");
+
+    // Flanco inicial aceptado en el acto; los rebotes dentro de la ventana se ignoran
+    capture.injectEdge(4, LOW, 1000);
+    capture.injectEdge(4, HIGH, 1200);
+    capture.injectEdge(4, LOW, 1500);
+    EdgeEvent event;
+    HOST_CHECK(checks, capture.isActive(channel) && capture.getActivations(channel) == 1 &&
+               capture.popEvent(event) && event.timestampUs == 1000 && event.active, "flanco con marca de tiempo");
+    EdgeCaptureStats stats = capture.getStats();
+    HOST_CHECK(checks, stats.bounces == 2 && !capture.popEvent(event), "rebotes descartados");
+
+    // Pulsación dentro de la ventana de la liberación: service() la acepta al cerrarse la ventana
+    capture.injectEdge(4, HIGH, 6500);
+    capture.injectEdge(4, LOW, 7000);
+    HostMock::setTimeUs(11000);
+    capture.service();
+    HOST_CHECK(checks, !capture.isActive(channel), "ventana de antirrebote abierta");
+    HostMock::setTimeUs(11500);
+    capture.service();
+    stats = capture.getStats();
+    HOST_CHECK(checks, capture.isActive(channel) && capture.getActivations(channel) == 2 &&
+               capture.getDeactivations(channel) == 1 && stats.settled == 1, "antirrebote cerrado por service()");
+
+    // Interrupción real desde el mock del pin
+    HostMock::setTimeUs(30000);
+    HostMock::setDigital(4, LOW);
+    HostMock::setTimeUs(40000);
+    HostMock::setDigital(4, HIGH);
+    HOST_CHECK(checks, !capture.isActive(channel) && capture.getLastEdgeUs(channel) == 40000, "flanco por interrupción");
+
+    // Estado de flancos por instancia (antes era static, compartido por todas las palancas)
+    Lever first(DIGITAL_LEVER, 20, 21);
+    Lever second(DIGITAL_LEVER, 22, 23);
+    first.begin();
+    second.begin();
+    HostMock::setDigital(20, LOW);
+    first.update();
+    HostMock::setDigital(22, LOW);
+    second.update();
+    HOST_CHECK(checks, first.getDigitalPosition() == 1 && second.getDigitalPosition() == 1,
+               "palancas digitales independientes");
+
+    // Pulsaciones contadas por interrupción aunque update() llegue tarde
+    second.setEdgeCapture(&capture);
+    HostMock::setDigital(22, HIGH);
+    for (uint8_t i = 0; i < 2; i++) {
+        HostMock::advanceUs(60000);
+        HostMock::setDigital(22, LOW);
+        HostMock::advanceUs(60000);
+        HostMock::setDigital(22, HIGH);
+    }
+    second.update();
+    HOST_CHECK(checks, second.getDigitalPosition() == 3, "pasos de la palanca contados en el flanco");
+}
+
+static void checkQuadratureEncoder(HostChecks& checks) {
+    HostMock::reset();
+    Lever encoder(ROTARY_ENCODER, 24, 25);
+    encoder.begin();
+    HOST_CHECK(checks, encoder.attachInterrupt() && strcmp(encoder.getEncoder().getBackendName(), "ISR") == 0,
+               "encoder por interrupciones en el host");
+
+    // Un ciclo completo hacia adelante entre dos update(): 4 pasos
+    HostMock::setDigital(24, LOW);
+    HostMock::setDigital(25, LOW);
+    HostMock::setDigital(24, HIGH);
+    HostMock::setDigital(25, HIGH);
+    encoder.update();
+    HOST_CHECK(checks, encoder.readEncoderSteps() == 4, "ciclo de cuadratura = 4 pasos");
+
+    // Ambos pines a la vez: flanco perdido, no cuenta
+    IsrEncoderBackend backend;
+    backend.onEdge(true, true);
+    HOST_CHECK(checks, backend.getCount() == 0 && backend.getErrorCount() == 1, "transición inválida detectada");
+}
+
+static void checkAnalogAcquisition(HostChecks& checks) {
+    HostMock::reset();
+    SyntheticAnalogSource source(13);
+    AnalogAcquisition acquisition;
+    acquisition.addChannel(5);
+    acquisition.addChannel(2);
+
+    // El arranque rellena los buffers con ceros; 5 ms después ya no quedan
+    HOST_CHECK(checks, acquisition.begin(&source, 20000), "AnalogAcquisition begin");
+    source.setValue(5, 1000);
+    source.setValue(2, 3000);
+    delay(5);
+    acquisition.poll();
+    HOST_CHECK(checks, acquisition.read(5) == 1000 && acquisition.read(2) == 3000, "canales filtrados");
+    HOST_CHECK(checks, acquisition.read(9) == -1, "pin no registrado");
+    acquisition.end();
+}
+
+static void checkPacketCodec(HostChecks& checks) {
+    DataPacket packet = {};
+    packet.packetId = 7;
+    packet.timestamp = 1234;
+    packet.frameType = FRAME_KEYFRAME;
+    packet.controlCount = 2;
+    packet.controls[0] = {0, CONTROL_JOYSTICK, -100, 55, 1, 0};
+    packet.controls[1] = {1, CONTROL_LEVER_ANALOG, 1000, 0, 0, 0};
+
+    uint8_t frame[PACKET_FRAME_MAX];
+    uint8_t length = PacketCodec::encode(packet, frame);
+    HOST_CHECK(checks, length > 0 && length <= PACKET_FRAME_MAX, "codificación en una trama");
+
+    DataPacket decoded = {};
+    bool complete = false;
+    uint8_t nextFragment = 0;
+    HOST_CHECK(checks, PacketCodec::decode(frame, length, decoded, complete, nextFragment) && complete, "decodificación");
+    HOST_CHECK(checks, decoded.controlCount == 2 && decoded.controls[0].valueX == -100 &&
+                       decoded.controls[1].valueX == 1000, "valores decodificados");
+
+    // Ocho controles con ids salteados y valores de 16 bits: tres fragmentos
+    packet.controlCount = PACKET_MAX_CONTROLS;
+    for (uint8_t i = 0; i < PACKET_MAX_CONTROLS; i++) {
+        packet.controls[i] = {(uint8_t)(i * 2), CONTROL_JOYSTICK, (int16_t)(-20000 - i), (int16_t)(20000 + i), 0x80, 0};
+    }
+    uint8_t fragments[PACKET_MAX_FRAGMENTS][PACKET_FRAME_MAX];
+    uint8_t lengths[PACKET_MAX_FRAGMENTS];
+    uint8_t count = 0;
+    uint8_t first = 0;
+    do {
+        uint8_t next;
+        lengths[count] = PacketCodec::encode(packet, fragments[count], first, count, next);
+        first = next;
+        count++;
+    } while (first < packet.controlCount && count < PACKET_MAX_FRAGMENTS);
+    HOST_CHECK(checks, count == 3 && PacketCodec::fragmentCount(packet) == 3, "paquete en tres fragmentos");
+
+    // Fragmento repetido: se rechaza y el paquete termina con cada control una vez
+    decoded = {};
+    bool ordered = PacketCodec::decode(fragments[0], lengths[0], decoded, complete, nextFragment) &&
+                   PacketCodec::decode(fragments[1], lengths[1], decoded, complete, nextFragment);
+    bool duplicate = PacketCodec::decode(fragments[1], lengths[1], decoded, complete, nextFragment);
+    ordered = ordered && PacketCodec::decode(fragments[2], lengths[2], decoded, complete, nextFragment) && complete;
+    bool sameControls = decoded.controlCount == PACKET_MAX_CONTROLS;
+    for (uint8_t i = 0; sameControls && i < PACKET_MAX_CONTROLS; i++) {
+        sameControls = decoded.controls[i].id == i * 2 && decoded.controls[i].valueY == 20000 + i;
+    }
+    HOST_CHECK(checks, ordered && !duplicate && sameControls, "fragmento repetido rechazado");
+
+    // Fragmento perdido: los siguientes se rechazan y el paquete no se completa
+    decoded = {};
+    bool skipped = PacketCodec::decode(fragments[0], lengths[0], decoded, complete, nextFragment) &&
+                   !PacketCodec::decode(fragments[2], lengths[2], decoded, complete, nextFragment);
+    HOST_CHECK(checks, skipped && !complete && decoded.controlCount == 3, "fragmento perdido: paquete incompleto");
+}
+
+static void checkTxScheduler(HostChecks& checks) {
+    TxScheduler scheduler;
+    scheduler.setIntervals(5000, 100000, 250000);
+    scheduler.setHoldTime(20000);
+
+    // En movimiento: un paquete por ciclo de 5 ms
+    uint8_t payload[7] = {};
+    uint32_t now = 1000;
+    uint32_t sent = 0;
+    for (uint8_t i = 0; i < 10; i++, now += 5000) {
+        payload[0] = i;
+        sent += scheduler.poll(payload, sizeof(payload), now);
+    }
+    HOST_CHECK(checks, sent == 10, "TxScheduler: cada ciclo en movimiento");
+
+    // En reposo: el intervalo crece hasta el latido y se mantiene
+    uint32_t lastSend = now, maxGap = 0;
+    sent = 0;
+    for (uint16_t i = 0; i < 400; i++, now += 5000) {
+        if (scheduler.poll(payload, sizeof(payload), now)) {
+            if (now - lastSend > maxGap) maxGap = now - lastSend;
+            lastSend = now;
+            sent++;
+        }
+    }
+    HOST_CHECK(checks, maxGap == 100000 && sent < 40 && scheduler.getIntervalUs() == 100000,
+               "TxScheduler: latido en reposo");
+
+    // Un envío forzado sale en el siguiente ciclo sin volver al ritmo activo
+    scheduler.forceSend();
+    bool forced = scheduler.poll(payload, sizeof(payload), now);
+    now += 5000;
+    HOST_CHECK(checks, forced && !scheduler.poll(payload, sizeof(payload), now) &&
+                       scheduler.getIntervalUs() == 100000, "TxScheduler: envío forzado sin salir del latido");
+
+    // Un cambio vuelve al ritmo activo en el mismo ciclo
+    payload[1] = 1;
+    HOST_CHECK(checks, scheduler.poll(payload, sizeof(payload), now) && scheduler.getIntervalUs() == 5000,
+               "TxScheduler: cambio enviado sin esperar");
+
+    scheduler.setIntervals(5000, 500000, 250000);
+    HOST_CHECK(checks, scheduler.getHeartbeatUs() == 250000, "TxScheduler: latido limitado por el failsafe");
+}
+
+static void countRadioTx(const RadioTxResult& result, void* context) {
+    uint32_t* counts = static_cast<uint32_t*>(context);
+    counts[result.status]++;
+}
+
+static void checkRadioTx(HostChecks& checks) {
+    HostMock::reset();
+    const uint64_t address = 0xE8E8F0F0E1ULL;
+    uint8_t payload[7] = {1, 2, 3, 4, 5, 6, 7};
+
+    RF24 radio(6, 7);
+    RF24 receiver(16, 17);
+    radio.begin();
+    receiver.begin();
+    radio.setDataRate(RF24_250KBPS);
+    receiver.setDataRate(RF24_250KBPS);
+    radio.setPayloadSize(sizeof(payload));
+    receiver.setPayloadSize(sizeof(payload));
+    radio.openWritingPipe(address);
+    radio.stopListening();
+    receiver.openReadingPipe(1, address);
+    receiver.startListening();
+
+    uint32_t counts[4] = {};
+    RadioTx tx;
+    tx.begin(&radio);
+    tx.onComplete(countRadioTx, counts);
+
+    // El paquete sale mientras la tarea sigue; poll() lo da por enviado en el ciclo siguiente
+    HOST_CHECK(checks, tx.submit(payload, sizeof(payload), micros()) && tx.inFlight() == 1 && !receiver.available(),
+               "RadioTx: submit() no espera al aire");
+    HostMock::advanceUs(5000);
+    HOST_CHECK(checks, tx.poll(micros()) == 1 && counts[RADIO_TX_SENT] == 1 && receiver.available(),
+               "RadioTx: TX_DS visto en poll()");
+
+    // Receptor fuera de alcance: los reintentos no bloquean, la cola no crece
+    receiver.setChannel(100);
+    bool submitted = true;
+    for (uint8_t i = 0; i < 40; i++) {
+        HostMock::advanceUs(5000);
+        tx.poll(micros());
+        submitted = tx.submit(payload, sizeof(payload), micros()) && submitted;
+    }
+    RadioTxStats stats = tx.getStats();
+    HOST_CHECK(checks, submitted && stats.maxInFlight <= RADIO_TX_FIFO_DEPTH && stats.sent == 1 &&
+                       counts[RADIO_TX_DROPPED] + counts[RADIO_TX_FAILED] == stats.submitted - 1 - tx.inFlight(),
+               "RadioTx: sin receptor se descartan paquetes sin bloquear");
+
+    // Pocos reintentos: MAX_RT antes del ciclo siguiente
+    tx.flush(micros());
+    tx.setDepth(1);
+    radio.setRetries(1, 3);
+    uint32_t failed = counts[RADIO_TX_FAILED];
+    tx.submit(payload, sizeof(payload), micros());
+    HostMock::advanceUs(5000);
+    tx.poll(micros());
+    HOST_CHECK(checks, counts[RADIO_TX_FAILED] == failed + 1 && tx.isIdle(), "RadioTx: MAX_RT informado como fallo");
+}
+
+static void countTelemetryAck(const RadioTxResult& result, void* context) {
+    TelemetryLink* link = static_cast<TelemetryLink*>(context);
+    if (result.status != RADIO_TX_DROPPED) link->onAck(result.status == RADIO_TX_SENT);
+}
+
+// Receptor de test/receptor_telemetria.cpp: lee los paquetes y deja la telemetría para el próximo ACK
+static void serviceTelemetryReceiver(RF24& receiver, TelemetryResponder& responder) {
+    uint8_t frame[32];
+    bool received = false;
+    while (receiver.available()) {
+        uint8_t length = receiver.getDynamicPayloadSize();
+        receiver.read(frame, length);
+        responder.onPacket(frame[length - 1], receiver.testRPD());
+        received = true;
+    }
+    if (received) {
+        uint8_t length = responder.build(frame, 7400, -1250, TELEMETRY_FLAG_LOW_BATTERY);
+        receiver.flush_tx();
+        receiver.writeAckPayload(1, frame, length);
+    }
+}
+
+static void checkTelemetry(HostChecks& checks) {
+    TelemetryFrame frame = {42, 7400, -1250, 87, TELEMETRY_FLAG_FAILSAFE};
+    TelemetryFrame decoded = {};
+    uint8_t buffer[TELEMETRY_FRAME_SIZE];
+    uint8_t length = TelemetryCodec::encode(frame, buffer);
+    HOST_CHECK(checks, TelemetryCodec::decode(buffer, length, decoded) && decoded.ackSequence == 42 &&
+                       decoded.batteryMv == 7400 && decoded.motorCurrentMa == -1250 && decoded.rssi == 87 &&
+                       decoded.flags == TELEMETRY_FLAG_FAILSAFE, "Telemetry: trama codificada y decodificada");
+    uint8_t keyframeRequest = PACKET_ACK_KEYFRAME_REQUEST;
+    HOST_CHECK(checks, !TelemetryCodec::decode(&keyframeRequest, 1, decoded), "Telemetry: otras cargas de ACK rechazadas");
+
+    HostMock::reset();
+    const uint64_t address = 0xE8E8F0F0E1ULL;
+    RF24 radio(6, 7);
+    RF24 receiver(16, 17);
+    radio.begin();
+    receiver.begin();
+    RF24* radios[] = {&radio, &receiver};
+    for (RF24* r : radios) {
+        r->setDataRate(RF24_250KBPS);
+        r->setAutoAck(true);
+        r->enableDynamicPayloads();
+        r->enableAckPayload();
+        r->setRetries(5, 1);
+    }
+    radio.openWritingPipe(address);
+    radio.stopListening();
+    receiver.openReadingPipe(1, address);
+    receiver.startListening();
+
+    TelemetryLink link;
+    TelemetryResponder responder;
+    RadioTx tx;
+    tx.begin(&radio);
+    tx.setDepth(1);
+    tx.onComplete(countTelemetryAck, &link);
+
+    // Mismo ciclo que controlTick() en modo bidireccional, a 200 Hz
+    uint8_t packet[7 + TELEMETRY_SEQUENCE_SIZE] = {1, 2, 3, 4, 5, 0, 0, 0};
+    for (uint8_t tick = 0; tick < 20; tick++) {
+        if (tick == 10) receiver.setChannel(100);   // Receptor fuera de alcance
+        uint32_t now = micros();
+        tx.poll(now);
+        while (radio.available()) {
+            uint8_t size = radio.getDynamicPayloadSize();
+            radio.read(buffer, size);
+            link.parse(buffer, size, now);
+        }
+        if (tick == 9) {
+            TelemetryState state = link.getState();
+            HOST_CHECK(checks, state.valid && state.frame.batteryMv == 7400 && state.frame.motorCurrentMa == -1250 &&
+                               (state.frame.flags & TELEMETRY_FLAG_LOW_BATTERY) && state.frame.rssi == 100,
+                       "Telemetry: datos del receptor en la carga del ACK");
+            // El eco llega en el ACK del paquete siguiente: un ciclo y algo
+            HOST_CHECK(checks, state.rttUs >= 5000 && state.rttUs <= 10000 && state.ackRate == 100,
+                       "Telemetry: ida y vuelta medida con la secuencia devuelta");
+        }
+        packet[7] = link.nextSequence(now);
+        tx.submit(packet, sizeof(packet), now);
+        HostMock::advanceUs(2500);
+        serviceTelemetryReceiver(receiver, responder);
+        HostMock::advanceUs(2500);
+    }
+    TelemetryStats stats = link.getStats();
+    HOST_CHECK(checks, link.getState().ackRate < 100 && stats.lost > 0 && !link.isFresh(micros(), 20000),
+               "Telemetry: sin ACK baja la tasa y la telemetría caduca");
+}
+
+static void checkLinkQuality(HostChecks& checks) {
+    HostMock::reset();
+    const uint64_t address = 0xE8E8F0F0E1ULL;
+    RF24 radio(6, 7);
+    RF24 receiver(16, 17);
+    radio.begin();
+    receiver.begin();
+    RF24* radios[] = {&radio, &receiver};
+    for (RF24* r : radios) {
+        r->setDataRate(RF24_250KBPS);
+        r->setAutoAck(true);
+        r->setRetries(1, 5);
+    }
+    radio.openWritingPipe(address);
+    radio.stopListening();
+    receiver.openReadingPipe(1, address);
+    receiver.startListening();
+
+    // Un paquete cada 5 ms; el receptor vacía su FIFO en cada ciclo. La ventana son los
+    // últimos 10 cubos de 100 ms, el actual incluido aunque acabe de empezar.
+    LinkQuality link;
+    uint8_t packet[7] = {1, 2, 3, 4, 5, 6, 7};
+    uint8_t buffer[32];
+    uint32_t lost = 0;
+    for (uint16_t tick = 0; tick < 600; tick++) {
+        if (tick == 200) HostMock::setRadioLoss(50);
+        if (tick == 400) receiver.setChannel(100);   // Receptor fuera de alcance
+        bool acked = radio.write(packet, sizeof(packet));
+        if (!acked) lost++;
+        link.observe(radio, acked, millis());
+        while (receiver.available()) receiver.read(buffer, sizeof(packet));
+        HostMock::advanceUs(5000);
+
+        if (tick == 199) {
+            LinkQualityReport report = link.getReport(millis());
+            HOST_CHECK(checks, report.valid && report.score == 100 && report.lossPercent == 0 &&
+                               report.retransmits == 0 && report.packets >= 180 && report.windowMs == 1000,
+                       "LinkQuality: enlace limpio, ventana de 1 s");
+        }
+        if (tick == 399) {
+            LinkQualityReport report = link.getReport(millis());
+            HOST_CHECK(checks, report.retriesX100 >= 50 && report.score < 80 && report.score > 20 &&
+                               report.lossPercent < 5, "LinkQuality: reintentos (ARC_CNT) bajan la puntuación");
+        }
+    }
+    HostMock::setRadioLoss(0);
+
+    LinkQualityReport report = link.getReport(millis());
+    HOST_CHECK(checks, report.lossPercent == 100 && report.retriesX100 == 500 && report.score < 10,
+               "LinkQuality: pérdidas por ventana");
+    HOST_CHECK(checks, report.plosTotal == lost, "LinkQuality: perdidos acumulados más allá de 15");
+
+    // Sin paquetes la ventana se vacía y la puntuación se mantiene
+    HostMock::advanceUs(2000000);
+    LinkQualityReport idle = link.getReport(millis());
+    HOST_CHECK(checks, idle.packets == 0 && idle.score == report.score, "LinkQuality: la ventana caduca");
+
+    // Latencias: percentiles de las últimas LINK_QUALITY_RTT_SAMPLES muestras (37..100 x 100 us)
+    for (uint32_t i = 1; i <= 100; i++) link.onRoundTrip(i * 100);
+    report = link.getReport(millis());
+    HOST_CHECK(checks, report.rttSamples == 64 && report.rttP50Us == 6800 && report.rttP99Us == 9900 &&
+                       report.rttMaxUs == 10000, "LinkQuality: percentiles de ida y vuelta");
+}
+
+static void checkFrequencyHop(HostChecks& checks) {
+    HostMock::reset();
+    const uint64_t address = 0xE8E8F0F0E1ULL;
+
+    // Misma dirección, misma secuencia: 16 canales distintos dentro de la banda
+    HopSequence sequence, copy, other;
+    sequence.begin(address);
+    copy.begin(address);
+    other.begin(address + 1);
+    bool same = true, differs = false, valid = true;
+    for (uint8_t slot = 0; slot < HOP_SLOTS; slot++) {
+        uint8_t channel = sequence.getBaseChannel(slot);
+        if (copy.getBaseChannel(slot) != channel) same = false;
+        if (other.getBaseChannel(slot) != channel) differs = true;
+        if (channel < HOP_CHANNEL_MIN || channel > HOP_CHANNEL_MAX) valid = false;
+        for (uint8_t previous = 0; previous < slot; previous++) {
+            if (sequence.getBaseChannel(previous) == channel) valid = false;
+        }
+        int spacing = slot ? channel - sequence.getBaseChannel(slot - 1) : HOP_MIN_SPACING;
+        if (spacing < HOP_MIN_SPACING && -spacing < HOP_MIN_SPACING) valid = false;
+    }
+    HOST_CHECK(checks, same && differs, "FrequencyHop: secuencia determinista por dirección");
+    HOST_CHECK(checks, valid, "FrequencyHop: canales distintos, en la banda y separados");
+
+    // Lista negra: la ranura toma el canal de la anterior no vetada; la de sincronismo nunca se veta
+    sequence.setBlacklist(0x0007);
+    HOST_CHECK(checks, sequence.getBlacklist() == 0x0006 && sequence.getChannel(2) == sequence.getBaseChannel(0) &&
+                       sequence.getChannel(3) == sequence.getBaseChannel(3), "FrequencyHop: sustitución de la lista negra");
+
+    // Trailer: ranura, instante en unidades de 100 us y lista negra
+    uint8_t frame[HOP_TRAILER_SIZE];
+    HopTrailer trailer = {5, 12345, 0x0F0E};
+    HopTrailer decoded = {};
+    HopCodec::encode(trailer, frame);
+    bool roundTrip = HopCodec::decode(frame, decoded) && decoded.slot == 5 && decoded.offsetUs == 12300 &&
+                     decoded.blacklist == 0x0F0E;
+    frame[0] = HOP_SLOTS;
+    HOST_CHECK(checks, roundTrip && !HopCodec::decode(frame, decoded), "FrequencyHop: trailer de ida y vuelta");
+
+    // Receptor: espera en la ranura de sincronismo, engancha con un paquete y salta solo
+    RF24 receiver(16, 17);
+    receiver.begin();
+    receiver.startListening();
+    HopReceiver hop;
+    hop.begin(&receiver, address, micros());
+    bool parked = !hop.isSynced() && receiver.getChannel() == copy.getBaseChannel(HOP_SYNC_SLOT);
+
+    trailer = {3, 2500, 0};
+    HopCodec::encode(trailer, frame);
+    hop.onPacket(frame, micros());
+    bool locked = hop.isSynced() && hop.getSlot() == 3 && receiver.getChannel() == copy.getBaseChannel(3);
+    // Inicio de la ranura: recepción - instante en el trailer - latencia de recepción
+    HostMock::advanceUs(HOP_DEFAULT_SLOT_US - trailer.offsetUs - HOP_RX_LATENCY_US + 100);
+    hop.update(micros());
+    HOST_CHECK(checks, parked && locked && hop.getSlot() == 4 && receiver.getChannel() == copy.getBaseChannel(4),
+               "FrequencyHop: el receptor engancha con un paquete y salta");
+
+    HostMock::advanceUs((uint64_t)HOP_LOST_CYCLES * HOP_SLOTS * HOP_DEFAULT_SLOT_US);
+    hop.update(micros());
+    HOST_CHECK(checks, !hop.isSynced() && hop.getLostSyncs() == 1 &&
+                       receiver.getChannel() == copy.getBaseChannel(HOP_SYNC_SLOT),
+               "FrequencyHop: sin paquetes vuelve a la ranura de sincronismo");
+}
+
+static void checkRadio(HostChecks& checks) {
+    HostMock::reset();
+    const uint64_t toReceiver = 0xE8E8F0F0E1ULL;
+    const uint64_t toTransmitter = 0xE8E8F0F0E2ULL;
+
+    NRF24Controller transmitter(6, 7);
+    NRF24Controller receiver(16, 17);
+    HOST_CHECK(checks, transmitter.begin() && receiver.begin(), "NRF24Controller begin");
+    transmitter.setAddresses(toReceiver, toTransmitter);
+    receiver.setAddresses(toTransmitter, toReceiver);
+    receiver.startListening();
+
+    HostMock::setAnalog(5, 2048);
+    HostMock::setAnalog(2, 2048);
+    Joystick joystick(5, 2);
+    joystick.begin();
+    HostMock::setAnalog(5, 4095);
+    HostMock::setAnalog(2, 0);
+    transmitter.addJoystick(&joystick, 3);
+    HOST_CHECK(checks, transmitter.sendData(), "envío con ACK");
+
+    DataPacket packet = {};
+    HOST_CHECK(checks, receiver.readData(packet), "recepción");
+    ControlData control = {};
+    HOST_CHECK(checks, receiver.readControlData(3, control) && control.valueX == joystick.readX() &&
+                       control.valueY == joystick.readY(), "control recibido");
+
+    // Sin bloqueo: sendData() solo encola, update() recoge el ACK
+    transmitter.setNonBlocking(true);
+    uint32_t sentBefore = transmitter.getStats().packetsSent;
+    HostMock::setAnalog(5, 0);
+    HOST_CHECK(checks, transmitter.sendData() && transmitter.getStats().packetsSent == sentBefore &&
+                       !transmitter.isTxIdle(), "envío sin bloqueo encolado");
+    HostMock::advanceUs(5000);
+    transmitter.update();
+    HOST_CHECK(checks, transmitter.isTxIdle() && transmitter.getStats().packetsSent == sentBefore + 1 &&
+                       receiver.readData(packet), "ACK recogido en update()");
+    transmitter.setNonBlocking(false);
+
+    // Sin receptor en el canal los reintentos se agotan
+    receiver.setChannel(100);
+    transmitter.requestKeyframe();
+    HOST_CHECK(checks, !transmitter.sendData(), "envío sin receptor falla");
+}
+
+static void checkSeqLock(HostChecks& checks) {
+    SeqLock<ControlLimitsTest> lock;
+    ControlLimitsTest value = {{1, 2, 3}};
+    lock.publish(value);
+    HOST_CHECK(checks, lock.getVersion() == 1, "SeqLock versión publicada");
+
+    // Una publicación durante la lectura no toca el buffer que se está leyendo
+    uint32_t token;
+    const ControlLimitsTest* read = lock.beginRead(token);
+    value.v[0] = 10;
+    lock.publish(value);
+    HOST_CHECK(checks, read->v[0] == 1 && lock.endRead(token), "SeqLock lectura válida tras una publicación");
+
+    // La segunda reescribe ese buffer: la lectura se descarta
+    read = lock.beginRead(token);
+    lock.beginWrite().v[0] = 20;
+    HOST_CHECK(checks, lock.endRead(token), "SeqLock escritura en el buffer trasero");
+    lock.endWrite();
+    read = lock.beginRead(token);
+    value.v[0] = 30;
+    lock.publish(value);
+    lock.publish(value);
+    HOST_CHECK(checks, !lock.endRead(token), "SeqLock detecta lectura rota");
+
+    ControlLimitsTest copy = {};
+    HOST_CHECK(checks, lock.read(copy) && copy.v[0] == 30 && lock.getVersion() == 5, "SeqLock read()");
+}
+
+// Imagen de perfil con las tres palancas de límite a 'limit' y la radio dada
+static void makeProfileImage(ControlLimits& image, uint8_t profile, uint8_t limit, uint64_t address,
+                             uint8_t channel, uint8_t paLevel) {
+    image = ControlLimits();
+    for (uint8_t i = 0; i < PALANCAS_COUNT; i++) {
+        memset(image.palanca[i], limit, 3);
+    }
+    ResponseCurveConfig linear;
+    ResponseCurve::defaultConfig(linear);
+    for (uint8_t i = 0; i < CURVAS_COUNT; i++) {
+        image.curves[i].build(linear);
+    }
+    image.radio.address = address;
+    image.radio.channel = channel;
+    image.radio.paLevel = paLevel;
+    image.profile = profile;
+    image.publishedUs = micros();
+}
+
+static void checkProfileSwitch(HostChecks& checks) {
+    HostMock::reset();
+    RF24 radio(6, 7);
+    radio.begin();
+    radio.stopListening();
+
+    SeqLock<ControlLimits> images;
+    ControlLimits image;
+    makeProfileImage(image, 0, 100, 0xE8E8F0F0E1ULL, 76, RF24_PA_LOW);
+    images.publish(image);
+
+    ProfileSwitch profileSwitch;
+    HOST_CHECK(checks, profileSwitch.begin(&radio, images.front().radio, images.getVersion()) &&
+                       radio.getChannel() == 76 && radio.getPALevel() == RF24_PA_LOW &&
+                       profileSwitch.pending(images.front().radio) == 0, "ProfileSwitch aplica la radio inicial");
+
+    // Stick de velocidad a fondo: ch1 = límite de palanca1 del perfil
+    ControlInputs inputs = {};
+    inputs.izquierdo_Y = 255;
+    memset(inputs.palanca_position, 1, sizeof(inputs.palanca_position));
+
+    // La UI cambia de perfil y lo vuelve a editar mientras el lazo calcula el paquete:
+    // la lectura se descarta y se repite entera con la imagen nueva
+    Data_to_be_sent data = {};
+    RadioProfile radioProfile = {};
+    uint32_t token;
+    uint8_t attempts = 0;
+    do {
+        const ControlLimits* limits = images.beginRead(token);
+        computeSentData(inputs, limits->palanca, limits->curves, data);
+        if (attempts++ == 0) {
+            makeProfileImage(image, 1, 200, 0xE8E8F0F0E2ULL, 90, RF24_PA_MAX);
+            images.publish(image);
+            images.publish(image);
+        }
+        radioProfile = limits->radio;
+    } while (!images.endRead(token));
+    HOST_CHECK(checks, attempts == 2 && data.ch1 == 200 && radioProfile.channel == 90 &&
+                       radioProfile.address == 0xE8E8F0F0E2ULL, "paquete con límites y radio de la misma imagen");
+
+    // Radio del perfil nuevo aplicada antes del paquete, solo lo que cambió
+    HOST_CHECK(checks, profileSwitch.pending(radioProfile) ==
+                       (PROFILE_RADIO_ADDRESS | PROFILE_RADIO_CHANNEL | PROFILE_RADIO_PA),
+               "ProfileSwitch detecta dirección, canal y potencia nuevos");
+    HostMock::advanceUs(3000);
+    profileSwitch.apply(radioProfile);
+    profileSwitch.onFrame(token >> 1, images.front().publishedUs, micros());
+    profileSwitch.onFrame(token >> 1, images.front().publishedUs, micros() + 5000);
+    ProfileSwitchStats stats = profileSwitch.getStats();
+    HOST_CHECK(checks, radio.getChannel() == 90 && radio.getPALevel() == RF24_PA_MAX &&
+                       profileSwitch.pending(radioProfile) == 0 && stats.radioChanges == 1,
+               "ProfileSwitch reconfigura la radio entre paquetes");
+    HOST_CHECK(checks, stats.swaps == 1 && stats.lastLatencyUs == 3000 && stats.maxLatencyUs == 3000,
+               "latencia del cambio hasta el primer paquete con la imagen");
+
+    // Con salto de frecuencia el canal es de HopTransmitter
+    ProfileSwitch hopping;
+    hopping.begin(&radio, radioProfile, token >> 1, false);
+    radioProfile.channel = 10;
+    HOST_CHECK(checks, hopping.pending(radioProfile) == 0 && hopping.apply(radioProfile) == 0 &&
+                       radio.getChannel() == 90, "ProfileSwitch sin canal fijo no toca el canal");
+}
+
+struct ConfigWriteLog {
+    ConfigWriteResult results[8];
+    uint8_t count;
+};
+
+static void logWriteResult(const ConfigWriteResult& result, void* context) {
+    ConfigWriteLog* log = static_cast<ConfigWriteLog*>(context);
+    if (log->count < 8) log->results[log->count++] = result;
+}
+
+static void checkConfigStorage(HostChecks& checks) {
+    HostMock::reset();
+
+    // Perfil guardado antes de las curvas (sin clave "p<n>c"): curvas lineales.
+    // Sin directorio en flash begin() lee todos los perfiles, así que se escribe antes
+    // de la primera instancia
+    uint8_t values[CONFIG_VALUES_COUNT] = {};
+    Preferences preferences;
+    preferences.begin("config", false);
+    preferences.putBytes("p3v", values, CONFIG_VALUES_COUNT);
+    preferences.end();
+
+    {
+        ConfigStorage config;
+        HOST_CHECK(checks, config.begin(), "ConfigStorage begin");
+        config.setActiveProfile(2);
+        config.setSpeedLimits(10, 20, 30);
+        config.setNRFAddress(0x1122334455ULL);
+        ResponseCurveConfig curve = config.getCurve(1);
+        curve.type = CURVE_SCURVE;
+        curve.amount = 35;
+        config.setCurve(1, curve);
+        HOST_CHECK(checks, config.saveCurrentConfig(), "guardar perfil");
+        config.end();
+    }
+
+    // Una instancia nueva lee lo que quedó en "flash"
+    ConfigStorage config;
+    config.begin();
+    HOST_CHECK(checks, config.getActiveProfile() == 2, "perfil activo persistido");
+    HOST_CHECK(checks, config.getSpeedLimit(1) == 20 && config.getNRFAddress() == 0x1122334455ULL,
+               "valores persistidos");
+    HOST_CHECK(checks, config.getCurve(1).type == CURVE_SCURVE && config.getCurve(1).amount == 35 &&
+               config.getCurve(0).type == CURVE_LINEAR, "curvas persistidas");
+    HOST_CHECK(checks, HostMock::getPreferencesWrites() > 0, "escrituras contadas");
+
+    // Cambiar de perfil y guardar lo mismo varias veces no toca la flash
+    uint32_t writes = HostMock::getPreferencesWrites();
+    config.resetStats();
+    config.setActiveProfile(3);
+    HOST_CHECK(checks, config.getCurve(1).type == CURVE_LINEAR, "perfil sin curvas carga lineales");
+    config.setActiveProfile(2);
+    config.saveCurrentConfig();
+    config.saveCurrentConfig();
+    ConfigStorageStats stats = config.getStats();
+    HOST_CHECK(checks, HostMock::getPreferencesWrites() == writes && stats.switches == 2,
+               "cambio de perfil sin escribir en flash");
+    HOST_CHECK(checks, stats.unchangedSaves >= 2, "guardados repetidos detectados");
+
+    // Un cambio se escribe una sola vez tras el periodo sin cambios: su perfil y el directorio
+    config.setActiveProfile(3);
+    config.setSpeedLimit(0, 99);
+    config.saveCurrentConfig();
+    config.saveCurrentConfig();
+    uint32_t changedMs = millis();
+    HOST_CHECK(checks, config.hasPendingWrites() && !config.poll(changedMs + CONFIG_COMMIT_DELAY_MS - 1) &&
+               HostMock::getPreferencesWrites() == writes, "commit retrasado");
+    HOST_CHECK(checks, config.poll(changedMs + CONFIG_COMMIT_DELAY_MS) && !config.hasPendingWrites(),
+               "commit tras el periodo sin cambios");
+    stats = config.getStats();
+    HOST_CHECK(checks, stats.commits == 1 && stats.keysWritten == 2 &&
+               HostMock::getPreferencesWrites() == writes + 2, "solo el perfil y el directorio escritos");
+    HOST_CHECK(checks, !config.poll(changedMs + 2 * CONFIG_COMMIT_DELAY_MS), "sin commit si no hay cambios");
+
+    ConfigStorage reopened;
+    reopened.begin();
+    HOST_CHECK(checks, reopened.getActiveProfile() == 3 && reopened.getSpeedLimit(0) == 99,
+               "commit diferido persistido");
+
+    // Tarea de escritura: poll() solo encola; los resultados llegan en el siguiente poll()
+    ConfigWriteLog log = {};
+    reopened.onWriteComplete(logWriteResult, &log);
+    HOST_CHECK(checks, reopened.startWriter(), "tarea de escritura creada");
+    writes = HostMock::getPreferencesWrites();
+    reopened.setActiveProfile(1);
+    reopened.setSpeedLimit(2, 77);
+    reopened.saveCurrentConfig();
+    changedMs = millis();
+    HOST_CHECK(checks, reopened.poll(changedMs + CONFIG_COMMIT_DELAY_MS) &&
+               HostMock::getPreferencesWrites() == writes && reopened.hasPendingWrites(),
+               "poll con tarea solo encola");
+    HOST_CHECK(checks, reopened.processWrites() == 2 && log.count == 0, "la tarea escribe perfil y directorio");
+    reopened.poll(changedMs + CONFIG_COMMIT_DELAY_MS);
+    HOST_CHECK(checks, log.count == 2 && log.results[0].kind == CONFIG_WRITE_PROFILE && log.results[0].profile == 1 &&
+               log.results[1].kind == CONFIG_WRITE_DIRECTORY && log.results[0].success && log.results[1].success &&
+               !reopened.hasPendingWrites(), "resultados en orden en la tarea de UI");
+
+    // Fallo de escritura: el directorio no apunta a un perfil activo sin escribir, y se reintenta
+    HostMock::setPreferencesFail(true);
+    reopened.setActiveProfile(0);
+    reopened.setSpeedLimit(2, 55);
+    reopened.saveCurrentConfig();
+    changedMs = millis();
+    reopened.poll(changedMs + CONFIG_COMMIT_DELAY_MS);
+    reopened.processWrites();
+    HostMock::setPreferencesFail(false);
+    reopened.poll(changedMs + CONFIG_COMMIT_DELAY_MS);
+    {
+        Preferences check;
+        check.begin("config", true);
+        uint8_t blob[CONFIG_DIRECTORY_MAX];
+        size_t length = check.getBytes("dir", blob, sizeof(blob));
+        ConfigDirectoryRecord record;
+        HOST_CHECK(checks, ConfigCodec::decodeDirectory(blob, length, record) && record.active == 1 && log.count == 4 &&
+                   !log.results[2].success && !log.results[3].success, "perfil activo intacto si falla su perfil");
+    }
+    HOST_CHECK(checks, reopened.hasPendingWrites() && reopened.getStats().writeErrors == 2, "fallo pendiente de reintento");
+    uint32_t retryMs = millis();
+    reopened.poll(retryMs + CONFIG_COMMIT_DELAY_MS);
+    reopened.processWrites();
+    reopened.poll(retryMs + CONFIG_COMMIT_DELAY_MS);
+    HOST_CHECK(checks, !reopened.hasPendingWrites() && log.count == 6 && log.results[4].success && log.results[5].success,
+               "reintento tras el fallo");
+}
+
+static void checkConfigCodec(HostChecks& checks) {
+    ConfigProfile config;
+    ConfigCodec::defaults(config);
+    config.values[0] = 11;
+    config.values[14] = 3;
+    config.address = 0x0102030405ULL;
+    config.curves[2].type = CURVE_EXPO;
+    config.curves[2].amount = 60;
+
+    uint8_t blob[CONFIG_BLOB_MAX];
+    uint16_t length = ConfigCodec::encode(config, blob);
+    ConfigProfile decoded;
+    uint8_t version = 0xFF;
+    HOST_CHECK(checks, length <= CONFIG_BLOB_MAX && ConfigCodec::decode(blob, length, decoded, version) &&
+               version == CONFIG_BLOB_VERSION && memcmp(decoded.values, config.values, sizeof(config.values)) == 0 &&
+               decoded.address == config.address && decoded.curves[2].type == CURVE_EXPO &&
+               decoded.curves[2].amount == 60, "blob ida y vuelta");
+
+    uint8_t damaged[CONFIG_BLOB_MAX];
+    memcpy(damaged, blob, length);
+    damaged[length - 1] ^= 0x01;
+    HOST_CHECK(checks, !ConfigCodec::decode(damaged, length, decoded, version) &&
+               !ConfigCodec::decode(blob, length - 1, decoded, version), "blob dañado o cortado rechazado");
+
+    // Blob de otra versión a mano: sin intensidad y con una etiqueta que esta versión no conoce
+    uint8_t other[CONFIG_BLOB_HEADER_SIZE + 9] = {'C', 'P', 0, 9, 0, 0, 0, 0, 0,
+                                                   CONFIG_TAG_SPEED, 3, 7, 8, 9,
+                                                   0x7F, 2, 0xAA, 0xBB};
+    uint32_t crc = ConfigCodec::crc32(other, 5);
+    crc = ConfigCodec::crc32(other + CONFIG_BLOB_HEADER_SIZE, 9, crc);
+    memcpy(other + 5, &crc, 4);
+    HOST_CHECK(checks, ConfigCodec::decode(other, sizeof(other), decoded, version) && version == 0 &&
+               decoded.values[2] == 9 && decoded.values[3] == 128 && decoded.values[14] == 1,
+               "campos que faltan por defecto, etiquetas desconocidas saltadas");
+
+    // Versión 0 (claves sueltas): la migración valida la intensidad
+    uint8_t legacy[CONFIG_VALUES_COUNT] = {};
+    ConfigCodec::decodeLegacy(legacy, CONFIG_VALUES_COUNT, decoded);
+    HOST_CHECK(checks, ConfigCodec::upgrade(decoded, 0) && decoded.values[14] == 1 &&
+               !ConfigCodec::upgrade(decoded, CONFIG_BLOB_VERSION), "migración desde la versión 0");
+
+    // Perfil de 14 valores en claves sueltas: se migra a blob y se borran las claves
+    HostMock::reset();
+    uint8_t values14[14];
+    memset(values14, 42, sizeof(values14));
+    {
+        Preferences preferences;
+        preferences.begin("config", false);
+        preferences.putBytes("p1v", values14, sizeof(values14));
+        preferences.putULong64("p1a", 0x1122334455ULL);
+        preferences.putUChar("active", 1);
+        preferences.end();
+    }
+    {
+        ConfigStorage storage;
+        storage.begin();
+        HOST_CHECK(checks, storage.getSpeedLimit(0) == 42 && storage.getIntensityLimit() == 1 &&
+                   storage.getNRFAddress() == 0x1122334455ULL, "perfil de 14 valores migrado");
+        storage.end();
+    }
+    Preferences preferences;
+    preferences.begin("config", false);
+    HOST_CHECK(checks, preferences.isKey("p1") && !preferences.isKey("p1v") && !preferences.isKey("p1a"),
+               "blob escrito y claves sueltas borradas");
+
+    // Blob dañado: el perfil se trata como vacío (valores por defecto) y se cuenta
+    uint8_t stored[CONFIG_BLOB_MAX];
+    size_t storedLength = preferences.getBytes("p1", stored, sizeof(stored));
+    stored[storedLength / 2] ^= 0xFF;
+    preferences.putBytes("p1", stored, storedLength);
+    preferences.end();
+    ConfigStorage storage;
+    storage.begin();
+    HOST_CHECK(checks, storage.getStats().corruptProfiles == 1 && storage.getSpeedLimit(0) != 42,
+               "blob dañado detectado");
+}
+
+// Directorio de modelos: búsquedas, caché LRU y un arranque que no lee los perfiles
+// createProfile(): nombre obligatorio y único una vez recortado
+static void checkProfileNames(HostChecks& checks) {
+    HostMock::reset();
+    ConfigStorage config;
+    config.begin();
+
+    uint8_t first = config.createProfile("Camion grande");
+    uint8_t count = config.getProfileCount();
+    HOST_CHECK(checks, first != CONFIG_NO_PROFILE && config.getProfileName(first) == "Camion gran" &&
+               config.findProfileByName("Camion gran") == first, "nombre recortado");
+    HOST_CHECK(checks, config.createProfile("Camion granate") == CONFIG_NO_PROFILE &&
+               config.getProfileCount() == count, "nombre repetido tras recortar");
+    HOST_CHECK(checks, config.createProfile(nullptr) == CONFIG_NO_PROFILE && config.createProfile("") == CONFIG_NO_PROFILE &&
+               config.getProfileCount() == count, "modelo sin nombre rechazado");
+    config.end();
+}
+
+static void checkConfigDirectory(HostChecks& checks) {
+    HostMock::reset();
+    {
+        ConfigStorage config;
+        config.begin();
+        config.setProfileName(0, "Buggy");
+        config.end();
+    }
+
+    // Lecturas de begin() con un modelo y con el directorio lleno
+    uint32_t bootReads[2];
+    {
+        uint32_t reads = HostMock::getPreferencesReads();
+        ConfigStorage config;
+        config.begin();
+        bootReads[0] = HostMock::getPreferencesReads() - reads;
+
+        char name[CONFIG_NAME_SIZE];
+        for (uint8_t i = 1; i < MAX_PROFILES; i++) {
+            snprintf(name, sizeof(name), "Coche %u", i);
+            config.setActiveProfile(config.createProfile(name));
+            config.setSpeedLimit(0, i);
+            config.setNRFAddress(0xC0DE000000ULL + i);
+            config.saveCurrentConfig();
+        }
+        HOST_CHECK(checks, config.getProfileCount() == MAX_PROFILES && config.createProfile("Otro") == CONFIG_NO_PROFILE &&
+                   config.getStats().evictions > 0, "directorio lleno con la caché acotada");
+        config.end();
+    }
+
+    uint32_t reads = HostMock::getPreferencesReads();
+    ConfigStorage config;
+    config.begin();
+    bootReads[1] = HostMock::getPreferencesReads() - reads;
+    HOST_CHECK(checks, bootReads[1] == bootReads[0] && config.getStats().cacheMisses == 1 &&
+               config.getProfileCount() == MAX_PROFILES, "arranque sin leer los perfiles");
+    HOST_CHECK(checks, config.getActiveProfile() == MAX_PROFILES - 1 && config.getActiveProfileName() == "Coche 31" &&
+               config.getProfileName(0) == "Buggy", "nombres persistidos");
+
+    ConfigModelInfo info;
+    HOST_CHECK(checks, config.findProfileByName("Coche 17") == 17 && config.findProfileByName("Coche 99") == CONFIG_NO_PROFILE &&
+               config.findProfileByAddress(0xC0DE000000ULL + 5) == 5 && config.findProfileByAddress(1) == CONFIG_NO_PROFILE &&
+               config.getProfileInfo(20, info) && info.address == 0xC0DE000000ULL + 20 && config.getStats().cacheMisses == 1,
+               "búsqueda por nombre y dirección sin leer perfiles");
+
+    // Más modelos de los que caben en la caché: los expulsados se releen con sus valores
+    bool reloaded = true;
+    for (uint8_t i = 10; i < 16; i++) config.setActiveProfile(i);
+    for (uint8_t i = 10; i < 16; i++) {
+        config.setActiveProfile(i);
+        if (config.getSpeedLimit(0) != i) reloaded = false;
+    }
+    ConfigStorageStats stats = config.getStats();
+    HOST_CHECK(checks, reloaded && stats.evictions >= 6 && stats.cacheMisses == 13, "perfiles expulsados y releídos");
+    config.setActiveProfile(13);
+    config.setActiveProfile(14);
+    config.setActiveProfile(15);
+    uint8_t recent[3];
+    HOST_CHECK(checks, config.getStats().cacheMisses == stats.cacheMisses && config.getRecentProfiles(recent, 3) == 3 &&
+               recent[0] == 15 && recent[1] == 14 && recent[2] == 13, "recientes en RAM y por último uso");
+
+    HOST_CHECK(checks, !config.setProfileName(3, "Coche 4") && config.setProfileName(3, "Rally") &&
+               config.findProfileByName("Coche 3") == CONFIG_NO_PROFILE && config.findProfileByName("Rally") == 3,
+               "nombres únicos");
+    config.end();
+    {
+        ConfigStorage reopened;
+        reopened.begin();
+        HOST_CHECK(checks, reopened.getRecentProfiles(recent, 1) == 1 && recent[0] == 15 &&
+                   reopened.findProfileByName("Rally") == 3, "directorio persistido");
+    }
+
+    // Caché llena de perfiles sin escribir y la flash fallando: el cambio se rechaza y
+    // se queda el perfil actual (nunca valores por defecto para un modelo guardado)
+    {
+        ConfigStorage full;
+        full.begin();
+        HostMock::setPreferencesFail(true);
+        for (uint8_t i = 0; i < CONFIG_CACHE_SIZE; i++) {
+            full.setActiveProfile(i);
+            full.setSpeedLimit(0, 200 + i);
+            full.saveCurrentConfig();
+        }
+        uint8_t last = CONFIG_CACHE_SIZE - 1;
+        HOST_CHECK(checks, !full.setActiveProfile(20) && full.getActiveProfile() == last &&
+                   full.getSpeedLimit(0) == 200 + last && full.getStats().failedSwitches == 1,
+                   "cambio de perfil rechazado con la caché sin vaciar");
+        HostMock::setPreferencesFail(false);
+        HOST_CHECK(checks, full.setActiveProfile(20) && full.getSpeedLimit(0) == 20 &&
+                   full.getActiveProfileName() == "Coche 20", "cambio de perfil al recuperarse la flash");
+        full.end();
+    }
+
+    // Directorio dañado: se rehace desde los blobs (sin nombres) y se reescribe
+    Preferences preferences;
+    preferences.begin("config", false);
+    uint8_t blob[CONFIG_DIRECTORY_MAX];
+    size_t length = preferences.getBytes("dir", blob, sizeof(blob));
+    blob[length - 1] ^= 0xFF;
+    preferences.putBytes("dir", blob, length);
+    preferences.end();
+    ConfigStorage rebuilt;
+    rebuilt.begin();
+    HOST_CHECK(checks, rebuilt.getStats().rebuilds == 1 && rebuilt.getProfileCount() == MAX_PROFILES &&
+               rebuilt.findProfileByAddress(0xC0DE000000ULL + 7) == 7, "directorio reconstruido");
+}
+
+int runSmoke(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    HostChecks checks = {0, 0};
+
+    // Las librerías imprimen por Serial; aquí solo interesa el resultado
+    HostMock::setSerialOutput(false);
+    checkClock(checks);
+    checkJoystick(checks);
+    checkLever(checks);
+    checkSignalChain(checks);
+    checkResponseCurve(checks);
+    checkLeverTable(checks);
+    checkEdgeCapture(checks);
+    checkQuadratureEncoder(checks);
+    checkAnalogAcquisition(checks);
+    checkPacketCodec(checks);
+    checkTxScheduler(checks);
+    checkRadioTx(checks);
+    checkTelemetry(checks);
+    checkLinkQuality(checks);
+    checkFrequencyHop(checks);
+    checkRadio(checks);
+    checkSeqLock(checks);
+    checkProfileSwitch(checks);
+    checkConfigStorage(checks);
+    checkConfigCodec(checks);
+    checkProfileNames(checks);
+    checkConfigDirectory(checks);
+    HostMock::setSerialOutput(true);
+
+    printf("smoke: %u comprobaciones correctas, %u fallos\n", checks.passed, checks.failed);
+    return checks.failed == 0 ? 0 : 1;
+}
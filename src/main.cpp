@@ -7,140 +7,156 @@
 
 #include "ConfigStorage.h"
 #include <Joystick.h>
+#include <ControlLoop.h>
+#include <EdgeCapture.h>
+#include <AnalogAcquisition.h>
+#include <AnalogSources.h>
+#include <TransmitterLogic.h>
+#include <ControlState.h>
+#include <ProfileSwitch.h>
+#include <DisplayFlush.h>
+#include <UiBinding.h>
+#include <TxScheduler.h>
+#include <RadioTx.h>
+#include <TelemetryLink.h>
+#include <LinkQuality.h>
+#include <HopTransmitter.h>
 
 ConfigStorage config;
-Joystick joystick_izquierdo(5, 2, 4);
-Joystick joystick_derecho(8, 9, 10);
+Joystick joystick_izquierdo(JOYSTICK_IZQ_X, JOYSTICK_IZQ_Y, JOYSTICK_IZQ_BTN);
+Joystick joystick_derecho(JOYSTICK_DER_X, JOYSTICK_DER_Y, JOYSTICK_DER_BTN);
+
+// Botones de los joysticks por interrupción (flanco con marca de tiempo y antirrebote)
+EdgeCapture botones;
 
 #define TFT_LED 38
 #define BATTERY 3
 
 #define NRF24_CE 6
 #define NRF24_CSN 7
-#define P1_1 13
-#define P1_2 14
-
-#define P2_1 11
-#define P2_2 12
-
-#define P3_1 40
-#define P3_2 39 
-
-#define P4_1 16
-#define P4_2 17
-
+#define NRF24_IRQ RADIO_TX_NO_IRQ   // IRQ del NRF24 sin cablear: RadioTx consulta STATUS en cada ciclo
+// Pines de joysticks y palancas (P1_1 ... P4_2): TransmitterLogic.h
+
+
+// Frecuencia fija del lazo de control (lectura de entradas + transmisión NRF24)
+#define CONTROL_RATE_HZ 200
+// Frecuencia total de conversión del ADC en modo continuo (repartida entre los canales)
+#define ANALOG_SAMPLE_RATE_HZ 20000
+// Transmisión adaptativa: cada ciclo mientras cambian los canales (y TX_HOLD_US después),
+// luego el intervalo se duplica hasta el latido, que nunca supera el failsafe
+#define TX_ACTIVE_US (1000000UL / CONTROL_RATE_HZ)
+#define TX_HEARTBEAT_US 100000UL
+#define TX_FAILSAFE_US 250000UL
+#define TX_HOLD_US 200000UL
+// Modo bidireccional: auto-ACK con telemetría del receptor en la carga del ACK
+// (receptor: test/receptor_telemetria.cpp). Con 0 el enlace va sin ACK, como
+// espera test/receptor_beta.cpp.
+#define RADIO_TELEMETRY 0
+#define TELEMETRY_RETRY_DELAY 5         // (5 + 1) x 250 us: espera mínima para un ACK con carga a 250 kbps
+#define TELEMETRY_RETRIES 1             // Un reintento: el paquete termina antes del siguiente ciclo
+#define TELEMETRY_STALE_US 500000UL     // Sin telemetría durante este tiempo: enlace perdido en pantalla
+#define LINK_QUALITY_UI_MS 250          // Refresco del panel de calidad del enlace (pantalla ALCANCE)
+// Salto de frecuencia: 16 canales derivados de la dirección NRF, uno por ranura de
+// HOP_DEFAULT_SLOT_US, con lista negra de los canales ocupados. Con 0 se usa el canal
+// fijo de la configuración. El receptor debe tener el mismo valor (test/receptor_*.cpp).
+#define RADIO_HOPPING 0
+// Intervalo del reporte de jitter del lazo de control por Serial (0 = desactivado)
+#define CONTROL_STATS_INTERVAL_MS 5000
 
 SPIClass nrf_spi(HSPI);  // Usar HSPI para ESP32-S2
 RF24 radio(NRF24_CE, NRF24_CSN);
 
 const uint64_t my_radio_pipe = 0xE8E8F0F0E1LL;
-struct Data_to_be_sent {
-    byte ch1;
-    byte ch2;
-    byte ch3;
-    byte ch4;
-    byte ch5;
-    byte ch6;
-    byte ch7;
-};
 
-Data_to_be_sent sent_data;
+Data_to_be_sent sent_data;   // Solo la usa la tarea de control; los demás leen control_state
 bool nrf24_available = false;
-// Variables para almacenar el estado actual de las palancas
-uint8_t palanca1_position = 1; // Posición central por defecto
-uint8_t palanca2_position = 1;
-uint8_t palanca3_position = 1;
-uint8_t palanca4_position = 1;
-
-// Declarar los arrays antes de las funciones que los usan
+TxScheduler tx_scheduler;    // Decide en cada ciclo de control si sent_data sale al aire
+RadioTx radio_tx;            // Carga sent_data en la FIFO del NRF24 sin esperar a que salga
+TelemetryLink telemetry;     // Secuencia de los paquetes y telemetría leída de los ACK (RADIO_TELEMETRY)
+LinkQuality link_quality;    // Pérdidas, reintentos, RPD y latencia por ventana deslizante (RADIO_TELEMETRY)
+HopTransmitter hop_tx;       // Ranuras de salto, trailer de cada paquete y lista negra (RADIO_HOPPING)
+ProfileSwitch profile_switch; // Radio del perfil publicado, aplicada entre dos paquetes
+
+// Adquisición analógica continua (joysticks + batería) por DMA, con respaldo por analogRead
+AnalogAcquisition analog_input;
+DmaAnalogSource adc_dma;
+PollingAnalogSource adc_polling;
+
+// Tarea de control de alta prioridad: muestrea entradas, calcula sent_data y transmite
+ControlLoop control_loop;
+
+// Estado compartido entre tareas (ver ControlState.h):
+// - control_limits: imagen del perfil activo; la publica la UI, la lee el lazo de control
+// - control_state: lo publica el lazo de control, lo leen la UI y demás consumidores
+SeqLock<ControlLimits> control_limits;
+SeqLock<ControlState> control_state;
+
+void controlTick(void* context);
+void radioTxDone(const RadioTxResult& result, void* context);
+void readTelemetry(uint32_t now);
+
+// Vectores de edición de la UI (ui_events.c los modifica directamente en calibración).
+// El lazo de control no los lee: usa la copia publicada en control_limits.
 uint8_t palanca1[3] = {128, 128, 128};
 uint8_t palanca2[3] = {128, 128, 128};
 uint8_t palanca3[3] = {128, 128, 128};
 uint8_t palanca4[3] = {128, 128, 128};
 
-// Función para leer la posición de la palanca 1
-uint8_t readPalanca1Position() {
-    bool pin1 = digitalRead(P1_1);
-    bool pin2 = digitalRead(P1_2);
-    
-    if (!pin1 && pin2) {
-        return 0; // Posición 0
-    } else if (pin1 && pin2) {
-        return 1; // Posición 1 (centro)
-    } else if (pin1 && !pin2) {
-        return 2; // Posición 2
+// Palancas de 3 posiciones: tabla de pines en TransmitterLogic.h, una lectura de GPIO por ciclo
+PalancaTable palancas(PALANCA_PINS);
+
+// Vector de cada palanca, en el mismo orden que PALANCA_PINS
+static uint8_t* const palanca_vectors[PALANCAS_COUNT] = {palanca1, palanca2, palanca3, palanca4};
+void loadPalancaVectors();
+
+// Curvas de respuesta de ch1-ch4 ya precalculadas (las construye la tarea de UI al
+// cargar el perfil o editar una curva; el lazo de control usa la copia publicada)
+static_assert(CONFIG_CURVES_COUNT == CURVAS_COUNT, "Una curva guardada por canal de joystick");
+ResponseCurve response_curves[CURVAS_COUNT];
+void loadResponseCurves();
+
+static bool sameControlLimits(const ControlLimits& a, const ControlLimits& b) {
+    if (memcmp(a.palanca, b.palanca, sizeof(a.palanca)) != 0 || a.profile != b.profile) return false;
+    if (a.radio.address != b.radio.address || a.radio.channel != b.radio.channel ||
+        a.radio.paLevel != b.radio.paLevel) return false;
+    for (uint8_t i = 0; i < CURVAS_COUNT; i++) {
+        if (a.curves[i] != b.curves[i]) return false;
     }
-    return 1; // Por defecto centro
+    return true;
 }
 
-// Función para leer la posición de la palanca 2
-uint8_t readPalanca2Position() {
-    bool pin1 = digitalRead(P2_1);
-    bool pin2 = digitalRead(P2_2);
-    
-    if (!pin1 && pin2) {
-        return 0; // Posición 0
-    } else if (pin1 && pin2) {
-        return 1; // Posición 1 (centro)
-    } else if (pin1 && !pin2) {
-        return 2; // Posición 2
+// Publica la imagen del perfil (vectores y curvas de la UI, radio de la configuración)
+// para el lazo de control, solo si cambió. Se llama desde la tarea de UI: todas las
+// ediciones de una vuelta, y un cambio de perfil completo, se ven juntas.
+void publishControlLimits() {
+    ControlLimits limits;
+    for (uint8_t i = 0; i < PALANCAS_COUNT; i++) {
+        memcpy(limits.palanca[i], palanca_vectors[i], 3);
     }
-    return 1; // Por defecto centro
-}
-
-// Función para leer la posición de la palanca 3
-uint8_t readPalanca3Position() {
-    bool pin1 = digitalRead(P3_1);
-    bool pin2 = digitalRead(P3_2);
-    
-    if (!pin1 && pin2) {
-        return 0; // Posición 0
-    } else if (pin1 && pin2) {
-        return 1; // Posición 1 (centro)
-    } else if (pin1 && !pin2) {
-        return 2; // Posición 2
+    for (uint8_t i = 0; i < CURVAS_COUNT; i++) {
+        limits.curves[i] = response_curves[i];
     }
-    return 1; // Por defecto centro
-}
-
-// Función para leer la posición de la palanca 4
-uint8_t readPalanca4Position() {
-    bool pin1 = digitalRead(P4_1);
-    bool pin2 = digitalRead(P4_2);
-    
-    if (!pin1 && pin2) {
-        return 0; // Posición 0
-    } else if (pin1 && pin2) {
-        return 1; // Posición 1 (centro)
-    } else if (pin1 && !pin2) {
-        return 2; // Posición 2
+    limits.radio.address = config.getNRFAddress();
+    limits.radio.channel = config.getExtraConfig();
+    limits.radio.paLevel = ProfileSwitch::paLevelFor(config.getIntensityLimit());
+    limits.profile = config.getActiveProfile();
+
+    if (control_limits.getVersion() == 0 || !sameControlLimits(limits, control_limits.front())) {
+        limits.publishedUs = micros();
+        control_limits.publish(limits);
     }
-    return 1; // Por defecto centro
-}
-
-// Función para actualizar todas las posiciones de las palancas
-void updatePalancasPositions() {
-    palanca1_position = readPalanca1Position();
-    palanca2_position = readPalanca2Position();
-    palanca3_position = readPalanca3Position();
-    palanca4_position = readPalanca4Position();
 }
 
-// Función para obtener el valor configurado según la posición de la palanca
-uint8_t getPalanca1Value() {
-    return palanca1[palanca1_position];
-}
-
-uint8_t getPalanca2Value() {
-    return palanca2[palanca2_position];
-}
-
-uint8_t getPalanca3Value() {
-    return palanca3[palanca3_position];
-}
-
-uint8_t getPalanca4Value() {
-    return palanca4[palanca4_position];
+// Valor configurado según la posición actual de la palanca (último ciclo de control)
+uint8_t getPalancaValue(uint8_t palanca) {
+    uint32_t state_token, limits_token;
+    uint8_t value;
+    do {
+        const ControlState* state = control_state.beginRead(state_token);
+        const ControlLimits* limits = control_limits.beginRead(limits_token);
+        value = limits->palanca[palanca][state->inputs.palanca_position[palanca]];
+    } while (!control_state.endRead(state_token) || !control_limits.endRead(limits_token));
+    return value;
 }
 
 static uint8_t original_turn_limits[3] = {0, 0, 0};
@@ -173,6 +189,7 @@ bool palanca4_calibration_mode = false;
 bool settings_calibration_mode = false;
 bool intensidad_calibration_mode = false;
 bool canal_calibration_mode = false; // << añadido
+bool curva_calibration_mode = false;
 
 extern "C" {
     void applyBrightness(int brightness_value);
@@ -189,8 +206,11 @@ extern "C" {
     void setBoostLimits(uint8_t pos1, uint8_t pos2, uint8_t pos3);
     void getExtraLimits(uint8_t* pos1, uint8_t* pos2, uint8_t* pos3);
     void setExtraLimits(uint8_t pos1, uint8_t pos2, uint8_t pos3);
-    void setActiveProfile(uint8_t profile);
+    bool setActiveProfile(uint8_t profile);
     uint8_t getActiveProfile();
+    uint8_t getRecentModels(uint8_t* profiles, uint8_t max);
+    void getModelName(uint8_t profile, char* name, uint8_t size);
+    bool createModel(uint8_t* profile);
     void setIntensity(uint8_t intensity);
     uint8_t getIntensityLimit();
     void clearAllProfiles();
@@ -203,34 +223,107 @@ extern "C" {
     // getters/setters para índice 13 (canal)
     void setExtraConfig(uint8_t value);
     uint8_t getExtraConfig(void);
+
+    // Curvas de respuesta (canal 0-3 = ch1-ch4, puntos: RESPONSE_CURVE_POINTS valores)
+    void getCurve(uint8_t canal, uint8_t* tipo, uint8_t* cantidad, uint8_t* puntos);
+    void setCurve(uint8_t canal, uint8_t tipo, uint8_t cantidad, const uint8_t* puntos);
+    void previewCurve(uint8_t canal, uint8_t tipo, uint8_t cantidad, const uint8_t* puntos);
+    void updateCurves();
 }
 
 TFT_eSPI tft = TFT_eSPI(); 
 static const uint16_t screenWidth  = 320;
 static const uint16_t screenHeight = 240;
-static lv_disp_draw_buf_t draw_buf;
-static lv_color_t buf[ screenWidth * screenHeight / 10 ];
+
+// Flush de LVGL por DMA con dos buffers de 1/10 de pantalla: LVGL dibuja una franja
+// mientras la anterior se envía por SPI
+DisplayFlush display;
+// false si no hubo memoria para el buffer de dibujo: el mando sigue funcionando sin pantalla
+bool ui_available = false;
 
 // Añadir un style global (inicializarlo UNA vez en setup)
 static lv_style_t style_bar_indicator;
 
-void my_disp_flush( lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p )
-{
-    uint32_t w = ( area->x2 - area->x1 + 1 );
-    uint32_t h = ( area->y2 - area->y1 + 1 );
+// Enlace de widgets: solo se llama a LVGL si el valor cambió y el widget está en la pantalla cargada
+#define UI_JOYSTICK_THRESHOLD 3     // Cambio mínimo en las barras de joystick (0-255)
+#define UI_ANGLE_THRESHOLD 10       // Cambio mínimo del indicador (décimas de grado)
 
-    tft.startWrite();
-    tft.setAddrWindow( area->x1, area->y1, w, h );
-    tft.pushColors( ( uint16_t * )&color_p->full, w * h, true );
-    tft.endWrite();
+UiBinding ui_binding;
 
-    lv_disp_flush_ready( disp );
+// Un indicador de batería por pantalla
+static lv_obj_t** const battery_bars[] = {
+    &ui_Bar5, &ui_Bar4, &ui_Bar9, &ui_Bar1, &ui_Bar7, &ui_Bar6, &ui_Bar2, &ui_Bar3, &ui_Bar8
+};
+#define BATTERY_BARS_COUNT (sizeof(battery_bars) / sizeof(battery_bars[0]))
+int8_t bind_battery[BATTERY_BARS_COUNT];
+
+// Barras de los ejes: {barra de valor (positivo), barra de rango (negativo)}
+enum { EJE_IZQ_Y, EJE_IZQ_X, EJE_DER_Y, EJE_DER_X, EJES_COUNT };
+static lv_obj_t** const axis_bars[EJES_COUNT][2] = {
+    {&ui_BarJoystickIzquierdoSup1, &ui_BarJoystickIzquierdoSup2},
+    {&ui_BarJoystickIzquierdoSup5, &ui_BarJoystickIzquierdoSup6},
+    {&ui_BarJoystickIzquierdoSup3, &ui_BarJoystickIzquierdoSup4},
+    {&ui_BarJoystickIzquierdoSup7, &ui_BarJoystickIzquierdoSup8}
+};
+int8_t bind_axis[EJES_COUNT][2];
+int8_t bind_speed_gauge;
+
+// Telemetría del receptor (solo en modo bidireccional; si no, se ocultan)
+enum { TELEM_BATERIA, TELEM_CORRIENTE, TELEM_RSSI, TELEM_RTT, TELEM_COUNT };
+static lv_obj_t** const telemetry_labels[TELEM_COUNT] = {
+    &ui_LabelCocheBateria, &ui_LabelCocheCorriente, &ui_LabelEnlaceRssi, &ui_LabelEnlaceRtt
+};
+static const char* const telemetry_formats[TELEM_COUNT] = {"%d mV", "%d mA", "RSSI %d%%", "%d ms"};
+static const uint16_t telemetry_thresholds[TELEM_COUNT] = {20, 50, 0, 0};
+int8_t bind_telemetry[TELEM_COUNT];
+
+// Calidad del enlace en la pantalla ALCANCE (solo con ACK: sin él no hay reintentos ni RPD)
+enum { ENLACE_CALIDAD, ENLACE_PERDIDA, ENLACE_REENVIOS, ENLACE_LATENCIA, ENLACE_COUNT };
+static lv_obj_t** const link_labels[ENLACE_COUNT] = {
+    &ui_LabelEnlaceCalidad, &ui_LabelEnlacePerdida, &ui_LabelEnlaceReenvios, &ui_LabelEnlaceLatencia
+};
+static const char* const link_formats[ENLACE_COUNT] = {"Calidad %d%%", "Perdida %d%%", "Reenvios %d%%", "p90 %d us"};
+int8_t bind_link[ENLACE_COUNT];
+
+void bindUiWidgets() {
+    for (uint8_t i = 0; i < BATTERY_BARS_COUNT; i++) {
+        bind_battery[i] = ui_binding.bind(battery_bars[i], UI_BIND_BAR_VALUE);
+    }
+    for (uint8_t i = 0; i < EJES_COUNT; i++) {
+        bind_axis[i][0] = ui_binding.bind(axis_bars[i][0], UI_BIND_BAR_VALUE, UI_JOYSTICK_THRESHOLD);
+        bind_axis[i][1] = ui_binding.bind(axis_bars[i][1], UI_BIND_BAR_START_VALUE, UI_JOYSTICK_THRESHOLD);
+    }
+    bind_speed_gauge = ui_binding.bind(&ui_Image28, UI_BIND_IMG_ANGLE, UI_ANGLE_THRESHOLD);
+    for (uint8_t i = 0; i < TELEM_COUNT; i++) {
+        if (RADIO_TELEMETRY) {
+            bind_telemetry[i] = ui_binding.bindLabel(telemetry_labels[i], telemetry_formats[i], telemetry_thresholds[i]);
+        } else {
+            bind_telemetry[i] = -1;
+            lv_obj_add_flag(*telemetry_labels[i], LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+    for (uint8_t i = 0; i < ENLACE_COUNT; i++) {
+        if (RADIO_TELEMETRY) {
+            bind_link[i] = ui_binding.bindLabel(link_labels[i], link_formats[i]);
+        } else {
+            bind_link[i] = -1;
+            lv_obj_add_flag(*link_labels[i], LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+}
+
+// Positivo: barra de valor hasta val. Negativo: barra de rango desde 255 - |val|
+void setAxisBars(uint8_t axis, int val) {
+    ui_binding.set(bind_axis[axis][0], val > 0 ? val : 0);
+    ui_binding.set(bind_axis[axis][1], val < 0 ? map(val, 0, -255, 255, 0) : 255);
 }
 
 void my_touchpad_read( lv_indev_drv_t * indev_driver, lv_indev_data_t * data )
 {
     uint16_t touchX = 0, touchY = 0;
 
+    // El táctil comparte el bus SPI con la pantalla: terminar la franja en curso
+    display.waitIdle();
     bool touched = tft.getTouch( &touchX, &touchY, 10 );
 
     if( !touched )
@@ -303,18 +396,44 @@ void setExtraLimits(uint8_t pos1, uint8_t pos2, uint8_t pos3) {
     config.setExtraLimits(pos1, pos2, pos3);
 }
 
-void setActiveProfile(uint8_t profile) {
-    config.setActiveProfile(profile);
-    updatePalanca1Vector();
-    updatePalanca2Vector();
-    updatePalanca3Vector();
-    updatePalanca4Vector();
+// Solo prepara los vectores de la UI: el lazo de control sigue con la imagen anterior
+// hasta que publishControlLimits() publica la nueva entera al final de la vuelta.
+// false: ConfigStorage no pudo cargar el perfil y sigue el actual.
+bool setActiveProfile(uint8_t profile) {
+    if (!config.setActiveProfile(profile)) return false;
+    loadPalancaVectors();
+    loadResponseCurves();
+    return true;
 }
 
 uint8_t getActiveProfile() {
     return config.getActiveProfile();
 }
 
+// Selector de modelos de la pantalla de perfiles (del más reciente al más antiguo)
+uint8_t getRecentModels(uint8_t* profiles, uint8_t max) {
+    return config.getRecentProfiles(profiles, max);
+}
+
+void getModelName(uint8_t profile, char* name, uint8_t size) {
+    if (name == nullptr || size == 0) return;
+    strncpy(name, config.getProfileName(profile).c_str(), size - 1);
+    name[size - 1] = '\0';
+}
+
+// Alta de un modelo con valores por defecto: "Modelo N" con el primer N libre
+bool createModel(uint8_t* profile) {
+    char name[CONFIG_NAME_SIZE];
+    for (uint8_t n = 1; n <= MAX_PROFILES; n++) {
+        snprintf(name, sizeof(name), "Modelo %u", n);
+        if (config.findProfileByName(name) == CONFIG_NO_PROFILE) {
+            *profile = config.createProfile(name);
+            return *profile != CONFIG_NO_PROFILE;
+        }
+    }
+    return false;
+}
+
 void setIntensity(uint8_t intensity) {
     config.setIntensity(intensity);
 }
@@ -331,36 +450,39 @@ bool repairProfile(uint8_t profile) {
     return config.repairProfile(profile);
 }
 
+// Límites guardados de cada palanca, en el mismo orden que PALANCA_PINS
+typedef void (*PalancaLimitsGetter)(uint8_t* pos1, uint8_t* pos2, uint8_t* pos3);
+static const PalancaLimitsGetter palanca_limits_getters[PALANCAS_COUNT] = {
+    getTurnLimits, getSpeedLimits, getBoostLimits, getExtraLimits
+};
+
+// Copia los límites guardados de una palanca a su vector de la UI
+void loadPalancaVector(uint8_t palanca) {
+    uint8_t* vector = palanca_vectors[palanca];
+    palanca_limits_getters[palanca](&vector[0], &vector[1], &vector[2]);
+}
+
+void loadPalancaVectors() {
+    for (uint8_t i = 0; i < PALANCAS_COUNT; i++) {
+        loadPalancaVector(i);
+    }
+}
+
+// Llamadas desde ui_events.c tras guardar los límites
 void updatePalanca1Vector() {
-    uint8_t temp_limits[3];
-    getTurnLimits(&temp_limits[0], &temp_limits[1], &temp_limits[2]);
-    palanca1[0] = temp_limits[0];
-    palanca1[1] = temp_limits[1];
-    palanca1[2] = temp_limits[2];
+    loadPalancaVector(0);
 }
 
 void updatePalanca2Vector() {
-    uint8_t temp_limits[3];
-    getSpeedLimits(&temp_limits[0], &temp_limits[1], &temp_limits[2]);
-    palanca2[0] = temp_limits[0];
-    palanca2[1] = temp_limits[1];
-    palanca2[2] = temp_limits[2];
+    loadPalancaVector(1);
 }
 
 void updatePalanca3Vector() {
-    uint8_t temp_limits[3];
-    getBoostLimits(&temp_limits[0], &temp_limits[1], &temp_limits[2]);
-    palanca3[0] = temp_limits[0];
-    palanca3[1] = temp_limits[1];
-    palanca3[2] = temp_limits[2];
+    loadPalancaVector(2);
 }
 
 void updatePalanca4Vector() {
-    uint8_t temp_limits[3];
-    getExtraLimits(&temp_limits[0], &temp_limits[1], &temp_limits[2]);
-    palanca4[0] = temp_limits[0];
-    palanca4[1] = temp_limits[1];
-    palanca4[2] = temp_limits[2];
+    loadPalancaVector(3);
 }
 
 // wrapper para index 13 (extra config / canal)
@@ -372,59 +494,61 @@ uint8_t getExtraConfig(void) {
     return config.getExtraConfig();
 }
 
-void setup() {
-    pinMode(TFT_LED, OUTPUT);
-    pinMode(BATTERY, INPUT);
-    Serial.begin(9600);
-    
-    if (!config.begin()) return;
-    
-    // Inicializar palancas (vectores)
-    uint8_t temp_limits[3];
-    getTurnLimits(&temp_limits[0], &temp_limits[1], &temp_limits[2]);
-    palanca1[0] = temp_limits[0];
-    palanca1[1] = temp_limits[1];
-    palanca1[2] = temp_limits[2];
-    
-    getSpeedLimits(&temp_limits[0], &temp_limits[1], &temp_limits[2]);
-    palanca2[0] = temp_limits[0];
-    palanca2[1] = temp_limits[1];
-    palanca2[2] = temp_limits[2];
-    
-    getBoostLimits(&temp_limits[0], &temp_limits[1], &temp_limits[2]);
-    palanca3[0] = temp_limits[0];
-    palanca3[1] = temp_limits[1];
-    palanca3[2] = temp_limits[2];
-    
-    getExtraLimits(&temp_limits[0], &temp_limits[1], &temp_limits[2]);
-    palanca4[0] = temp_limits[0];
-    palanca4[1] = temp_limits[1];
-    palanca4[2] = temp_limits[2];
-    
-    analogWrite(TFT_LED, config.getBrightnessLimit());
+// Precalcula las tablas de las curvas guardadas del perfil activo
+void loadResponseCurves() {
+    for (uint8_t i = 0; i < CURVAS_COUNT; i++) {
+        response_curves[i].build(config.getCurve(i));
+    }
+}
 
-    // Inicializar SPI para TFT y NRF24
-    SPI.begin(36, 37, 35, 15);        // TFT (VSPI)
-    nrf_spi.begin(14, 12, 13, NRF24_CSN); // NRF24 (HSPI) - Solo para inicializar el módulo
+static ResponseCurveConfig makeCurve(uint8_t tipo, uint8_t cantidad, const uint8_t* puntos) {
+    ResponseCurveConfig curve;
+    ResponseCurve::defaultConfig(curve);
+    curve.type = tipo < CURVE_TYPES_COUNT ? tipo : CURVE_LINEAR;
+    curve.amount = cantidad > 100 ? 100 : cantidad;
+    if (puntos) memcpy(curve.points, puntos, RESPONSE_CURVE_POINTS);
+    return curve;
+}
 
-    // Inicializar TFT y LVGL
-    lv_init();
-    tft.init();
-    tft.setRotation(1);
+void getCurve(uint8_t canal, uint8_t* tipo, uint8_t* cantidad, uint8_t* puntos) {
+    ResponseCurveConfig curve = config.getCurve(canal);
+    if (tipo) *tipo = curve.type;
+    if (cantidad) *cantidad = curve.amount;
+    if (puntos) memcpy(puntos, curve.points, RESPONSE_CURVE_POINTS);
+}
 
-    uint16_t calData[5] = { 140, 3820, 250, 3600, 7 };
-    tft.setTouch(calData);
+void setCurve(uint8_t canal, uint8_t tipo, uint8_t cantidad, const uint8_t* puntos) {
+    config.setCurve(canal, makeCurve(tipo, cantidad, puntos));
+}
 
-    lv_disp_draw_buf_init(&draw_buf, buf, NULL, screenWidth * screenHeight / 10);
+// Edición en vivo (modo calibración): solo la tabla que usa el lazo de control, sin
+// tocar la configuración; cancelar_cambios vuelve a la guardada con updateCurves()
+void previewCurve(uint8_t canal, uint8_t tipo, uint8_t cantidad, const uint8_t* puntos) {
+    if (canal < CURVAS_COUNT) {
+        response_curves[canal].build(makeCurve(tipo, cantidad, puntos));
+    }
+}
+
+// Resultado de cada escritura en flash; llega desde config.poll(), en la tarea de UI.
+// context es la etiqueta de estado de la capa superior: el error se ve en cualquier
+// pantalla y se quita con la siguiente escritura correcta (p. ej. el reintento)
+void configWriteDone(const ConfigWriteResult& result, void* context) {
+    lv_obj_t* status = (lv_obj_t*)context;
+    if (result.success) {
+        lv_obj_add_flag(status, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_clear_flag(status, LV_OBJ_FLAG_HIDDEN);
+    }
+}
 
-    static lv_disp_drv_t disp_drv;
-    lv_disp_drv_init(&disp_drv);
-    disp_drv.hor_res = screenWidth;
-    disp_drv.ver_res = screenHeight;
-    disp_drv.flush_cb = my_disp_flush;
-    disp_drv.draw_buf = &draw_buf;
-    lv_disp_drv_register(&disp_drv);
+// Llamada desde ui_events.c tras guardar o cancelar una curva
+void updateCurves() {
+    loadResponseCurves();
+}
 
+// Touch, pantallas de SquareLine, style de las barras, enlace de widgets y estado de guardado
+// (solo con el driver de LVGL registrado)
+static void setupUi() {
     static lv_indev_drv_t indev_drv;
     lv_indev_drv_init(&indev_drv);
     indev_drv.type = LV_INDEV_TYPE_POINTER;
@@ -448,6 +572,57 @@ void setup() {
     lv_obj_add_style(ui_Bar3,  &style_bar_indicator, LV_PART_INDICATOR);
     lv_obj_add_style(ui_Bar8,  &style_bar_indicator, LV_PART_INDICATOR);
 
+    bindUiWidgets();
+
+    // Estado de las escrituras en flash: etiqueta propia en la capa superior (oculta)
+    lv_obj_t* save_status = lv_label_create(lv_layer_top());
+    lv_label_set_text(save_status, "ERROR AL GUARDAR");
+    lv_obj_set_style_text_color(save_status, lv_color_hex(0xFF0000), LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(save_status, &lv_font_montserrat_12, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_align(save_status, LV_ALIGN_BOTTOM_MID, 0, -2);
+    lv_obj_add_flag(save_status, LV_OBJ_FLAG_HIDDEN);
+    config.onWriteComplete(configWriteDone, save_status);
+}
+
+void setup() {
+    pinMode(TFT_LED, OUTPUT);
+    pinMode(BATTERY, INPUT);
+    Serial.begin(9600);
+    
+    if (!config.begin()) return;
+    // Escrituras en flash en su propia tarea: guardar desde la UI no detiene loop()
+    config.startWriter();
+    
+    // Inicializar palancas (vectores) y curvas de respuesta
+    loadPalancaVectors();
+    loadResponseCurves();
+
+    // Imagen inicial del perfil: límites para el lazo de control y ajustes de la radio
+    publishControlLimits();
+    
+    analogWrite(TFT_LED, config.getBrightnessLimit());
+
+    // Inicializar SPI para TFT y NRF24
+    SPI.begin(36, 37, 35, 15);        // TFT (VSPI)
+    nrf_spi.begin(14, 12, 13, NRF24_CSN); // NRF24 (HSPI) - Solo para inicializar el módulo
+
+    // Inicializar TFT y LVGL
+    lv_init();
+    tft.init();
+    tft.setRotation(1);
+
+    uint16_t calData[5] = { 140, 3820, 250, 3600, 7 };
+    tft.setTouch(calData);
+
+    // Registra el driver de LVGL (si no hay DMA usa el envío bloqueante de siempre).
+    // Sin memoria para el buffer no hay UI, pero la radio y el lazo de control arrancan igual
+    ui_available = display.begin(&tft, screenWidth, screenHeight, screenHeight / 10);
+    if (ui_available) {
+        setupUi();
+    } else {
+        Serial.println("❌ Pantalla: sin memoria para el buffer de dibujo, se sigue sin UI");
+    }
+
     // Inicializar NRF24L01
     pinMode(NRF24_CE, OUTPUT);
     pinMode(NRF24_CSN, OUTPUT);
@@ -455,29 +630,25 @@ void setup() {
     digitalWrite(NRF24_CSN, HIGH);
     
     if (radio.begin(&nrf_spi) && radio.isChipConnected()) {
-        radio.setAutoAck(false);
-        radio.setDataRate(RF24_250KBPS);
-        switch (config.getIntensityLimit()) {
-            case 1:
-            radio.setPALevel(RF24_PA_MIN);
-            break;
-            case 2:
-            radio.setPALevel(RF24_PA_LOW);
-            break;
-            case 3:
-            radio.setPALevel(RF24_PA_HIGH);
-            break;
-            case 4:
-            radio.setPALevel(RF24_PA_MAX);
-            break;
-            default:
-            radio.setPALevel(RF24_PA_LOW);
-            break;
+        if (RADIO_TELEMETRY) {
+            // El receptor contesta cada paquete con un ACK que lleva su telemetría
+            radio.setAutoAck(true);
+            radio.enableDynamicPayloads();
+            radio.enableAckPayload();
+            radio.setRetries(TELEMETRY_RETRY_DELAY, TELEMETRY_RETRIES);
+        } else {
+            radio.setAutoAck(false);
         }
-        // Valor por defecto 76 (canal 76)
-        radio.setChannel(config.getExtraConfig());
-        radio.openWritingPipe(config.getNRFAddress());
+        radio.setDataRate(RF24_250KBPS);
+        // Potencia, canal (por defecto 76) y dirección del perfil activo; los cambios de
+        // perfil posteriores los aplica el lazo de control entre dos paquetes
+        const RadioProfile& radio_profile = control_limits.front().radio;
+        profile_switch.begin(&radio, radio_profile, control_limits.getVersion(), !RADIO_HOPPING);
         radio.stopListening();
+        if (RADIO_HOPPING) {
+            // Sustituye al canal fijo: empieza en la ranura de sincronismo
+            hop_tx.begin(&radio, radio_profile.address, micros());
+        }
         sent_data.ch1 = 0;
         sent_data.ch2 = 0;
         sent_data.ch3 = 0;
@@ -486,32 +657,38 @@ void setup() {
         sent_data.ch6 = 0;
         sent_data.ch7 = 0;
 
+        tx_scheduler.setIntervals(TX_ACTIVE_US, TX_HEARTBEAT_US, TX_FAILSAFE_US);
+        tx_scheduler.setHoldTime(TX_HOLD_US);
+
+        // Un solo paquete en la FIFO: si el anterior no salió, el nuevo lo sustituye
+        radio_tx.begin(&radio, NRF24_IRQ);
+        radio_tx.setDepth(1);
+        radio_tx.onComplete(radioTxDone, nullptr);
         nrf24_available = true;
     }
 
     // DESPUÉS de inicializar el NRF24, reconfigurar los pines para las palancas
-    // Configurar pines de las palancas como INPUT_PULLUP
-    pinMode(P1_1, INPUT_PULLUP);  // Pin 13
-    pinMode(P1_2, INPUT_PULLUP);  // Pin 14
-    pinMode(P2_1, INPUT_PULLUP);  // Pin 11
-    pinMode(P2_2, INPUT_PULLUP);  // Pin 12
-    pinMode(P3_1, INPUT_PULLUP);  // Pin 1
-    pinMode(P3_2, INPUT_PULLUP);  // Pin 39
-    pinMode(P4_1, INPUT_PULLUP);  // Pin 16
-    pinMode(P4_2, INPUT_PULLUP);  // Pin 17
-
-    // Inicializar joysticks
-    joystick_izquierdo.begin();
-    joystick_izquierdo.setCenter(5520, 5160);
-    joystick_izquierdo.setDeadZone(100, true);
-    joystick_izquierdo.setLimits(60, 8180, 65, 8180);
-    joystick_izquierdo.invertAxis(false, false);
-
-    joystick_derecho.begin();
-    joystick_derecho.setCenter(5060, 4970);
-    joystick_derecho.setDeadZone(100, true);
-    joystick_derecho.setLimits(60, 8180, 65, 8180);
-    joystick_derecho.invertAxis(false, false);
+    // Configurar pines de las palancas como INPUT_PULLUP y leer su posición inicial
+    palancas.begin();
+
+    // Inicializar joysticks (misma configuración que usa el simulador de host)
+    configureJoysticks(joystick_izquierdo, joystick_derecho, botones);
+
+    // ADC continuo: se arranca después de begin() de los joysticks (usan analogRead para el centro)
+    analog_input.addChannel(JOYSTICK_IZQ_X);
+    analog_input.addChannel(JOYSTICK_IZQ_Y);
+    analog_input.addChannel(JOYSTICK_DER_X);
+    analog_input.addChannel(JOYSTICK_DER_Y);
+    analog_input.addChannel(BATTERY);
+    if (!analog_input.begin(&adc_dma, ANALOG_SAMPLE_RATE_HZ)) {
+        Serial.println("ADC DMA no disponible, usando analogRead");
+        analog_input.begin(&adc_polling, ANALOG_SAMPLE_RATE_HZ);
+    }
+    joystick_izquierdo.setAnalogReader(AnalogAcquisition::readPin, &analog_input);
+    joystick_derecho.setAnalogReader(AnalogAcquisition::readPin, &analog_input);
+
+    // Arrancar el lazo de control a frecuencia fija (tarea separada de la UI)
+    control_loop.begin(controlTick, nullptr, CONTROL_RATE_HZ);
 }
 
 
@@ -533,7 +710,7 @@ float leerVoltaje() {
   static float filtered_v = 0.0f;
   static bool initialized = false;
 
-  int lectura = analogRead(BATTERY);
+  int lectura = AnalogAcquisition::readPin(BATTERY, &analog_input);
   float v_raw = m * lectura + b;
 
   if (!initialized) {
@@ -557,137 +734,288 @@ int leerPorcentaje() {
 
 
 
+// Fin de un paquete (desde radio_tx.poll(), tarea de control). Si no llegó a salir,
+// el siguiente ciclo transmite aunque los canales no hayan cambiado.
+void radioTxDone(const RadioTxResult& result, void* context) {
+    if (result.status != RADIO_TX_SENT) {
+        tx_scheduler.forceSend();
+    }
+    // Con auto-ACK, enviado = recibido. Los sustituidos nunca salieron: no cuentan.
+    if (RADIO_TELEMETRY && result.status != RADIO_TX_DROPPED) {
+        bool acked = result.status == RADIO_TX_SENT;
+        telemetry.onAck(acked);
+
+        // Reintentos del paquete (ARC_CNT), potencia del ACK (RPD) y tiempo hasta el ACK
+        uint32_t now = millis();
+        link_quality.observe(radio, acked, now);
+        if (acked) {
+            link_quality.sampleRpd(radio, now);
+            link_quality.onRoundTrip(result.completedUs - result.queuedUs);
+        }
+    }
+}
+
+// Cargas de ACK que dejó el receptor en la FIFO de RX (sin cambiar de modo la radio)
+void readTelemetry(uint32_t now) {
+    uint8_t buffer[32];
+    while (radio.available()) {
+        uint8_t length = radio.getDynamicPayloadSize();
+        if (length == 0) continue;   // Longitud corrupta: RF24 ya vació la FIFO
+        radio.read(buffer, length);
+        telemetry.parse(buffer, length, now);
+    }
+}
+
+// Ciclo de control: se ejecuta a CONTROL_RATE_HZ en su propia tarea, sin depender de LVGL
+void controlTick(void* context) {
+    static uint32_t tick = 0;
+
+    // Vaciar el buffer DMA del ADC (no bloquea) antes de muestrear
+    analog_input.poll();
+
+    // Cerrar los antirrebotes que terminaron con el botón en otro nivel
+    botones.service();
+
+    // Joysticks y palancas, una adquisición por ciclo
+    ControlInputs inputs;
+    sampleControlInputs(joystick_izquierdo, joystick_derecho, palancas, inputs);
+
+    // Mapeo de canales (compartido con el simulador de src/host/) con la imagen del perfil
+    // publicada por la UI. Si la UI publicó dos veces mientras tanto (cambio de perfil), se
+    // repite: los canales y la radio del paquete salen siempre de la misma imagen.
+    uint32_t limits_token;
+    const ControlLimits* limits;
+    RadioProfile radio_profile;
+    uint32_t published_us;
+    bool first = true;
+    do {
+        if (!first) profile_switch.onRecompute();
+        first = false;
+        limits = control_limits.beginRead(limits_token);
+        computeSentData(inputs, limits->palanca, limits->curves, sent_data);
+        radio_profile = limits->radio;
+        published_us = limits->publishedUs;
+    } while (!control_limits.endRead(limits_token));
+    uint32_t limits_version = limits_token >> 1;
+
+    // Transmisión NRF24: en cada ciclo con los sticks en movimiento, latido en reposo.
+    // Sin bloqueo: se recoge cómo terminó el paquete anterior y se carga el nuevo en la FIFO.
+    if (nrf24_available) {
+        uint32_t now = micros();
+        radio_tx.poll(now);
+        if (RADIO_TELEMETRY) {
+            readTelemetry(now);
+        }
+        if (profile_switch.pending(radio_profile)) {
+            // Perfil con otra radio: lo que quede en la FIFO es del perfil anterior (otra
+            // dirección o canal) y se descarta; el primer paquete del nuevo sale ya
+            if (!radio_tx.isIdle()) radio_tx.flush(now);
+            uint8_t changes = profile_switch.apply(radio_profile);
+            if (RADIO_HOPPING && (changes & PROFILE_RADIO_ADDRESS)) {
+                // Otra dirección, otra secuencia de salto: vuelta a la ranura de sincronismo
+                hop_tx.begin(&radio, radio_profile.address, now);
+            }
+            tx_scheduler.forceSend();
+        }
+        if (RADIO_HOPPING && hop_tx.isHopDue(now)) {
+            // Lo que quede en la FIFO iría al canal siguiente: se descarta y se repite allí.
+            // En la ranura de sincronismo siempre sale un paquete (receptor sin enganchar).
+            radio_tx.flush(now);
+            hop_tx.hop(now);
+            if (hop_tx.isSyncSlot()) {
+                tx_scheduler.forceSend();
+            }
+        }
+        if (RADIO_HOPPING && radio_tx.isIdle()) {
+            // FIFO vacía: muestra de portadora en un canal de la secuencia (una por ranura,
+            // bloquea ~0,8 ms entre la escucha y la vuelta a TX)
+            hop_tx.survey(now);
+        }
+        if (tx_scheduler.poll(&sent_data, sizeof(Data_to_be_sent), now)) {
+            if (RADIO_TELEMETRY || RADIO_HOPPING) {
+                // Los canales y, detrás, la secuencia que el receptor devuelve en su telemetría
+                // y el trailer de salto (ranura, instante dentro de ella y lista negra)
+                uint8_t frame[sizeof(Data_to_be_sent) + TELEMETRY_SEQUENCE_SIZE + HOP_TRAILER_SIZE];
+                uint8_t length = sizeof(Data_to_be_sent);
+                memcpy(frame, &sent_data, length);
+                if (RADIO_TELEMETRY) {
+                    frame[length++] = telemetry.nextSequence(now);
+                }
+                if (RADIO_HOPPING) {
+                    // Instante real de salida: survey() puede haber consumido parte del ciclo
+                    length += hop_tx.writeTrailer(frame + length, micros());
+                }
+                radio_tx.submit(frame, length, now);
+            } else {
+                radio_tx.submit(&sent_data, sizeof(Data_to_be_sent), now);
+            }
+            profile_switch.onFrame(limits_version, published_us, micros());
+        }
+    }
+
+    // Publicar el ciclo para la UI y demás consumidores (se escribe en el buffer libre)
+    ControlState& state = control_state.beginWrite();
+    state.tick = ++tick;
+    state.timestampUs = micros();
+    state.limitsVersion = limits_version;
+    state.inputs = inputs;
+    state.data = sent_data;
+    state.telemetry = telemetry.getState();
+    control_state.endWrite();
+}
+
+// loop() queda como tarea de UI (prioridad baja): solo lee el estado publicado por el lazo de control
 void loop() {
+    // Vuelta más larga del loop (parada de la UI), para el reporte de estadísticas
+    static uint32_t max_loop_us = 0;
+    uint32_t loop_start_us = micros();
 
     // ANTES: se inicializaba y añadía el style en cada iteración -> provoca fugas / corrupción LVGL
     // AHORA: solo actualizamos valor y color del style (sin re-inicializar ni re-adjuntar)
     
     int pct = leerPorcentaje();
 
-    // Actualizar todos los indicadores de batería con el mismo valor
-    lv_bar_set_value(ui_Bar5, pct, LV_ANIM_ON);
-    lv_bar_set_value(ui_Bar4, pct, LV_ANIM_ON);
-    lv_bar_set_value(ui_Bar9, pct, LV_ANIM_ON);
-    lv_bar_set_value(ui_Bar1, pct, LV_ANIM_ON);
-    lv_bar_set_value(ui_Bar7, pct, LV_ANIM_ON);
-    lv_bar_set_value(ui_Bar6, pct, LV_ANIM_ON);
-    lv_bar_set_value(ui_Bar2, pct, LV_ANIM_ON);
-    lv_bar_set_value(ui_Bar3, pct, LV_ANIM_ON);
-    lv_bar_set_value(ui_Bar8, pct, LV_ANIM_ON);
-
-    // Cambiamos color según porcentaje (solo actualizar el style ya registrado)
-    if (pct < 15) {
-        lv_style_set_bg_color(&style_bar_indicator, lv_color_hex(0xFF0000));
-    } else {
-        lv_style_set_bg_color(&style_bar_indicator, lv_color_hex(0x00FF00));
+    // Todos los indicadores de batería con el mismo valor (solo se dibuja el de la pantalla cargada)
+    for (uint8_t i = 0; i < BATTERY_BARS_COUNT; i++) {
+        ui_binding.set(bind_battery[i], pct);
     }
 
+    // Cambiamos color según porcentaje (solo al cruzar el umbral: el style es compartido)
+    static int8_t bateria_baja = -1;
+    if (ui_available && (pct < 15) != (bateria_baja == 1)) {
+        bateria_baja = pct < 15;
+        lv_style_set_bg_color(&style_bar_indicator, lv_color_hex(bateria_baja ? 0xFF0000 : 0x00FF00));
+        lv_obj_report_style_change(&style_bar_indicator);
+    }
 
-    int val_izquierdo_Y = joystick_izquierdo.readY();
-    if (val_izquierdo_Y > 0) {
-        if(joystick_derecho.isPressed()){
-            uint16_t max_val = palanca1[readPalanca1Position()] + palanca3[readPalanca3Position()];
-            if (max_val > 255) max_val = 255;
-            sent_data.ch1 = map(val_izquierdo_Y, 0, 255, 0, max_val);
-            sent_data.ch2 = 0;
-        }else{
-            sent_data.ch1 = map(val_izquierdo_Y, 0, 255, 0, palanca1[readPalanca1Position()] );
-            sent_data.ch2 = 0;
+    // Lectura directa del último ciclo de control (sin copia); se repite si el lazo
+    // publicó dos ciclos mientras tanto
+    uint32_t state_token;
+    do {
+        const ControlState* state = control_state.beginRead(state_token);
+
+        setAxisBars(EJE_IZQ_Y, state->inputs.izquierdo_Y);
+        setAxisBars(EJE_IZQ_X, state->inputs.izquierdo_X);
+        setAxisBars(EJE_DER_Y, state->inputs.derecho_Y);
+        setAxisBars(EJE_DER_X, state->inputs.derecho_X);
+
+        int mapped_value = map((state->data.ch1 + state->data.ch2), 0, 255, -1355, 1300);
+        ui_binding.set(bind_speed_gauge, mapped_value); // Ángulo en décimas de grado
+
+        // Telemetría: los valores se quedan con el último dato; el RSSI cae a 0 si deja de llegar
+        const TelemetryState& t = state->telemetry;
+        if (RADIO_TELEMETRY && t.valid) {
+            bool fresh = state->timestampUs - t.receivedUs < TELEMETRY_STALE_US;
+            ui_binding.set(bind_telemetry[TELEM_BATERIA], t.frame.batteryMv);
+            ui_binding.set(bind_telemetry[TELEM_CORRIENTE], t.frame.motorCurrentMa);
+            ui_binding.set(bind_telemetry[TELEM_RSSI], fresh ? t.frame.rssi : 0);
+            ui_binding.set(bind_telemetry[TELEM_RTT], t.rttUs / 1000);
+        }
+    } while (!control_state.endRead(state_token));
+
+    // Calidad del enlace: el informe se copia con su propio cerrojo (ordena las latencias,
+    // por eso no en cada vuelta)
+    static unsigned long last_link_time = 0;
+    if (RADIO_TELEMETRY && millis() - last_link_time >= LINK_QUALITY_UI_MS) {
+        last_link_time = millis();
+        LinkQualityReport link = link_quality.getReport(last_link_time);
+        if (link.valid) {
+            ui_binding.set(bind_link[ENLACE_CALIDAD], link.score);
+            ui_binding.set(bind_link[ENLACE_PERDIDA], link.lossPercent);
+            ui_binding.set(bind_link[ENLACE_REENVIOS], link.retriesX100);
+            ui_binding.set(bind_link[ENLACE_LATENCIA], link.rttP90Us);
         }
+    }
+
+    // Una sola pasada por LVGL con los widgets que cambiaron
+    if (ui_available) ui_binding.apply();
+
+#if CONTROL_STATS_INTERVAL_MS > 0
+    // Histograma de jitter del lazo de control (min/max/p99 del periodo, por ventana)
+    static unsigned long last_stats_time = 0;
+    if (millis() - last_stats_time >= CONTROL_STATS_INTERVAL_MS) {
+        control_loop.printStats();
 
-        lv_bar_set_value(ui_BarJoystickIzquierdoSup1, val_izquierdo_Y, LV_ANIM_ON);
-        lv_bar_set_start_value(ui_BarJoystickIzquierdoSup2, 255, LV_ANIM_ON);
-
-    } else if (val_izquierdo_Y < 0) {
-        if(joystick_derecho.isPressed()){
-            uint16_t max_val = palanca1[readPalanca1Position()] + palanca3[readPalanca3Position()];
-            if (max_val > 255) max_val = 255;
-            sent_data.ch2 = map(val_izquierdo_Y, 0, -255, 0, max_val);
-            sent_data.ch1 = 0;
-        }else{
-            sent_data.ch2 = map(val_izquierdo_Y, 0, -255, 0, palanca1[readPalanca1Position()] );
-            sent_data.ch1 = 0;
+        // Lecturas ADC de los joysticks por ciclo de control (AnalogAcquisition o analogRead)
+        ControlLoopStats stats = control_loop.getStats();
+        uint32_t adc_reads = joystick_izquierdo.getAdcReadCount() + joystick_derecho.getAdcReadCount();
+        if (stats.ticks > 0) {
+            Serial.print("ADC reads/tick: "); Serial.println(adc_reads / stats.ticks);
+        }
+        joystick_izquierdo.resetAdcReadCount();
+        joystick_derecho.resetAdcReadCount();
+        control_loop.resetStats();
+
+        analog_input.printStats();
+        analog_input.resetStats();
+
+        // Paquetes y bytes en el aire por segundo, intervalo elegido
+        tx_scheduler.printStats();
+        tx_scheduler.resetStats();
+
+        // Paquetes enviados/descartados y latencia de la FIFO del NRF24
+        radio_tx.printStats();
+        radio_tx.resetStats();
+
+        // Telemetría del receptor: paquetes con ACK, tiempo de ida y vuelta
+        if (RADIO_TELEMETRY) {
+            // Estado del receptor: la copia publicada por el lazo de control
+            TelemetryState link_state;
+            uint32_t link_token;
+            do {
+                link_state = control_state.beginRead(link_token)->telemetry;
+            } while (!control_state.endRead(link_token));
+            telemetry.printStats(link_state);
+            telemetry.resetStats();
+
+            // Ventana deslizante: no se reinicia con las demás estadísticas
+            link_quality.printReport(millis());
         }
 
-        lv_bar_set_value(ui_BarJoystickIzquierdoSup1, 0, LV_ANIM_ON);
-        lv_bar_set_start_value(ui_BarJoystickIzquierdoSup2, map(val_izquierdo_Y, 0, -255, 255, 0), LV_ANIM_ON);
-    } else {
-        sent_data.ch1 = 0;
-        sent_data.ch2 = 0;
-        lv_bar_set_value(ui_BarJoystickIzquierdoSup1, 0, LV_ANIM_ON);
-        lv_bar_set_start_value(ui_BarJoystickIzquierdoSup2, 255, LV_ANIM_ON);
-    }
+        // Cambios de perfil: imágenes nuevas en el aire y latencia desde la publicación
+        profile_switch.printStats();
+        profile_switch.resetStats();
 
-    // Joystick izquierdo X
-    int val_izquierdo_X = joystick_izquierdo.readX();
-    if (val_izquierdo_X > 0) {        
-        lv_bar_set_value(ui_BarJoystickIzquierdoSup5, val_izquierdo_X, LV_ANIM_ON);
-        lv_bar_set_start_value(ui_BarJoystickIzquierdoSup6, 255, LV_ANIM_ON);
-    } else if (val_izquierdo_X < 0) {
+        // Saltos, muestras de portadora y canales en la lista negra
+        if (RADIO_HOPPING) {
+            hop_tx.printStats();
+            hop_tx.resetStats();
+        }
 
-        lv_bar_set_value(ui_BarJoystickIzquierdoSup5, 0, LV_ANIM_ON);
-        lv_bar_set_start_value(ui_BarJoystickIzquierdoSup6, map(val_izquierdo_X, 0, -255, 255, 0), LV_ANIM_ON);
-    } else {
-        lv_bar_set_value(ui_BarJoystickIzquierdoSup5, 0, LV_ANIM_ON);
-        lv_bar_set_start_value(ui_BarJoystickIzquierdoSup6, 255, LV_ANIM_ON);
-    }
+        // Flancos de los botones capturados por interrupción
+        botones.printStats();
+        botones.resetStats();
 
-    // Joystick derecho Y
-    int val_Derecho_Y = joystick_derecho.readY();
-    if (val_Derecho_Y > 0) {
-        lv_bar_set_value(ui_BarJoystickIzquierdoSup3, val_Derecho_Y, LV_ANIM_ON);
-        lv_bar_set_start_value(ui_BarJoystickIzquierdoSup4, 255, LV_ANIM_ON);
-    } else if (val_Derecho_Y < 0) {
-        lv_bar_set_value(ui_BarJoystickIzquierdoSup3, 0, LV_ANIM_ON);
-        lv_bar_set_start_value(ui_BarJoystickIzquierdoSup4, map(val_Derecho_Y, 0, -255, 255, 0), LV_ANIM_ON);
-    } else {
-        lv_bar_set_value(ui_BarJoystickIzquierdoSup3, 0, LV_ANIM_ON);
-        lv_bar_set_start_value(ui_BarJoystickIzquierdoSup4, 255, LV_ANIM_ON);
-    }
+        // Tiempo de frame y CPU ahorrada por el flush con DMA
+        display.printStats();
+        display.resetStats();
 
-    // Joystick derecho X
-    int val_Derecho_X = joystick_derecho.readX();
-    if (val_Derecho_X > 0) {
-        sent_data.ch3 = map(val_Derecho_X, 0, 255, 0, palanca2[readPalanca2Position()]);
-        sent_data.ch4 = 0;
-        lv_bar_set_value(ui_BarJoystickIzquierdoSup7, val_Derecho_X, LV_ANIM_ON);
-        lv_bar_set_start_value(ui_BarJoystickIzquierdoSup8, 255, LV_ANIM_ON);
-    } else if (val_Derecho_X < 0) {
-        sent_data.ch4 = map(val_Derecho_X, 0, -255, 0, palanca2[readPalanca2Position()]);
-        sent_data.ch3 = 0;
-        lv_bar_set_value(ui_BarJoystickIzquierdoSup7, 0, LV_ANIM_ON);
-        lv_bar_set_start_value(ui_BarJoystickIzquierdoSup8, map(val_Derecho_X, 0, -255, 255, 0), LV_ANIM_ON);
-    } else {
-        sent_data.ch3 = 0;
-        sent_data.ch4 = 0;
-        lv_bar_set_value(ui_BarJoystickIzquierdoSup7, 0, LV_ANIM_ON);
-        lv_bar_set_start_value(ui_BarJoystickIzquierdoSup8, 255, LV_ANIM_ON);
-    }
+        // Invalidaciones evitadas por el enlace de widgets
+        ui_binding.printStats();
+        ui_binding.resetStats();
 
+        // Guardados y escrituras en flash de la configuración (acumulado de la sesión)
+        config.printStats();
 
-  
-    int val_palanca4 = palanca4[readPalanca4Position()];
-    if (val_palanca4 >= 0) {
-        sent_data.ch5 = map(val_palanca4, 0, 255, 0, 255);
-        sent_data.ch6 = 0;
-    } else {
-        sent_data.ch5 = 0;
-        sent_data.ch6 = map(val_palanca4, -255, 0, 255, 0);
+        Serial.print("Loop UI: vuelta máx "); Serial.print(max_loop_us); Serial.println(" us");
+        max_loop_us = 0;
+
+        last_stats_time = millis();
     }
-    // Transmisión NRF24
-    if (nrf24_available) {
-        static unsigned long last_nrf_time = 0;
-        if (millis() - last_nrf_time >= 50) {
-            
-            radio.write(&sent_data, sizeof(Data_to_be_sent));
-            last_nrf_time = millis();
-        }
+#endif
+
+    // Avisar a LVGL si terminó la franja que estaba en el bus
+    if (ui_available) {
+        display.service();
+        lv_timer_handler(); 
     }
 
+    // Los callbacks de la UI pudieron cambiar límites o perfil: publicarlos juntos
+    publishControlLimits();
 
-    int mapped_value = map((sent_data.ch1 + sent_data.ch2), 0, 255, -1355, 1300);
-    // Puedes usar mapped_value como necesites, por ejemplo:
-    lv_img_set_angle(ui_Image28, mapped_value); // Ángulo en décimas de grado
+    // Los guardados de la UI quedan en RAM: a la tarea de escritura tras un rato sin cambios
+    config.poll(millis());
 
-    lv_timer_handler(); 
+    uint32_t loop_us = micros() - loop_start_us;
+    if (loop_us > max_loop_us) max_loop_us = loop_us;
 }
@@ -3,6 +3,11 @@
 #include <RF24.h>
 #include <BTS7960.h>
 #include <Servo.h>  // Biblioteca para el control del servomotor
+#include "FrequencyHop.h"
+
+// Salto de frecuencia: mismo valor que RADIO_HOPPING en src/main.cpp.
+// Copiar FrequencyHop.h y FrequencyHop.cpp de lib/FrequencyHop junto al sketch.
+#define SALTO_FRECUENCIA 0
 
 #define L_EN 8
 #define R_EN 7
@@ -17,6 +22,7 @@ const uint64_t pipeIn = 0xE8E8F0F0E5LL; // Dirección de comunicación NRF24
 RF24 radio(9, 10);                     // Pines CSN y CE
 
 Servo servo;                           // Declaración del servomotor
+HopReceiver salto;                     // Canal de cada ranura y sincronismo con el mando
 
 // Estructura de datos recibidos (solo 4 canales ahora)
 struct Received_data {
@@ -59,6 +65,10 @@ void setup() {
   radio.setDataRate(RF24_250KBPS);
   radio.openReadingPipe(1, pipeIn);
   radio.startListening();
+  if (SALTO_FRECUENCIA) {
+    // Espera en el canal de sincronismo hasta el primer paquete
+    salto.begin(&radio, pipeIn, micros());
+  }
 
   // Inicialización del servomotor
   servo.attach(SERVO_PIN);
@@ -71,9 +81,18 @@ unsigned long lastRecvTime = 0;
 
 void receive_the_data() {
   while (radio.available()) {
-    radio.read(&received_data, sizeof(Received_data));
+    // Canales y, con salto de frecuencia, el trailer que va detrás
+    uint8_t buffer[sizeof(Received_data) + HOP_TRAILER_SIZE];
+    radio.read(buffer, sizeof(buffer));
+    memcpy(&received_data, buffer, sizeof(Received_data));
+    if (SALTO_FRECUENCIA) {
+      salto.onPacket(buffer + sizeof(Received_data), micros());
+    }
     lastRecvTime = millis();
   }
+  if (SALTO_FRECUENCIA) {
+    salto.update(micros());
+  }
 }
 
 void loop() {
@@ -128,7 +147,11 @@ void loop() {
     servo.write(direccionFinal);
   }
 
-  // Depuración por Serial
+  // Depuración por Serial. Con salto de frecuencia el lazo debe pasar varias veces
+  // por ranura: a 9600 baudios cada línea tarda ~90 ms, solo una por segundo.
+  static unsigned long lastPrintTime = 0;
+  if (SALTO_FRECUENCIA && now - lastPrintTime < 1000) return;
+  lastPrintTime = now;
   Serial.print("CH1 (Adelante): ");
   Serial.print(received_data.ch1);
   Serial.print(" | CH2 (Atrás): ");
@@ -142,5 +165,7 @@ void loop() {
   Serial.print(" | Dir Final: ");
   Serial.println(direccionFinal);
 
-  delay(10); // Pequeño delay para estabilidad
+  if (!SALTO_FRECUENCIA) {
+    delay(10); // Pequeño delay para estabilidad
+  }
 }
@@ -0,0 +1,206 @@
+// Receptor del coche en modo bidireccional (RADIO_TELEMETRY = 1 en src/main.cpp)
+// Igual que receptor_beta.cpp, pero con auto-ACK: cada ACK devuelve al mando la
+// telemetría del coche (batería, corriente del motor, RSSI aproximado y la última
+// secuencia recibida). Copiar Telemetry.h y Telemetry.cpp de lib/Telemetry junto al sketch
+// (y FrequencyHop.h y FrequencyHop.cpp de lib/FrequencyHop con SALTO_FRECUENCIA).
+#include <SPI.h>
+#include <nRF24L01.h>
+#include <RF24.h>
+#include <BTS7960.h>
+#include <Servo.h>  // Biblioteca para el control del servomotor
+#include "Telemetry.h"
+#include "FrequencyHop.h"
+
+// Salto de frecuencia: mismo valor que RADIO_HOPPING en src/main.cpp
+#define SALTO_FRECUENCIA 0
+
+#define L_EN 8
+#define R_EN 7
+#define L_PWM 5                             //pin 5 supports 980hz pwm frequency
+#define R_PWM 6
+
+// Salidas de corriente del BTS7960 (R_IS / L_IS con 1 kOhm a masa) y divisor de la batería
+#define R_IS A1
+#define L_IS A2
+#define BATERIA_PIN A0
+const float DIVISOR_BATERIA = 3.0;        // 20k / 10k
+const float MA_POR_MV_IS = 8.5;           // kILIS = 8500 con 1 kOhm
+const uint16_t BATERIA_BAJA_MV = 6600;    // 2S LiPo a 3.3 V por celda
+
+// Pines del servomotor
+BTS7960 motor1(L_EN, R_EN, L_PWM, R_PWM);
+#define SERVO_PIN 3
+
+const uint64_t pipeIn = 0xE8E8F0F0E5LL; // Dirección de comunicación NRF24
+RF24 radio(9, 10);                     // Pines CSN y CE
+
+Servo servo;                           // Declaración del servomotor
+
+// Estructura de datos recibidos (solo 4 canales ahora)
+struct Received_data {
+  byte ch1;  // Velocidad adelante (0-255)
+  byte ch2;  // Velocidad atrás (0-255)
+  byte ch3;  // Giro derecha (0-255)
+  byte ch4;  // Giro izquierda (0-255)
+  byte ch5;  // (no usado)
+  byte ch6;  // (no usado)
+  byte ch7;  // (no usado)
+};
+
+Received_data received_data;
+TelemetryResponder telemetria;
+HopReceiver salto;                     // Canal de cada ranura y sincronismo con el mando
+bool failsafe = false;                 // Se perdió la señal desde la última telemetría
+
+// Variables para el control
+int velocidadFinal = 0;
+int direccionFinal = 90;  // Ángulo inicial del servomotor (posición neutra)
+
+void reset_the_Data() {
+  // Valores predeterminados al perder señal
+  received_data.ch1 = 0;   // Sin velocidad adelante
+  received_data.ch2 = 0;   // Sin velocidad atrás
+  received_data.ch3 = 0;   // Sin giro derecha
+  received_data.ch4 = 0;   // Sin giro izquierda
+}
+
+uint16_t leerBateriaMv() {
+  return analogRead(BATERIA_PIN) * (5000.0 / 1023.0) * DIVISOR_BATERIA;
+}
+
+// Positiva hacia adelante, negativa hacia atrás
+int16_t leerCorrienteMa() {
+  float adelante = analogRead(R_IS) * (5000.0 / 1023.0) * MA_POR_MV_IS;
+  float atras = analogRead(L_IS) * (5000.0 / 1023.0) * MA_POR_MV_IS;
+  return constrain(adelante - atras, -32000, 32000);
+}
+
+// Deja lista la telemetría que viajará en el ACK del próximo paquete.
+// Solo una en la FIFO: el mando siempre recibe la más reciente.
+void cargar_telemetria() {
+  uint16_t bateria = leerBateriaMv();
+  uint8_t flags = 0;
+  if (failsafe) flags |= TELEMETRY_FLAG_FAILSAFE;
+  if (bateria < BATERIA_BAJA_MV) flags |= TELEMETRY_FLAG_LOW_BATTERY;
+
+  uint8_t buffer[TELEMETRY_FRAME_SIZE];
+  uint8_t length = telemetria.build(buffer, bateria, leerCorrienteMa(), flags);
+  radio.flush_tx();
+  radio.writeAckPayload(1, buffer, length);
+  failsafe = false;
+}
+
+void setup() {
+  Serial.begin(9600);
+  reset_the_Data();
+
+  // Configuración del NRF24L01
+  Serial.println();
+  Serial.println(F("LGT RF_NANO v2.0 Telemetria"));
+
+  radio.begin();
+  radio.setAutoAck(true);
+  radio.enableDynamicPayloads();
+  radio.enableAckPayload();
+  radio.setDataRate(RF24_250KBPS);
+  radio.openReadingPipe(1, pipeIn);
+  radio.startListening();
+  if (SALTO_FRECUENCIA) {
+    // Espera en el canal de sincronismo hasta el primer paquete
+    salto.begin(&radio, pipeIn, micros());
+  }
+  cargar_telemetria();
+
+  // Inicialización del servomotor
+  servo.attach(SERVO_PIN);
+  servo.write(direccionFinal); // Coloca el servomotor en la posición inicial
+  motor1.begin();
+  motor1.enable();
+}
+
+unsigned long lastRecvTime = 0;
+
+void receive_the_data() {
+  bool recibido = false;
+  while (radio.available()) {
+    // Canales + secuencia del mando (los 7 bytes de siempre si el mando no la envía)
+    // + trailer de salto al final con SALTO_FRECUENCIA
+    uint8_t buffer[32];
+    uint8_t length = radio.getDynamicPayloadSize();
+    if (length == 0) continue;
+    radio.read(buffer, length);
+    uint32_t rxUs = micros();
+    uint8_t trailer = SALTO_FRECUENCIA && length >= sizeof(Received_data) + HOP_TRAILER_SIZE ? HOP_TRAILER_SIZE : 0;
+    memcpy(&received_data, buffer, min((size_t)length, sizeof(Received_data)));
+    if (length - trailer > sizeof(Received_data)) {
+      telemetria.onPacket(buffer[sizeof(Received_data)], radio.testRPD());
+    }
+    // Después de testRPD(): si cambia de canal, el RPD se pierde
+    if (trailer) {
+      salto.onPacket(buffer + length - trailer, rxUs);
+    }
+    lastRecvTime = millis();
+    recibido = true;
+  }
+  if (recibido) {
+    cargar_telemetria();
+  }
+  if (SALTO_FRECUENCIA) {
+    salto.update(micros());
+  }
+}
+
+void loop() {
+  // Recibir datos por radiofrecuencia
+  receive_the_data();
+
+  // Verificar si se perdió la señal
+  unsigned long now = millis();
+  if (now - lastRecvTime > 1000) {
+    reset_the_Data();
+    failsafe = true;
+  }
+
+  // ========== CONTROL DE MOTOR ==========
+  if (received_data.ch1 > 0 && received_data.ch2 == 0) {
+    velocidadFinal = received_data.ch1;
+    motor1.pwm = velocidadFinal;
+    motor1.front();
+  }
+  else if (received_data.ch2 > 0 && received_data.ch1 == 0) {
+    velocidadFinal = received_data.ch2;
+    motor1.pwm = velocidadFinal;
+    motor1.back();
+  }
+  else {
+    velocidadFinal = 0;
+    motor1.stop();
+  }
+
+  // ========== CONTROL DE DIRECCIÓN (SERVO) ==========
+  if (received_data.ch3 > 0) {
+    direccionFinal = map(received_data.ch3, 0, 255, 71, 180);
+  }
+  else if (received_data.ch4 > 0) {
+    direccionFinal = map(received_data.ch4, 0, 255, 71, 0);
+  }
+  else {
+    direccionFinal = 71;
+  }
+  servo.write(direccionFinal);
+
+  // Depuración por Serial (a 9600 baudios cada línea tarda ~50 ms: solo 4 por segundo,
+  // una con salto de frecuencia para no perder ranuras)
+  static unsigned long lastPrintTime = 0;
+  if (now - lastPrintTime < (SALTO_FRECUENCIA ? 1000 : 250)) return;
+  lastPrintTime = now;
+  Serial.print("Vel Final: ");
+  Serial.print(velocidadFinal);
+  Serial.print(" | Dir Final: ");
+  Serial.print(direccionFinal);
+  Serial.print(" | Sec: ");
+  Serial.print(telemetria.getLastSequence());
+  Serial.print(" | RSSI: ");
+  Serial.print(telemetria.getRssi());
+  Serial.println("%");
+}